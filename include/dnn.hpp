@@ -1,8 +1,20 @@
 /* Please Note:
- * 1. The data is 4D.
+ * 1. The data is 4D, NCHW by default, NHWC and nChw16c by ACSASetTensor4dFormat.
+ *    Convolution of the other layouts runs by the fused pipeline.
  * 2. Conv Default:
- *      filter size is 3x3
- *      stride = 1, pad = 0/1
+ *      filter size is 3x3, 5x5 by ACSA_WINOGRAD_2X5/4X5, 1x3 and 3x1 by ACSA_WINOGRAD_4X3_1D
+ *      3x3 also by ACSA_WINOGRAD_5X3/8X3, AUTO and TUNE leave 8X3 out for its fp32 error
+ *      stride = 1/2, pad = 0/1
+ *      stride 2 runs the tiles of the 3x3 algorithms by the fused pipeline, see ACSAWinoConvolutionStride2
+ *      dilation by ACSASetConvDilation runs on interleaved sub-images, see ACSAWinoConvolutionDilated
+ *      groups by ACSASetConvGroups, the filter is (K, C/groups, r, r), see ACSAWinoConvolutionGrouped
+ *      depthwise (groups = K = C) runs the element-wise kernel, see ACSAWinoDepthwise
+ *      bf16/fp16 bridge data by ACSASetWinoBridge runs by the fused pipeline
+ *      INT8 bridge data runs by the fused pipeline of ACSA_WINOGRAD_2X3, the output stays float
+ *      ACSA_CONV_DIRECT is direct convolution of 3x3 filters, AUTO picks it for few channels
+ *      ACSA_CONV_GEMM is im2col and gemm of any filter, AUTO takes it when no variant fits the filter or the stride
+ *      ACSAWinoConvolutionBwdData is the backward-data pass of any of them
+ *      ACSAWinoConvolutionBwdFilter is the filter gradient of the winograd variants, without dilation
  * 3. Pool Default:
  *      kernel size is 2x2
  *      stride = 2, pad = 0
@@ -16,21 +28,18 @@
 #include <stdlib.h>
 #include <string.h>
 #include <typeinfo>
+#include <algorithm>
+#include <limits>
 #include <assert.h>
+#include <stdint.h>
 #include <omp.h>
 #include <mkl.h>
+#ifdef __F16C__
+#include <immintrin.h>
+#endif
 
 #include "dnnDescriptor.hpp"
 
-// The below parameters are required to generate the scratch pad memory
-// It is required to reserve enough memory to store data for all the sizes you will be working on
-// For example : by default, the below parameters are set for the VGG-16 Type D network 
-#define MAX_BATCH           64
-#define MAX_IMAGE_CHANNELS  64
-#define MAX_IROWS           226
-#define MAX_FILTER_CHANNELS 512
-#define MAX_FILTERS         512
-
 #define ACSA_MESSAGE(s) printf("%s : %s, %d >>> %s\n", \
         __FILE__, __FUNCTION__, __LINE__, s);
 
@@ -41,26 +50,272 @@
     } \
 }while(0)
 
-/* ISTRIDE is the max batch*ntile*channel.
- * FSTRIDE is the max C*K for filter.
- * OSTRIDE is the max batch*ntile*nfilter.
+/* Align the stride of bridge data to 64 bytes,
+ * and keep it away from multiples of 4K to avoid cache aliasing.
+ **/
+inline long no4k_aligned(long stride, const int dsize)
+{
+    const long align = 64/dsize;
+
+    stride = (stride+align-1)/align*align;
+    if((stride*dsize)%4096 == 0)
+        stride += align;
+
+    return stride;
+}
+
+/* Conversions of the 16-bit bridges, both round to nearest even.
+ * bf16 is the upper half of fp32, fp16 is IEEE half precision.
  **/
-const long MAX_TILES = (MAX_IROWS-2)*(MAX_IROWS-2)*0.25; 
-#if 1
-/* The max stride for bridge data. */
-const long ISTRIDE = (MAX_BATCH)*(MAX_IMAGE_CHANNELS+18)*(MAX_TILES+13)*1.5; 
-const long FSTRIDE = (MAX_FILTER_CHANNELS+1)*(MAX_FILTERS+1); 
-const long OSTRIDE = ISTRIDE; 
+inline uint16_t ACSAFloatToBf16(const float x)
+{
+    uint32_t u;
+
+    memcpy(&u, &x, 4);
+    if((u & 0x7fffffff) > 0x7f800000)
+        return (u >> 16) | 0x40;    // keep NaN a quiet NaN
+    u += 0x7fff + ((u >> 16) & 1);
+
+    return u >> 16;
+}
+
+inline float ACSABf16ToFloat(const uint16_t h)
+{
+    const uint32_t u = (uint32_t)h << 16;
+    float x;
+
+    memcpy(&x, &u, 4);
+
+    return x;
+}
+
+inline uint16_t ACSAFloatToHalf(const float x)
+{
+#ifdef __F16C__
+    return _cvtss_sh(x, 0);
 #else
-extern long ISTRIDE; 
-extern long FSTRIDE;
-extern long OSTRIDE;
+    uint32_t u;
+    float f;
+
+    memcpy(&u, &x, 4);
+    const uint32_t sign = (u >> 16) & 0x8000;
+    u &= 0x7fffffff;
+
+    if(u >= 0x7f800000)     // inf and NaN
+        return sign | 0x7c00 | ((u > 0x7f800000) ? 0x200 : 0);
+    if(u >= 0x477ff000)     // rounds beyond 65504
+        return sign | 0x7c00;
+    if(u < 0x38800000){     // subnormal, the add rounds at 2^-24
+        memcpy(&f, &u, 4);
+        f += 0.5f;
+        memcpy(&u, &f, 4);
+        return sign | (u - 0x3f000000);
+    }
+    // Rebias the exponent and round the 13 dropped bits
+    u += 0xc8000fff + ((u >> 13) & 1);
+
+    return sign | (u >> 13);
 #endif
+}
+
+inline float ACSAHalfToFloat(const uint16_t h)
+{
+#ifdef __F16C__
+    return _cvtsh_ss(h);
+#else
+    const uint32_t sign = (uint32_t)(h & 0x8000) << 16;
+    const uint32_t e = (h >> 10) & 0x1f;
+    const uint32_t m = h & 0x3ff;
+    uint32_t u;
+    float x;
+
+    if(e == 0){
+        x = m*5.9604644775390625e-8f;   // m * 2^-24
+        memcpy(&u, &x, 4);
+        u |= sign;
+    }
+    else if(e == 31)
+        u = sign | 0x7f800000 | (m << 13);
+    else
+        u = sign | ((e + 112) << 23) | (m << 13);
+    memcpy(&x, &u, 4);
+
+    return x;
+#endif
+}
+
+/* Offset of element (n, c, h, w) in the layout of tensor. */
+inline long ACSATensorOffset(const ACSATensor4d *tensor,
+        const int n, const int c, const int h, const int w)
+{
+    const long C = tensor->c_;
+    const long H = tensor->h_;
+    const long W = tensor->w_;
+
+    switch(tensor->format_)
+    {
+        case ACSA_TENSOR_NHWC:
+            return ((n*H + h)*W + w)*C + c;
+        case ACSA_TENSOR_NCHW16C:
+            return (((n*((C+15)/16) + c/16)*H + h)*W + w)*16 + c%16;
+        default:
+            return ((n*C + c)*H + h)*W + w;
+    }
+}
+
+/* Elements held by tensor, nChw16c counts the padded channels. */
+inline long ACSATensorSize(const ACSATensor4d *tensor)
+{
+    long C = tensor->c_;
+
+    if(tensor->format_ == ACSA_TENSOR_NCHW16C)
+        C = (C+15)/16*16;
+
+    return (long)tensor->n_*C*tensor->h_*tensor->w_;
+}
+
+/* Fused bias and activation for the output of convolution.
+ * y = min(max(x+b, (x+b)*slope), ceil) covers relu, leaky relu and clipped relu.
+ **/
+template<typename Dtype>
+inline Dtype ACSAActivate(const Dtype x, const Dtype b, const Dtype slope, const Dtype ceil)
+{
+    const Dtype y = x + b;
+
+    return std::min(std::max(y, y*slope), ceil);
+}
 
-/* Pointer for bridge data. */
-extern void* winoIn;    
-extern void* winoFilter;    
-extern void* winoOut;    
+template<typename Dtype>
+inline void ACSAActivateTile(Dtype *tile, const int size,
+        const Dtype b, const Dtype slope, const Dtype ceil)
+{
+    for(int i = 0; i < size; i++)
+        tile[i] = ACSAActivate<Dtype>(tile[i], b, slope, ceil);
+}
+
+/* Get slope and ceil for ACSAActivate, NULL means no activation. */
+template<typename Dtype>
+inline void ACSAActivParam(ACSAActivMessage *activMess, Dtype &slope, Dtype &ceil)
+{
+    slope = 1;
+    ceil = std::numeric_limits<Dtype>::max();
+    if(activMess == NULL)
+        return;
+
+    switch(activMess->mode_)
+    {
+        case ACSA_ACTIVATION_RELU:
+            slope = 0;
+            break;
+        case ACSA_ACTIVATION_LEAKY_RELU:
+            slope = activMess->alpha_;
+            break;
+        case ACSA_ACTIVATION_CLIPPED_RELU:
+            slope = 0;
+            ceil = activMess->ceil_;
+            break;
+        default:
+            break;
+    }
+}
+
+/* Whether poolMess can be fused into the output transform, only 2x2 with stride 2. */
+inline bool ACSAPoolFusible(ACSAPoolMessage *poolMess, const int out_h, const int out_w)
+{
+    return (poolMess->kernel_h_ == 2) && (poolMess->kernel_w_ == 2) &&
+        (poolMess->stride_h_ == 2) && (poolMess->stride_w_ == 2) &&
+        (poolMess->pad_h_ == 0) && (poolMess->pad_w_ == 0) &&
+        (out_h%2 == 0) && (out_w%2 == 0);
+}
+
+/* Max pooling 2x2 of the r_out*c_out corner of a M*M output tile, write to pooled data. */
+template<typename Dtype>
+inline void ACSAPoolTileMax(Dtype *data, const Dtype *tile, const int M,
+        const int r_out, const int c_out, const int r_init, const int c_init, const int c_num)
+{
+    for(int i = 0; i < r_out; i += 2)
+        for(int j = 0; j < c_out; j += 2){
+            const Dtype *t = tile + i*M + j;
+            data[(r_init+i)/2*c_num + (c_init+j)/2] =
+                std::max(std::max(t[0], t[1]), std::max(t[M], t[M+1]));
+        }
+}
+
+/* Whether algo computes filters of the shape of tensorFilter. */
+inline bool ACSAWinoAlgoFits(ACSAWinogradAlgo algo, const ACSATensor4d *tensorFilter)
+{
+    const int h = tensorFilter->h_;
+    const int w = tensorFilter->w_;
+
+    switch(algo)
+    {
+        case ACSA_WINOGRAD_2X3:
+        case ACSA_WINOGRAD_3X3:
+        case ACSA_WINOGRAD_4X3:
+        case ACSA_WINOGRAD_6X3:
+        case ACSA_WINOGRAD_5X3:
+        case ACSA_WINOGRAD_8X3:
+        case ACSA_CONV_DIRECT:
+            return (h == 3) && (w == 3);
+        case ACSA_WINOGRAD_2X5:
+        case ACSA_WINOGRAD_4X5:
+            return (h == 5) && (w == 5);
+        case ACSA_WINOGRAD_4X3_1D:
+            return ((h == 1) && (w == 3)) || ((h == 3) && (w == 1));
+        case ACSA_CONV_GEMM:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* Whether the layer is depthwise, every channel of in has its own filter.
+ * The filter is (C, 1, r, r), the shapes alone tell it.
+ **/
+inline bool ACSAIsDepthwise(const ACSATensor4d *tensorIn, const ACSATensor4d *tensorFilter)
+{
+    return (tensorIn->c_ > 1) && (tensorFilter->c_ == 1) && (tensorFilter->n_ == tensorIn->c_);
+}
+
+/* The INT8 bridge applies to float, double keeps its own storage. */
+template<typename Dtype>
+inline bool ACSAWinoInt8(const ACSAWinoMessage *winoMess)
+{
+    return winoMess->bridge_ == ACSA_BRIDGE_INT8 && typeid(Dtype) == typeid(float);
+}
+
+/* Bridge Dtype runs with, double ignores the one of winoMess. */
+template<typename Dtype>
+inline ACSABridgeType ACSAWinoBridge(const ACSAWinoMessage *winoMess)
+{
+    return (typeid(Dtype) == typeid(float)) ? winoMess->bridge_ : ACSA_BRIDGE_FP32;
+}
+
+/* Whether the filter of ACSACreateWinoFilter was made for Dtype and the bridge of winoMess,
+ * the direct and im2col convolutions always run in Dtype.
+ **/
+template<typename Dtype>
+inline bool ACSAWinoFilterFits(const ACSAWinoFilter *wfilter, const ACSAWinoMessage *winoMess)
+{
+    if(wfilter->dsize_ != (int)sizeof(Dtype))
+        return false;
+
+    return wfilter->algo_ >= ACSA_CONV_DIRECT || wfilter->bridge_ == ACSAWinoBridge<Dtype>(winoMess);
+}
+
+/* Whether a winograd layer runs by the fused pipeline: asked by the schedule, or
+ * needed by a bridge other than FP32 or a layout other than NCHW.
+ **/
+inline bool ACSAWinoFused(const ACSATensor4d *tensorIn, const ACSATensor4d *tensorOut, const ACSAWinoMessage *winoMess)
+{
+    return winoMess->schedule_ == ACSA_SCHEDULE_FUSED || winoMess->bridge_ != ACSA_BRIDGE_FP32 ||
+        tensorIn->format_ != ACSA_TENSOR_NCHW || tensorOut->format_ != ACSA_TENSOR_NCHW;
+}
+
+/* Return the workspace of handle to hold bridge data, grow it if needed.
+ * NULL when the memory of caller is too small, the convolution returns ACSAFAIL.
+ **/
+void* ACSAReserveWorkspace(ACSAHandle *handle, size_t size);
 
 #if 0
 /* Decide wether to use batch block strategy. */
@@ -69,54 +324,513 @@ void decide_batch_block(const int lyn,
         int *pbb2x3, int *pbb3x3);
 #endif
 
+/* Create and destroy the handle.
+ * num_threads = 0 uses the default threads of OpenMP.
+ * The threads of a handle are not pinned here, set OMP_PLACES=cores and OMP_PROC_BIND=close
+ * (or spread for the handles of several streams) so the workspace stays near its cores.
+ **/
+ACSAStatus ACSACreateHandle(ACSAHandle &handle, int num_threads);
+ACSAStatus ACSADestroyHandle(ACSAHandle &handle);
+ACSAStatus ACSASetHandleThreads(ACSAHandle &handle, int num_threads);
+/* Use the memory of caller as workspace, see ACSAGetWinoWorkspaceSize. */
+ACSAStatus ACSASetHandleWorkspace(ACSAHandle &handle, void *workspace, size_t workspaceSize);
+
 /* Kernel API for Convolution */
 ACSAStatus ACSASetTensor4d(ACSATensor4d &tensor, int n, int c, int h, int w);
+ACSAStatus ACSASetTensor4dFormat(ACSATensor4d &tensor, ACSATensorFormat format);
 ACSAStatus ACSASetConvMessage(ACSAConvMessage &convMess,
         int kernel_h, int kernel_w,
         int pad_h, int pad_w, int stride_h, int stride_w);
+/* Taps of the filter are dilation apart, out is in+2*pad-dilation*(kernel-1). */
+ACSAStatus ACSASetConvDilation(ACSAConvMessage &convMess, int dilation_h, int dilation_w);
+/* Channels of in and filters split into groups, filter is (K, C/groups, kernel_h, kernel_w). */
+ACSAStatus ACSASetConvGroups(ACSAConvMessage &convMess, int groups);
 ACSAStatus ACSASetPoolMessage(ACSAPoolMessage &poolMess,
         int kernel_h, int kernel_w,
         int pad_h, int pad_w, int stride_h, int stride_w);
 ACSAStatus ACSASetWinoMessage(ACSAWinoMessage &winoMess,
         ACSAWinogradAlgo algo, int bb, int mg);
+ACSAStatus ACSASetWinoGemm(ACSAWinoMessage &winoMess, ACSAGemmMode gemm);
+ACSAStatus ACSASetWinoSchedule(ACSAWinoMessage &winoMess, ACSAWinoSchedule schedule);
+/* Keep the transformed input and filter of float in 16 bits, fp32 by default.
+ * The gemm reads half the bytes of them, the fused pipeline always runs for it.
+ * A raw filter is still transformed in fp32 and rounded into the workspace on every
+ * call, ACSACreateWinoFilter rounds it once and keeps the 16-bit copy with its own.
+ * The rounding grows with the tile, the largest error relative to the largest output
+ * is about 0.5% on F(2x3), 8% on F(4x3) and 14% on F(6x3) for bf16, and about a tenth
+ * of it for fp16: prefer F(2x3) or fp16 where the accuracy matters. Stride 2 fails
+ * F(6x3) with them, its tile has the 13 points of F(11,3).
+ * ACSA_BRIDGE_INT8 quantizes them to 8 bits for the 8-bit dot products,
+ * the input by its largest magnitude of every call and the filter per point and filter,
+ * once by ACSACreateWinoFilter.
+ **/
+ACSAStatus ACSASetWinoBridge(ACSAWinoMessage &winoMess, ACSABridgeType bridge);
+ACSAStatus ACSASetActivMessage(ACSAActivMessage &activMess,
+        ACSAActivationMode mode, float alpha, float ceil);
 
+/* Winograd convolution.
+ * bias (K values) and activMess are optional, they are fused into the output transform.
+ * poolMess (2x2, stride 2) fuses max pooling too, out then holds the pooled
+ * result (N, K, h/2, w/2) while tensorOut still describes the convolution output.
+ * Only F(2,3), F(4,3), F(6,3), F(2,5) and F(4,5) support it, their tiles do not straddle a window.
+ **/
+
+/* Bytes of workspace needed by ACSAWinoConvolutionFwd for the given shape.
+ * Attach a buffer of this size by ACSASetHandleWorkspace, or let the handle grow its own.
+ * The fused pipeline keeps blocks for every thread, they are counted for the threads
+ * of OpenMP at the query: a handle of more threads needs a larger buffer.
+ **/
 template<typename Dtype>
-ACSAStatus ACSAWinoConvolutionFwd(const Dtype *in, const Dtype *filter, Dtype *out,
+ACSAStatus ACSAGetWinoWorkspaceSize(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess);
+/* Same, a dilated or grouped layer needs its convMess. */
+template<typename Dtype>
+ACSAStatus ACSAGetWinoWorkspaceSize(size_t &size,
         ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
         ACSAConvMessage* convMess, ACSAWinoMessage *winoMess);
+
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolutionFwd(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
 		  
+/* Forward by the filter of ACSACreateWinoFilter, its algorithm overrides winoMess->algo_.
+ * Only ACSA_CONV_GEMM takes strides here, the others return ACSAFAIL for a stride
+ * other than 1, whose tiles need a filter transform of their own: pass the raw filter for them.
+ **/
 template<typename Dtype>
-ACSAStatus ACSAWinoConvolution_2x3(const Dtype *in, const Dtype *filter, Dtype *out,
+ACSAStatus ACSAWinoConvolutionFwd(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+
+/* Backward-data convolution for training, diffIn (shape of tensorIn) from diffOut (shape of tensorOut).
+ * The tensors and convMess are those of the forward layer, the filter is (K, C/groups, r, s) as it is.
+ * It runs ACSAWinoConvolutionFwd on the rotated filter with C and K swapped, by the algo of winoMess.
+ **/
+template<typename Dtype>
+ACSAStatus ACSAGetWinoBwdDataWorkspaceSize(size_t &size,
         ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
         ACSAConvMessage* convMess, ACSAWinoMessage *winoMess);
 
 template<typename Dtype>
-ACSAStatus ACSAWinoConvolution_3x3(const Dtype *in, const Dtype *filter, Dtype *out,
+ACSAStatus ACSAWinoConvolutionBwdData(ACSAHandle *handle,
+        const Dtype *diffOut, const Dtype *filter, Dtype *diffIn,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess);
+
+/* Backward-filter convolution for training, diffFilter (K, C/groups, r, s) from in and diffOut.
+ * It runs in the winograd domain by the variant of winoMess that fits the filter,
+ * AUTO and TUNE take the variant ACSAWinoSelect picks for the forward layer,
+ * ACSA_CONV_DIRECT and ACSA_CONV_GEMM the widest of F(4x4,3x3), F(2x2,5x5) and the 1D one.
+ * Strides spread diffOut with zeros, dilation returns ACSAFAIL even under AUTO.
+ * The sum over the batch runs in a fixed order, the result doesn't depend on the threads.
+ **/
+template<typename Dtype>
+ACSAStatus ACSAGetWinoBwdFilterWorkspaceSize(size_t &size,
         ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
         ACSAConvMessage* convMess, ACSAWinoMessage *winoMess);
 
 template<typename Dtype>
-ACSAStatus ACSAWinoConvolution_4x3(const Dtype *in, const Dtype *filter, Dtype *out,
+ACSAStatus ACSAWinoConvolutionBwdFilter(ACSAHandle *handle,
+        const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess);
+
+/* Winograd convolution of stride 2, called by ACSAWinoConvolutionFwd.
+ * A tile of F(m,3) reads 2m+1 rows of in, the even ones by F(m,2) with the
+ * even taps and the odd ones by F(m,1) with the middle tap, so the four
+ * phases of the filter run as their own sub-kernels in one fused pipeline.
+ * It takes the algorithms of 3x3 filters, AUTO and TUNE pick F(4,3), or
+ * F(2,3) for INT8 and the outputs smaller than one of its tiles.
+ **/
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolutionStride2(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_stride2(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess);
+
+/* Winograd convolution with dilation, called by ACSAWinoConvolutionFwd.
+ * It is one stride-1 convolution of N*d_h*d_w interleaved sub-images of in,
+ * (out_h/d_h + r-1, out_w/d_w + r-1) rounded up, with the filter as it is.
+ * The sub-images sit in front of the workspace of their convolution, and the
+ * 2x2 pooling reads its windows straight from them.
+ **/
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolutionDilated(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolutionDilated(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+void ACSADilationPhaseTensors(ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSATensor4d &phaseIn, ACSATensor4d &phaseOut);
+template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_dilation(size_t &size,
         ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
         ACSAConvMessage* convMess, ACSAWinoMessage *winoMess);
 
+/* Grouped winograd convolution, called by ACSAWinoConvolutionFwd.
+ * The groups run one by one as dense convolutions of (N, C/groups) to
+ * (N, K/groups). Depthwise layers of stride 1 skip it for ACSAWinoDepthwise.
+ **/
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolutionGrouped(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
 template<typename Dtype>
-ACSAStatus ACSAWinoConvolution_6x3(const Dtype *in, const Dtype *filter, Dtype *out,
+ACSAStatus ACSAWinoConvolutionGrouped(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+void ACSAGroupTensors(ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSATensor4d &groupIn, ACSATensor4d &groupFilter, ACSATensor4d &groupOut);
+template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_grouped(size_t &size,
         ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
         ACSAConvMessage* convMess, ACSAWinoMessage *winoMess);
 
+/* Direct 3x3 convolution of stride 1 for ACSA_CONV_DIRECT, called by ACSAWinoConvolutionFwd.
+ * filter is (K, C, 3, 3) as it is, the pre-transformed filter of this algorithm holds
+ * tap p of filter (k, c) at p*stride_ + k*c_ + c as the points of winograd.
+ **/
+template<typename Dtype>
+ACSAStatus ACSADirectConvolution(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+template<typename Dtype>
+ACSAStatus ACSADirectConvolution(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+
+/* Convolution by im2col and gemm for ACSA_CONV_GEMM, called by ACSAWinoConvolutionFwd.
+ * filter is (K, C/groups, R, S) as it is, strides, dilation and groups run as they are.
+ * The columns and the gemm result of a task are buffers of its thread, no workspace.
+ **/
+template<typename Dtype>
+ACSAStatus ACSAGemmConvolution(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+
+/* Variant of the lowest estimated cost for the shape, written to winoMess->algo_.
+ * Nothing runs, ACSAWinoConvolutionFwd with ACSA_WINOGRAD_AUTO calls it on every run.
+ **/
+template<typename Dtype>
+ACSAStatus ACSAWinoSelect(ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess, ACSAPoolMessage *poolMess = NULL);
+
+/* Auto-tuning of the algorithm, merge and batch block for one layer.
+ * The candidates run on the given data, the winner is written to winoMess
+ * (gemm and schedule are kept) and to a cache file keyed by the shape, the
+ * CPU model and the threads of handle. Later calls read the cache only.
+ * The file is $ACSA_TUNE_CACHE, or acsa_wino_tune.cache in the working directory.
+ * ACSAWinoConvolutionFwd with ACSA_WINOGRAD_TUNE calls it on every run.
+ **/
+template<typename Dtype>
+ACSAStatus ACSAWinoTune(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+
+template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_2x3(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess);
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_2x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_2x3(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+template<typename Dtype>
+ACSAStatus ACSAWinoFilterTransform_2x3(const Dtype *filter, Dtype *wino_filter,
+        const int C, const int K, const long fstride);
+template<typename Dtype>
+ACSAStatus ACSAWinoBwdFilter_2x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess);
+
+template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_3x3(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess);
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_3x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_3x3(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+template<typename Dtype>
+ACSAStatus ACSAWinoFilterTransform_3x3(const Dtype *filter, Dtype *wino_filter,
+        const int C, const int K, const long fstride);
+template<typename Dtype>
+ACSAStatus ACSAWinoBwdFilter_3x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess);
+
+template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_4x3(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess);
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_4x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_4x3(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+template<typename Dtype>
+ACSAStatus ACSAWinoFilterTransform_4x3(const Dtype *filter, Dtype *wino_filter,
+        const int C, const int K, const long fstride);
+template<typename Dtype>
+ACSAStatus ACSAWinoBwdFilter_4x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess);
+
+template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_6x3(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess);
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_6x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_6x3(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+template<typename Dtype>
+ACSAStatus ACSAWinoFilterTransform_6x3(const Dtype *filter, Dtype *wino_filter,
+        const int C, const int K, const long fstride);
+template<typename Dtype>
+ACSAStatus ACSAWinoBwdFilter_6x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess);
+
+template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_2x5(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess);
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_2x5(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_2x5(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+template<typename Dtype>
+ACSAStatus ACSAWinoFilterTransform_2x5(const Dtype *filter, Dtype *wino_filter,
+        const int C, const int K, const long fstride);
+template<typename Dtype>
+ACSAStatus ACSAWinoBwdFilter_2x5(ACSAHandle *handle,
+        const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess);
+
+template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_4x5(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess);
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_4x5(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_4x5(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+template<typename Dtype>
+ACSAStatus ACSAWinoFilterTransform_4x5(const Dtype *filter, Dtype *wino_filter,
+        const int C, const int K, const long fstride);
+template<typename Dtype>
+ACSAStatus ACSAWinoBwdFilter_4x5(ACSAHandle *handle,
+        const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess);
+
+template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_5x3(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess);
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_5x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_5x3(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+template<typename Dtype>
+ACSAStatus ACSAWinoFilterTransform_5x3(const Dtype *filter, Dtype *wino_filter,
+        const int C, const int K, const long fstride);
+template<typename Dtype>
+ACSAStatus ACSAWinoBwdFilter_5x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess);
+
+template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_8x3(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess);
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_8x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_8x3(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+template<typename Dtype>
+ACSAStatus ACSAWinoFilterTransform_8x3(const Dtype *filter, Dtype *wino_filter,
+        const int C, const int K, const long fstride);
+template<typename Dtype>
+ACSAStatus ACSAWinoBwdFilter_8x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess);
+
+template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_4x3_1d(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess);
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_4x3_1d(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_4x3_1d(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias = NULL, ACSAActivMessage *activMess = NULL,
+        ACSAPoolMessage *poolMess = NULL);
+template<typename Dtype>
+ACSAStatus ACSAWinoFilterTransform_4x3_1d(const Dtype *filter, Dtype *wino_filter,
+        const int C, const int K, const long fstride, const int vertical);
+template<typename Dtype>
+ACSAStatus ACSAWinoBwdFilter_4x3_1d(ACSAHandle *handle,
+        const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess);
+
+/* Transform the filter once, reuse it for every forward call.
+ * AUTO and TUNE return ACSAFAIL, choose the algorithm by ACSAWinoSelect first.
+ * It keeps Dtype and the bridge of winoMess, a forward of another type or bridge returns ACSAFAIL.
+ * Release it by ACSADestroyWinoFilter when the weights change. */
+template<typename Dtype>
+ACSAStatus ACSACreateWinoFilter(ACSAWinoFilter &wfilter, const Dtype *filter,
+        ACSATensor4d* tensorFilter, ACSAWinoMessage *winoMess);
+ACSAStatus ACSADestroyWinoFilter(ACSAWinoFilter &wfilter);
+
 /* kernel API for activation. */
 template<typename Dtype>
-ACSAStatus ACSAReLUInplaceFwd(Dtype *in_out, ACSATensor4d* tensor);
+ACSAStatus ACSAReLUInplaceFwd(ACSAHandle *handle, Dtype *in_out, ACSATensor4d* tensor);
 template<typename Dtype>
-ACSAStatus ACSAReLUOutplaceFwd(const Dtype *in, Dtype *out, ACSATensor4d* tensor);
+ACSAStatus ACSAReLUOutplaceFwd(ACSAHandle *handle, const Dtype *in, Dtype *out, ACSATensor4d* tensor);
 
 /* kernel API for pooling. */
 template<typename Dtype>
-ACSAStatus ACSAMaxPoolingFwd(const Dtype *in, Dtype *out, ACSATensor4d* tensor,
+ACSAStatus ACSAMaxPoolingFwd(ACSAHandle *handle, const Dtype *in, Dtype *out, ACSATensor4d* tensor,
         ACSAPoolMessage* poolMess);
 template<typename Dtype>
-ACSAStatus ACSAAvePoolingFwd(const Dtype *in, Dtype *out, ACSATensor4d* tensor,
+ACSAStatus ACSAAvePoolingFwd(ACSAHandle *handle, const Dtype *in, Dtype *out, ACSATensor4d* tensor,
         ACSAPoolMessage* poolMess);
 
 /* kernel API for other. */
@@ -128,23 +842,137 @@ template<typename Dtype>
 ACSAStatus ACSAGetFinalOutput(Dtype *data, const Dtype *tmp,
         int r_out, int c_out, int r_init, int c_init, int c_num,
         int r_up, int r_down, int c_left, int c_right);
+template<typename Dtype>
+ACSAStatus ACSABatchGemm(const Dtype *in, const int irows, const int icols, const long istride,
+        const Dtype *filter, const int fcols, const long fstride,
+        Dtype *out, const long ostride,
+        const int points, const int batch);
+/* Winograd F(F_M,3) by the fused pipeline, called by the algorithms when ACSAWinoFused.
+ * work holds ACSAWinoPipelineBytes for the threads of OpenMP, the blocks of a thread are its own.
+ **/
+template<typename Dtype, int F_M>
+ACSAStatus ACSAWinoPipeline(const float *BT, const float *AT,
+        const Dtype *in, const Dtype *wino_filter, const long fstride, const ACSAWinoFilter *wfilter,
+        Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess, void *work,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess);
+/* Winograd F(M_H x M_W, R_H x R_W) by the fused pipeline, rows and columns of
+ * a tile transform by their own matrixes. ACSAWinoPipeline is F(F_M x F_M, 3x3).
+ **/
+template<typename Dtype, int M_H, int R_H, int M_W, int R_W>
+ACSAStatus ACSAWinoPipelineRect(const float *BTh, const float *ATh, const float *BTw, const float *ATw,
+        const Dtype *in, const Dtype *wino_filter, const long fstride, const ACSAWinoFilter *wfilter,
+        Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess, void *work,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess);
+/* Winograd of stride 2 by the fused pipeline, called by ACSAWinoConvolutionStride2.
+ * BT and AT are (2*F_M+1) x (2*F_M+1) and F_M x (2*F_M+1), tiles start 2*F_M rows apart.
+ **/
+template<typename Dtype, int F_M>
+ACSAStatus ACSAWinoPipelineStride2(const float *BT, const float *AT,
+        const Dtype *in, const Dtype *wino_filter, const long fstride, const ACSAWinoFilter *wfilter,
+        Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess, void *work,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess);
+/* Bytes of the work of the fused pipeline of F(M_H x M_W, r x s) for nthreads threads,
+ * the algorithms add them after the transformed filter. 0 when the layer doesn't run by it.
+ **/
+template<typename Dtype>
+size_t ACSAWinoPipelineBytes(const int M_H, const int M_W, ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter,
+        ACSATensor4d* tensorOut, ACSAWinoMessage *winoMess, const int nthreads, const int stride = 1);
+/* Depthwise winograd F(F_M,3), called by the algorithms when ACSAIsDepthwise.
+ * The transformed tiles of 16 channels are multiplied element-wise with the
+ * filters in the SIMD lanes, there is no gemm and no bridge data.
+ **/
+template<typename Dtype, int F_M>
+ACSAStatus ACSAWinoDepthwise(const float *BT, const float *AT,
+        const Dtype *in, const Dtype *wino_filter, const long fstride, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess);
+template<typename Dtype, int M_H, int R_H, int M_W, int R_W>
+ACSAStatus ACSAWinoDepthwiseRect(const float *BTh, const float *ATh, const float *BTw, const float *ATw,
+        const Dtype *in, const Dtype *wino_filter, const long fstride, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess);
+/* AT (m x a), G (a x r) and BT (a x a) of winograd F(m,r) with tile a = m+r-1,
+ * from the Cook-Toom points of winoCookToom.cpp. Feeds the Rect engines.
+ **/
+ACSAStatus ACSAWinoCookToom(const int m, const int r, float *AT, float *G, float *BT);
+/* Filter transform U = Gh * g * Gw^T of ACSAWinoPipelineRect, in the layout of bridge data. */
+template<typename Dtype, int M_H, int R_H, int M_W, int R_W>
+ACSAStatus ACSAWinoFilterRect(const float *Gh, const float *Gw,
+        const Dtype *filter, Dtype *wino_filter, const int C, const int K, const long fstride);
+/* Filter gradient of winograd F(F_M,3) and F(M_H x M_W, R_H x R_W), called by the algorithms.
+ * dU = V^T * M of the input and output gradient tiles is summed over the batch in
+ * a fixed order, then transformed back by G^T. diffOut is stride 1 of shape tensorOut.
+ **/
+template<typename Dtype, int F_M>
+ACSAStatus ACSAWinoBwdFilter(const float *BT, const float *AT, const float *G,
+        ACSAHandle *handle, const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess);
+template<typename Dtype, int M_H, int R_H, int M_W, int R_W>
+ACSAStatus ACSAWinoBwdFilterRect(const float *BTh, const float *ATh, const float *Gh,
+        const float *BTw, const float *ATw, const float *Gw,
+        ACSAHandle *handle, const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess);
+size_t ACSAWinoBwdFilterBytes(const int M_H, const int M_W, ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter,
+        ACSATensor4d* tensorGrad, const size_t dsize);
+/* Same as ACSABatchGemm, by the register-blocked kernel when the ISA allows. */
+template<typename Dtype>
+ACSAStatus ACSAWinoGemm(const Dtype *in, const int irows, const int icols, const long istride,
+        const Dtype *filter, const int fcols, const long fstride,
+        Dtype *out, const long ostride,
+        const int points, const int batch);
 
-#if 0
-/* Compute stride for bridge data. */
-inline ACSAStatus no4k_aligned(long *);
-ACSAStatus compute_max_stride(const int, const int, const int *, const int *, const int *, const int *);
+/* Same with in and filter in 16 bits of bridge, out accumulates in fp32. */
+ACSAStatus ACSAWinoGemmHalf(const uint16_t *in, const int irows, const int icols, const long istride,
+        const uint16_t *filter, const int fcols, const long fstride,
+        float *out, const long ostride,
+        const int points, const int batch, const ACSABridgeType bridge);
+
+/* Largest magnitude of the INT8 filter. Without VNNI the pairs of u8*s8
+ * products add up in int16, 7 bits of filter keep them from saturating.
+ **/
+#if defined(__AVX512BW__) && defined(__AVX512VNNI__)
+#define ACSA_INT8_FILTER_MAX 127
+#else
+#define ACSA_INT8_FILTER_MAX 63
 #endif
 
+/* Same with the INT8 bridge, out = (in * filter - comp) * scale with int32 products.
+ * in is u8, the int8 value plus 128, and filter is s8, icols is a multiple of 4.
+ * in of a point is (icols/4, irows, 4), 4 channels of a row together, filter is column major.
+ * scale and comp are per point and column, comp is 128 times the column sum of filter.
+ **/
+ACSAStatus ACSAWinoGemmInt8(const uint8_t *in, const int irows, const int icols, const long istride,
+        const int8_t *filter, const int fcols, const long fstride,
+        float *out, const long ostride,
+        const int points, const int batch,
+        const float *scale, const int32_t *comp);
+
+/* Point stride of the int8 filter of K x C, C rounded up to 4 as icols of ACSAWinoGemmInt8. */
+inline long ACSAWinoInt8Stride(const int C, const int K)
+{
+    return no4k_aligned((long)K*((C+3)/4*4), sizeof(int8_t));
+}
+
+/* Quantize P points of the transformed filter to int8 per point and filter, done
+ * once by ACSACreateWinoFilter. fscale (K x P) takes the int8 products of filter k
+ * back to float with the input scale of the call, comp (K x P) is 128 times its sum.
+ **/
+void ACSAWinoQuantizeFilter(const float *wino_filter, const long fstride, const int P, const int C, const int K,
+        int8_t *filter8, const long fstride8, float *fscale, int32_t *comp);
+
 #if 0
 /* Decide to size of merge. */
 ACSAStatus decide_merge(...);
 #endif
 
-/* Init and Clean the environment of winograd. */
-template<typename Dtype>
-ACSAStatus ACSACnnInitLib();
-
-template<typename Dtype>
-ACSAStatus ACSACnnFreeLib();
-
 #endif
@@ -3,6 +3,8 @@
 #ifndef _DNN_DESCRIPTOR_HPP_
 #define _DNN_DESCRIPTOR_HPP_
 
+#include <stddef.h>
+
 enum ACSAStatus {
     ACSASUCCESS,
     ACSAFAIL
@@ -12,7 +14,52 @@ enum ACSAWinogradAlgo {
     ACSA_WINOGRAD_2X3,
     ACSA_WINOGRAD_3X3,
     ACSA_WINOGRAD_4X3,
-    ACSA_WINOGRAD_6X3
+    ACSA_WINOGRAD_6X3,
+    ACSA_WINOGRAD_2X5,     // F(2x2,5x5)
+    ACSA_WINOGRAD_4X5,     // F(4x4,5x5)
+    ACSA_WINOGRAD_4X3_1D,  // F(1x4,1x3) or F(4x1,3x1), by the shape of the filter
+    ACSA_WINOGRAD_5X3,     // F(5x5,3x3)
+    ACSA_WINOGRAD_8X3,     // F(8x8,3x3), explicit only, its fp32 error is the largest, fp32 bridge only
+    ACSA_CONV_DIRECT,      // direct 3x3 convolution, for the few channels of first layers
+    ACSA_CONV_GEMM,        // im2col and gemm, any filter, stride, dilation and groups
+    ACSA_WINOGRAD_TUNE,    // benchmark the variants once, then use the tuning cache
+    ACSA_WINOGRAD_AUTO     // pick the variant by the cost model of the shape
+};
+
+/* Engine of the element-wise gemm between transformed input and filter. */
+enum ACSAGemmMode {
+    ACSA_GEMM_MKL,      // one batched gemm of MKL
+    ACSA_GEMM_KERNEL    // register-blocked AVX-512/AVX2 kernel of this library
+};
+
+/* Storage of the transformed input and filter, the gemm accumulates in fp32,
+ * or in int32 for INT8.
+ * */
+enum ACSABridgeType {
+    ACSA_BRIDGE_FP32,   // Dtype as computed
+    ACSA_BRIDGE_BF16,   // 8-bit mantissa, the range of fp32
+    ACSA_BRIDGE_FP16,   // 11-bit mantissa, up to 65504
+    ACSA_BRIDGE_INT8    // u8 input and s8 filter scaled per point, F(2x3) only
+};
+
+/* Order of the three phases over the tiles. */
+enum ACSAWinoSchedule {
+    ACSA_SCHEDULE_PHASED,   // every phase over a whole batch block
+    ACSA_SCHEDULE_FUSED     // all phases over a block of tiles sized for L2
+};
+
+enum ACSAActivationMode {
+    ACSA_ACTIVATION_NONE,
+    ACSA_ACTIVATION_RELU,
+    ACSA_ACTIVATION_LEAKY_RELU,
+    ACSA_ACTIVATION_CLIPPED_RELU
+};
+
+/* Memory layout of a 4D tensor. */
+enum ACSATensorFormat {
+    ACSA_TENSOR_NCHW,
+    ACSA_TENSOR_NHWC,
+    ACSA_TENSOR_NCHW16C     // nChw16c, channels are blocked by 16 and padded to 16
 };
 
 enum ACSALayerType {
@@ -22,11 +69,22 @@ enum ACSALayerType {
     POOLING
 };
 
+/* Per-instance state: scratch memory for bridge data and threads.
+ * Independent streams should each own a handle.
+ **/
+struct ACSAHandle {
+    void *workspace_;
+    size_t workspace_size_;
+    int own_workspace_;
+    int num_threads_;
+};
+
 struct ACSATensor4d {
     int n_;
     int c_;
     int h_;
     int w_;
+    ACSATensorFormat format_;
 };
 
 struct ACSAConvMessage {
@@ -36,12 +94,25 @@ struct ACSAConvMessage {
     int pad_w_;
     int stride_h_;
     int stride_w_;
+    int dilation_h_;    // 1 by ACSASetConvMessage, see ACSASetConvDilation
+    int dilation_w_;
+    int groups_;        // 1 by ACSASetConvMessage, see ACSASetConvGroups
 };
 
 struct ACSAWinoMessage {
     ACSAWinogradAlgo algo_;
     int batch_block_;
     int merge_;
+    ACSAGemmMode gemm_;
+    ACSAWinoSchedule schedule_;
+    ACSABridgeType bridge_;
+};
+
+/* Activation fused into the output transform of convolution. */
+struct ACSAActivMessage {
+    ACSAActivationMode mode_;
+    float alpha_;   // negative slope of leaky relu
+    float ceil_;    // upper bound of clipped relu
 };
 
 struct ACSAPoolMessage {
@@ -53,6 +124,23 @@ struct ACSAPoolMessage {
     int stride_w_;
 };
 
+/* Filter transformed once and kept for many forward calls. */
+struct ACSAWinoFilter {
+    ACSAWinogradAlgo algo_;
+    int k_;
+    int c_;
+    int dsize_;                 // sizeof the Dtype it is made for
+    ACSABridgeType bridge_;     // bridge it is made for, always FP32 for double
+    long stride_;
+    void *data_;
+    void *bdata_;               // data_ rounded to the 16-bit bridge, NULL for the others
+    int points_;                // points of the transformed filter
+    long qstride_;              // point stride of qdata_
+    void *qdata_;               // INT8: data_ quantized to int8, K x C rounded up to 4 in a point
+    void *qscale_;              // INT8: float back-scale of the int8 products, K x points_
+    void *qcomp_;               // INT8: int32 128 times the sum of a filter, K x points_
+};
+
 struct ACSATailMessage {
     int tail_h_;
     int tail_w_;
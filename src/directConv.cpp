@@ -0,0 +1,292 @@
+/* Direct 3x3 convolution for layers of few channels.
+ * With C = 3 the gemm of winograd is (tiles x 3) * (3 x K), too thin to run
+ * well, and the transforms cost more than the products, so the filter is
+ * applied to the input as it is. A task is two rows of out for one image:
+ * the four input rows under them are copied with their pad into a window,
+ * then KB filters times XB vectors of one row stay in registers while every
+ * channel and tap of the filter goes by. Bias, activation and pooling are
+ * applied on the two rows before they are stored.
+ * */
+
+#include "dnn.hpp"
+#include <immintrin.h>
+
+#if defined(__AVX512F__)
+#define VLEN 16     // floats of one vector
+#define KB 6        // filters of a register block, 6*4 accumulators of 32 zmm
+#define XB 4        // vectors of a row in a register block
+typedef __m512 vec_t;
+#define VZERO() _mm512_setzero_ps()
+#define VLOAD(p) _mm512_loadu_ps(p)
+#define VSTORE(p, v) _mm512_storeu_ps(p, v)
+#define VBCAST(p) _mm512_set1_ps(*(p))
+#define VFMA(a, b, c) _mm512_fmadd_ps(a, b, c)
+#elif defined(__AVX2__) && defined(__FMA__)
+#define VLEN 8
+#define KB 4        // 4*3 accumulators of 16 ymm
+#define XB 3
+typedef __m256 vec_t;
+#define VZERO() _mm256_setzero_ps()
+#define VLOAD(p) _mm256_loadu_ps(p)
+#define VSTORE(p, v) _mm256_storeu_ps(p, v)
+#define VBCAST(p) _mm256_broadcast_ss(p)
+#define VFMA(a, b, c) _mm256_fmadd_ps(a, b, c)
+#else
+#define KB 4
+#endif
+
+#define WIN_ROWS 4  // input rows under two rows of out
+
+/* dst(KB, nx) = the filters of fp over the window, by plain code.
+ * win is the window at the first column of the row, a channel is plane apart.
+ * */
+template<typename Dtype>
+static inline void row_plain(const Dtype *win, const long plane, const int PW, const int C,
+        const Dtype *fp, Dtype *dst, const int ldd, const int nx)
+{
+    int k, x, c, r, s;
+
+    for(k = 0; k < KB; k++)
+        for(x = 0; x < nx; x++){
+            Dtype sum = 0;
+            for(c = 0; c < C; c++)
+                for(r = 0; r < 3; r++)
+                    for(s = 0; s < 3; s++)
+                        sum += win[c*plane + r*PW + x + s] * fp[(c*9 + r*3 + s)*KB + k];
+            dst[k*ldd + x] = sum;
+        }
+}
+
+#ifdef VLEN
+/* dst(KB, MV*VLEN) of one register block. */
+template<int MV>
+static inline void micro_kernel(const float *win, const long plane, const int PW, const int C,
+        const float *fp, float *dst, const int ldd)
+{
+    int c, r, s, k, v;
+    vec_t acc[KB][MV];
+    vec_t iv[MV];
+
+    for(k = 0; k < KB; k++)
+        for(v = 0; v < MV; v++)
+            acc[k][v] = VZERO();
+
+    for(c = 0; c < C; c++)
+        for(r = 0; r < 3; r++)
+            for(s = 0; s < 3; s++){
+                const float *src = win + c*plane + r*PW + s;
+                const float *f = fp + (c*9 + r*3 + s)*KB;
+                for(v = 0; v < MV; v++)
+                    iv[v] = VLOAD(src + v*VLEN);
+                for(k = 0; k < KB; k++){
+                    const vec_t fv = VBCAST(f + k);
+                    for(v = 0; v < MV; v++)
+                        acc[k][v] = VFMA(iv[v], fv, acc[k][v]);
+                }
+            }
+
+    for(k = 0; k < KB; k++)
+        for(v = 0; v < MV; v++)
+            VSTORE(dst + k*ldd + v*VLEN, acc[k][v]);
+}
+#endif
+
+/* One row of out for the KB filters of fp, nx is a multiple of the vector. */
+template<typename Dtype>
+static inline void row_kernel(const Dtype *win, const long plane, const int PW, const int C,
+        const Dtype *fp, Dtype *dst, const int ldd, const int nx)
+{
+#ifdef VLEN
+    if(typeid(Dtype) == typeid(float)){
+        int x;
+        for(x = 0; x+XB*VLEN <= nx; x += XB*VLEN)
+            micro_kernel<XB>((const float *)win + x, plane, PW, C, (const float *)fp, (float *)dst + x, ldd);
+        for(; x < nx; x += VLEN)
+            micro_kernel<1>((const float *)win + x, plane, PW, C, (const float *)fp, (float *)dst + x, ldd);
+        return;
+    }
+#endif
+
+    row_plain(win, plane, PW, C, fp, dst, ldd, nx);
+}
+
+/* Direct convolution, tap p of filter (k, c) is at k*kstride + c*cstride + p*pstride. */
+    template<typename Dtype>
+static ACSAStatus directConvolution(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, const long kstride, const long cstride, const long pstride,
+        Dtype *out, ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    const int N = tensorIn->n_;
+    const int C = tensorIn->c_;
+    const int H = tensorIn->h_;
+    const int W = tensorIn->w_;
+    const int K = tensorFilter->n_;
+    const int pad_h = convMess->pad_h_;
+    const int pad_w = convMess->pad_w_;
+    const int outHeight = tensorOut->h_;
+    const int outWidth = tensorOut->w_;
+#ifdef VLEN
+    const int OWp = (outWidth+VLEN-1)/VLEN*VLEN;
+#else
+    const int OWp = outWidth;
+#endif
+    const int PW = OWp+2;
+    const long plane = (long)WIN_ROWS*PW;
+    const int nkb = (K+KB-1)/KB;
+    const int nrows = (outHeight+1)/2;
+
+    // Check
+    ACSA_CHECK(((tensorFilter->h_ == 3) && (tensorFilter->w_ == 3)));
+    ACSA_CHECK((tensorFilter->c_ == C));
+    ACSA_CHECK(((outHeight == H+2*pad_h-2) && (outWidth == W+2*pad_w-2)));
+    if(poolMess != NULL)
+        ACSA_CHECK(ACSAPoolFusible(poolMess, outHeight, outWidth));
+
+    Dtype slope, ceil;
+    ACSAActivParam(activMess, slope, ceil);
+
+    /* Layout and shape of out. */
+    ACSATensor4d tensorDst = *tensorOut;
+    if(poolMess != NULL){
+        tensorDst.h_ = outHeight/2;
+        tensorDst.w_ = outWidth/2;
+    }
+
+    /* Filters in blocks of KB, (nkb, C, 9, KB), the missing filters are zero. */
+    Dtype *fpack = (Dtype *)mkl_malloc((long)nkb*C*9*KB*sizeof(Dtype), 64);
+    assert(fpack != NULL);
+    int d1;
+#pragma omp parallel for private(d1) num_threads(handle->num_threads_)
+    for(d1 = 0; d1 < nkb*C*9; d1++){
+        const int kb = d1/(C*9);
+        const int c = d1%(C*9)/9;
+        const int p = d1%9;
+        for(int k = 0; k < KB; k++)
+            fpack[(long)d1*KB + k] = (kb*KB+k < K) ?
+                filter[(kb*KB+k)*kstride + c*cstride + p*pstride] : (Dtype)0;
+    }
+
+#pragma omp parallel num_threads(handle->num_threads_)
+    {
+        Dtype *win = (Dtype *)mkl_malloc(C*plane*sizeof(Dtype), 64);
+        Dtype *rows = (Dtype *)mkl_malloc(2L*KB*OWp*sizeof(Dtype), 64);
+        int d2;
+
+#pragma omp for schedule(dynamic)
+        for(d2 = 0; d2 < N*nrows; d2++){
+            const int n = d2/nrows;
+            const int y = (d2%nrows)*2;
+            const int ny = std::min(2, outHeight-y);
+            int c, i, j, k, kb;
+
+            // The window holds input rows y-pad_h .. y-pad_h+3, zero out of the image
+            for(c = 0; c < C; c++)
+                for(i = 0; i < WIN_ROWS; i++){
+                    const int r = y+i-pad_h;
+                    Dtype *dst = win + c*plane + i*PW;
+                    for(j = 0; j < PW; j++){
+                        const int s = j-pad_w;
+                        dst[j] = (r >= 0 && r < H && s >= 0 && s < W) ?
+                            in[ACSATensorOffset(tensorIn, n, c, r, s)] : (Dtype)0;
+                    }
+                }
+
+            for(kb = 0; kb < nkb; kb++){
+                const int kv = std::min(KB, K-kb*KB);
+                const Dtype *fp = fpack + (long)kb*C*9*KB;
+
+                for(i = 0; i < ny; i++)
+                    row_kernel(win + i*PW, plane, PW, C, fp, rows + (long)i*KB*OWp, OWp, OWp);
+
+                for(k = 0; k < kv; k++){
+                    const int kk = kb*KB+k;
+                    const Dtype b = (bias == NULL) ? (Dtype)0 : bias[kk];
+                    Dtype *r0 = rows + (long)k*OWp;
+                    Dtype *r1 = r0 + (long)KB*OWp;
+
+                    for(i = 0; i < ny; i++){
+                        Dtype *ri = r0 + (long)i*KB*OWp;
+                        for(j = 0; j < outWidth; j++)
+                            ri[j] = ACSAActivate<Dtype>(ri[j], b, slope, ceil);
+                    }
+
+                    if(poolMess == NULL){
+                        for(i = 0; i < ny; i++)
+                            for(j = 0; j < outWidth; j++)
+                                out[ACSATensorOffset(&tensorDst, n, kk, y+i, j)] = r0[(long)i*KB*OWp + j];
+                    }
+                    else{
+                        for(j = 0; j < outWidth; j += 2)
+                            out[ACSATensorOffset(&tensorDst, n, kk, y/2, j/2)] =
+                                std::max(std::max(r0[j], r0[j+1]), std::max(r1[j], r1[j+1]));
+                    }
+                }
+            }
+        }
+
+        mkl_free(win);
+        mkl_free(rows);
+    }
+
+    mkl_free(fpack);
+
+    return ACSASUCCESS;
+}
+
+/* API for direct convolution, filter is the K x C x 3 x 3 filter as it is. */
+    template<typename Dtype>
+ACSAStatus ACSADirectConvolution(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    const int C = tensorFilter->c_;
+
+    return directConvolution(handle, in, filter, (long)C*9, 9L, 1L, out,
+            tensorIn, tensorFilter, tensorOut, convMess, bias, activMess, poolMess);
+}
+
+/* API for direct convolution with the filter of ACSACreateWinoFilter. */
+    template<typename Dtype>
+ACSAStatus ACSADirectConvolution(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    // Check
+    ACSA_CHECK((wfilter->algo_ == ACSA_CONV_DIRECT));
+    ACSA_CHECK(((wfilter->c_ == tensorFilter->c_) && (wfilter->k_ == tensorFilter->n_)));
+    if(wfilter->dsize_ != (int)sizeof(Dtype)){
+        ACSA_MESSAGE("ERROR: The filter was transformed for another type!");
+        return ACSAFAIL;
+    }
+
+    return directConvolution(handle, in, (const Dtype *)wfilter->data_, (long)wfilter->c_, 1L, wfilter->stride_, out,
+            tensorIn, tensorFilter, tensorOut, convMess, bias, activMess, poolMess);
+}
+
+/* Instantiate Template */
+template ACSAStatus ACSADirectConvolution<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *,
+        const float *, ACSAActivMessage *, ACSAPoolMessage *);
+template ACSAStatus ACSADirectConvolution<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *,
+        const double *, ACSAActivMessage *, ACSAPoolMessage *);
+template ACSAStatus ACSADirectConvolution<float>(ACSAHandle *,
+        const float *, const ACSAWinoFilter *, float *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *,
+        const float *, ACSAActivMessage *, ACSAPoolMessage *);
+template ACSAStatus ACSADirectConvolution<double>(ACSAHandle *,
+        const double *, const ACSAWinoFilter *, double *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *,
+        const double *, ACSAActivMessage *, ACSAPoolMessage *);
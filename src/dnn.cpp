@@ -3,18 +3,6 @@
 
 #include <dnn.hpp>
 
-/* Pointer for bridge data. */
-void* winoIn;    
-void* winoFilter;    
-void* winoOut;    
-
-#if 0
-/* The default of stride for bridge data. */
-long ISTRIDE = (MAX_BATCH)*(MAX_IMAGE_CHANNELS+18)*(MAX_TILES+13); 
-long FSTRIDE = (MAX_FILTER_CHANNELS+1)*(MAX_FILTERS+1); 
-long OSTRIDE = ISTRIDE;
-#endif
-
 /* Create Tensor4d */
 ACSAStatus ACSASetTensor4d(ACSATensor4d &tensor,
         int n, int c, int h, int w)
@@ -23,6 +11,15 @@ ACSAStatus ACSASetTensor4d(ACSATensor4d &tensor,
     tensor.c_ = c;
     tensor.h_ = h;
     tensor.w_ = w;
+    tensor.format_ = ACSA_TENSOR_NCHW;
+
+    return ACSASUCCESS;
+}
+
+/* Set the layout of Tensor4d, NCHW by default. */
+ACSAStatus ACSASetTensor4dFormat(ACSATensor4d &tensor, ACSATensorFormat format)
+{
+    tensor.format_ = format;
 
     return ACSASUCCESS;
 }
@@ -38,10 +35,78 @@ ACSAStatus ACSASetConvMessage(ACSAConvMessage &convMess,
     convMess.pad_w_ = pad_w;
     convMess.stride_h_ = stride_h;
     convMess.stride_w_ = stride_w;
+    convMess.dilation_h_ = 1;
+    convMess.dilation_w_ = 1;
+    convMess.groups_ = 1;
 
     return ACSASUCCESS;
 }
 
+/* Set the dilation of the filter taps. */
+ACSAStatus ACSASetConvDilation(ACSAConvMessage &convMess, int dilation_h, int dilation_w)
+{
+    if(dilation_h < 1 || dilation_w < 1){
+        ACSA_MESSAGE("ERROR: The dilation should be at least 1!");
+        return ACSAFAIL;
+    }
+    convMess.dilation_h_ = dilation_h;
+    convMess.dilation_w_ = dilation_w;
+
+    return ACSASUCCESS;
+}
+
+/* Set the groups of channels, C and K of the layer are multiples of it. */
+ACSAStatus ACSASetConvGroups(ACSAConvMessage &convMess, int groups)
+{
+    if(groups < 1){
+        ACSA_MESSAGE("ERROR: The groups should be at least 1!");
+        return ACSAFAIL;
+    }
+    convMess.groups_ = groups;
+
+    return ACSASUCCESS;
+}
+
+/* Whether the layer runs group by group, depthwise of stride 1 has its own kernel
+ * in the winograd algorithms, the direct convolution takes its groups one by one.
+ * */
+static bool runsByGroup(ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSAConvMessage* convMess,
+        ACSAWinogradAlgo algo)
+{
+    if(convMess->groups_ == 1)
+        return false;
+
+    return !(ACSAIsDepthwise(tensorIn, tensorFilter) && convMess->stride_h_ == 1 && convMess->stride_w_ == 1 &&
+            algo != ACSA_CONV_DIRECT);
+}
+
+/* Whether the layer runs by im2col and gemm, it takes the groups, dilation and
+ * strides as they are. AUTO and TUNE send the filters no variant fits there,
+ * and the strides other than the 3x3 filters of stride 2 without dilation.
+ * The direct convolution has no stride, its strided layers go there too.
+ * */
+static bool runsByGemm(ACSATensor4d* tensorFilter, ACSAConvMessage* convMess, ACSAWinogradAlgo algo)
+{
+    if(algo == ACSA_CONV_GEMM)
+        return true;
+    if(algo == ACSA_CONV_DIRECT && (convMess->stride_h_ != 1 || convMess->stride_w_ != 1))
+        return true;
+    if(algo != ACSA_WINOGRAD_AUTO && algo != ACSA_WINOGRAD_TUNE)
+        return false;
+
+    if((convMess->stride_h_ != 1 || convMess->stride_w_ != 1) &&
+            !((convMess->stride_h_ == 2) && (convMess->stride_w_ == 2) &&
+              (tensorFilter->h_ == 3) && (tensorFilter->w_ == 3) &&
+              (convMess->dilation_h_ == 1) && (convMess->dilation_w_ == 1)))
+        return true;
+
+    for(int a = ACSA_WINOGRAD_2X3; a <= ACSA_CONV_DIRECT; a++)
+        if(ACSAWinoAlgoFits((ACSAWinogradAlgo)a, tensorFilter))
+            return false;
+
+    return true;
+}
+
 /* Create winograd message. */
 ACSAStatus ACSASetWinoMessage(ACSAWinoMessage &winoMess,
         ACSAWinogradAlgo algo, int bb, int mg)
@@ -49,6 +114,44 @@ ACSAStatus ACSASetWinoMessage(ACSAWinoMessage &winoMess,
     winoMess.algo_ = algo;
     winoMess.batch_block_ = bb;
     winoMess.merge_ = mg;
+    winoMess.gemm_ = ACSA_GEMM_MKL;
+    winoMess.schedule_ = ACSA_SCHEDULE_PHASED;
+    winoMess.bridge_ = ACSA_BRIDGE_FP32;
+
+    return ACSASUCCESS;
+}
+
+/* Select the engine of the element-wise gemm. */
+ACSAStatus ACSASetWinoGemm(ACSAWinoMessage &winoMess, ACSAGemmMode gemm)
+{
+    winoMess.gemm_ = gemm;
+
+    return ACSASUCCESS;
+}
+
+/* Select the schedule of the phases. */
+ACSAStatus ACSASetWinoSchedule(ACSAWinoMessage &winoMess, ACSAWinoSchedule schedule)
+{
+    winoMess.schedule_ = schedule;
+
+    return ACSASUCCESS;
+}
+
+/* Select the storage of bridge data. */
+ACSAStatus ACSASetWinoBridge(ACSAWinoMessage &winoMess, ACSABridgeType bridge)
+{
+    winoMess.bridge_ = bridge;
+
+    return ACSASUCCESS;
+}
+
+/* Create activation message. */
+ACSAStatus ACSASetActivMessage(ACSAActivMessage &activMess,
+        ACSAActivationMode mode, float alpha, float ceil)
+{
+    activMess.mode_ = mode;
+    activMess.alpha_ = alpha;
+    activMess.ceil_ = ceil;
 
     return ACSASUCCESS;
 }
@@ -107,71 +210,607 @@ ACSAStatus ACSAGetFinalOutput(Dtype *data, const Dtype *tmp,
     return ACSASUCCESS;
 }
 
-/* Init to prepare the environment of winograd. */
-template<typename Dtype>
-ACSAStatus ACSACnnInitLib()
+/* Multiply all transform points in one batched gemm, out[p][b] = in[p][b] * filter[p].
+ * Matrixes are column major, in is irows*icols and filter is icols*fcols.
+ * */
+template <typename Dtype>
+ACSAStatus ACSABatchGemm(const Dtype *in, const int irows, const int icols, const long istride,
+        const Dtype *filter, const int fcols, const long fstride,
+        Dtype *out, const long ostride,
+        const int points, const int batch)
 {
-    int ret;
-	winoIn = mkl_malloc(16*ISTRIDE*sizeof(Dtype), 64);
-    assert(winoIn != NULL); 
-	winoFilter = mkl_malloc(64*FSTRIDE*sizeof(Dtype), 64);
-    assert(winoFilter != NULL); 
-	winoOut = mkl_malloc(16*OSTRIDE*sizeof(Dtype), 64);
-    assert(winoOut != NULL); 
+    int d1, d2;
+    const char trans = 'n';
+    const Dtype alpha = 1.0;
+    const Dtype beta = 0.0;
+    const int group_count = 1;
+    const int group_size = points*batch;
+
+    const Dtype **pin = (const Dtype **)mkl_malloc(3*group_size*sizeof(Dtype *), 64);
+    const Dtype **pft = pin + group_size;
+    Dtype **pot = (Dtype **)(pin + 2*group_size);
+
+    for(d1 = 0; d1 < points; d1++){
+        for(d2 = 0; d2 < batch; d2++){
+            pin[d1*batch+d2] = in + d1*istride + d2*irows*icols;
+            pft[d1*batch+d2] = filter + d1*fstride;
+            pot[d1*batch+d2] = out + d1*ostride + d2*irows*fcols;
+        }
+    }
+
+    // MKL schedules the whole group with its own threads
+    if(typeid(Dtype) == typeid(float))
+        sgemm_batch(&trans, &trans, &irows, &fcols, &icols, (const float *)&alpha,
+                (const float **)pin, &irows, (const float **)pft, &icols, (const float *)&beta,
+                (float **)pot, &irows, &group_count, &group_size);
+    else if(typeid(Dtype) == typeid(double))
+        dgemm_batch(&trans, &trans, &irows, &fcols, &icols, (const double *)&alpha,
+                (const double **)pin, &irows, (const double **)pft, &icols, (const double *)&beta,
+                (double **)pot, &irows, &group_count, &group_size);
+
+    mkl_free(pin);
 
     return ACSASUCCESS;
 }
 
-/* Clean the environment of winograd. */
+/* Return the workspace of handle to hold bridge data, NULL if the memory of caller is too small. */
+void* ACSAReserveWorkspace(ACSAHandle *handle, size_t size)
+{
+    if(handle->workspace_size_ >= size)
+        return handle->workspace_;
+
+    // The memory of caller can't grow
+    if(!handle->own_workspace_){
+        ACSA_MESSAGE("ERROR: The workspace of caller is too small, see ACSAGetWinoWorkspaceSize!");
+        return NULL;
+    }
+
+    if(handle->workspace_ != NULL)
+        mkl_free(handle->workspace_);
+    handle->workspace_ = mkl_malloc(size, 64);
+    assert(handle->workspace_ != NULL);
+    handle->workspace_size_ = size;
+
+    return handle->workspace_;
+}
+
+/* Create the handle, the workspace is allocated by the first convolution. */
+ACSAStatus ACSACreateHandle(ACSAHandle &handle, int num_threads)
+{
+    handle.workspace_ = NULL;
+    handle.workspace_size_ = 0;
+    handle.own_workspace_ = 1;
+
+    return ACSASetHandleThreads(handle, num_threads);
+}
+
+/* Destroy the handle. */
+ACSAStatus ACSADestroyHandle(ACSAHandle &handle)
+{
+    if(handle.own_workspace_ && handle.workspace_ != NULL)
+        mkl_free(handle.workspace_);
+    handle.workspace_ = NULL;
+    handle.workspace_size_ = 0;
+
+    return ACSASUCCESS;
+}
+
+/* Set the threads used by the handle. */
+ACSAStatus ACSASetHandleThreads(ACSAHandle &handle, int num_threads)
+{
+    if(num_threads <= 0)
+        num_threads = omp_get_max_threads();
+    handle.num_threads_ = num_threads;
+
+    return ACSASUCCESS;
+}
+
+/* Attach the memory of caller as workspace. */
+ACSAStatus ACSASetHandleWorkspace(ACSAHandle &handle, void *workspace, size_t workspaceSize)
+{
+    if(handle.own_workspace_ && handle.workspace_ != NULL)
+        mkl_free(handle.workspace_);
+
+    handle.workspace_ = workspace;
+    handle.workspace_size_ = workspaceSize;
+    handle.own_workspace_ = 0;
+
+    return ACSASUCCESS;
+}
+
+/* Bytes of workspace needed by the winograd algorithm. */
 template<typename Dtype>
-ACSAStatus ACSACnnFreeLib()
+ACSAStatus ACSAGetWinoWorkspaceSize(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess)
 {
-    if(winoIn != NULL)
-        mkl_free(winoIn);
-        
-    if(winoFilter != NULL)
-        mkl_free(winoFilter);    
-    
-    if(winoOut != NULL)
-        mkl_free(winoOut);    
-    
+    ACSAWinogradAlgo algo = winoMess->algo_;
+
+    // Stride 1 keeps the out within the filter of the in, a stride-2 layer has tiles of its own
+    if(tensorOut->h_ < tensorIn->h_-tensorFilter->h_+1 || tensorOut->w_ < tensorIn->w_-tensorFilter->w_+1)
+        return ACSAWinoWorkspaceSize_stride2<Dtype>(size, tensorIn, tensorFilter, tensorOut, winoMess);
+
+    size = 0;
+    switch(algo)
+    {
+        case ACSA_WINOGRAD_2X3:
+            ACSAWinoWorkspaceSize_2x3<Dtype>(size, tensorIn, tensorFilter, tensorOut, winoMess);
+            break;
+        case ACSA_WINOGRAD_3X3:
+            ACSAWinoWorkspaceSize_3x3<Dtype>(size, tensorIn, tensorFilter, tensorOut, winoMess);
+            break;
+        case ACSA_WINOGRAD_4X3:
+            ACSAWinoWorkspaceSize_4x3<Dtype>(size, tensorIn, tensorFilter, tensorOut, winoMess);
+            break;
+        case ACSA_WINOGRAD_6X3:
+            ACSAWinoWorkspaceSize_6x3<Dtype>(size, tensorIn, tensorFilter, tensorOut, winoMess);
+            break;
+        case ACSA_WINOGRAD_2X5:
+            ACSAWinoWorkspaceSize_2x5<Dtype>(size, tensorIn, tensorFilter, tensorOut, winoMess);
+            break;
+        case ACSA_WINOGRAD_4X5:
+            ACSAWinoWorkspaceSize_4x5<Dtype>(size, tensorIn, tensorFilter, tensorOut, winoMess);
+            break;
+        case ACSA_WINOGRAD_4X3_1D:
+            ACSAWinoWorkspaceSize_4x3_1d<Dtype>(size, tensorIn, tensorFilter, tensorOut, winoMess);
+            break;
+        case ACSA_WINOGRAD_5X3:
+            ACSAWinoWorkspaceSize_5x3<Dtype>(size, tensorIn, tensorFilter, tensorOut, winoMess);
+            break;
+        case ACSA_WINOGRAD_8X3:
+            ACSAWinoWorkspaceSize_8x3<Dtype>(size, tensorIn, tensorFilter, tensorOut, winoMess);
+            break;
+        case ACSA_CONV_DIRECT:
+        case ACSA_CONV_GEMM:
+            // No bridge data, the windows and columns of the tasks are their own
+            break;
+        case ACSA_WINOGRAD_TUNE:
+        case ACSA_WINOGRAD_AUTO:
+            {
+                // Any variant of the filter may be chosen, tuning times each over the whole batch
+                ACSAWinoMessage cand = *winoMess;
+                size_t csize;
+
+                if(algo == ACSA_WINOGRAD_TUNE)
+                    cand.batch_block_ = 0;
+                for(int a = ACSA_WINOGRAD_2X3; a <= ACSA_CONV_GEMM; a++){
+                    // F(8x8,3x3) is never chosen, its bridge data is the largest
+                    if(a == ACSA_WINOGRAD_8X3 || !ACSAWinoAlgoFits((ACSAWinogradAlgo)a, tensorFilter))
+                        continue;
+                    cand.algo_ = (ACSAWinogradAlgo)a;
+                    ACSAGetWinoWorkspaceSize<Dtype>(csize, tensorIn, tensorFilter, tensorOut, &cand);
+                    size = std::max(size, csize);
+                }
+            }
+            break;
+        default:
+            ACSA_MESSAGE("ERROR: This winograd algorithm is nonexistent!\n");
+            return ACSAFAIL;
+    }
+
     return ACSASUCCESS;
 }
 
-/* Fix Winograd Alogrithm */
+/* Bytes of workspace needed by the winograd algorithm for the layer of convMess. */
 template<typename Dtype>
-ACSAStatus ACSAWinoConvolutionFwd(const Dtype *in, const Dtype *filter, Dtype *out,
+ACSAStatus ACSAGetWinoWorkspaceSize(size_t &size,
         ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
         ACSAConvMessage* convMess, ACSAWinoMessage *winoMess)
+{
+    // im2col keeps its columns in the buffers of the threads
+    if(runsByGemm(tensorFilter, convMess, winoMess->algo_)){
+        size = 0;
+        return ACSASUCCESS;
+    }
+
+    // A grouped layer runs on the shapes of one group, its channels go in front
+    if(runsByGroup(tensorIn, tensorFilter, convMess, winoMess->algo_))
+        return ACSAWinoWorkspaceSize_grouped<Dtype>(size, tensorIn, tensorFilter, tensorOut, convMess, winoMess);
+
+    // A dilated layer runs on its sub-images, the shapes alone can't tell it
+    if(convMess->dilation_h_ != 1 || convMess->dilation_w_ != 1)
+        return ACSAWinoWorkspaceSize_dilation<Dtype>(size, tensorIn, tensorFilter, tensorOut, convMess, winoMess);
+
+    if(convMess->stride_h_ != 1 || convMess->stride_w_ != 1)
+        return ACSAWinoWorkspaceSize_stride2<Dtype>(size, tensorIn, tensorFilter, tensorOut, winoMess);
+
+    return ACSAGetWinoWorkspaceSize<Dtype>(size, tensorIn, tensorFilter, tensorOut, winoMess);
+}
+
+/* Fix Winograd Alogrithm */
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolutionFwd(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
 {
     ACSAWinogradAlgo algo = winoMess->algo_;
 
+    // Check
+    ACSA_CHECK((tensorFilter->c_*convMess->groups_ == tensorIn->c_));
+
+    // Odd output tiles straddle the 2x2 pooling windows
+    if((algo == ACSA_WINOGRAD_3X3 || algo == ACSA_WINOGRAD_5X3) && poolMess != NULL){
+        ACSA_MESSAGE("ERROR: Odd output tiles can not fuse pooling!");
+        return ACSAFAIL;
+    }
+
+    if(ACSAWinoInt8<Dtype>(winoMess) && algo < ACSA_CONV_DIRECT && algo != ACSA_WINOGRAD_2X3){
+        ACSA_MESSAGE("ERROR: The INT8 bridge only supports F(2x3)!");
+        return ACSAFAIL;
+    }
+
+    // The 16-bit bridges lose too much of the F(8,3) points
+    if(typeid(Dtype) == typeid(float) && algo == ACSA_WINOGRAD_8X3 && winoMess->bridge_ != ACSA_BRIDGE_FP32){
+        ACSA_MESSAGE("ERROR: Winograd F(8,3) only supports the FP32 bridge!");
+        return ACSAFAIL;
+    }
+
+    if(runsByGemm(tensorFilter, convMess, algo))
+        return ACSAGemmConvolution(handle, in, filter, out,
+                tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                bias, activMess, poolMess);
+
+    if(runsByGroup(tensorIn, tensorFilter, convMess, algo))
+        return ACSAWinoConvolutionGrouped(handle, in, filter, out,
+                tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                bias, activMess, poolMess);
+
+    if(convMess->dilation_h_ != 1 || convMess->dilation_w_ != 1)
+        return ACSAWinoConvolutionDilated(handle, in, filter, out,
+                tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                bias, activMess, poolMess);
+
+    if(convMess->stride_h_ != 1 || convMess->stride_w_ != 1)
+        return ACSAWinoConvolutionStride2(handle, in, filter, out,
+                tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                bias, activMess, poolMess);
+
     switch(algo)
     {
         case ACSA_WINOGRAD_2X3:
-            ACSAWinoConvolution_2x3(in, filter, out,
-                    tensorIn, tensorFilter, tensorOut, convMess, winoMess);
+            return ACSAWinoConvolution_2x3(handle, in, filter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                    bias, activMess, poolMess);
+        case ACSA_WINOGRAD_3X3:
+            return ACSAWinoConvolution_3x3(handle, in, filter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                    bias, activMess, poolMess);
+        case ACSA_WINOGRAD_4X3:
+            return ACSAWinoConvolution_4x3(handle, in, filter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                    bias, activMess, poolMess);
+        case ACSA_WINOGRAD_6X3:
+            return ACSAWinoConvolution_6x3(handle, in, filter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                    bias, activMess, poolMess);
+        case ACSA_WINOGRAD_2X5:
+            return ACSAWinoConvolution_2x5(handle, in, filter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                    bias, activMess, poolMess);
+        case ACSA_WINOGRAD_4X5:
+            return ACSAWinoConvolution_4x5(handle, in, filter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                    bias, activMess, poolMess);
+        case ACSA_WINOGRAD_4X3_1D:
+            return ACSAWinoConvolution_4x3_1d(handle, in, filter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                    bias, activMess, poolMess);
+        case ACSA_WINOGRAD_5X3:
+            return ACSAWinoConvolution_5x3(handle, in, filter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                    bias, activMess, poolMess);
+        case ACSA_WINOGRAD_8X3:
+            return ACSAWinoConvolution_8x3(handle, in, filter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                    bias, activMess, poolMess);
+        case ACSA_CONV_DIRECT:
+            return ACSADirectConvolution(handle, in, filter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess,
+                    bias, activMess, poolMess);
+        case ACSA_WINOGRAD_TUNE:
+            {
+                // The variant comes from the tuning cache, the caller keeps asking for tuning
+                ACSAWinoMessage tuned = *winoMess;
+
+                if(ACSAWinoTune(handle, in, filter, out,
+                            tensorIn, tensorFilter, tensorOut, convMess, &tuned,
+                            bias, activMess, poolMess) != ACSASUCCESS)
+                    return ACSAFAIL;
+                return ACSAWinoConvolutionFwd(handle, in, filter, out,
+                        tensorIn, tensorFilter, tensorOut, convMess, &tuned,
+                        bias, activMess, poolMess);
+            }
+        case ACSA_WINOGRAD_AUTO:
+            {
+                ACSAWinoMessage chosen = *winoMess;
+
+                ACSAWinoSelect<Dtype>(tensorIn, tensorFilter, tensorOut, &chosen, poolMess);
+                return ACSAWinoConvolutionFwd(handle, in, filter, out,
+                        tensorIn, tensorFilter, tensorOut, convMess, &chosen,
+                        bias, activMess, poolMess);
+            }
+        default:
+            ACSA_MESSAGE("ERROR: This winograd algorithm is nonexistent!\n");
+            return ACSAFAIL;
+    }
+}
+
+/* Transform the filter into a persistent buffer. */
+template<typename Dtype>
+ACSAStatus ACSACreateWinoFilter(ACSAWinoFilter &wfilter, const Dtype *filter,
+        ACSATensor4d* tensorFilter, ACSAWinoMessage *winoMess)
+{
+    const int K = tensorFilter->n_;
+    const int C = tensorFilter->c_;
+    int npoints;
+
+    // The shapes of in and out choose AUTO and TUNE, the filter alone can't
+    if(winoMess->algo_ == ACSA_WINOGRAD_AUTO || winoMess->algo_ == ACSA_WINOGRAD_TUNE){
+        ACSA_MESSAGE("ERROR: Choose the algorithm by ACSAWinoSelect before transforming the filter!");
+        return ACSAFAIL;
+    }
+    if(!ACSAWinoAlgoFits(winoMess->algo_, tensorFilter)){
+        ACSA_MESSAGE("ERROR: The algorithm doesn't fit the filter!");
+        return ACSAFAIL;
+    }
+    if(ACSAWinoInt8<Dtype>(winoMess) && winoMess->algo_ < ACSA_CONV_DIRECT && winoMess->algo_ != ACSA_WINOGRAD_2X3){
+        ACSA_MESSAGE("ERROR: The INT8 bridge only supports F(2x3)!");
+        return ACSAFAIL;
+    }
+    if(typeid(Dtype) == typeid(float) && winoMess->algo_ == ACSA_WINOGRAD_8X3 && winoMess->bridge_ != ACSA_BRIDGE_FP32){
+        ACSA_MESSAGE("ERROR: Winograd F(8,3) only supports the FP32 bridge!");
+        return ACSAFAIL;
+    }
+
+    switch(winoMess->algo_)
+    {
+        case ACSA_WINOGRAD_2X3:
+            npoints = 16;
             break;
         case ACSA_WINOGRAD_3X3:
-            ACSAWinoConvolution_3x3(in, filter, out,
-                    tensorIn, tensorFilter, tensorOut, convMess, winoMess);
+            npoints = 25;
             break;
         case ACSA_WINOGRAD_4X3:
-            ACSAWinoConvolution_4x3(in, filter, out,
-                    tensorIn, tensorFilter, tensorOut, convMess, winoMess);
+            npoints = 36;
             break;
         case ACSA_WINOGRAD_6X3:
-            ACSAWinoConvolution_6x3(in, filter, out,
-                    tensorIn, tensorFilter, tensorOut, convMess, winoMess);
+            npoints = 64;
+            break;
+        case ACSA_WINOGRAD_2X5:
+            npoints = 36;
+            break;
+        case ACSA_WINOGRAD_4X5:
+            npoints = 64;
+            break;
+        case ACSA_WINOGRAD_4X3_1D:
+            npoints = 6;
+            break;
+        case ACSA_WINOGRAD_5X3:
+            npoints = 49;
+            break;
+        case ACSA_WINOGRAD_8X3:
+            npoints = 100;
+            break;
+        case ACSA_CONV_DIRECT:
+            npoints = 9;
+            break;
+        case ACSA_CONV_GEMM:
+            npoints = tensorFilter->h_*tensorFilter->w_;
             break;
         default:
             ACSA_MESSAGE("ERROR: This winograd algorithm is nonexistent!\n");
+            return ACSAFAIL;
+    }
+
+    wfilter.algo_ = winoMess->algo_;
+    wfilter.k_ = K;
+    wfilter.c_ = C;
+    wfilter.dsize_ = sizeof(Dtype);
+    wfilter.bridge_ = ACSAWinoBridge<Dtype>(winoMess);
+    wfilter.points_ = npoints;
+    wfilter.stride_ = no4k_aligned((long)K*C, sizeof(Dtype));
+    wfilter.data_ = mkl_malloc(npoints*wfilter.stride_*sizeof(Dtype), 64);
+    assert(wfilter.data_ != NULL);
+
+    Dtype *data = (Dtype *)wfilter.data_;
+    switch(wfilter.algo_)
+    {
+        case ACSA_WINOGRAD_2X3:
+            ACSAWinoFilterTransform_2x3(filter, data, C, K, wfilter.stride_);
+            break;
+        case ACSA_WINOGRAD_3X3:
+            ACSAWinoFilterTransform_3x3(filter, data, C, K, wfilter.stride_);
+            break;
+        case ACSA_WINOGRAD_4X3:
+            ACSAWinoFilterTransform_4x3(filter, data, C, K, wfilter.stride_);
+            break;
+        case ACSA_WINOGRAD_6X3:
+            ACSAWinoFilterTransform_6x3(filter, data, C, K, wfilter.stride_);
             break;
+        case ACSA_WINOGRAD_2X5:
+            ACSAWinoFilterTransform_2x5(filter, data, C, K, wfilter.stride_);
+            break;
+        case ACSA_WINOGRAD_4X5:
+            ACSAWinoFilterTransform_4x5(filter, data, C, K, wfilter.stride_);
+            break;
+        case ACSA_WINOGRAD_4X3_1D:
+            ACSAWinoFilterTransform_4x3_1d(filter, data, C, K, wfilter.stride_, tensorFilter->w_ == 1);
+            break;
+        case ACSA_WINOGRAD_5X3:
+            ACSAWinoFilterTransform_5x3(filter, data, C, K, wfilter.stride_);
+            break;
+        case ACSA_WINOGRAD_8X3:
+            ACSAWinoFilterTransform_8x3(filter, data, C, K, wfilter.stride_);
+            break;
+        case ACSA_CONV_DIRECT:
+            // The taps are laid out as the points, so a group is a view as for winograd
+            for(long kc = 0; kc < (long)K*C; kc++)
+                for(int p = 0; p < 9; p++)
+                    data[p*wfilter.stride_ + kc] = filter[kc*9 + p];
+            break;
+        case ACSA_CONV_GEMM:
+            // The gemm takes the filter as it is, the groups are never viewed
+            memcpy(data, filter, (long)K*C*npoints*sizeof(Dtype));
+            break;
+        default:
+            break;
+    }
+
+    // The 16-bit bridges read the filter in 16 bits, it is rounded here once
+    wfilter.bdata_ = NULL;
+    if(wfilter.algo_ < ACSA_CONV_DIRECT &&
+            (wfilter.bridge_ == ACSA_BRIDGE_BF16 || wfilter.bridge_ == ACSA_BRIDGE_FP16)){
+        const long count = npoints*wfilter.stride_;
+        uint16_t *bdata = (uint16_t *)mkl_malloc(count*sizeof(uint16_t), 64);
+        assert(bdata != NULL);
+        for(long i = 0; i < count; i++)
+            bdata[i] = (wfilter.bridge_ == ACSA_BRIDGE_BF16) ?
+                ACSAFloatToBf16((float)data[i]) : ACSAFloatToHalf((float)data[i]);
+        wfilter.bdata_ = bdata;
+    }
+
+    // So is the INT8 filter quantized once with its scales
+    wfilter.qdata_ = NULL;
+    wfilter.qscale_ = NULL;
+    wfilter.qcomp_ = NULL;
+    if(wfilter.algo_ < ACSA_CONV_DIRECT && wfilter.bridge_ == ACSA_BRIDGE_INT8){
+        wfilter.qstride_ = ACSAWinoInt8Stride(C, K);
+        wfilter.qdata_ = mkl_malloc(npoints*wfilter.qstride_, 64);
+        wfilter.qscale_ = mkl_malloc((long)npoints*K*sizeof(float), 64);
+        wfilter.qcomp_ = mkl_malloc((long)npoints*K*sizeof(int32_t), 64);
+        assert(wfilter.qdata_ != NULL && wfilter.qscale_ != NULL && wfilter.qcomp_ != NULL);
+        ACSAWinoQuantizeFilter((const float *)data, wfilter.stride_, npoints, C, K,
+                (int8_t *)wfilter.qdata_, wfilter.qstride_, (float *)wfilter.qscale_, (int32_t *)wfilter.qcomp_);
     }
 
     return ACSASUCCESS;
 }
 
+/* Release the persistent filter. */
+ACSAStatus ACSADestroyWinoFilter(ACSAWinoFilter &wfilter)
+{
+    if(wfilter.data_ != NULL)
+        mkl_free(wfilter.data_);
+    wfilter.data_ = NULL;
+    if(wfilter.bdata_ != NULL)
+        mkl_free(wfilter.bdata_);
+    wfilter.bdata_ = NULL;
+    if(wfilter.qdata_ != NULL){
+        mkl_free(wfilter.qdata_);
+        mkl_free(wfilter.qscale_);
+        mkl_free(wfilter.qcomp_);
+    }
+    wfilter.qdata_ = NULL;
+
+    return ACSASUCCESS;
+}
+
+/* Fix Winograd Alogrithm with the pre-transformed filter. */
+template<typename Dtype>
+ACSAStatus ACSAWinoConvolutionFwd(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    ACSAWinogradAlgo algo = wfilter->algo_;
+
+    // Check
+    ACSA_CHECK((tensorFilter->c_*convMess->groups_ == tensorIn->c_));
+    if(!ACSAWinoFilterFits<Dtype>(wfilter, winoMess)){
+        ACSA_MESSAGE("ERROR: The filter was transformed for another type or bridge!");
+        return ACSAFAIL;
+    }
+
+    // Odd output tiles straddle the 2x2 pooling windows
+    if((algo == ACSA_WINOGRAD_3X3 || algo == ACSA_WINOGRAD_5X3) && poolMess != NULL){
+        ACSA_MESSAGE("ERROR: Odd output tiles can not fuse pooling!");
+        return ACSAFAIL;
+    }
+
+    if(ACSAWinoInt8<Dtype>(winoMess) && algo < ACSA_CONV_DIRECT && algo != ACSA_WINOGRAD_2X3){
+        ACSA_MESSAGE("ERROR: The INT8 bridge only supports F(2x3)!");
+        return ACSAFAIL;
+    }
+
+    // The 16-bit bridges lose too much of the F(8,3) points
+    if(typeid(Dtype) == typeid(float) && algo == ACSA_WINOGRAD_8X3 && winoMess->bridge_ != ACSA_BRIDGE_FP32){
+        ACSA_MESSAGE("ERROR: Winograd F(8,3) only supports the FP32 bridge!");
+        return ACSAFAIL;
+    }
+
+    // Only the filter of im2col is kept as it is
+    if(algo == ACSA_CONV_GEMM)
+        return ACSAGemmConvolution(handle, in, (const Dtype *)wfilter->data_, out,
+                tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                bias, activMess, poolMess);
+
+    if(runsByGroup(tensorIn, tensorFilter, convMess, algo))
+        return ACSAWinoConvolutionGrouped(handle, in, wfilter, out,
+                tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                bias, activMess, poolMess);
+
+    if(convMess->dilation_h_ != 1 || convMess->dilation_w_ != 1)
+        return ACSAWinoConvolutionDilated(handle, in, wfilter, out,
+                tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                bias, activMess, poolMess);
+
+    // The tiles of a strided layer need their own filter transform
+    if(convMess->stride_h_ != 1 || convMess->stride_w_ != 1){
+        ACSA_MESSAGE("ERROR: The pre-transformed filter only supports stride 1!");
+        return ACSAFAIL;
+    }
+
+    switch(algo)
+    {
+        case ACSA_WINOGRAD_2X3:
+            return ACSAWinoConvolution_2x3(handle, in, wfilter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                    bias, activMess, poolMess);
+        case ACSA_WINOGRAD_3X3:
+            return ACSAWinoConvolution_3x3(handle, in, wfilter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                    bias, activMess, poolMess);
+        case ACSA_WINOGRAD_4X3:
+            return ACSAWinoConvolution_4x3(handle, in, wfilter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                    bias, activMess, poolMess);
+        case ACSA_WINOGRAD_6X3:
+            return ACSAWinoConvolution_6x3(handle, in, wfilter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                    bias, activMess, poolMess);
+        case ACSA_WINOGRAD_2X5:
+            return ACSAWinoConvolution_2x5(handle, in, wfilter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                    bias, activMess, poolMess);
+        case ACSA_WINOGRAD_4X5:
+            return ACSAWinoConvolution_4x5(handle, in, wfilter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                    bias, activMess, poolMess);
+        case ACSA_WINOGRAD_4X3_1D:
+            return ACSAWinoConvolution_4x3_1d(handle, in, wfilter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                    bias, activMess, poolMess);
+        case ACSA_WINOGRAD_5X3:
+            return ACSAWinoConvolution_5x3(handle, in, wfilter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                    bias, activMess, poolMess);
+        case ACSA_WINOGRAD_8X3:
+            return ACSAWinoConvolution_8x3(handle, in, wfilter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+                    bias, activMess, poolMess);
+        case ACSA_CONV_DIRECT:
+            return ACSADirectConvolution(handle, in, wfilter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess,
+                    bias, activMess, poolMess);
+        default:
+            ACSA_MESSAGE("ERROR: This winograd algorithm is nonexistent!\n");
+            return ACSAFAIL;
+    }
+}
+
 /* Instantiate Template */
 template ACSAStatus ACSAGetInputTile<float>(float *, const float *,
         int, int, int, int, int,
@@ -187,15 +826,51 @@ template ACSAStatus ACSAGetFinalOutput<double>(double *, const double *,
         int, int, int, int, int,
         int, int, int, int);
 
-template ACSAStatus ACSACnnInitLib<float>();
-template ACSAStatus ACSACnnInitLib<double>();
+template ACSAStatus ACSABatchGemm<float>(const float *, const int, const int, const long,
+        const float *, const int, const long,
+        float *, const long,
+        const int, const int);
+template ACSAStatus ACSABatchGemm<double>(const double *, const int, const int, const long,
+        const double *, const int, const long,
+        double *, const long,
+        const int, const int);
 
-template ACSAStatus ACSACnnFreeLib<float>();
-template ACSAStatus ACSACnnFreeLib<double>();
-
-template ACSAStatus ACSAWinoConvolutionFwd<float>(const float*, const float*, float*,
+template ACSAStatus ACSAGetWinoWorkspaceSize<float>(size_t &,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*);
+template ACSAStatus ACSAGetWinoWorkspaceSize<double>(size_t &,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*);
+template ACSAStatus ACSAGetWinoWorkspaceSize<float>(size_t &,
         ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
         ACSAConvMessage*, ACSAWinoMessage*);
-template ACSAStatus ACSAWinoConvolutionFwd<double>(const double*, const double*, double*,
+template ACSAStatus ACSAGetWinoWorkspaceSize<double>(size_t &,
         ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
         ACSAConvMessage*, ACSAWinoMessage*);
+
+template ACSAStatus ACSAWinoConvolutionFwd<float>(ACSAHandle *,
+        const float*, const float*, float*,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoConvolutionFwd<double>(ACSAHandle *,
+        const double*, const double*, double*,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+
+template ACSAStatus ACSAWinoConvolutionFwd<float>(ACSAHandle *,
+        const float*, const ACSAWinoFilter*, float*,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoConvolutionFwd<double>(ACSAHandle *,
+        const double*, const ACSAWinoFilter*, double*,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+
+template ACSAStatus ACSACreateWinoFilter<float>(ACSAWinoFilter &, const float *,
+        ACSATensor4d*, ACSAWinoMessage*);
+template ACSAStatus ACSACreateWinoFilter<double>(ACSAWinoFilter &, const double *,
+        ACSATensor4d*, ACSAWinoMessage*);
@@ -0,0 +1,188 @@
+/* Convolution by im2col and gemm, the fallback for the layers winograd loses:
+ * 1x1 filters, tiny images, strides, and the filters no variant fits.
+ * A chunk of images, or of output rows of a large image, is unrolled into
+ * the columns of the filter taps, (pixels, C/G*R*S) column major for every
+ * group, and the gemm of each image and group gives (pixels, K/G). Bias,
+ * activation and pooling are applied when the result goes to the layout of out.
+ * Strides, dilation and groups are taken as they are, without the wrappers.
+ * A task is one chunk in one thread, its columns stay in cache for its gemm.
+ * */
+
+#include "dnn.hpp"
+
+#ifndef GEMM_COL_BYTES
+#define GEMM_COL_BYTES (1L << 20)   // columns of a task, they stay in the L2 of its core for the gemm
+#endif
+
+/* Images and output rows of a task, enough tasks for the threads,
+ * the rows are even when the pooling is fused.
+ * */
+    template<typename Dtype>
+static void gemmChunk(ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        const bool pool, const int nthreads, int &nb, int &br)
+{
+    const int N = tensorIn->n_;
+    const int outHeight = tensorOut->h_;
+    const long rowBytes = (long)tensorOut->w_*tensorIn->c_*tensorFilter->h_*tensorFilter->w_*sizeof(Dtype);
+
+    nb = 1;
+    br = std::max(1L, std::min((long)outHeight, GEMM_COL_BYTES/rowBytes));
+    if(br == outHeight)
+        nb = std::max(1L, std::min((long)(N+nthreads-1)/nthreads, GEMM_COL_BYTES/(rowBytes*outHeight)));
+    else
+        br = std::min(br, std::max(1, (int)((long)outHeight*N/nthreads)));
+    if(pool && br < outHeight)
+        br = std::max(2, br/2*2);
+}
+
+/* Whether in itself is the columns, 1x1 filters of stride 1 on NCHW without pad. */
+static bool inIsColumns(ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, const int br)
+{
+    return (tensorFilter->h_ == 1) && (tensorFilter->w_ == 1) &&
+        (convMess->stride_h_ == 1) && (convMess->stride_w_ == 1) &&
+        (convMess->pad_h_ == 0) && (convMess->pad_w_ == 0) &&
+        (tensorIn->format_ == ACSA_TENSOR_NCHW) && (convMess->groups_ == 1) &&
+        (br == tensorOut->h_);
+}
+
+/* API for im2col convolution, Filter is (K, C/groups, R, S) as it is. */
+    template<typename Dtype>
+ACSAStatus ACSAGemmConvolution(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    const int N = tensorIn->n_;
+    const int C = tensorIn->c_;
+    const int H = tensorIn->h_;
+    const int W = tensorIn->w_;
+    const int K = tensorFilter->n_;
+    const int R = tensorFilter->h_;
+    const int S = tensorFilter->w_;
+    const int G = convMess->groups_;
+    const int Cg = C/G;
+    const int Kg = K/G;
+    const int CRS = Cg*R*S;
+    const int outHeight = tensorOut->h_;
+    const int outWidth = tensorOut->w_;
+    const int sh = convMess->stride_h_;
+    const int sw = convMess->stride_w_;
+    const int dh = convMess->dilation_h_;
+    const int dw = convMess->dilation_w_;
+    const int ph = convMess->pad_h_;
+    const int pw = convMess->pad_w_;
+    int nb, br;
+
+    // Check
+    ACSA_CHECK(((tensorFilter->c_*G == C) && (K%G == 0)));
+    ACSA_CHECK(((outHeight == (H+2*ph-dh*(R-1)-1)/sh+1) && (outWidth == (W+2*pw-dw*(S-1)-1)/sw+1)));
+    if(poolMess != NULL)
+        ACSA_CHECK(ACSAPoolFusible(poolMess, outHeight, outWidth));
+
+    Dtype slope, ceil;
+    ACSAActivParam(activMess, slope, ceil);
+
+    /* Layout and shape of out. */
+    ACSATensor4d tensorDst = *tensorOut;
+    if(poolMess != NULL){
+        tensorDst.h_ = outHeight/2;
+        tensorDst.w_ = outWidth/2;
+    }
+
+    gemmChunk<Dtype>(tensorIn, tensorFilter, tensorOut, poolMess != NULL, handle->num_threads_, nb, br);
+    const bool direct_in = inIsColumns(tensorIn, tensorFilter, tensorOut, convMess, br);
+    const int nbands = (outHeight+br-1)/br;
+    const int nchunks = (N+nb-1)/nb;
+
+#pragma omp parallel num_threads(handle->num_threads_)
+    {
+        Dtype *col = direct_in ? NULL : (Dtype *)mkl_malloc((long)nb*br*outWidth*C*R*S*sizeof(Dtype), 64);
+        Dtype *res = (Dtype *)mkl_malloc((long)nb*br*outWidth*K*sizeof(Dtype), 64);
+        int d1;
+
+        /* A task is a band of rows of a chunk of images, the gemm runs in the thread. */
+#pragma omp for schedule(dynamic)
+        for(d1 = 0; d1 < nchunks*nbands; d1++){
+            const int n0 = d1/nbands*nb;
+            const int y0 = d1%nbands*br;
+            const int nbc = std::min(nb, N-n0);
+            const int nrows = std::min(br, outHeight-y0);
+            const int irows = nrows*outWidth;
+            const long istride = (long)nbc*irows*CRS;
+            const long ostride = (long)nbc*irows*Kg;
+            int g, b, t, y, x, k;
+
+            /* Columns of group g and image b at g*istride + b*irows*CRS, a tap is a column. */
+            if(!direct_in){
+                for(g = 0; g < G; g++)
+                    for(b = 0; b < nbc; b++)
+                        for(t = 0; t < CRS; t++){
+                            const int c = t/(R*S);
+                            const int r = t%(R*S)/S;
+                            const int s = t%S;
+                            Dtype *dst = col + g*istride + (long)b*irows*CRS + (long)t*irows;
+
+                            for(y = 0; y < nrows; y++){
+                                const int iy = (y0+y)*sh - ph + r*dh;
+                                for(x = 0; x < outWidth; x++){
+                                    const int ix = x*sw - pw + s*dw;
+                                    dst[y*outWidth + x] = (iy >= 0 && iy < H && ix >= 0 && ix < W) ?
+                                        in[ACSATensorOffset(tensorIn, n0+b, g*Cg+c, iy, ix)] : (Dtype)0;
+                                }
+                            }
+                        }
+            }
+
+            /* out(pixels, Kg) = col(pixels, CRS) * filter(CRS, Kg) of every group and image. */
+            const Dtype *a = direct_in ? in + (long)n0*C*H*W : col;
+            if(winoMess->gemm_ == ACSA_GEMM_KERNEL)
+                ACSAWinoGemm(a, irows, CRS, istride, filter, Kg, (long)Kg*CRS, res, ostride, G, nbc);
+            else
+                ACSABatchGemm(a, irows, CRS, istride, filter, Kg, (long)Kg*CRS, res, ostride, G, nbc);
+
+            /* Bias, activation and pooling into the layout of out. */
+            for(b = 0; b < nbc; b++)
+                for(k = 0; k < K; k++){
+                    const Dtype bk = (bias == NULL) ? (Dtype)0 : bias[k];
+                    Dtype *src = res + (k/Kg)*ostride + (long)b*irows*Kg + (long)(k%Kg)*irows;
+
+                    for(y = 0; y < irows; y++)
+                        src[y] = ACSAActivate<Dtype>(src[y], bk, slope, ceil);
+
+                    if(poolMess == NULL){
+                        for(y = 0; y < nrows; y++)
+                            for(x = 0; x < outWidth; x++)
+                                out[ACSATensorOffset(&tensorDst, n0+b, k, y0+y, x)] = src[y*outWidth + x];
+                    }
+                    else{
+                        for(y = 0; y < nrows; y += 2)
+                            for(x = 0; x < outWidth; x += 2){
+                                const Dtype *p = src + y*outWidth + x;
+                                out[ACSATensorOffset(&tensorDst, n0+b, k, (y0+y)/2, x/2)] =
+                                    std::max(std::max(p[0], p[1]), std::max(p[outWidth], p[outWidth+1]));
+                            }
+                    }
+                }
+        }
+
+        if(col != NULL)
+            mkl_free(col);
+        mkl_free(res);
+    }
+
+    return ACSASUCCESS;
+}
+
+/* Instantiate Template */
+template ACSAStatus ACSAGemmConvolution<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *,
+        const float *, ACSAActivMessage *, ACSAPoolMessage *);
+template ACSAStatus ACSAGemmConvolution<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *,
+        const double *, ACSAActivMessage *, ACSAPoolMessage *);
@@ -3,8 +3,44 @@
 
 #include "dnn.hpp"
 
+/* Pooling of NHWC and nChw16c, the channels of one pixel are contiguous. */
 template <typename Dtype>
-ACSAStatus ACSAMaxPoolingFwd(const Dtype *in, Dtype *out, ACSATensor4d* tensor,
+static void poolingChannelLast(const Dtype *in, Dtype *out, ACSATensor4d* tensor,
+        const int is_max, const int num_threads)
+{
+    const int N = tensor->n_;
+    const int C = tensor->c_;
+    const int H = tensor->h_;
+    const int W = tensor->w_;
+    const int cgroup = (tensor->format_ == ACSA_TENSOR_NHWC) ? C : 16;
+    const int ngroup = (C+cgroup-1)/cgroup;
+
+    ACSATensor4d pooled = *tensor;
+    pooled.h_ = H/2;
+    pooled.w_ = W/2;
+
+    #pragma omp parallel for collapse(3) num_threads(num_threads)
+    for(int n = 0; n < N; n++)
+        for(int g = 0; g < ngroup; g++)
+            for(int i = 0; i < H/2; i++)
+                for(int j = 0; j < W/2; j++){
+                    const Dtype *b00 = in + ACSATensorOffset(tensor, n, g*cgroup, 2*i, 2*j);
+                    const Dtype *b01 = in + ACSATensorOffset(tensor, n, g*cgroup, 2*i, 2*j+1);
+                    const Dtype *b10 = in + ACSATensorOffset(tensor, n, g*cgroup, 2*i+1, 2*j);
+                    const Dtype *b11 = in + ACSATensorOffset(tensor, n, g*cgroup, 2*i+1, 2*j+1);
+                    Dtype *bout = out + ACSATensorOffset(&pooled, n, g*cgroup, i, j);
+
+                    if(is_max)
+                        for(int l = 0; l < cgroup; l++)
+                            bout[l] = std::max(std::max(b00[l], b01[l]), std::max(b10[l], b11[l]));
+                    else
+                        for(int l = 0; l < cgroup; l++)
+                            bout[l] = (b00[l] + b01[l] + b10[l] + b11[l])/4;
+                }
+}
+
+template <typename Dtype>
+ACSAStatus ACSAMaxPoolingFwd(ACSAHandle *handle, const Dtype *in, Dtype *out, ACSATensor4d* tensor,
         ACSAPoolMessage* poolMess)
 {
     int N, C, H, W;
@@ -13,7 +49,12 @@ ACSAStatus ACSAMaxPoolingFwd(const Dtype *in, Dtype *out, ACSATensor4d* tensor,
     H = tensor->h_;
     W = tensor->w_;
 
-	#pragma omp parallel for
+    if(tensor->format_ != ACSA_TENSOR_NCHW){
+        poolingChannelLast(in, out, tensor, 1, handle->num_threads_);
+        return ACSASUCCESS;
+    }
+
+	#pragma omp parallel for num_threads(handle->num_threads_)
 	for(int k = 0; k < N*C; k++){
 	    const Dtype *bin = in + k*H*W;
 	    Dtype *bout = out + k*(H/2)*(W/2);
@@ -33,7 +74,7 @@ ACSAStatus ACSAMaxPoolingFwd(const Dtype *in, Dtype *out, ACSATensor4d* tensor,
 }
 
 template <typename Dtype>
-ACSAStatus ACSAAvePoolingFwd(const Dtype *in, Dtype *out, ACSATensor4d* tensor,
+ACSAStatus ACSAAvePoolingFwd(ACSAHandle *handle, const Dtype *in, Dtype *out, ACSATensor4d* tensor,
         ACSAPoolMessage* poolMess)
 {
     int N, C, H, W;
@@ -42,14 +83,19 @@ ACSAStatus ACSAAvePoolingFwd(const Dtype *in, Dtype *out, ACSATensor4d* tensor,
     H = tensor->h_;
     W = tensor->w_;
 
-    #pragma omp parallel for
+    if(tensor->format_ != ACSA_TENSOR_NCHW){
+        poolingChannelLast(in, out, tensor, 0, handle->num_threads_);
+        return ACSASUCCESS;
+    }
+
+    #pragma omp parallel for num_threads(handle->num_threads_)
     for(int k = 0; k < N*C; k++){
         const Dtype *bin = in + k*H*W;
         Dtype *bout = out + k*(H/2)*(W/2);
         int counter = 0;
 
-        for(int i = 0; i < H; i++)
-            for(int j = 0; j < W; j++){
+        for(int i = 0; i < H; i += 2)
+            for(int j = 0; j < W; j += 2){
                 bout[counter] = (bin[i*W+j] + bin[i*W+(j+1)] +
                 bin[(i+1)*W+j] + bin[(i+1)*W+(j+1)])/4;
                 counter++;
@@ -59,12 +105,12 @@ ACSAStatus ACSAAvePoolingFwd(const Dtype *in, Dtype *out, ACSATensor4d* tensor,
     return ACSASUCCESS;
 }
 
-template ACSAStatus ACSAMaxPoolingFwd<float>(const float*, float*, ACSATensor4d*,
+template ACSAStatus ACSAMaxPoolingFwd<float>(ACSAHandle *, const float*, float*, ACSATensor4d*,
         ACSAPoolMessage*);
-template ACSAStatus ACSAAvePoolingFwd<float>(const float*, float*, ACSATensor4d*,
+template ACSAStatus ACSAAvePoolingFwd<float>(ACSAHandle *, const float*, float*, ACSATensor4d*,
         ACSAPoolMessage*);
 
-template ACSAStatus ACSAMaxPoolingFwd<double>(const double*, double*, ACSATensor4d*,
+template ACSAStatus ACSAMaxPoolingFwd<double>(ACSAHandle *, const double*, double*, ACSATensor4d*,
         ACSAPoolMessage*);
-template ACSAStatus ACSAAvePoolingFwd<double>(const double*, double*, ACSATensor4d*,
+template ACSAStatus ACSAAvePoolingFwd<double>(ACSAHandle *, const double*, double*, ACSATensor4d*,
         ACSAPoolMessage*);
@@ -4,42 +4,32 @@
 #include "dnn.hpp"
 
 template<typename Dtype>
-ACSAStatus ACSAReLUInplaceFwd(Dtype *in_out, ACSATensor4d* tensor)
+ACSAStatus ACSAReLUInplaceFwd(ACSAHandle *handle, Dtype *in_out, ACSATensor4d* tensor)
 {
-    int N, C, H, W;
-    int size;
-    N = tensor->n_;
-    C = tensor->c_;
-    H = tensor->h_;
-    W = tensor->w_;
-    size = N*C*H*W;
-
-    #pragma omp parallel for
-    for(int i = 0; i < size; i++)
+    // Element-wise, any layout of tensor
+    long size = ACSATensorSize(tensor);
+
+    #pragma omp parallel for num_threads(handle->num_threads_)
+    for(long i = 0; i < size; i++)
 	in_out[i] = std::max(in_out[i], Dtype(0));
 
     return ACSASUCCESS;
 }
 
 template<typename Dtype>
-ACSAStatus ACSAReLUOutplaceFwd(const Dtype *in, Dtype *out, ACSATensor4d* tensor)
+ACSAStatus ACSAReLUOutplaceFwd(ACSAHandle *handle, const Dtype *in, Dtype *out, ACSATensor4d* tensor)
 {
-    int N, C, H, W;
-    int size;
-    N = tensor->n_;
-    C = tensor->c_;
-    H = tensor->h_;
-    W = tensor->w_;
-    size = N*C*H*W;
-
-    #pragma omp parallel for
-    for(int i = 0; i < size; i++)
+    // Element-wise, any layout of tensor
+    long size = ACSATensorSize(tensor);
+
+    #pragma omp parallel for num_threads(handle->num_threads_)
+    for(long i = 0; i < size; i++)
 	out[i] = std::max(in[i], Dtype(0));
 
     return ACSASUCCESS;
 }
 
-template ACSAStatus ACSAReLUInplaceFwd<float>(float *in_out, ACSATensor4d* tensor);
-template ACSAStatus ACSAReLUInplaceFwd<double>(double *in_out, ACSATensor4d* tensor);
-template ACSAStatus ACSAReLUOutplaceFwd<float>(const float *in, float *out, ACSATensor4d* tensor);
-template ACSAStatus ACSAReLUOutplaceFwd<double>(const double *in, double *out, ACSATensor4d* tensor);
+template ACSAStatus ACSAReLUInplaceFwd<float>(ACSAHandle *handle, float *in_out, ACSATensor4d* tensor);
+template ACSAStatus ACSAReLUInplaceFwd<double>(ACSAHandle *handle, double *in_out, ACSATensor4d* tensor);
+template ACSAStatus ACSAReLUOutplaceFwd<float>(ACSAHandle *handle, const float *in, float *out, ACSATensor4d* tensor);
+template ACSAStatus ACSAReLUOutplaceFwd<double>(ACSAHandle *handle, const double *in, double *out, ACSATensor4d* tensor);
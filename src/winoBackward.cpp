@@ -0,0 +1,370 @@
+/* Backward convolution for training.
+ * The gradient of in is the convolution of the gradient of out with the
+ * filter rotated by 180 degrees and its C and K swapped, so it runs by
+ * ACSAWinoConvolutionFwd on the swapped shapes with any of its algorithms.
+ * With the pad d*(r-1)-pad around the gradient of out, a stride-1 layer
+ * is such a convolution as it is. A strided layer, or a pad the winograd
+ * kernels don't take, copies the gradient of out into a padded buffer
+ * with stride-1 zeros between its pixels first.
+ * The gradient of the filter runs in the winograd domain, see ACSAWinoBwdFilterRect.
+ * A strided layer spreads the gradient of out the same way, without the pad.
+ * */
+
+#include "dnn.hpp"
+
+/* Copy diffOut into buf, (N, K, h, w) of tensorBuf in NCHW, pixel (y, x) lands at
+ * (oh + y*stride_h, ow + x*stride_w) and the rest is zero.
+ * */
+    template<typename Dtype>
+static void spreadGrad(ACSAHandle *handle, const Dtype *diffOut, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, const int oh, const int ow, ACSATensor4d* tensorBuf, Dtype *buf)
+{
+    const int BH = tensorBuf->h_;
+    const int BW = tensorBuf->w_;
+    const int K = tensorOut->c_;
+    int d1;
+
+#pragma omp parallel for private(d1) num_threads(handle->num_threads_)
+    for(d1 = 0; d1 < tensorOut->n_*K; d1++){
+        const int n = d1/K;
+        const int k = d1%K;
+        Dtype *dst = buf + (long)d1*BH*BW;
+
+        memset(dst, 0, (long)BH*BW*sizeof(Dtype));
+        for(int y = 0; y < tensorOut->h_; y++){
+            const int i = oh + y*convMess->stride_h_;
+            if(i < 0 || i >= BH)
+                continue;
+            for(int x = 0; x < tensorOut->w_; x++){
+                const int j = ow + x*convMess->stride_w_;
+                if(j >= 0 && j < BW)
+                    dst[i*BW + j] = diffOut[ACSATensorOffset(tensorOut, n, k, y, x)];
+            }
+        }
+    }
+}
+
+/* Shapes and convolution of the backward-data pass, spread tells if diffOut goes to the buffer. */
+static void bwdDataTensors(ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSATensor4d &bwdIn, ACSATensor4d &bwdFilter, ACSATensor4d &bwdOut,
+        ACSAConvMessage &bwdConv, bool &spread)
+{
+    const int R = tensorFilter->h_;
+    const int S = tensorFilter->w_;
+    const int G = convMess->groups_;
+    const int dh = convMess->dilation_h_;
+    const int dw = convMess->dilation_w_;
+    const int ph = dh*(R-1) - convMess->pad_h_;
+    const int pw = dw*(S-1) - convMess->pad_w_;
+
+    spread = (convMess->stride_h_ != 1) || (convMess->stride_w_ != 1) ||
+        (ph < 0) || (pw < 0) || (ph > 1) || (pw > 1);
+
+    ACSASetTensor4d(bwdFilter, tensorIn->c_, tensorFilter->n_/G, R, S);
+    bwdOut = *tensorIn;
+    if(spread){
+        ACSASetTensor4d(bwdIn, tensorOut->n_, tensorOut->c_, tensorIn->h_+dh*(R-1), tensorIn->w_+dw*(S-1));
+        ACSASetConvMessage(bwdConv, R, S, 0, 0, 1, 1);
+    }
+    else{
+        bwdIn = *tensorOut;
+        ACSASetConvMessage(bwdConv, R, S, ph, pw, 1, 1);
+    }
+    ACSASetConvDilation(bwdConv, dh, dw);
+    ACSASetConvGroups(bwdConv, G);
+}
+
+/* Bytes of workspace needed by ACSAWinoConvolutionBwdData. */
+    template<typename Dtype>
+ACSAStatus ACSAGetWinoBwdDataWorkspaceSize(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess)
+{
+    ACSATensor4d bwdIn, bwdFilter, bwdOut;
+    ACSAConvMessage bwdConv;
+    bool spread;
+
+    bwdDataTensors(tensorIn, tensorFilter, tensorOut, convMess, bwdIn, bwdFilter, bwdOut, bwdConv, spread);
+
+    return ACSAGetWinoWorkspaceSize<Dtype>(size, &bwdIn, &bwdFilter, &bwdOut, &bwdConv, winoMess);
+}
+
+/* API for the backward-data convolution, diffIn = conv(diffOut, rotated filter). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolutionBwdData(ACSAHandle *handle,
+        const Dtype *diffOut, const Dtype *filter, Dtype *diffIn,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess)
+{
+    const int K = tensorFilter->n_;
+    const int Cg = tensorFilter->c_;
+    const int R = tensorFilter->h_;
+    const int S = tensorFilter->w_;
+    const int G = convMess->groups_;
+    const int Kg = K/G;
+    const int outHeight = tensorOut->h_;
+    const int outWidth = tensorOut->w_;
+    ACSATensor4d bwdIn, bwdFilter, bwdOut;
+    ACSAConvMessage bwdConv;
+    bool spread;
+
+    // Check
+    ACSA_CHECK(((Cg*G == tensorIn->c_) && (K%G == 0) && (tensorOut->c_ == K)));
+    ACSA_CHECK(((outHeight == (tensorIn->h_+2*convMess->pad_h_-convMess->dilation_h_*(R-1)-1)/convMess->stride_h_+1) &&
+                (outWidth == (tensorIn->w_+2*convMess->pad_w_-convMess->dilation_w_*(S-1)-1)/convMess->stride_w_+1)));
+
+    bwdDataTensors(tensorIn, tensorFilter, tensorOut, convMess, bwdIn, bwdFilter, bwdOut, bwdConv, spread);
+
+    /* Filter (g*Cg + c, k, r, s) of the pass is (g*Kg + k, c, R-1-r, S-1-s) of the layer. */
+    Dtype *bwd_filter = (Dtype *)mkl_malloc((long)K*Cg*R*S*sizeof(Dtype), 64);
+    assert(bwd_filter != NULL);
+    int d1;
+#pragma omp parallel for private(d1) num_threads(handle->num_threads_)
+    for(d1 = 0; d1 < G*Cg*Kg; d1++){
+        const int g = d1/(Cg*Kg);
+        const int c = d1/Kg%Cg;
+        const int k = d1%Kg;
+        const Dtype *src = filter + ((long)(g*Kg + k)*Cg + c)*R*S;
+        Dtype *dst = bwd_filter + ((long)(g*Cg + c)*Kg + k)*R*S;
+
+        for(int rs = 0; rs < R*S; rs++)
+            dst[rs] = src[R*S-1-rs];
+    }
+
+    /* diffOut goes into the pad of d*(r-1)-pad, with the zeros of the stride. */
+    const Dtype *bwd_in = diffOut;
+    Dtype *spread_in = NULL;
+    if(spread){
+        spread_in = (Dtype *)mkl_malloc(ACSATensorSize(&bwdIn)*sizeof(Dtype), 64);
+        assert(spread_in != NULL);
+        spreadGrad(handle, diffOut, tensorOut, convMess,
+                convMess->dilation_h_*(R-1) - convMess->pad_h_, convMess->dilation_w_*(S-1) - convMess->pad_w_,
+                &bwdIn, spread_in);
+        bwd_in = spread_in;
+    }
+
+    ACSAStatus ret = ACSAWinoConvolutionFwd(handle, bwd_in, (const Dtype *)bwd_filter, diffIn,
+            &bwdIn, &bwdFilter, &bwdOut, &bwdConv, winoMess);
+
+    if(spread_in != NULL)
+        mkl_free(spread_in);
+    mkl_free(bwd_filter);
+
+    return ret;
+}
+
+/* Output tile of algo for the filter gradient, m_h = 0 when it has none. */
+static void bwdFilterTile(ACSAWinogradAlgo algo, ACSATensor4d* tensorFilter, int &m_h, int &m_w)
+{
+    m_h = m_w = 0;
+    if(!ACSAWinoAlgoFits(algo, tensorFilter))
+        return;
+
+    switch(algo)
+    {
+        case ACSA_WINOGRAD_2X3:
+        case ACSA_WINOGRAD_2X5:
+            m_h = m_w = 2;
+            break;
+        case ACSA_WINOGRAD_3X3:
+            m_h = m_w = 3;
+            break;
+        case ACSA_WINOGRAD_4X3:
+        case ACSA_WINOGRAD_4X5:
+            m_h = m_w = 4;
+            break;
+        case ACSA_WINOGRAD_5X3:
+            m_h = m_w = 5;
+            break;
+        case ACSA_WINOGRAD_6X3:
+            m_h = m_w = 6;
+            break;
+        case ACSA_WINOGRAD_8X3:
+            m_h = m_w = 8;
+            break;
+        case ACSA_WINOGRAD_4X3_1D:
+            m_h = (tensorFilter->h_ == 1) ? 1 : 4;
+            m_w = (tensorFilter->h_ == 1) ? 4 : 1;
+            break;
+        default:
+            break;
+    }
+}
+
+/* Variant of the filter gradient, AUTO and TUNE take the pick of ACSAWinoSelect.
+ * The direct and im2col convolutions, asked or picked, take the widest variant of the filter.
+ * */
+    template<typename Dtype>
+static ACSAWinogradAlgo bwdFilterAlgo(ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess)
+{
+    const ACSAWinogradAlgo wide[3] = {ACSA_WINOGRAD_4X3, ACSA_WINOGRAD_2X5, ACSA_WINOGRAD_4X3_1D};
+    ACSAWinogradAlgo algo = winoMess->algo_;
+    int m_h, m_w;
+
+    if(algo == ACSA_WINOGRAD_AUTO || algo == ACSA_WINOGRAD_TUNE){
+        ACSAWinoMessage select = *winoMess;
+        select.algo_ = ACSA_WINOGRAD_AUTO;
+        ACSAWinoSelect<Dtype>(tensorIn, tensorFilter, tensorOut, &select);
+        algo = select.algo_;
+    }
+
+    if(algo == ACSA_CONV_DIRECT || algo == ACSA_CONV_GEMM){
+        m_h = 0;
+        for(int i = 0; i < 3 && m_h == 0; i++){
+            algo = wide[i];
+            bwdFilterTile(algo, tensorFilter, m_h, m_w);
+        }
+    }
+
+    return algo;
+}
+
+/* Stride-1 shape of diffOut for the filter gradient, a strided one is spread by the stride. */
+static void bwdFilterGrad(ACSATensor4d* tensorOut, ACSAConvMessage* convMess, ACSATensor4d &tensorGrad)
+{
+    if(convMess->stride_h_ == 1 && convMess->stride_w_ == 1)
+        tensorGrad = *tensorOut;
+    else
+        ACSASetTensor4d(tensorGrad, tensorOut->n_, tensorOut->c_,
+                (tensorOut->h_-1)*convMess->stride_h_+1, (tensorOut->w_-1)*convMess->stride_w_+1);
+}
+
+/* Bytes of workspace needed by ACSAWinoConvolutionBwdFilter. */
+    template<typename Dtype>
+ACSAStatus ACSAGetWinoBwdFilterWorkspaceSize(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess)
+{
+    ACSATensor4d tensorGrad;
+    int m_h, m_w;
+
+    if(convMess->dilation_h_ != 1 || convMess->dilation_w_ != 1){
+        ACSA_MESSAGE("ERROR: The filter gradient doesn't support dilation!");
+        size = 0;
+        return ACSAFAIL;
+    }
+
+    bwdFilterTile(bwdFilterAlgo<Dtype>(tensorIn, tensorFilter, tensorOut, winoMess), tensorFilter, m_h, m_w);
+    if(m_h == 0){
+        ACSA_MESSAGE("ERROR: No winograd variant computes the filter gradient of this shape!");
+        size = 0;
+        return ACSAFAIL;
+    }
+
+    bwdFilterGrad(tensorOut, convMess, tensorGrad);
+    size = ACSAWinoBwdFilterBytes(m_h, m_w, tensorIn, tensorFilter, &tensorGrad, sizeof(Dtype));
+
+    return ACSASUCCESS;
+}
+
+/* API for the backward-filter convolution, diffFilter = sum of in * diffOut over the batch. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolutionBwdFilter(ACSAHandle *handle,
+        const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess)
+{
+    const int R = tensorFilter->h_;
+    const int S = tensorFilter->w_;
+    const int G = convMess->groups_;
+    ACSATensor4d tensorGrad;
+    ACSAStatus ret;
+
+    // Check
+    ACSA_CHECK(((tensorFilter->c_*G == tensorIn->c_) && (tensorFilter->n_%G == 0) && (tensorOut->c_ == tensorFilter->n_)));
+    ACSA_CHECK(((tensorOut->h_ == (tensorIn->h_+2*convMess->pad_h_-convMess->dilation_h_*(R-1)-1)/convMess->stride_h_+1) &&
+                (tensorOut->w_ == (tensorIn->w_+2*convMess->pad_w_-convMess->dilation_w_*(S-1)-1)/convMess->stride_w_+1)));
+    if(convMess->dilation_h_ != 1 || convMess->dilation_w_ != 1){
+        ACSA_MESSAGE("ERROR: The filter gradient doesn't support dilation!");
+        return ACSAFAIL;
+    }
+
+    const ACSAWinogradAlgo algo = bwdFilterAlgo<Dtype>(tensorIn, tensorFilter, tensorOut, winoMess);
+    int m_h, m_w;
+    bwdFilterTile(algo, tensorFilter, m_h, m_w);
+    if(m_h == 0){
+        ACSA_MESSAGE("ERROR: No winograd variant computes the filter gradient of this shape!");
+        return ACSAFAIL;
+    }
+
+    /* Pixel (y, x) of a strided diffOut lands at (y*stride, x*stride), the rest is zero. */
+    bwdFilterGrad(tensorOut, convMess, tensorGrad);
+    const Dtype *grad = diffOut;
+    Dtype *spread_grad = NULL;
+    if(convMess->stride_h_ != 1 || convMess->stride_w_ != 1){
+        spread_grad = (Dtype *)mkl_malloc(ACSATensorSize(&tensorGrad)*sizeof(Dtype), 64);
+        assert(spread_grad != NULL);
+        spreadGrad(handle, diffOut, tensorOut, convMess, 0, 0, &tensorGrad, spread_grad);
+        grad = spread_grad;
+    }
+
+    const int nthreads = omp_get_max_threads();
+    omp_set_num_threads(handle->num_threads_);
+    switch(algo)
+    {
+        case ACSA_WINOGRAD_2X3:
+            ret = ACSAWinoBwdFilter_2x3(handle, in, grad, diffFilter, tensorIn, tensorFilter, &tensorGrad, convMess);
+            break;
+        case ACSA_WINOGRAD_3X3:
+            ret = ACSAWinoBwdFilter_3x3(handle, in, grad, diffFilter, tensorIn, tensorFilter, &tensorGrad, convMess);
+            break;
+        case ACSA_WINOGRAD_4X3:
+            ret = ACSAWinoBwdFilter_4x3(handle, in, grad, diffFilter, tensorIn, tensorFilter, &tensorGrad, convMess);
+            break;
+        case ACSA_WINOGRAD_6X3:
+            ret = ACSAWinoBwdFilter_6x3(handle, in, grad, diffFilter, tensorIn, tensorFilter, &tensorGrad, convMess);
+            break;
+        case ACSA_WINOGRAD_2X5:
+            ret = ACSAWinoBwdFilter_2x5(handle, in, grad, diffFilter, tensorIn, tensorFilter, &tensorGrad, convMess);
+            break;
+        case ACSA_WINOGRAD_4X5:
+            ret = ACSAWinoBwdFilter_4x5(handle, in, grad, diffFilter, tensorIn, tensorFilter, &tensorGrad, convMess);
+            break;
+        case ACSA_WINOGRAD_5X3:
+            ret = ACSAWinoBwdFilter_5x3(handle, in, grad, diffFilter, tensorIn, tensorFilter, &tensorGrad, convMess);
+            break;
+        case ACSA_WINOGRAD_8X3:
+            ret = ACSAWinoBwdFilter_8x3(handle, in, grad, diffFilter, tensorIn, tensorFilter, &tensorGrad, convMess);
+            break;
+        default:
+            ret = ACSAWinoBwdFilter_4x3_1d(handle, in, grad, diffFilter, tensorIn, tensorFilter, &tensorGrad, convMess);
+            break;
+    }
+    omp_set_num_threads(nthreads);
+
+    if(spread_grad != NULL)
+        mkl_free(spread_grad);
+
+    return ret;
+}
+
+/* Instantiate Template */
+template ACSAStatus ACSAGetWinoBwdDataWorkspaceSize<float>(size_t &,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *);
+template ACSAStatus ACSAGetWinoBwdDataWorkspaceSize<double>(size_t &,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *);
+template ACSAStatus ACSAWinoConvolutionBwdData<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *);
+template ACSAStatus ACSAWinoConvolutionBwdData<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *);
+template ACSAStatus ACSAGetWinoBwdFilterWorkspaceSize<float>(size_t &,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *);
+template ACSAStatus ACSAGetWinoBwdFilterWorkspaceSize<double>(size_t &,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *);
+template ACSAStatus ACSAWinoConvolutionBwdFilter<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *);
+template ACSAStatus ACSAWinoConvolutionBwdFilter<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *);
@@ -5,9 +5,6 @@
 
 #define ZERO_LENGTH(tail) (2-tail)%2
 
-static const long ISTRIDE2X3 = ISTRIDE;
-static const long FSTRIDE2X3 = FSTRIDE;
-static const long OSTRIDE2X3 = OSTRIDE;
 
 /* AT-G-BT for F(2,3).
  * The dimensions for AT/G/BT.
@@ -28,7 +25,7 @@ static const float G[12] = {
 };
 
 static const float BT[16] = {
-    2,  0, -1,  0,
+    1,  0, -1,  0,
     0,  1,  1,  0,
     0, -1,  1,  0,
     0,  1,  0, -1
@@ -122,7 +119,8 @@ static const float BT[16] = {
     template<typename Dtype>
 static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
         const int N, const int C, const int rows, const int cols,
-        ACSATailMessage *tailMess, const int ntiles, const int mg2x3)
+        ACSATailMessage *tailMess, const int ntiles, const int mg2x3,
+        const long istride)
 {   
     int d1, d2;
     int sizeI = rows*cols;
@@ -174,7 +172,7 @@ static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE2X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++; 
             }
 
@@ -184,7 +182,7 @@ static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE2X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++; 
             }
         }
@@ -212,7 +210,7 @@ static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE2X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++;
             }
         }
@@ -223,7 +221,7 @@ static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
 
             // The tranformation manually simplified
             TRANS_BT_FST(BT, tmp, bridge);
-            TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE2X3);
+            TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
             tileCount++;
         }
     }
@@ -236,7 +234,8 @@ static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
 static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
         const int N, const int C, const int rows, const int cols,
         const int pad_h, const int pad_w,
-        ACSATailMessage *tailMess, const int ntiles, const int mg2x3)
+        ACSATailMessage *tailMess, const int ntiles, const int mg2x3,
+        const long istride)
 {   
     int d1, d2;
     int rows_pad = rows + 2*pad_h;
@@ -302,7 +301,7 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE2X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++; 
             }
         }
@@ -330,7 +329,7 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 
             // Tranformation manually simplified
             TRANS_BT_FST(BT, tmp, bridge);
-            TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE2X3);
+            TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
             tileCount++;
         }
 
@@ -354,7 +353,7 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 
                 // Tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE2X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++;
             }
         }
@@ -378,7 +377,7 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 
                 // Tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE2X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++;
             }
         }
@@ -390,7 +389,7 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 
             // Tranformation manually simplified
             TRANS_BT_FST(BT, tmp, bridge);
-            TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE2X3);
+            TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
             tileCount += col_nTiles;
         }
 
@@ -401,7 +400,7 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 
             // Tranformation manually simplified
             TRANS_BT_FST(BT, tmp, bridge);
-            TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE2X3);
+            TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
             tileCount += col_nTiles;
         }
 
@@ -409,26 +408,26 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
         tileCount = baseTileCount;
         ACSAGetInputTile(tmp, data, 4, 4, 0, 0, cols, 1, 0, 1, 0);
         TRANS_BT_FST(BT, tmp, bridge);
-        TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE2X3);
+        TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
 
         // Top Right Corner for third region
         tileCount = baseTileCount + col_nTiles -1;
         ACSAGetInputTile(tmp, data, 4, 4, 0, cols-3+ZERO_LENGTH(tail_w), cols, 1, 0, 0, ZERO_LENGTH(tail_w)+1);
         TRANS_BT_FST(BT, tmp, bridge);
-        TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE2X3);
+        TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
 
         // Bottom Left Corner for third region
         tileCount = baseTileCount + (row_nTiles - 1)*(col_nTiles);
         ACSAGetInputTile(tmp, data, 4, 4, rows-3+ZERO_LENGTH(tail_h), 0, cols, 0, ZERO_LENGTH(tail_h)+1, 1, 0);
         TRANS_BT_FST(BT, tmp, bridge);
-        TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE2X3);
+        TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
 
         // Bottom Right Corner for third region
         tileCount = baseTileCount + 
             row_nTiles*col_nTiles - 1;
         ACSAGetInputTile(tmp, data, 4, 4, rows-3+ZERO_LENGTH(tail_h), cols-3+ZERO_LENGTH(tail_w), cols, 0, ZERO_LENGTH(tail_h)+1, 0, ZERO_LENGTH(tail_w)+1);
         TRANS_BT_FST(BT, tmp, bridge);
-        TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE2X3);
+        TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
     }
 }
 
@@ -439,7 +438,8 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *dataDst,
         const int N, const int C, const int rows, const int cols,
         const int pad_h, const int pad_w,
-        ACSATailMessage *tailMess, const int ntiles, const int mg2x3)
+        ACSATailMessage *tailMess, const int ntiles, const int mg2x3,
+        const long istride)
 {   
     int d1, d2;
     int rows_pad = rows + 2*pad_h;
@@ -505,7 +505,7 @@ static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *d
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE2X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++; 
             }
 
@@ -515,7 +515,7 @@ static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *d
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE2X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++; 
             }
         }
@@ -546,7 +546,7 @@ static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *d
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE2X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++; 
             }
         }
@@ -557,7 +557,7 @@ static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *d
 
             // The tranformation manually simplified
             TRANS_BT_FST(BT, tmp, bridge);
-            TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE2X3);
+            TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
             tileCount++; 
         }
     }
@@ -566,7 +566,7 @@ static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *d
 /* Compute the bridge data for filter, and transform to form matrix B. */
     template<typename Dtype>
 static void filterByTransform(const Dtype *filter, Dtype *dataDst,
-        const int C, const int K)
+        const int C, const int K, const long fstride)
 {
 
     int d1, d2, d3; 
@@ -595,22 +595,22 @@ static void filterByTransform(const Dtype *filter, Dtype *dataDst,
             bridge[11] = G[ 9]*tmp[ 2] + G[10]*tmp[ 5] + G[11]*tmp[ 8];
 
             // Second transform filter data by G
-            dataDst[ 0*FSTRIDE2X3+d1*C+d2] = bridge[ 0]*G[ 0] + bridge[ 1]*G[ 1] + bridge[ 2]*G[ 2];
-            dataDst[ 1*FSTRIDE2X3+d1*C+d2] = bridge[ 0]*G[ 3] + bridge[ 1]*G[ 4] + bridge[ 2]*G[ 5];
-            dataDst[ 2*FSTRIDE2X3+d1*C+d2] = bridge[ 0]*G[ 6] + bridge[ 1]*G[ 7] + bridge[ 2]*G[ 8];
-            dataDst[ 3*FSTRIDE2X3+d1*C+d2] = bridge[ 0]*G[ 9] + bridge[ 1]*G[10] + bridge[ 2]*G[11];
-            dataDst[ 4*FSTRIDE2X3+d1*C+d2] = bridge[ 3]*G[ 0] + bridge[ 4]*G[ 1] + bridge[ 5]*G[ 2];
-            dataDst[ 5*FSTRIDE2X3+d1*C+d2] = bridge[ 3]*G[ 3] + bridge[ 4]*G[ 4] + bridge[ 5]*G[ 5];
-            dataDst[ 6*FSTRIDE2X3+d1*C+d2] = bridge[ 3]*G[ 6] + bridge[ 4]*G[ 7] + bridge[ 5]*G[ 8];
-            dataDst[ 7*FSTRIDE2X3+d1*C+d2] = bridge[ 3]*G[ 9] + bridge[ 4]*G[10] + bridge[ 5]*G[11];
-            dataDst[ 8*FSTRIDE2X3+d1*C+d2] = bridge[ 6]*G[ 0] + bridge[ 7]*G[ 1] + bridge[ 8]*G[ 2];
-            dataDst[ 9*FSTRIDE2X3+d1*C+d2] = bridge[ 6]*G[ 3] + bridge[ 7]*G[ 4] + bridge[ 8]*G[ 5];
-            dataDst[10*FSTRIDE2X3+d1*C+d2] = bridge[ 6]*G[ 6] + bridge[ 7]*G[ 7] + bridge[ 8]*G[ 8];
-            dataDst[11*FSTRIDE2X3+d1*C+d2] = bridge[ 6]*G[ 9] + bridge[ 7]*G[10] + bridge[ 8]*G[11];
-            dataDst[12*FSTRIDE2X3+d1*C+d2] = bridge[ 9]*G[ 0] + bridge[10]*G[ 1] + bridge[11]*G[ 2];
-            dataDst[13*FSTRIDE2X3+d1*C+d2] = bridge[ 9]*G[ 3] + bridge[10]*G[ 4] + bridge[11]*G[ 5];
-            dataDst[14*FSTRIDE2X3+d1*C+d2] = bridge[ 9]*G[ 6] + bridge[10]*G[ 7] + bridge[11]*G[ 8];
-            dataDst[15*FSTRIDE2X3+d1*C+d2] = bridge[ 9]*G[ 9] + bridge[10]*G[10] + bridge[11]*G[11];
+            dataDst[ 0*fstride+d1*C+d2] = bridge[ 0]*G[ 0] + bridge[ 1]*G[ 1] + bridge[ 2]*G[ 2];
+            dataDst[ 1*fstride+d1*C+d2] = bridge[ 0]*G[ 3] + bridge[ 1]*G[ 4] + bridge[ 2]*G[ 5];
+            dataDst[ 2*fstride+d1*C+d2] = bridge[ 0]*G[ 6] + bridge[ 1]*G[ 7] + bridge[ 2]*G[ 8];
+            dataDst[ 3*fstride+d1*C+d2] = bridge[ 0]*G[ 9] + bridge[ 1]*G[10] + bridge[ 2]*G[11];
+            dataDst[ 4*fstride+d1*C+d2] = bridge[ 3]*G[ 0] + bridge[ 4]*G[ 1] + bridge[ 5]*G[ 2];
+            dataDst[ 5*fstride+d1*C+d2] = bridge[ 3]*G[ 3] + bridge[ 4]*G[ 4] + bridge[ 5]*G[ 5];
+            dataDst[ 6*fstride+d1*C+d2] = bridge[ 3]*G[ 6] + bridge[ 4]*G[ 7] + bridge[ 5]*G[ 8];
+            dataDst[ 7*fstride+d1*C+d2] = bridge[ 3]*G[ 9] + bridge[ 4]*G[10] + bridge[ 5]*G[11];
+            dataDst[ 8*fstride+d1*C+d2] = bridge[ 6]*G[ 0] + bridge[ 7]*G[ 1] + bridge[ 8]*G[ 2];
+            dataDst[ 9*fstride+d1*C+d2] = bridge[ 6]*G[ 3] + bridge[ 7]*G[ 4] + bridge[ 8]*G[ 5];
+            dataDst[10*fstride+d1*C+d2] = bridge[ 6]*G[ 6] + bridge[ 7]*G[ 7] + bridge[ 8]*G[ 8];
+            dataDst[11*fstride+d1*C+d2] = bridge[ 6]*G[ 9] + bridge[ 7]*G[10] + bridge[ 8]*G[11];
+            dataDst[12*fstride+d1*C+d2] = bridge[ 9]*G[ 0] + bridge[10]*G[ 1] + bridge[11]*G[ 2];
+            dataDst[13*fstride+d1*C+d2] = bridge[ 9]*G[ 3] + bridge[10]*G[ 4] + bridge[11]*G[ 5];
+            dataDst[14*fstride+d1*C+d2] = bridge[ 9]*G[ 6] + bridge[10]*G[ 7] + bridge[11]*G[ 8];
+            dataDst[15*fstride+d1*C+d2] = bridge[ 9]*G[ 9] + bridge[10]*G[10] + bridge[11]*G[11];
         }
     }
 }
@@ -619,49 +619,30 @@ static void filterByTransform(const Dtype *filter, Dtype *dataDst,
  * Number of sgemm calls is 16*BATCH. 
  * */ 
     template<typename Dtype>
-static void matrix_compute(const Dtype *in, const int irows, const int icols,
-        const Dtype *filter, const int frows, const int fcols,
-        Dtype *out,
-        const int batch)
+static void matrix_compute(const Dtype *in, const int irows, const int icols, const long istride,
+        const Dtype *filter, const int frows, const int fcols, const long fstride,
+        Dtype *out, const long ostride,
+        const int batch, const ACSAGemmMode gemm)
 {
 
     /* In  - matrix A
      * Filter - matrix B
      * Output - matrix C
+     * All 16 points of every batch are issued as one batched gemm.
      * */
-    int d1, d2; 
-    const char trans ='n'; 
-    const float alpha_f = 1.0; 
-    const float beta_f =  0.0; 
-    const double alpha_d = 1.0; 
-    const double beta_d =  0.0; 
-    const int ldi = irows;
-    const int ldf = frows;
-    const int ldo = irows;
-
-#pragma omp parallel for collapse(2) private(d1, d2)
-    for(d1 = 0; d1 < 16; d1++){
-        for(d2 = 0; d2 < batch; d2++){
-            const Dtype* pin = in+d1*ISTRIDE2X3+d2*irows*icols; 
-            const Dtype* pft = filter+d1*FSTRIDE2X3; 
-            Dtype* pot = out+d1*OSTRIDE2X3+d2*irows*fcols; 
-            if(typeid(Dtype) == typeid(float))
-                sgemm(&trans, &trans, &irows, &fcols, &icols, &alpha_f, 
-                        (const float *)pin, &ldi, (const float *)pft, &ldf, &beta_f, (float *)pot, &ldo); 
-            else if(typeid(Dtype) == typeid(double))
-                dgemm(&trans, &trans, &irows, &fcols, &icols, &alpha_d, 
-                        (const double *)pin, &ldi, (const double *)pft, &ldf, &beta_d, (double *)pot, &ldo); 
-            else
-                printf("Currently, only support float/double data!!!\n");
-        }
-    }
+    if(gemm == ACSA_GEMM_KERNEL)
+        ACSAWinoGemm(in, irows, icols, istride, filter, fcols, fstride, out, ostride, 16, batch);
+    else
+        ACSABatchGemm(in, irows, icols, istride, filter, fcols, fstride, out, ostride, 16, batch);
 } 
 
 /* Compute the bridge data for out, and transform to form matrix C. */
     template<typename Dtype>
 static void outByTransform(Dtype *out, const Dtype *dataSrc,
         const int N, const int K, const int rows, const int cols,
-        ACSATailMessage *tailMess, const int ntiles, const int mg2x3)
+        ACSATailMessage *tailMess, const int ntiles, const int mg2x3,
+        const long ostride,
+        const Dtype *bias, const Dtype slope, const Dtype ceil)
 {
     int d1; 
     int sizeO = rows * cols;
@@ -688,31 +669,35 @@ static void outByTransform(Dtype *out, const Dtype *dataSrc,
         const int t3 = d1%mg2x3;
 
         Dtype *dataDst = out + (t1*mg2x3*K + t3*K + t2)*sizeO;
+
+        const Dtype bk = (bias == NULL) ? (Dtype)0 : bias[t2];
         int tileCount = d1*ntiles;
 
         for(i = 0; i < rowSeg1; i += 2){
 #pragma simd
             // Process no tail
             for(j = 0; j < colSeg1; j += 2){
-                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, OSTRIDE2X3);
+                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, ostride);
                 // First inverse transfrom for output data by AT
                 TRANS_AT_FST(AT, tmp, bridge);
                 // Second inverse transfrom for output data by AT
-                dataDst[(i+0)*cols + (j+0)] = bridge[ 0]*AT[ 0] + bridge[ 1]*AT[ 1] + bridge[ 2]*AT[ 2] + bridge[ 3]*AT[ 3];
-                dataDst[(i+0)*cols + (j+1)] = bridge[ 0]*AT[ 4] + bridge[ 1]*AT[ 5] + bridge[ 2]*AT[ 6] + bridge[ 3]*AT[ 7];
-                dataDst[(i+1)*cols + (j+0)] = bridge[ 4]*AT[ 0] + bridge[ 5]*AT[ 1] + bridge[ 6]*AT[ 2] + bridge[ 7]*AT[ 3];
-                dataDst[(i+1)*cols + (j+1)] = bridge[ 4]*AT[ 4] + bridge[ 5]*AT[ 5] + bridge[ 6]*AT[ 6] + bridge[ 7]*AT[ 7];
+                dataDst[(i+0)*cols + (j+0)] = ACSAActivate<Dtype>(bridge[ 0]*AT[ 0] + bridge[ 1]*AT[ 1] + bridge[ 2]*AT[ 2] + bridge[ 3]*AT[ 3], bk, slope, ceil);
+                dataDst[(i+0)*cols + (j+1)] = ACSAActivate<Dtype>(bridge[ 0]*AT[ 4] + bridge[ 1]*AT[ 5] + bridge[ 2]*AT[ 6] + bridge[ 3]*AT[ 7], bk, slope, ceil);
+                dataDst[(i+1)*cols + (j+0)] = ACSAActivate<Dtype>(bridge[ 4]*AT[ 0] + bridge[ 5]*AT[ 1] + bridge[ 6]*AT[ 2] + bridge[ 7]*AT[ 3], bk, slope, ceil);
+                dataDst[(i+1)*cols + (j+1)] = ACSAActivate<Dtype>(bridge[ 4]*AT[ 4] + bridge[ 5]*AT[ 5] + bridge[ 6]*AT[ 6] + bridge[ 7]*AT[ 7], bk, slope, ceil);
                 tileCount++; 
             }
 
             // Process col tail
             if(colSeg2 != 0){
-                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, OSTRIDE2X3);
+                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, ostride);
                 // First inverse transfrom for output data by AT
                 TRANS_AT_FST(AT, tmp, bridge);
                 // Second inverse transfrom for output data by AT
                 TRANS_AT_SED(bridge, AT, middle);
 
+                ACSAActivateTile(middle, 4, bk, slope, ceil);
+
                 ACSAGetFinalOutput(dataDst, middle, 2, 2, i, j, cols, 0, 0, 0, ZERO_LENGTH(colSeg2));
                 tileCount++; 
             }
@@ -722,30 +707,76 @@ static void outByTransform(Dtype *out, const Dtype *dataSrc,
         if(rowSeg2 == 1){
 #pragma simd
             for(j = 0; j < colSeg1; j += 2){
-                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, OSTRIDE2X3);
+                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, ostride);
                 // First inverse transfrom for output data by AT
                 TRANS_AT_FST(AT, tmp, bridge);
                 // Second inverse transfrom for output data by AT
-                dataDst[(rowSeg1+0)*cols + (j+0)] = bridge[ 0]*AT[ 0] + bridge[ 1]*AT[ 1] + bridge[ 2]*AT[ 2] + bridge[ 3]*AT[ 3];
-                dataDst[(rowSeg1+0)*cols + (j+1)] = bridge[ 0]*AT[ 4] + bridge[ 1]*AT[ 5] + bridge[ 2]*AT[ 6] + bridge[ 3]*AT[ 7];
+                dataDst[(rowSeg1+0)*cols + (j+0)] = ACSAActivate<Dtype>(bridge[ 0]*AT[ 0] + bridge[ 1]*AT[ 1] + bridge[ 2]*AT[ 2] + bridge[ 3]*AT[ 3], bk, slope, ceil);
+                dataDst[(rowSeg1+0)*cols + (j+1)] = ACSAActivate<Dtype>(bridge[ 0]*AT[ 4] + bridge[ 1]*AT[ 5] + bridge[ 2]*AT[ 6] + bridge[ 3]*AT[ 7], bk, slope, ceil);
                 tileCount++; 
             }
         }
 
         // Process row&col tail
         if((rowSeg2 != 0) && (colSeg2 != 0)){
-            GET_OUTPUT_TILE(tmp, dataSrc, tileCount, OSTRIDE2X3);
+            GET_OUTPUT_TILE(tmp, dataSrc, tileCount, ostride);
             // First inverse transfrom for output data by AT
             TRANS_AT_FST(AT, tmp, bridge);
             // Second inverse transfrom for output data by AT
             TRANS_AT_SED(bridge, AT, middle);
 
+            ACSAActivateTile(middle, 4, bk, slope, ceil);
+
             ACSAGetFinalOutput(dataDst, middle, 2, 2, rowSeg1, colSeg1, cols, 0, ZERO_LENGTH(rowSeg2), 0, ZERO_LENGTH(colSeg2));
             tileCount++; 
         }
     }
 }
 
+/* Compute the bridge data for out, transform and max pool 2x2 to form the pooled matrix C. */
+    template<typename Dtype>
+static void outByTransformPool(Dtype *out, const Dtype *dataSrc,
+        const int N, const int K, const int rows, const int cols,
+        const int ntiles, const int mg2x3,
+        const long ostride,
+        const Dtype *bias, const Dtype slope, const Dtype ceil)
+{
+    int d1;
+    const int pcols = cols/2;
+    const int sizeP = (rows/2) * pcols;
+
+#pragma omp parallel for private(d1)
+    for(d1 = 0; d1 < N*K; d1++){
+        int i, j;
+        Dtype tmp[16] __attribute__((aligned(64)));
+        Dtype bridge[8] __attribute__((aligned(64)));
+        Dtype middle[4] __attribute__((aligned(64)));
+
+        const int t1 = d1/(K*mg2x3);
+        const int t2 = (d1%(K*mg2x3))/mg2x3;
+        const int t3 = d1%mg2x3;
+
+        Dtype *dataDst = out + (t1*mg2x3*K + t3*K + t2)*sizeP;
+
+        const Dtype bk = (bias == NULL) ? (Dtype)0 : bias[t2];
+        int tileCount = d1*ntiles;
+
+        // Every output tile is exactly one pooling window
+        for(i = 0; i < rows; i += 2){
+            for(j = 0; j < cols; j += 2){
+                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, ostride);
+                TRANS_AT_FST(AT, tmp, bridge);
+                TRANS_AT_SED(bridge, AT, middle);
+
+                ACSAActivateTile(middle, 4, bk, slope, ceil);
+
+                ACSAPoolTileMax(dataDst, middle, 2, 2, 2, i, j, pcols);
+                tileCount++;
+            }
+        }
+    }
+}
+
 /* Process the data tail. */
 static void tailPreProcess(ACSATensor4d *tensorOut, ACSATailMessage &tailMess, int &ntiles)
 {
@@ -768,12 +799,64 @@ static void tailPreProcess(ACSATensor4d *tensorOut, ACSATailMessage &tailMess, i
         ntiles *= out_w/2 +1;
 }
 
-/* API for winograd F(2,3). */
+/* Compute the stride of every transform point for bridge data. */
+    template<typename Dtype>
+static void bridgeStride(ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess, long &istride, long &fstride, long &ostride)
+{
+    const int N = tensorIn->n_;
+    const int C = tensorIn->c_;
+    const int K = tensorFilter->n_;
+    int ntiles;
+    ACSATailMessage tailMess;
+
+    tailPreProcess(tensorOut, tailMess, ntiles);
+
+    int b_bts = winoMess->batch_block_;
+    if(b_bts == 0 || b_bts > N)
+        b_bts = N;
+
+    // Depthwise keeps no bridge data, only the transformed filters
+    if(ACSAIsDepthwise(tensorIn, tensorFilter)){
+        istride = ostride = 0;
+        fstride = no4k_aligned((long)K, sizeof(Dtype));
+        return;
+    }
+
+    // The fused pipeline keeps its blocks after the filter, see ACSAWinoPipelineBytes
+    if(ACSAWinoFused(tensorIn, tensorOut, winoMess)){
+        istride = ostride = 0;
+        fstride = no4k_aligned((long)C*K, sizeof(Dtype));
+        return;
+    }
+
+    istride = no4k_aligned((long)b_bts*ntiles*C, sizeof(Dtype));
+    fstride = no4k_aligned((long)C*K, sizeof(Dtype));
+    ostride = no4k_aligned((long)b_bts*ntiles*K, sizeof(Dtype));
+}
+
+/* Winograd F(2,3) with the filter already transformed. */
     template<typename Dtype>
-ACSAStatus ACSAWinoConvolution_2x3(const Dtype *in, const Dtype *filter, Dtype *out,
+static ACSAStatus winoConvolution(const Dtype *in, const Dtype *wino_filter, const long fstride, const ACSAWinoFilter *wfilter,
+        Dtype *out,
         ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
-        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess)
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        Dtype *wino_in, const long istride, Dtype *wino_out, const long ostride,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
 {
+    // Depthwise has no gemm, the element-wise kernel takes any schedule and layout
+    if(ACSAIsDepthwise(tensorIn, tensorFilter))
+        return ACSAWinoDepthwise<Dtype, 2>(BT, AT, in, wino_filter, fstride, out,
+                tensorIn, tensorFilter, tensorOut, convMess,
+                bias, activMess, poolMess);
+
+    // Only the fused pipeline reads and writes layouts other than NCHW or 16-bit bridges,
+    // its blocks take the place of wino_out
+    if(ACSAWinoFused(tensorIn, tensorOut, winoMess))
+        return ACSAWinoPipeline<Dtype, 2>(BT, AT, in, wino_filter, fstride, wfilter, out,
+                tensorIn, tensorFilter, tensorOut, convMess, winoMess, (void *)wino_out,
+                bias, activMess, poolMess);
+
     const int N = tensorIn->n_;
     const int C = tensorIn->c_;
     const int H = tensorIn->h_;
@@ -791,20 +874,24 @@ ACSAStatus ACSAWinoConvolution_2x3(const Dtype *in, const Dtype *filter, Dtype *
 
     tailPreProcess(tensorOut, tailMess, ntiles);
 
+    Dtype slope, ceil;
+    ACSAActivParam(activMess, slope, ceil);
+
     const Dtype *b_in;
     Dtype *b_out;
 
     int b_bts = bb2x3;
-    if(b_bts == 0)
+    if(b_bts == 0 || b_bts > N)
         b_bts = N;
 
-    Dtype *wino_in = (Dtype *)winoIn;
-    Dtype *wino_filter = (Dtype *)winoFilter; 
-    Dtype *wino_out = (Dtype *)winoOut;
 
     // Check 
-    ACSA_CHECK((N%b_bts == 0));
-    ACSA_CHECK(((pad_h < 2) || (pad_w < 2)));
+    ACSA_CHECK(((pad_h < 2) && (pad_w < 2)));
+    if(poolMess != NULL)
+        ACSA_CHECK(ACSAPoolFusible(poolMess, outHeight, outWidth));
+
+    /* Pooled plane is a quarter of the convolution output. */
+    const int sizeO = (poolMess == NULL) ? outHeight*outWidth : (outHeight/2)*(outWidth/2);
 
     /* Get the needed threads number. */
     int num_threads;
@@ -814,70 +901,241 @@ ACSAStatus ACSAWinoConvolution_2x3(const Dtype *in, const Dtype *filter, Dtype *
         num_threads = omp_get_num_threads();
     }
 
-    filterByTransform(filter, wino_filter, C, K);
     for(int i = 0; i < N; i += b_bts){
+        // The last block takes the rest of the batch, and the merge
+        // falls back to 1 if it doesn't divide that block.
+        const int nb = std::min(b_bts, N-i);
+        const int mg = (nb%mg2x3 == 0) ? mg2x3 : 1;
+
         b_in = in + i*C*H*W;
-        b_out = out + i*K*outHeight*outWidth;
+        b_out = out + i*K*sizeO;
         if(pad_h == 0 && pad_w == 0)
-            inByTransform_nopad(b_in, wino_in, b_bts, C, H, W, &tailMess, ntiles, mg2x3);
+            inByTransform_nopad(b_in, wino_in, nb, C, H, W, &tailMess, ntiles, mg, istride);
         else if(H*W > 1225)
-            inByTransform_padBigScale(b_in, wino_in, b_bts, C, H, W, pad_h, pad_w, &tailMess, ntiles, mg2x3);
+            inByTransform_padBigScale(b_in, wino_in, nb, C, H, W, pad_h, pad_w, &tailMess, ntiles, mg, istride);
         else{
             Dtype *in_pad = (Dtype *)mkl_malloc(num_threads*(H+2*pad_h)*(W+2*pad_w)*sizeof(Dtype), 64);
             memset(in_pad, 0, num_threads*(H+2*pad_h)*(W+2*pad_w)*sizeof(Dtype));
-            inByTransform_padSmallScale(b_in, in_pad, wino_in, N, C, H, W, pad_h, pad_w, &tailMess, ntiles, mg2x3);
+            inByTransform_padSmallScale(b_in, in_pad, wino_in, nb, C, H, W, pad_h, pad_w, &tailMess, ntiles, mg, istride);
             mkl_free(in_pad);
         }
-        matrix_compute(wino_in, mg2x3*ntiles, C, wino_filter, C, K, wino_out, b_bts/mg2x3);
-        outByTransform(b_out, wino_out, b_bts, K, outHeight, outWidth, &tailMess, ntiles, mg2x3);
+        matrix_compute(wino_in, mg*ntiles, C, istride, wino_filter, C, K, fstride, wino_out, ostride, nb/mg, winoMess->gemm_);
+        if(poolMess == NULL)
+            outByTransform(b_out, wino_out, nb, K, outHeight, outWidth, &tailMess, ntiles, mg, ostride, bias, slope, ceil);
+        else
+            outByTransformPool(b_out, wino_out, nb, K, outHeight, outWidth, ntiles, mg, ostride, bias, slope, ceil);
     }
 
     return ACSASUCCESS;
 }
 
+/* Bytes of workspace needed by winograd F(2,3). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_2x3(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess)
+{
+    long istride, fstride, ostride;
+
+    bridgeStride<Dtype>(tensorIn, tensorFilter, tensorOut, winoMess, istride, fstride, ostride);
+    size = 16*(istride+fstride+ostride)*sizeof(Dtype) +
+        ACSAWinoPipelineBytes<Dtype>(2, 2, tensorIn, tensorFilter, tensorOut, winoMess, omp_get_max_threads());
+
+    return ACSASUCCESS;
+}
+
+/* API for winograd F(2,3). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_2x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    const int C = tensorFilter->c_;
+    const int K = tensorFilter->n_;
+    long istride, fstride, ostride;
+
+    bridgeStride<Dtype>(tensorIn, tensorFilter, tensorOut, winoMess, istride, fstride, ostride);
+
+    Dtype *wino_in = (Dtype *)ACSAReserveWorkspace(handle, 16*(istride+fstride+ostride)*sizeof(Dtype) +
+            ACSAWinoPipelineBytes<Dtype>(2, 2, tensorIn, tensorFilter, tensorOut, winoMess, handle->num_threads_));
+    if(wino_in == NULL)
+        return ACSAFAIL;
+    Dtype *wino_filter = wino_in + 16*istride;
+    Dtype *wino_out = wino_filter + 16*fstride;
+
+    const int nthreads = omp_get_max_threads();
+    omp_set_num_threads(handle->num_threads_);
+    filterByTransform(filter, wino_filter, C, K, fstride);
+    ACSAStatus ret = winoConvolution((const Dtype *)in, (const Dtype *)wino_filter, fstride, (const ACSAWinoFilter *)NULL, out,
+            tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+            wino_in, istride, wino_out, ostride,
+            bias, activMess, poolMess);
+    omp_set_num_threads(nthreads);
+
+    return ret;
+}
+
+/* API for winograd F(2,3) with the pre-transformed filter. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_2x3(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    long istride, fstride, ostride;
+
+    // Check
+    ACSA_CHECK((wfilter->algo_ == ACSA_WINOGRAD_2X3));
+    ACSA_CHECK(((wfilter->c_*convMess->groups_ == tensorIn->c_) && (wfilter->k_ == tensorFilter->n_)));
+    if(!ACSAWinoFilterFits<Dtype>(wfilter, winoMess)){
+        ACSA_MESSAGE("ERROR: The filter was transformed for another type or bridge!");
+        return ACSAFAIL;
+    }
+
+    bridgeStride<Dtype>(tensorIn, tensorFilter, tensorOut, winoMess, istride, fstride, ostride);
+
+    Dtype *wino_in = (Dtype *)ACSAReserveWorkspace(handle, 16*(istride+fstride+ostride)*sizeof(Dtype) +
+            ACSAWinoPipelineBytes<Dtype>(2, 2, tensorIn, tensorFilter, tensorOut, winoMess, handle->num_threads_));
+    if(wino_in == NULL)
+        return ACSAFAIL;
+    Dtype *wino_out = wino_in + 16*(istride+fstride);
+
+    const int nthreads = omp_get_max_threads();
+    omp_set_num_threads(handle->num_threads_);
+    ACSAStatus ret = winoConvolution(in, (const Dtype *)wfilter->data_, wfilter->stride_, wfilter, out,
+            tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+            wino_in, istride, wino_out, ostride,
+            bias, activMess, poolMess);
+    omp_set_num_threads(nthreads);
+
+    return ret;
+}
+
+/* Transform the filter of F(2,3) into the layout of bridge data. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoFilterTransform_2x3(const Dtype *filter, Dtype *wino_filter,
+        const int C, const int K, const long fstride)
+{
+    filterByTransform(filter, wino_filter, C, K, fstride);
+
+    return ACSASUCCESS;
+}
+
+/* Filter gradient of winograd F(2,3). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoBwdFilter_2x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess)
+{
+    return ACSAWinoBwdFilter<Dtype, 2>(BT, AT, G, handle, in, diffOut, diffFilter,
+            tensorIn, tensorFilter, tensorOut, convMess);
+}
+
 /* Instantiate Template */
 template void inByTransform_nopad<float>(const float *, float *,
         const int, const int, const int, const int,
-        ACSATailMessage *, const int, const int);
+        ACSATailMessage *, const int, const int, const long);
 template void inByTransform_padBigScale<float>(const float *, float *,
         const int, const int, const int, const int,
         const int, const int,
-        ACSATailMessage *, const int, const int);
+        ACSATailMessage *, const int, const int, const long);
 template void inByTransform_padSmallScale<float>(const float *, float *, float *,
         const int, const int, const int, const int,
         const int, const int,
-        ACSATailMessage *, const int, const int);
+        ACSATailMessage *, const int, const int, const long);
 template void filterByTransform<float>(const float *, float *,
-        const int, const int);
-template void matrix_compute<float>(const float *, const int, const int,
-        const float *, const int, const int,
-        float *, const int);
+        const int, const int, const long);
+template void matrix_compute<float>(const float *, const int, const int, const long,
+        const float *, const int, const int, const long,
+        float *, const long, const int, const ACSAGemmMode);
 template void outByTransform<float>(float *, const float *,
         const int, const int, const int, const int,
-        ACSATailMessage *, const int, const int);
-template ACSAStatus ACSAWinoConvolution_2x3<float>(const float *, const float *, float *,
+        ACSATailMessage *, const int, const int, const long,
+        const float *, const float, const float);
+template void outByTransformPool<float>(float *, const float *,
+        const int, const int, const int, const int,
+        const int, const int, const long,
+        const float *, const float, const float);
+template void bridgeStride<float>(ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*, long &, long &, long &);
+template ACSAStatus winoConvolution<float>(const float *, const float *, const long, const ACSAWinoFilter *,
+        float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        float *, const long, float *, const long,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoWorkspaceSize_2x3<float>(size_t &,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*);
+template ACSAStatus ACSAWinoConvolution_2x3<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoConvolution_2x3<float>(ACSAHandle *,
+        const float *, const ACSAWinoFilter *, float *,
         ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
-        ACSAConvMessage*, ACSAWinoMessage*);
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoFilterTransform_2x3<float>(const float *, float *,
+        const int, const int, const long);
+template ACSAStatus ACSAWinoBwdFilter_2x3<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
 
 template void inByTransform_nopad<double>(const double *, double *,
         const int, const int, const int, const int,
-        ACSATailMessage *, const int, const int);
+        ACSATailMessage *, const int, const int, const long);
 template void inByTransform_padBigScale<double>(const double *, double *,
         const int, const int, const int, const int,
         const int, const int,
-        ACSATailMessage *, const int, const int);
+        ACSATailMessage *, const int, const int, const long);
 template void inByTransform_padSmallScale<double>(const double *, double *,  double *,
         const int, const int, const int, const int,
         const int, const int,
-        ACSATailMessage *, const int, const int);
+        ACSATailMessage *, const int, const int, const long);
 template void filterByTransform<double>(const double *, double *,
-        const int, const int);
-template void matrix_compute<double>(const double *, const int, const int,
-        const double *, const int, const int,
-        double *, const int);
+        const int, const int, const long);
+template void matrix_compute<double>(const double *, const int, const int, const long,
+        const double *, const int, const int, const long,
+        double *, const long, const int, const ACSAGemmMode);
 template void outByTransform<double>(double *, const double *,
         const int, const int, const int, const int,
-        ACSATailMessage *, const int, const int);
-template ACSAStatus ACSAWinoConvolution_2x3<double>(const double *, const double *, double *,
+        ACSATailMessage *, const int, const int, const long,
+        const double *, const double, const double);
+template void outByTransformPool<double>(double *, const double *,
+        const int, const int, const int, const int,
+        const int, const int, const long,
+        const double *, const double, const double);
+template void bridgeStride<double>(ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*, long &, long &, long &);
+template ACSAStatus winoConvolution<double>(const double *, const double *, const long, const ACSAWinoFilter *,
+        double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        double *, const long, double *, const long,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoWorkspaceSize_2x3<double>(size_t &,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*);
+template ACSAStatus ACSAWinoConvolution_2x3<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoConvolution_2x3<double>(ACSAHandle *,
+        const double *, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoFilterTransform_2x3<double>(const double *, double *,
+        const int, const int, const long);
+template ACSAStatus ACSAWinoBwdFilter_2x3<double>(ACSAHandle *,
+        const double *, const double *, double *,
         ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
-        ACSAConvMessage*, ACSAWinoMessage*);
+        ACSAConvMessage*);
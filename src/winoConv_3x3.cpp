@@ -4,9 +4,6 @@
 
 #define ZERO_LENGTH(tail) (3-tail)%3
 
-const long ISTRIDE3X3 = ISTRIDE/25*16;
-const long FSTRIDE3X3 = FSTRIDE;
-const long OSTRIDE3X3 = OSTRIDE/25*16;
 
 /* AT-G-BT for F(3,3).
  * The dimensions for AT/G/BT.
@@ -158,7 +155,8 @@ const float BT[25] = {
     template <typename Dtype>
 static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
         const int N, const int C, const int rows, const int cols,
-        ACSATailMessage *tailMess, const int ntiles, const int mg3x3)
+        ACSATailMessage *tailMess, const int ntiles, const int mg3x3,
+        const long istride)
 {
     int d1, d2;
     int sizeI = rows * cols;
@@ -224,7 +222,7 @@ static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE3X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++; 
             }
 
@@ -234,7 +232,7 @@ static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE3X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++; 
             }
         }
@@ -275,7 +273,7 @@ static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE3X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++; 
             }
         }
@@ -314,7 +312,7 @@ static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE3X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++; 
             }
         }
@@ -325,7 +323,7 @@ static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
 
             // The tranformation manually simplified
             TRANS_BT_FST(BT, tmp, bridge);
-            TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE3X3);
+            TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
             tileCount++; 
         }
     }
@@ -338,7 +336,8 @@ static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
 static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
         const int N, const int C, const int rows, const int cols,
         const int pad_h, const int pad_w,
-        ACSATailMessage *tailMess, const int ntiles, const int mg3x3)
+        ACSATailMessage *tailMess, const int ntiles, const int mg3x3,
+        const long istride)
 {   
     int d1, d2;
     int rows_pad = rows + 2*pad_h;
@@ -414,7 +413,7 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE3X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++; 
             }
         }
@@ -451,7 +450,7 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 
             // Tranformation manually simplified
             TRANS_BT_FST(BT, tmp, bridge);
-            TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE3X3);
+            TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
             tileCount++;
         }
 
@@ -483,7 +482,7 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 
                 // Tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE3X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++;
             }
         }
@@ -506,7 +505,7 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 
                 // Tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE3X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++;
             }
         }
@@ -539,7 +538,7 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 
                 // Tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE3X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++;
             }
         }
@@ -551,7 +550,7 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 
             // Tranformation manually simplified
             TRANS_BT_FST(BT, tmp, bridge);
-            TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE3X3);
+            TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
             tileCount += col_nTiles;
         }
 
@@ -562,7 +561,7 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 
             // Tranformation manually simplified
             TRANS_BT_FST(BT, tmp, bridge);
-            TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE3X3);
+            TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
             tileCount += col_nTiles;
         }
 
@@ -570,27 +569,27 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
         tileCount = baseTileCount;
         ACSAGetInputTile(tmp, data, 5, 5, 0, 0, cols, 1, 0, 1, 0);
         TRANS_BT_FST(BT, tmp, bridge);
-        TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE3X3);
+        TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
 
         // Top Right Corner for third region
         tileCount = baseTileCount + col_nTiles -1;
         ACSAGetInputTile(tmp, data, 5, 5, 0, cols-4+ZERO_LENGTH(tail_w), cols, 1, 0, 0, ZERO_LENGTH(tail_w)+1);
         TRANS_BT_FST(BT, tmp, bridge);
-        TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE3X3);
+        TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
 
         // Bottom Left Corner for third region
         tileCount = baseTileCount + 
             (row_nTiles - 1)*(col_nTiles);
         ACSAGetInputTile(tmp, data, 5, 5, rows-4+ZERO_LENGTH(tail_h), 0, cols, 0, ZERO_LENGTH(tail_h)+1, 1, 0);
         TRANS_BT_FST(BT, tmp, bridge);
-        TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE3X3);
+        TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
 
         // Bottom Right Corner for third region
         tileCount = baseTileCount + 
             (row_nTiles)*(col_nTiles) - 1;
         ACSAGetInputTile(tmp, data, 5, 5, rows-4+ZERO_LENGTH(tail_h), cols-4+ZERO_LENGTH(tail_w), cols, 0, ZERO_LENGTH(tail_h)+1, 0, ZERO_LENGTH(tail_w)+1);
         TRANS_BT_FST(BT, tmp, bridge);
-        TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE3X3);
+        TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
     }
 }
 
@@ -601,7 +600,8 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *dataDst,
         const int N, const int C, const int rows, const int cols,
         const int pad_h, const int pad_w,
-        ACSATailMessage *tailMess, const int ntiles, const int mg3x3)
+        ACSATailMessage *tailMess, const int ntiles, const int mg3x3,
+        const long istride)
 {   
     int d1, d2;
     int rows_pad = rows + 2*pad_h;
@@ -677,7 +677,7 @@ static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *d
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE3X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
 
                 tileCount++; 
             }
@@ -688,7 +688,7 @@ static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *d
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE3X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++; 
             }
         }
@@ -729,7 +729,7 @@ static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *d
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE3X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
 
                 tileCount++; 
             }
@@ -769,7 +769,7 @@ static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *d
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE3X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
 
                 tileCount++; 
             }
@@ -781,7 +781,7 @@ static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *d
 
             // The tranformation manually simplified
             TRANS_BT_FST(BT, tmp, bridge);
-            TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE3X3);
+            TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
             tileCount++; 
         }
     }
@@ -790,7 +790,7 @@ static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *d
 /* Compute the bridge data for filter, and transform to form matrix B. */
     template <typename Dtype>
 static void filterByTransform(const Dtype *filter, Dtype *dataDst,
-        const int C, const int K)
+        const int C, const int K, const long fstride)
 {
     int d1, d2, d3; 
 
@@ -822,31 +822,31 @@ static void filterByTransform(const Dtype *filter, Dtype *dataDst,
             bridge[14] = G[12]*tmp[ 2] + G[13]*tmp[ 5] + G[14]*tmp[ 8];
 
             // Second transfrom filter data by G
-            dataDst[ 0*FSTRIDE3X3+d1*C+d2] = bridge[ 0]*G[ 0] + bridge[ 1]*G[ 1] + bridge[ 2]*G[ 2];
-            dataDst[ 1*FSTRIDE3X3+d1*C+d2] = bridge[ 0]*G[ 3] + bridge[ 1]*G[ 4] + bridge[ 2]*G[ 5];
-            dataDst[ 2*FSTRIDE3X3+d1*C+d2] = bridge[ 0]*G[ 6] + bridge[ 1]*G[ 7] + bridge[ 2]*G[ 8];
-            dataDst[ 3*FSTRIDE3X3+d1*C+d2] = bridge[ 0]*G[ 9] + bridge[ 1]*G[10] + bridge[ 2]*G[11];
-            dataDst[ 4*FSTRIDE3X3+d1*C+d2] = bridge[ 0]*G[12] + bridge[ 1]*G[13] + bridge[ 2]*G[14];
-            dataDst[ 5*FSTRIDE3X3+d1*C+d2] = bridge[ 3]*G[ 0] + bridge[ 4]*G[ 1] + bridge[ 5]*G[ 2];
-            dataDst[ 6*FSTRIDE3X3+d1*C+d2] = bridge[ 3]*G[ 3] + bridge[ 4]*G[ 4] + bridge[ 5]*G[ 5];
-            dataDst[ 7*FSTRIDE3X3+d1*C+d2] = bridge[ 3]*G[ 6] + bridge[ 4]*G[ 7] + bridge[ 5]*G[ 8];
-            dataDst[ 8*FSTRIDE3X3+d1*C+d2] = bridge[ 3]*G[ 9] + bridge[ 4]*G[10] + bridge[ 5]*G[11];
-            dataDst[ 9*FSTRIDE3X3+d1*C+d2] = bridge[ 3]*G[12] + bridge[ 4]*G[13] + bridge[ 5]*G[14];
-            dataDst[10*FSTRIDE3X3+d1*C+d2] = bridge[ 6]*G[ 0] + bridge[ 7]*G[ 1] + bridge[ 8]*G[ 2];
-            dataDst[11*FSTRIDE3X3+d1*C+d2] = bridge[ 6]*G[ 3] + bridge[ 7]*G[ 4] + bridge[ 8]*G[ 5];
-            dataDst[12*FSTRIDE3X3+d1*C+d2] = bridge[ 6]*G[ 6] + bridge[ 7]*G[ 7] + bridge[ 8]*G[ 8];
-            dataDst[13*FSTRIDE3X3+d1*C+d2] = bridge[ 6]*G[ 9] + bridge[ 7]*G[10] + bridge[ 8]*G[11];
-            dataDst[14*FSTRIDE3X3+d1*C+d2] = bridge[ 6]*G[12] + bridge[ 7]*G[13] + bridge[ 8]*G[14];
-            dataDst[15*FSTRIDE3X3+d1*C+d2] = bridge[ 9]*G[ 0] + bridge[10]*G[ 1] + bridge[11]*G[ 2];
-            dataDst[16*FSTRIDE3X3+d1*C+d2] = bridge[ 9]*G[ 3] + bridge[10]*G[ 4] + bridge[11]*G[ 5];
-            dataDst[17*FSTRIDE3X3+d1*C+d2] = bridge[ 9]*G[ 6] + bridge[10]*G[ 7] + bridge[11]*G[ 8];
-            dataDst[18*FSTRIDE3X3+d1*C+d2] = bridge[ 9]*G[ 9] + bridge[10]*G[10] + bridge[11]*G[11];
-            dataDst[19*FSTRIDE3X3+d1*C+d2] = bridge[ 9]*G[12] + bridge[10]*G[13] + bridge[11]*G[14];
-            dataDst[20*FSTRIDE3X3+d1*C+d2] = bridge[12]*G[ 0] + bridge[13]*G[ 1] + bridge[14]*G[ 2];
-            dataDst[21*FSTRIDE3X3+d1*C+d2] = bridge[12]*G[ 3] + bridge[13]*G[ 4] + bridge[14]*G[ 5];
-            dataDst[22*FSTRIDE3X3+d1*C+d2] = bridge[12]*G[ 6] + bridge[13]*G[ 7] + bridge[14]*G[ 8];
-            dataDst[23*FSTRIDE3X3+d1*C+d2] = bridge[12]*G[ 9] + bridge[13]*G[10] + bridge[14]*G[11];
-            dataDst[24*FSTRIDE3X3+d1*C+d2] = bridge[12]*G[12] + bridge[13]*G[13] + bridge[14]*G[14];
+            dataDst[ 0*fstride+d1*C+d2] = bridge[ 0]*G[ 0] + bridge[ 1]*G[ 1] + bridge[ 2]*G[ 2];
+            dataDst[ 1*fstride+d1*C+d2] = bridge[ 0]*G[ 3] + bridge[ 1]*G[ 4] + bridge[ 2]*G[ 5];
+            dataDst[ 2*fstride+d1*C+d2] = bridge[ 0]*G[ 6] + bridge[ 1]*G[ 7] + bridge[ 2]*G[ 8];
+            dataDst[ 3*fstride+d1*C+d2] = bridge[ 0]*G[ 9] + bridge[ 1]*G[10] + bridge[ 2]*G[11];
+            dataDst[ 4*fstride+d1*C+d2] = bridge[ 0]*G[12] + bridge[ 1]*G[13] + bridge[ 2]*G[14];
+            dataDst[ 5*fstride+d1*C+d2] = bridge[ 3]*G[ 0] + bridge[ 4]*G[ 1] + bridge[ 5]*G[ 2];
+            dataDst[ 6*fstride+d1*C+d2] = bridge[ 3]*G[ 3] + bridge[ 4]*G[ 4] + bridge[ 5]*G[ 5];
+            dataDst[ 7*fstride+d1*C+d2] = bridge[ 3]*G[ 6] + bridge[ 4]*G[ 7] + bridge[ 5]*G[ 8];
+            dataDst[ 8*fstride+d1*C+d2] = bridge[ 3]*G[ 9] + bridge[ 4]*G[10] + bridge[ 5]*G[11];
+            dataDst[ 9*fstride+d1*C+d2] = bridge[ 3]*G[12] + bridge[ 4]*G[13] + bridge[ 5]*G[14];
+            dataDst[10*fstride+d1*C+d2] = bridge[ 6]*G[ 0] + bridge[ 7]*G[ 1] + bridge[ 8]*G[ 2];
+            dataDst[11*fstride+d1*C+d2] = bridge[ 6]*G[ 3] + bridge[ 7]*G[ 4] + bridge[ 8]*G[ 5];
+            dataDst[12*fstride+d1*C+d2] = bridge[ 6]*G[ 6] + bridge[ 7]*G[ 7] + bridge[ 8]*G[ 8];
+            dataDst[13*fstride+d1*C+d2] = bridge[ 6]*G[ 9] + bridge[ 7]*G[10] + bridge[ 8]*G[11];
+            dataDst[14*fstride+d1*C+d2] = bridge[ 6]*G[12] + bridge[ 7]*G[13] + bridge[ 8]*G[14];
+            dataDst[15*fstride+d1*C+d2] = bridge[ 9]*G[ 0] + bridge[10]*G[ 1] + bridge[11]*G[ 2];
+            dataDst[16*fstride+d1*C+d2] = bridge[ 9]*G[ 3] + bridge[10]*G[ 4] + bridge[11]*G[ 5];
+            dataDst[17*fstride+d1*C+d2] = bridge[ 9]*G[ 6] + bridge[10]*G[ 7] + bridge[11]*G[ 8];
+            dataDst[18*fstride+d1*C+d2] = bridge[ 9]*G[ 9] + bridge[10]*G[10] + bridge[11]*G[11];
+            dataDst[19*fstride+d1*C+d2] = bridge[ 9]*G[12] + bridge[10]*G[13] + bridge[11]*G[14];
+            dataDst[20*fstride+d1*C+d2] = bridge[12]*G[ 0] + bridge[13]*G[ 1] + bridge[14]*G[ 2];
+            dataDst[21*fstride+d1*C+d2] = bridge[12]*G[ 3] + bridge[13]*G[ 4] + bridge[14]*G[ 5];
+            dataDst[22*fstride+d1*C+d2] = bridge[12]*G[ 6] + bridge[13]*G[ 7] + bridge[14]*G[ 8];
+            dataDst[23*fstride+d1*C+d2] = bridge[12]*G[ 9] + bridge[13]*G[10] + bridge[14]*G[11];
+            dataDst[24*fstride+d1*C+d2] = bridge[12]*G[12] + bridge[13]*G[13] + bridge[14]*G[14];
         }
     }
 }
@@ -855,47 +855,30 @@ static void filterByTransform(const Dtype *filter, Dtype *dataDst,
  * Number of sgemm calls is 25*BATCH.
  * */
     template <typename Dtype>
-static void matrix_compute(const Dtype* in, const int irows, const int icols,
-        const Dtype* filter, const int frows, const int fcols,
-        Dtype* out,
-        const int batch)
+static void matrix_compute(const Dtype* in, const int irows, const int icols, const long istride,
+        const Dtype* filter, const int frows, const int fcols, const long fstride,
+        Dtype* out, const long ostride,
+        const int batch, const ACSAGemmMode gemm)
 {
 
-    /* In - matrix A
+    /* In  - matrix A
      * Filter - matrix B
      * Output - matrix C
+     * All 25 points of every batch are issued as one batched gemm.
      * */
-    int d1, d2; 
-    const char trans ='n'; 
-    const float alpha_f = 1.0; 
-    const float beta_f =  0.0; 
-    const double alpha_d = 1.0; 
-    const double beta_d =  0.0; 
-    const int ldi = irows; 
-    const int ldf = frows; 
-    const int ldo = irows; 
-
-#pragma omp parallel for collapse(2) private(d2, d1) 
-    for(d1 = 0; d1 < 25; d1++){
-        for(d2 = 0; d2 < batch; d2++){
-            const Dtype* pin = in+d1*ISTRIDE3X3+d2*irows*icols; 
-            const Dtype* pft = filter+d1*FSTRIDE3X3; 
-            Dtype* pot = out+d1*OSTRIDE3X3+d2*irows*fcols; 
-            if(typeid(Dtype) == typeid(float))
-                sgemm(&trans, &trans, &irows, &fcols, &icols, &alpha_f, 
-                        (const float *)pin, &ldi, (const float *)pft, &ldf, &beta_f, (float *)pot, &ldo); 
-            else if(typeid(Dtype) == typeid(double))
-                dgemm(&trans, &trans, &irows, &fcols, &icols, &alpha_d, 
-                        (const double *)pin, &ldi, (const double *)pft, &ldf, &beta_d, (double *)pot, &ldo); 
-        }
-    }
+    if(gemm == ACSA_GEMM_KERNEL)
+        ACSAWinoGemm(in, irows, icols, istride, filter, fcols, fstride, out, ostride, 25, batch);
+    else
+        ACSABatchGemm(in, irows, icols, istride, filter, fcols, fstride, out, ostride, 25, batch);
 } 
 
 /* Compute the bridge data for out, and transform to form matrix C. */
     template <typename Dtype>
 static void outByTransform(Dtype *out, const Dtype *dataSrc,
         const int N, const int K, const int rows, const int cols,
-        ACSATailMessage *tailMess, const int ntiles, const int mg3x3)
+        ACSATailMessage *tailMess, const int ntiles, const int mg3x3,
+        const long ostride,
+        const Dtype *bias, const Dtype slope, const Dtype ceil)
 {
 
     int d1; 
@@ -923,36 +906,40 @@ static void outByTransform(Dtype *out, const Dtype *dataSrc,
         const int t3 = d1%mg3x3;
 
         Dtype *dataDst = out + (t1*mg3x3*K + t3*K + t2)*sizeO;
+
+        const Dtype bk = (bias == NULL) ? (Dtype)0 : bias[t2];
         int tileCount = d1*ntiles; 
 
         for(i = 0; i < rowSeg1; i += 3){
 #pragma simd
             // Process no tail
             for(j = 0; j < colSeg1; j += 3){
-                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, OSTRIDE3X3);
+                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, ostride);
                 // First inverse transform for output by AT
                 TRANS_AT_FST(AT, tmp, bridge);
                 // Second inverse transform for output by AT
-                dataDst[(i+0)*cols + (j+0)] = bridge[ 0]*AT[ 0] + bridge[ 1]*AT[ 1] + bridge[ 2]*AT[ 2] + bridge[ 3]*AT[ 3] + bridge[ 4]*AT[ 4];
-                dataDst[(i+0)*cols + (j+1)] = bridge[ 0]*AT[ 5] + bridge[ 1]*AT[ 6] + bridge[ 2]*AT[ 7] + bridge[ 3]*AT[ 8] + bridge[ 4]*AT[ 9];
-                dataDst[(i+0)*cols + (j+2)] = bridge[ 0]*AT[10] + bridge[ 1]*AT[11] + bridge[ 2]*AT[12] + bridge[ 3]*AT[13] + bridge[ 4]*AT[14];
-                dataDst[(i+1)*cols + (j+0)] = bridge[ 5]*AT[ 0] + bridge[ 6]*AT[ 1] + bridge[ 7]*AT[ 2] + bridge[ 8]*AT[ 3] + bridge[ 9]*AT[ 4];
-                dataDst[(i+1)*cols + (j+1)] = bridge[ 5]*AT[ 5] + bridge[ 6]*AT[ 6] + bridge[ 7]*AT[ 7] + bridge[ 8]*AT[ 8] + bridge[ 9]*AT[ 9];
-                dataDst[(i+1)*cols + (j+2)] = bridge[ 5]*AT[10] + bridge[ 6]*AT[11] + bridge[ 7]*AT[12] + bridge[ 8]*AT[13] + bridge[ 9]*AT[14];
-                dataDst[(i+2)*cols + (j+0)] = bridge[10]*AT[ 0] + bridge[11]*AT[ 1] + bridge[12]*AT[ 2] + bridge[13]*AT[ 3] + bridge[14]*AT[ 4];
-                dataDst[(i+2)*cols + (j+1)] = bridge[10]*AT[ 5] + bridge[11]*AT[ 6] + bridge[12]*AT[ 7] + bridge[13]*AT[ 8] + bridge[14]*AT[ 9];
-                dataDst[(i+2)*cols + (j+2)] = bridge[10]*AT[10] + bridge[11]*AT[11] + bridge[12]*AT[12] + bridge[13]*AT[13] + bridge[14]*AT[14];
+                dataDst[(i+0)*cols + (j+0)] = ACSAActivate<Dtype>(bridge[ 0]*AT[ 0] + bridge[ 1]*AT[ 1] + bridge[ 2]*AT[ 2] + bridge[ 3]*AT[ 3] + bridge[ 4]*AT[ 4], bk, slope, ceil);
+                dataDst[(i+0)*cols + (j+1)] = ACSAActivate<Dtype>(bridge[ 0]*AT[ 5] + bridge[ 1]*AT[ 6] + bridge[ 2]*AT[ 7] + bridge[ 3]*AT[ 8] + bridge[ 4]*AT[ 9], bk, slope, ceil);
+                dataDst[(i+0)*cols + (j+2)] = ACSAActivate<Dtype>(bridge[ 0]*AT[10] + bridge[ 1]*AT[11] + bridge[ 2]*AT[12] + bridge[ 3]*AT[13] + bridge[ 4]*AT[14], bk, slope, ceil);
+                dataDst[(i+1)*cols + (j+0)] = ACSAActivate<Dtype>(bridge[ 5]*AT[ 0] + bridge[ 6]*AT[ 1] + bridge[ 7]*AT[ 2] + bridge[ 8]*AT[ 3] + bridge[ 9]*AT[ 4], bk, slope, ceil);
+                dataDst[(i+1)*cols + (j+1)] = ACSAActivate<Dtype>(bridge[ 5]*AT[ 5] + bridge[ 6]*AT[ 6] + bridge[ 7]*AT[ 7] + bridge[ 8]*AT[ 8] + bridge[ 9]*AT[ 9], bk, slope, ceil);
+                dataDst[(i+1)*cols + (j+2)] = ACSAActivate<Dtype>(bridge[ 5]*AT[10] + bridge[ 6]*AT[11] + bridge[ 7]*AT[12] + bridge[ 8]*AT[13] + bridge[ 9]*AT[14], bk, slope, ceil);
+                dataDst[(i+2)*cols + (j+0)] = ACSAActivate<Dtype>(bridge[10]*AT[ 0] + bridge[11]*AT[ 1] + bridge[12]*AT[ 2] + bridge[13]*AT[ 3] + bridge[14]*AT[ 4], bk, slope, ceil);
+                dataDst[(i+2)*cols + (j+1)] = ACSAActivate<Dtype>(bridge[10]*AT[ 5] + bridge[11]*AT[ 6] + bridge[12]*AT[ 7] + bridge[13]*AT[ 8] + bridge[14]*AT[ 9], bk, slope, ceil);
+                dataDst[(i+2)*cols + (j+2)] = ACSAActivate<Dtype>(bridge[10]*AT[10] + bridge[11]*AT[11] + bridge[12]*AT[12] + bridge[13]*AT[13] + bridge[14]*AT[14], bk, slope, ceil);
                 tileCount++; 
             }
 
             // Process col tail
             if(colSeg2 != 0){
-                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, OSTRIDE3X3);
+                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, ostride);
                 // First inverse transform for output by AT
                 TRANS_AT_FST(AT, tmp, bridge);
                 // Second inverse transform for output by AT
                 TRANS_AT_SED(bridge, AT, middle);
 
+                ACSAActivateTile(middle, 9, bk, slope, ceil);
+
                 ACSAGetFinalOutput(dataDst, middle, 3, 3, i, j, cols, 0, 0, 0, ZERO_LENGTH(colSeg2));
                 tileCount++; 
             }
@@ -962,41 +949,43 @@ static void outByTransform(Dtype *out, const Dtype *dataSrc,
         if(rowSeg2 == 1){
 #pragma simd
             for(j = 0; j < colSeg1; j += 3){
-                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, OSTRIDE3X3);
+                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, ostride);
                 // First inverse transform for output by AT
                 TRANS_AT_FST(AT, tmp, bridge);
                 // Second inverse transform for output by AT
-                dataDst[(rowSeg1+0)*cols + (j+0)] = bridge[ 0]*AT[ 0] + bridge[ 1]*AT[ 1] + bridge[ 2]*AT[ 2] + bridge[ 3]*AT[ 3] + bridge[ 4]*AT[ 4];
-                dataDst[(rowSeg1+0)*cols + (j+1)] = bridge[ 0]*AT[ 5] + bridge[ 1]*AT[ 6] + bridge[ 2]*AT[ 7] + bridge[ 3]*AT[ 8] + bridge[ 4]*AT[ 9];
-                dataDst[(rowSeg1+0)*cols + (j+2)] = bridge[ 0]*AT[10] + bridge[ 1]*AT[11] + bridge[ 2]*AT[12] + bridge[ 3]*AT[13] + bridge[ 4]*AT[14];
+                dataDst[(rowSeg1+0)*cols + (j+0)] = ACSAActivate<Dtype>(bridge[ 0]*AT[ 0] + bridge[ 1]*AT[ 1] + bridge[ 2]*AT[ 2] + bridge[ 3]*AT[ 3] + bridge[ 4]*AT[ 4], bk, slope, ceil);
+                dataDst[(rowSeg1+0)*cols + (j+1)] = ACSAActivate<Dtype>(bridge[ 0]*AT[ 5] + bridge[ 1]*AT[ 6] + bridge[ 2]*AT[ 7] + bridge[ 3]*AT[ 8] + bridge[ 4]*AT[ 9], bk, slope, ceil);
+                dataDst[(rowSeg1+0)*cols + (j+2)] = ACSAActivate<Dtype>(bridge[ 0]*AT[10] + bridge[ 1]*AT[11] + bridge[ 2]*AT[12] + bridge[ 3]*AT[13] + bridge[ 4]*AT[14], bk, slope, ceil);
                 tileCount++; 
             }
         }
         else if(rowSeg2 == 2){
 #pragma simd
             for(j = 0; j < colSeg1; j += 3){
-                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, OSTRIDE3X3);
+                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, ostride);
                 // First inverse transform for output by AT
                 TRANS_AT_FST(AT, tmp, bridge);
                 // Second inverse transform for output by AT
-                dataDst[(rowSeg1+0)*cols + (j+0)] = bridge[ 0]*AT[ 0] + bridge[ 1]*AT[ 1] + bridge[ 2]*AT[ 2] + bridge[ 3]*AT[ 3] + bridge[ 4]*AT[ 4];
-                dataDst[(rowSeg1+0)*cols + (j+1)] = bridge[ 0]*AT[ 5] + bridge[ 1]*AT[ 6] + bridge[ 2]*AT[ 7] + bridge[ 3]*AT[ 8] + bridge[ 4]*AT[ 9];
-                dataDst[(rowSeg1+0)*cols + (j+2)] = bridge[ 0]*AT[10] + bridge[ 1]*AT[11] + bridge[ 2]*AT[12] + bridge[ 3]*AT[13] + bridge[ 4]*AT[14];
-                dataDst[(rowSeg1+1)*cols + (j+0)] = bridge[ 5]*AT[ 0] + bridge[ 6]*AT[ 1] + bridge[ 7]*AT[ 2] + bridge[ 8]*AT[ 3] + bridge[ 9]*AT[ 4];
-                dataDst[(rowSeg1+1)*cols + (j+1)] = bridge[ 5]*AT[ 5] + bridge[ 6]*AT[ 6] + bridge[ 7]*AT[ 7] + bridge[ 8]*AT[ 8] + bridge[ 9]*AT[ 9];
-                dataDst[(rowSeg1+1)*cols + (j+2)] = bridge[ 5]*AT[10] + bridge[ 6]*AT[11] + bridge[ 7]*AT[12] + bridge[ 8]*AT[13] + bridge[ 9]*AT[14];
+                dataDst[(rowSeg1+0)*cols + (j+0)] = ACSAActivate<Dtype>(bridge[ 0]*AT[ 0] + bridge[ 1]*AT[ 1] + bridge[ 2]*AT[ 2] + bridge[ 3]*AT[ 3] + bridge[ 4]*AT[ 4], bk, slope, ceil);
+                dataDst[(rowSeg1+0)*cols + (j+1)] = ACSAActivate<Dtype>(bridge[ 0]*AT[ 5] + bridge[ 1]*AT[ 6] + bridge[ 2]*AT[ 7] + bridge[ 3]*AT[ 8] + bridge[ 4]*AT[ 9], bk, slope, ceil);
+                dataDst[(rowSeg1+0)*cols + (j+2)] = ACSAActivate<Dtype>(bridge[ 0]*AT[10] + bridge[ 1]*AT[11] + bridge[ 2]*AT[12] + bridge[ 3]*AT[13] + bridge[ 4]*AT[14], bk, slope, ceil);
+                dataDst[(rowSeg1+1)*cols + (j+0)] = ACSAActivate<Dtype>(bridge[ 5]*AT[ 0] + bridge[ 6]*AT[ 1] + bridge[ 7]*AT[ 2] + bridge[ 8]*AT[ 3] + bridge[ 9]*AT[ 4], bk, slope, ceil);
+                dataDst[(rowSeg1+1)*cols + (j+1)] = ACSAActivate<Dtype>(bridge[ 5]*AT[ 5] + bridge[ 6]*AT[ 6] + bridge[ 7]*AT[ 7] + bridge[ 8]*AT[ 8] + bridge[ 9]*AT[ 9], bk, slope, ceil);
+                dataDst[(rowSeg1+1)*cols + (j+2)] = ACSAActivate<Dtype>(bridge[ 5]*AT[10] + bridge[ 6]*AT[11] + bridge[ 7]*AT[12] + bridge[ 8]*AT[13] + bridge[ 9]*AT[14], bk, slope, ceil);
                 tileCount++; 
             }
         }
 
         // Process row&col tail
         if((rowSeg2 != 0) && (colSeg2 != 0)){
-            GET_OUTPUT_TILE(tmp, dataSrc, tileCount, OSTRIDE3X3);
+            GET_OUTPUT_TILE(tmp, dataSrc, tileCount, ostride);
             // First inverse transfrom for output data by AT
             TRANS_AT_FST(AT, tmp, bridge);
             // Second inverse transfrom for output data by AT
             TRANS_AT_SED(bridge, AT, middle);
 
+            ACSAActivateTile(middle, 9, bk, slope, ceil);
+
             ACSAGetFinalOutput(dataDst, middle, 3, 3, rowSeg1, colSeg1, cols, 0, ZERO_LENGTH(rowSeg2), 0, ZERO_LENGTH(colSeg2));
             tileCount++; 
         }
@@ -1025,12 +1014,64 @@ static void tailPreProcess(ACSATensor4d *tensorOut, ACSATailMessage &tailMess, i
         ntiles *= out_w/3 +1;
 }
 
-/* API for winograd F(3,3). */
+/* Compute the stride of every transform point for bridge data. */
+    template<typename Dtype>
+static void bridgeStride(ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess, long &istride, long &fstride, long &ostride)
+{
+    const int N = tensorIn->n_;
+    const int C = tensorIn->c_;
+    const int K = tensorFilter->n_;
+    int ntiles;
+    ACSATailMessage tailMess;
+
+    tailPreProcess(tensorOut, tailMess, ntiles);
+
+    int b_bts = winoMess->batch_block_;
+    if(b_bts == 0 || b_bts > N)
+        b_bts = N;
+
+    // Depthwise keeps no bridge data, only the transformed filters
+    if(ACSAIsDepthwise(tensorIn, tensorFilter)){
+        istride = ostride = 0;
+        fstride = no4k_aligned((long)K, sizeof(Dtype));
+        return;
+    }
+
+    // The fused pipeline keeps its blocks after the filter, see ACSAWinoPipelineBytes
+    if(ACSAWinoFused(tensorIn, tensorOut, winoMess)){
+        istride = ostride = 0;
+        fstride = no4k_aligned((long)C*K, sizeof(Dtype));
+        return;
+    }
+
+    istride = no4k_aligned((long)b_bts*ntiles*C, sizeof(Dtype));
+    fstride = no4k_aligned((long)C*K, sizeof(Dtype));
+    ostride = no4k_aligned((long)b_bts*ntiles*K, sizeof(Dtype));
+}
+
+/* Winograd F(3,3) with the filter already transformed. */
     template <typename Dtype>
-ACSAStatus ACSAWinoConvolution_3x3(const Dtype *in, const Dtype *filter, Dtype *out,
+static ACSAStatus winoConvolution(const Dtype *in, const Dtype *wino_filter, const long fstride, const ACSAWinoFilter *wfilter,
+        Dtype *out,
         ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
-        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess)
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        Dtype *wino_in, const long istride, Dtype *wino_out, const long ostride,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
 {
+    // Depthwise has no gemm, the element-wise kernel takes any schedule and layout
+    if(ACSAIsDepthwise(tensorIn, tensorFilter))
+        return ACSAWinoDepthwise<Dtype, 3>(BT, AT, in, wino_filter, fstride, out,
+                tensorIn, tensorFilter, tensorOut, convMess,
+                bias, activMess, poolMess);
+
+    // Only the fused pipeline reads and writes layouts other than NCHW or 16-bit bridges,
+    // its blocks take the place of wino_out
+    if(ACSAWinoFused(tensorIn, tensorOut, winoMess))
+        return ACSAWinoPipeline<Dtype, 3>(BT, AT, in, wino_filter, fstride, wfilter, out,
+                tensorIn, tensorFilter, tensorOut, convMess, winoMess, (void *)wino_out,
+                bias, activMess, poolMess);
+
     const int N = tensorIn->n_;
     const int C = tensorIn->c_;
     const int H = tensorIn->h_;
@@ -1049,20 +1090,25 @@ ACSAStatus ACSAWinoConvolution_3x3(const Dtype *in, const Dtype *filter, Dtype *
 
     tailPreProcess(tensorOut, tailMess, ntiles);
 
+    Dtype slope, ceil;
+    ACSAActivParam(activMess, slope, ceil);
+
     const Dtype *b_in;
     Dtype *b_out;
 
     int b_bts = bb3x3;
-    if(b_bts == 0)
+    if(b_bts == 0 || b_bts > N)
         b_bts = N;
 
-    Dtype *wino_in = (Dtype *)winoIn;
-    Dtype *wino_filter = (Dtype *)winoFilter; 
-    Dtype *wino_out = (Dtype *)winoOut;
 
     // Check 
-    ACSA_CHECK((N%b_bts == 0));
-    ACSA_CHECK(((pad_h < 2) || (pad_w < 2)));
+    ACSA_CHECK(((pad_h < 2) && (pad_w < 2)));
+
+    /* 3x3 output tiles straddle the 2x2 pooling windows. */
+    if(poolMess != NULL){
+        ACSA_MESSAGE("ERROR: Winograd F(3,3) can not fuse pooling!\n");
+        return ACSAFAIL;
+    }
 
     /* Get the needed threads number. */
     int num_threads;
@@ -1072,70 +1118,230 @@ ACSAStatus ACSAWinoConvolution_3x3(const Dtype *in, const Dtype *filter, Dtype *
         num_threads = omp_get_num_threads();
     }
 
-    filterByTransform(filter, wino_filter, C, K);
     for(int i = 0; i < N; i += b_bts){
+        // The last block takes the rest of the batch, and the merge
+        // falls back to 1 if it doesn't divide that block.
+        const int nb = std::min(b_bts, N-i);
+        const int mg = (nb%mg3x3 == 0) ? mg3x3 : 1;
+
         b_in = in + i*C*H*W;
         b_out = out + i*K*outHeight*outWidth;
         if(pad_h == 0 && pad_w == 0)
-            inByTransform_nopad(b_in, wino_in, b_bts, C, H, W, &tailMess, ntiles, mg3x3);
+            inByTransform_nopad(b_in, wino_in, nb, C, H, W, &tailMess, ntiles, mg, istride);
         else if(H*W > 1225)
-            inByTransform_padBigScale(b_in, wino_in, b_bts, C, H, W, pad_h, pad_w, &tailMess, ntiles, mg3x3);
+            inByTransform_padBigScale(b_in, wino_in, nb, C, H, W, pad_h, pad_w, &tailMess, ntiles, mg, istride);
         else{
             Dtype *in_pad = (Dtype *)mkl_malloc(num_threads*(H+2*pad_h)*(W+2*pad_w)*sizeof(Dtype), 64);
             memset(in_pad, 0, num_threads*(H+2*pad_h)*(W+2*pad_w)*sizeof(Dtype));
-            inByTransform_padSmallScale(b_in, in_pad, wino_in, N, C, H, W, pad_h, pad_w, &tailMess, ntiles, mg3x3);
+            inByTransform_padSmallScale(b_in, in_pad, wino_in, nb, C, H, W, pad_h, pad_w, &tailMess, ntiles, mg, istride);
             mkl_free(in_pad);
         }
-        matrix_compute(wino_in, mg3x3*ntiles, C, wino_filter, C, K, wino_out, b_bts/mg3x3);
-        outByTransform(b_out, wino_out, b_bts, K, outHeight, outWidth, &tailMess, ntiles, mg3x3);
+        matrix_compute(wino_in, mg*ntiles, C, istride, wino_filter, C, K, fstride, wino_out, ostride, nb/mg, winoMess->gemm_);
+        outByTransform(b_out, wino_out, nb, K, outHeight, outWidth, &tailMess, ntiles, mg, ostride, bias, slope, ceil);
+    }
+
+    return ACSASUCCESS;
+}
+
+/* Bytes of workspace needed by winograd F(3,3). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_3x3(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess)
+{
+    long istride, fstride, ostride;
+
+    bridgeStride<Dtype>(tensorIn, tensorFilter, tensorOut, winoMess, istride, fstride, ostride);
+    size = 25*(istride+fstride+ostride)*sizeof(Dtype) +
+        ACSAWinoPipelineBytes<Dtype>(3, 3, tensorIn, tensorFilter, tensorOut, winoMess, omp_get_max_threads());
+
+    return ACSASUCCESS;
+}
+
+/* API for winograd F(3,3). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_3x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    const int C = tensorFilter->c_;
+    const int K = tensorFilter->n_;
+    long istride, fstride, ostride;
+
+    bridgeStride<Dtype>(tensorIn, tensorFilter, tensorOut, winoMess, istride, fstride, ostride);
+
+    Dtype *wino_in = (Dtype *)ACSAReserveWorkspace(handle, 25*(istride+fstride+ostride)*sizeof(Dtype) +
+            ACSAWinoPipelineBytes<Dtype>(3, 3, tensorIn, tensorFilter, tensorOut, winoMess, handle->num_threads_));
+    if(wino_in == NULL)
+        return ACSAFAIL;
+    Dtype *wino_filter = wino_in + 25*istride;
+    Dtype *wino_out = wino_filter + 25*fstride;
+
+    const int nthreads = omp_get_max_threads();
+    omp_set_num_threads(handle->num_threads_);
+    filterByTransform(filter, wino_filter, C, K, fstride);
+    ACSAStatus ret = winoConvolution((const Dtype *)in, (const Dtype *)wino_filter, fstride, (const ACSAWinoFilter *)NULL, out,
+            tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+            wino_in, istride, wino_out, ostride,
+            bias, activMess, poolMess);
+    omp_set_num_threads(nthreads);
+
+    return ret;
+}
+
+/* API for winograd F(3,3) with the pre-transformed filter. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_3x3(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    long istride, fstride, ostride;
+
+    // Check
+    ACSA_CHECK((wfilter->algo_ == ACSA_WINOGRAD_3X3));
+    ACSA_CHECK(((wfilter->c_*convMess->groups_ == tensorIn->c_) && (wfilter->k_ == tensorFilter->n_)));
+    if(!ACSAWinoFilterFits<Dtype>(wfilter, winoMess)){
+        ACSA_MESSAGE("ERROR: The filter was transformed for another type or bridge!");
+        return ACSAFAIL;
     }
 
+    bridgeStride<Dtype>(tensorIn, tensorFilter, tensorOut, winoMess, istride, fstride, ostride);
+
+    Dtype *wino_in = (Dtype *)ACSAReserveWorkspace(handle, 25*(istride+fstride+ostride)*sizeof(Dtype) +
+            ACSAWinoPipelineBytes<Dtype>(3, 3, tensorIn, tensorFilter, tensorOut, winoMess, handle->num_threads_));
+    if(wino_in == NULL)
+        return ACSAFAIL;
+    Dtype *wino_out = wino_in + 25*(istride+fstride);
+
+    const int nthreads = omp_get_max_threads();
+    omp_set_num_threads(handle->num_threads_);
+    ACSAStatus ret = winoConvolution(in, (const Dtype *)wfilter->data_, wfilter->stride_, wfilter, out,
+            tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+            wino_in, istride, wino_out, ostride,
+            bias, activMess, poolMess);
+    omp_set_num_threads(nthreads);
+
+    return ret;
+}
+
+/* Transform the filter of F(3,3) into the layout of bridge data. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoFilterTransform_3x3(const Dtype *filter, Dtype *wino_filter,
+        const int C, const int K, const long fstride)
+{
+    filterByTransform(filter, wino_filter, C, K, fstride);
+
     return ACSASUCCESS;
 }
 
+/* Filter gradient of winograd F(3,3). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoBwdFilter_3x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess)
+{
+    return ACSAWinoBwdFilter<Dtype, 3>(BT, AT, G, handle, in, diffOut, diffFilter,
+            tensorIn, tensorFilter, tensorOut, convMess);
+}
+
 /* Instantiate Template */
 template void inByTransform_nopad<float>(const float *, float *,
         const int, const int, const int, const int,
-        ACSATailMessage *, const int, const int);
+        ACSATailMessage *, const int, const int, const long);
 template void inByTransform_padBigScale<float>(const float *, float *,
         const int, const int, const int, const int,
         const int, const int,
-        ACSATailMessage *, const int, const int);
+        ACSATailMessage *, const int, const int, const long);
 template void inByTransform_padSmallScale<float>(const float *, float *, float *,
         const int, const int, const int, const int,
         const int, const int,
-        ACSATailMessage *, const int, const int);
+        ACSATailMessage *, const int, const int, const long);
 template void filterByTransform<float>(const float *, float *,
-        const int, const int);
-template void matrix_compute<float>(const float *, const int, const int,
-        const float *, const int, const int,
-        float *, const int);
+        const int, const int, const long);
+template void matrix_compute<float>(const float *, const int, const int, const long,
+        const float *, const int, const int, const long,
+        float *, const long, const int, const ACSAGemmMode);
 template void outByTransform<float>(float *, const float *,
         const int, const int, const int, const int,
-        ACSATailMessage *, const int, const int);
-template ACSAStatus ACSAWinoConvolution_3x3<float>(const float *, const float *, float *,
+        ACSATailMessage *, const int, const int, const long,
+        const float *, const float, const float);
+template void bridgeStride<float>(ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*, long &, long &, long &);
+template ACSAStatus winoConvolution<float>(const float *, const float *, const long, const ACSAWinoFilter *,
+        float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        float *, const long, float *, const long,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoWorkspaceSize_3x3<float>(size_t &,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*);
+template ACSAStatus ACSAWinoConvolution_3x3<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoConvolution_3x3<float>(ACSAHandle *,
+        const float *, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoFilterTransform_3x3<float>(const float *, float *,
+        const int, const int, const long);
+template ACSAStatus ACSAWinoBwdFilter_3x3<float>(ACSAHandle *,
+        const float *, const float *, float *,
         ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
-        ACSAConvMessage*, ACSAWinoMessage*);
+        ACSAConvMessage*);
 
 template void inByTransform_nopad<double>(const double *, double *,
         const int, const int, const int, const int,
-        ACSATailMessage *, const int, const int);
+        ACSATailMessage *, const int, const int, const long);
 template void inByTransform_padBigScale<double>(const double *, double *,
         const int, const int, const int, const int,
         const int, const int,
-        ACSATailMessage *, const int, const int);
+        ACSATailMessage *, const int, const int, const long);
 template void inByTransform_padSmallScale<double>(const double *, double *,  double *,
         const int, const int, const int, const int,
         const int, const int,
-        ACSATailMessage *, const int, const int);
+        ACSATailMessage *, const int, const int, const long);
 template void filterByTransform<double>(const double *, double *,
-        const int, const int);
-template void matrix_compute<double>(const double *, const int, const int,
-        const double *, const int, const int,
-        double *, const int);
+        const int, const int, const long);
+template void matrix_compute<double>(const double *, const int, const int, const long,
+        const double *, const int, const int, const long,
+        double *, const long, const int, const ACSAGemmMode);
 template void outByTransform<double>(double *, const double *,
         const int, const int, const int, const int,
-        ACSATailMessage *, const int, const int);
-template ACSAStatus ACSAWinoConvolution_3x3<double>(const double *, const double *, double *,
+        ACSATailMessage *, const int, const int, const long,
+        const double *, const double, const double);
+template void bridgeStride<double>(ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*, long &, long &, long &);
+template ACSAStatus winoConvolution<double>(const double *, const double *, const long, const ACSAWinoFilter *,
+        double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        double *, const long, double *, const long,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoWorkspaceSize_3x3<double>(size_t &,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*);
+template ACSAStatus ACSAWinoConvolution_3x3<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoConvolution_3x3<double>(ACSAHandle *,
+        const double *, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoFilterTransform_3x3<double>(const double *, double *,
+        const int, const int, const long);
+template ACSAStatus ACSAWinoBwdFilter_3x3<double>(ACSAHandle *,
+        const double *, const double *, double *,
         ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
-        ACSAConvMessage*, ACSAWinoMessage*);
+        ACSAConvMessage*);
@@ -5,9 +5,6 @@
 
 #define ZERO_LENGTH(tail) (4-tail)%4
 
-const long ISTRIDE4X3 = ISTRIDE/36*16;
-const long FSTRIDE4X3 = FSTRIDE;
-const long OSTRIDE4X3 = OSTRIDE/36*16;
 
 /* AT-G-BT for F(4,3).
  * The dimensions for AT/G/BT.
@@ -40,86 +37,90 @@ const float BT[36] = {
     0,  4,  0, -5, 0, 1
 };
 
-// Twice transform for input data to get tiles
+/* y = BT*x along one dimension of the tile, x and y are strided by sx and sy.
+ * Only the nonzeros of BT are computed, 12 adds and 7 scales instead of 36 fma.
+ * V is a scalar or a vector holding the same element of several tiles.
+ * */
+template<typename V>
+static inline void bt_1d(const V *x, const int sx, V *y, const int sy)
+{
+    const V t0 = x[4*sx] - 4*x[2*sx];
+    const V t1 = x[3*sx] - 4*x[1*sx];
+    const V t2 = x[4*sx] - x[2*sx];
+    const V t3 = 2*(x[3*sx] - x[1*sx]);
+
+    y[0*sy] = 4*x[0*sx] - 5*x[2*sx] + x[4*sx];
+    y[1*sy] = t0 + t1;
+    y[2*sy] = t0 - t1;
+    y[3*sy] = t2 + t3;
+    y[4*sy] = t2 - t3;
+    y[5*sy] = 4*x[1*sx] - 5*x[3*sx] + x[5*sx];
+}
+
+// Twice transform for input data to get tiles, the BT argument is kept for
+// the callers, the sparse structure of BT is unrolled in bt_1d.
 #define TRANS_BT_FST(A, B, C) \
 { \
-    C[ 0] = A[ 0]*B[ 0] + A[ 1]*B[ 6] + A[ 2]*B[12] + A[ 3]*B[18] + A[ 4]*B[24] + A[ 5]*B[30]; \
-    C[ 1] = A[ 0]*B[ 1] + A[ 1]*B[ 7] + A[ 2]*B[13] + A[ 3]*B[19] + A[ 4]*B[25] + A[ 5]*B[31]; \
-    C[ 2] = A[ 0]*B[ 2] + A[ 1]*B[ 8] + A[ 2]*B[14] + A[ 3]*B[20] + A[ 4]*B[26] + A[ 5]*B[32]; \
-    C[ 3] = A[ 0]*B[ 3] + A[ 1]*B[ 9] + A[ 2]*B[15] + A[ 3]*B[21] + A[ 4]*B[27] + A[ 5]*B[33]; \
-    C[ 4] = A[ 0]*B[ 4] + A[ 1]*B[10] + A[ 2]*B[16] + A[ 3]*B[22] + A[ 4]*B[28] + A[ 5]*B[34]; \
-    C[ 5] = A[ 0]*B[ 5] + A[ 1]*B[11] + A[ 2]*B[17] + A[ 3]*B[23] + A[ 4]*B[29] + A[ 5]*B[35]; \
-    C[ 6] = A[ 6]*B[ 0] + A[ 7]*B[ 6] + A[ 8]*B[12] + A[ 9]*B[18] + A[10]*B[24] + A[11]*B[30]; \
-    C[ 7] = A[ 6]*B[ 1] + A[ 7]*B[ 7] + A[ 8]*B[13] + A[ 9]*B[19] + A[10]*B[25] + A[11]*B[31]; \
-    C[ 8] = A[ 6]*B[ 2] + A[ 7]*B[ 8] + A[ 8]*B[14] + A[ 9]*B[20] + A[10]*B[26] + A[11]*B[32]; \
-    C[ 9] = A[ 6]*B[ 3] + A[ 7]*B[ 9] + A[ 8]*B[15] + A[ 9]*B[21] + A[10]*B[27] + A[11]*B[33]; \
-    C[10] = A[ 6]*B[ 4] + A[ 7]*B[10] + A[ 8]*B[16] + A[ 9]*B[22] + A[10]*B[28] + A[11]*B[34]; \
-    C[11] = A[ 6]*B[ 5] + A[ 7]*B[11] + A[ 8]*B[17] + A[ 9]*B[23] + A[10]*B[29] + A[11]*B[35]; \
-    C[12] = A[12]*B[ 0] + A[13]*B[ 6] + A[14]*B[12] + A[15]*B[18] + A[16]*B[24] + A[17]*B[30]; \
-    C[13] = A[12]*B[ 1] + A[13]*B[ 7] + A[14]*B[13] + A[15]*B[19] + A[16]*B[25] + A[17]*B[31]; \
-    C[14] = A[12]*B[ 2] + A[13]*B[ 8] + A[14]*B[14] + A[15]*B[20] + A[16]*B[26] + A[17]*B[32]; \
-    C[15] = A[12]*B[ 3] + A[13]*B[ 9] + A[14]*B[15] + A[15]*B[21] + A[16]*B[27] + A[17]*B[33]; \
-    C[16] = A[12]*B[ 4] + A[13]*B[10] + A[14]*B[16] + A[15]*B[22] + A[16]*B[28] + A[17]*B[34]; \
-    C[17] = A[12]*B[ 5] + A[13]*B[11] + A[14]*B[17] + A[15]*B[23] + A[16]*B[29] + A[17]*B[35]; \
-    C[18] = A[18]*B[ 0] + A[19]*B[ 6] + A[20]*B[12] + A[21]*B[18] + A[22]*B[24] + A[23]*B[30]; \
-    C[19] = A[18]*B[ 1] + A[19]*B[ 7] + A[20]*B[13] + A[21]*B[19] + A[22]*B[25] + A[23]*B[31]; \
-    C[20] = A[18]*B[ 2] + A[19]*B[ 8] + A[20]*B[14] + A[21]*B[20] + A[22]*B[26] + A[23]*B[32]; \
-    C[21] = A[18]*B[ 3] + A[19]*B[ 9] + A[20]*B[15] + A[21]*B[21] + A[22]*B[27] + A[23]*B[33]; \
-    C[22] = A[18]*B[ 4] + A[19]*B[10] + A[20]*B[16] + A[21]*B[22] + A[22]*B[28] + A[23]*B[34]; \
-    C[23] = A[18]*B[ 5] + A[19]*B[11] + A[20]*B[17] + A[21]*B[23] + A[22]*B[29] + A[23]*B[35]; \
-    C[24] = A[24]*B[ 0] + A[25]*B[ 6] + A[26]*B[12] + A[27]*B[18] + A[28]*B[24] + A[29]*B[30]; \
-    C[25] = A[24]*B[ 1] + A[25]*B[ 7] + A[26]*B[13] + A[27]*B[19] + A[28]*B[25] + A[29]*B[31]; \
-    C[26] = A[24]*B[ 2] + A[25]*B[ 8] + A[26]*B[14] + A[27]*B[20] + A[28]*B[26] + A[29]*B[32]; \
-    C[27] = A[24]*B[ 3] + A[25]*B[ 9] + A[26]*B[15] + A[27]*B[21] + A[28]*B[27] + A[29]*B[33]; \
-    C[28] = A[24]*B[ 4] + A[25]*B[10] + A[26]*B[16] + A[27]*B[22] + A[28]*B[28] + A[29]*B[34]; \
-    C[29] = A[24]*B[ 5] + A[25]*B[11] + A[26]*B[17] + A[27]*B[23] + A[28]*B[29] + A[29]*B[35]; \
-    C[30] = A[30]*B[ 0] + A[31]*B[ 6] + A[32]*B[12] + A[33]*B[18] + A[34]*B[24] + A[35]*B[30]; \
-    C[31] = A[30]*B[ 1] + A[31]*B[ 7] + A[32]*B[13] + A[33]*B[19] + A[34]*B[25] + A[35]*B[31]; \
-    C[32] = A[30]*B[ 2] + A[31]*B[ 8] + A[32]*B[14] + A[33]*B[20] + A[34]*B[26] + A[35]*B[32]; \
-    C[33] = A[30]*B[ 3] + A[31]*B[ 9] + A[32]*B[15] + A[33]*B[21] + A[34]*B[27] + A[35]*B[33]; \
-    C[34] = A[30]*B[ 4] + A[31]*B[10] + A[32]*B[16] + A[33]*B[22] + A[34]*B[28] + A[35]*B[34]; \
-    C[35] = A[30]*B[ 5] + A[31]*B[11] + A[32]*B[17] + A[33]*B[23] + A[34]*B[29] + A[35]*B[35]; \
+    for(int _j = 0; _j < 6; _j++) \
+        bt_1d(B + _j, 6, C + _j, 6); \
 }
 
 #define TRANS_BT_SED(A, B, C, TC, ST) \
 { \
-    C[TC +  0*ST] = A[ 0]*B[ 0] + A[ 1]*B[ 1] + A[ 2]*B[ 2] + A[ 3]*B[ 3] + A[ 4]*B[ 4] + A[ 5]*B[ 5]; \
-    C[TC +  1*ST] = A[ 0]*B[ 6] + A[ 1]*B[ 7] + A[ 2]*B[ 8] + A[ 3]*B[ 9] + A[ 4]*B[10] + A[ 5]*B[11]; \
-    C[TC +  2*ST] = A[ 0]*B[12] + A[ 1]*B[13] + A[ 2]*B[14] + A[ 3]*B[15] + A[ 4]*B[16] + A[ 5]*B[17]; \
-    C[TC +  3*ST] = A[ 0]*B[18] + A[ 1]*B[19] + A[ 2]*B[20] + A[ 3]*B[21] + A[ 4]*B[22] + A[ 5]*B[23]; \
-    C[TC +  4*ST] = A[ 0]*B[24] + A[ 1]*B[25] + A[ 2]*B[26] + A[ 3]*B[27] + A[ 4]*B[28] + A[ 5]*B[29]; \
-    C[TC +  5*ST] = A[ 0]*B[30] + A[ 1]*B[31] + A[ 2]*B[32] + A[ 3]*B[33] + A[ 4]*B[34] + A[ 5]*B[35]; \
-    C[TC +  6*ST] = A[ 6]*B[ 0] + A[ 7]*B[ 1] + A[ 8]*B[ 2] + A[ 9]*B[ 3] + A[10]*B[ 4] + A[11]*B[ 5]; \
-    C[TC +  7*ST] = A[ 6]*B[ 6] + A[ 7]*B[ 7] + A[ 8]*B[ 8] + A[ 9]*B[ 9] + A[10]*B[10] + A[11]*B[11]; \
-    C[TC +  8*ST] = A[ 6]*B[12] + A[ 7]*B[13] + A[ 8]*B[14] + A[ 9]*B[15] + A[10]*B[16] + A[11]*B[17]; \
-    C[TC +  9*ST] = A[ 6]*B[18] + A[ 7]*B[19] + A[ 8]*B[20] + A[ 9]*B[21] + A[10]*B[22] + A[11]*B[23]; \
-    C[TC + 10*ST] = A[ 6]*B[24] + A[ 7]*B[25] + A[ 8]*B[26] + A[ 9]*B[27] + A[10]*B[28] + A[11]*B[29]; \
-    C[TC + 11*ST] = A[ 6]*B[30] + A[ 7]*B[31] + A[ 8]*B[32] + A[ 9]*B[33] + A[10]*B[34] + A[11]*B[35]; \
-    C[TC + 12*ST] = A[12]*B[ 0] + A[13]*B[ 1] + A[14]*B[ 2] + A[15]*B[ 3] + A[16]*B[ 4] + A[17]*B[ 5]; \
-    C[TC + 13*ST] = A[12]*B[ 6] + A[13]*B[ 7] + A[14]*B[ 8] + A[15]*B[ 9] + A[16]*B[10] + A[17]*B[11]; \
-    C[TC + 14*ST] = A[12]*B[12] + A[13]*B[13] + A[14]*B[14] + A[15]*B[15] + A[16]*B[16] + A[17]*B[17]; \
-    C[TC + 15*ST] = A[12]*B[18] + A[13]*B[19] + A[14]*B[20] + A[15]*B[21] + A[16]*B[22] + A[17]*B[23]; \
-    C[TC + 16*ST] = A[12]*B[24] + A[13]*B[25] + A[14]*B[26] + A[15]*B[27] + A[16]*B[28] + A[17]*B[29]; \
-    C[TC + 17*ST] = A[12]*B[30] + A[13]*B[31] + A[14]*B[32] + A[15]*B[33] + A[16]*B[34] + A[17]*B[35]; \
-    C[TC + 18*ST] = A[18]*B[ 0] + A[19]*B[ 1] + A[20]*B[ 2] + A[21]*B[ 3] + A[22]*B[ 4] + A[23]*B[ 5]; \
-    C[TC + 19*ST] = A[18]*B[ 6] + A[19]*B[ 7] + A[20]*B[ 8] + A[21]*B[ 9] + A[22]*B[10] + A[23]*B[11]; \
-    C[TC + 20*ST] = A[18]*B[12] + A[19]*B[13] + A[20]*B[14] + A[21]*B[15] + A[22]*B[16] + A[23]*B[17]; \
-    C[TC + 21*ST] = A[18]*B[18] + A[19]*B[19] + A[20]*B[20] + A[21]*B[21] + A[22]*B[22] + A[23]*B[23]; \
-    C[TC + 22*ST] = A[18]*B[24] + A[19]*B[25] + A[20]*B[26] + A[21]*B[27] + A[22]*B[28] + A[23]*B[29]; \
-    C[TC + 23*ST] = A[18]*B[30] + A[19]*B[31] + A[20]*B[32] + A[21]*B[33] + A[22]*B[34] + A[23]*B[35]; \
-    C[TC + 24*ST] = A[24]*B[ 0] + A[25]*B[ 1] + A[26]*B[ 2] + A[27]*B[ 3] + A[28]*B[ 4] + A[29]*B[ 5]; \
-    C[TC + 25*ST] = A[24]*B[ 6] + A[25]*B[ 7] + A[26]*B[ 8] + A[27]*B[ 9] + A[28]*B[10] + A[29]*B[11]; \
-    C[TC + 26*ST] = A[24]*B[12] + A[25]*B[13] + A[26]*B[14] + A[27]*B[15] + A[28]*B[16] + A[29]*B[17]; \
-    C[TC + 27*ST] = A[24]*B[18] + A[25]*B[19] + A[26]*B[20] + A[27]*B[21] + A[28]*B[22] + A[29]*B[23]; \
-    C[TC + 28*ST] = A[24]*B[24] + A[25]*B[25] + A[26]*B[26] + A[27]*B[27] + A[28]*B[28] + A[29]*B[29]; \
-    C[TC + 29*ST] = A[24]*B[30] + A[25]*B[31] + A[26]*B[32] + A[27]*B[33] + A[28]*B[34] + A[29]*B[35]; \
-    C[TC + 30*ST] = A[30]*B[ 0] + A[31]*B[ 1] + A[32]*B[ 2] + A[33]*B[ 3] + A[34]*B[ 4] + A[35]*B[ 5]; \
-    C[TC + 31*ST] = A[30]*B[ 6] + A[31]*B[ 7] + A[32]*B[ 8] + A[33]*B[ 9] + A[34]*B[10] + A[35]*B[11]; \
-    C[TC + 32*ST] = A[30]*B[12] + A[31]*B[13] + A[32]*B[14] + A[33]*B[15] + A[34]*B[16] + A[35]*B[17]; \
-    C[TC + 33*ST] = A[30]*B[18] + A[31]*B[19] + A[32]*B[20] + A[33]*B[21] + A[34]*B[22] + A[35]*B[23]; \
-    C[TC + 34*ST] = A[30]*B[24] + A[31]*B[25] + A[32]*B[26] + A[33]*B[27] + A[34]*B[28] + A[35]*B[29]; \
-    C[TC + 35*ST] = A[30]*B[30] + A[31]*B[31] + A[32]*B[32] + A[33]*B[33] + A[34]*B[34] + A[35]*B[35]; \
+    for(int _i = 0; _i < 6; _i++) \
+        bt_1d(A + _i*6, 1, C + TC + _i*6*ST, ST); \
+}
+
+#if defined(__AVX512F__)
+#define BT_VLEN 16
+typedef __m512 bt_vec;
+#define BT_GATHER(p, idx) _mm512_i32gather_ps(idx, p, 4)
+#define BT_STORE(p, v) _mm512_storeu_ps(p, v)
+#define BT_INDEX() _mm512_set_epi32(60, 56, 52, 48, 44, 40, 36, 32, 28, 24, 20, 16, 12, 8, 4, 0)
+#define BT_ADD(a, b) _mm512_add_ps(a, b)
+#define BT_SUB(a, b) _mm512_sub_ps(a, b)
+#define BT_SCALE(s, a) _mm512_mul_ps(_mm512_set1_ps(s), a)
+#elif defined(__AVX2__)
+#define BT_VLEN 8
+typedef __m256 bt_vec;
+#define BT_GATHER(p, idx) _mm256_i32gather_ps(p, idx, 4)
+#define BT_STORE(p, v) _mm256_storeu_ps(p, v)
+#define BT_INDEX() _mm256_set_epi32(28, 24, 20, 16, 12, 8, 4, 0)
+#define BT_ADD(a, b) _mm256_add_ps(a, b)
+#define BT_SUB(a, b) _mm256_sub_ps(a, b)
+#define BT_SCALE(s, a) _mm256_mul_ps(_mm256_set1_ps(s), a)
+#endif
+
+#ifdef BT_VLEN
+/* One lane per tile, bt_1d runs unchanged on the vectors. */
+struct bt_lanes {
+    bt_vec v;
+};
+static inline bt_lanes operator+(const bt_lanes a, const bt_lanes b) { bt_lanes r = {BT_ADD(a.v, b.v)}; return r; }
+static inline bt_lanes operator-(const bt_lanes a, const bt_lanes b) { bt_lanes r = {BT_SUB(a.v, b.v)}; return r; }
+static inline bt_lanes operator*(const float s, const bt_lanes a) { bt_lanes r = {BT_SCALE(s, a.v)}; return r; }
+
+/* BT_VLEN neighbouring tiles of one tile row, data points to the first
+ * tile and the tiles are written to consecutive positions of bridge data.
+ * */
+static inline void trans_bt_lanes(const float *data, const int cols, float *dataDst, const long istride)
+{
+    bt_lanes tmp[36], bridge[36];
+    int i, j;
+
+    for(i = 0; i < 6; i++)
+        for(j = 0; j < 6; j++)
+            tmp[i*6+j].v = BT_GATHER(data + i*cols + j, BT_INDEX());
+
+    for(j = 0; j < 6; j++)
+        bt_1d(tmp + j, 6, bridge + j, 6);
+    for(i = 0; i < 6; i++)
+        bt_1d(bridge + i*6, 1, tmp + i*6, 1);
+
+    for(i = 0; i < 36; i++)
+        BT_STORE(dataDst + i*istride, tmp[i].v);
 }
+#endif
 
 // Get output tile & Twice transform
 #define GET_OUTPUT_TILE(TMP, DATA, TC, ST) \
@@ -216,7 +217,8 @@ const float BT[36] = {
     template<typename Dtype>
 static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
         const int N, const int C, const int rows, const int cols,
-        ACSATailMessage *tailMess, const int ntiles, const int mg4x3)
+        ACSATailMessage *tailMess, const int ntiles, const int mg4x3,
+        const long istride)
 {   
     int d1, d2;
     int sizeI = rows*cols;
@@ -246,9 +248,18 @@ static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
         int tileCount = d1*ntiles;
 
         for(i = 0; i < rowSeg1; i += 4){
+            j = 0;
+#ifdef BT_VLEN
+            // BT_VLEN tiles at once, one tile per lane
+            if(typeid(Dtype) == typeid(float))
+                for(; j+4*BT_VLEN <= colSeg1; j += 4*BT_VLEN){
+                    trans_bt_lanes((const float *)data + i*cols + j, cols, (float *)dataDst + tileCount, istride);
+                    tileCount += BT_VLEN;
+                }
+#endif
 #pragma simd
             // Process no tail
-            for(j = 0; j < colSeg1; j += 4){
+            for(; j < colSeg1; j += 4){
                 tmp[0 ] = data[(i+0)*cols + (j+0)]; 
                 tmp[1 ] = data[(i+0)*cols + (j+1)]; 
                 tmp[2 ] = data[(i+0)*cols + (j+2)]; 
@@ -293,7 +304,7 @@ static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
 
                 tileCount++; 
             }
@@ -304,7 +315,7 @@ static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++; 
             }
         }
@@ -357,7 +368,7 @@ static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
 
                 tileCount++; 
             }
@@ -409,7 +420,7 @@ static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
 
                 tileCount++; 
             }
@@ -461,7 +472,7 @@ static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
 
                 tileCount++; 
             }
@@ -473,7 +484,7 @@ static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
 
             // The tranformation manually simplified
             TRANS_BT_FST(BT, tmp, bridge);
-            TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+            TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
             tileCount++; 
         }
     }
@@ -486,7 +497,8 @@ static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
 static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
         const int N, const int C, const int rows, const int cols,
         const int pad_h, const int pad_w,
-        ACSATailMessage *tailMess, const int ntiles, const int mg4x3)
+        ACSATailMessage *tailMess, const int ntiles, const int mg4x3,
+        const long istride)
 {   
     int d1, d2;
     int rows_pad = rows + 2*pad_h;
@@ -574,7 +586,7 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++; 
             }
         }
@@ -622,7 +634,7 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 
             // Tranformation manually simplified
             TRANS_BT_FST(BT, tmp, bridge);
-            TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+            TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
             tileCount++;
         }
 
@@ -664,7 +676,7 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 
                 // Tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++;
             }
         }
@@ -696,7 +708,7 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 
                 // Tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++;
             }
         }
@@ -722,7 +734,7 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 
                 // Tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++;
             }
         }
@@ -766,7 +778,7 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 
                 // Tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++;
             }
         }
@@ -778,7 +790,7 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 
             // Tranformation manually simplified
             TRANS_BT_FST(BT, tmp, bridge);
-            TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+            TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
             tileCount += col_nTiles;
         }
 
@@ -789,7 +801,7 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 
             // Tranformation manually simplified
             TRANS_BT_FST(BT, tmp, bridge);
-            TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+            TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
             tileCount += col_nTiles;
         }
 
@@ -797,27 +809,27 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
         tileCount = baseTileCount;
         ACSAGetInputTile(tmp, data, 6, 6, 0, 0, cols, 1, 0, 1, 0);
         TRANS_BT_FST(BT, tmp, bridge);
-        TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+        TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
 
         // Top Right Corner for third region
         tileCount = baseTileCount + col_nTiles -1;
         ACSAGetInputTile(tmp, data, 6, 6, 0, cols-5+ZERO_LENGTH(tail_w), cols, 1, 0, 0, ZERO_LENGTH(tail_w)+1);
         TRANS_BT_FST(BT, tmp, bridge);
-        TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+        TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
 
         // Bottom Left Corner for third region
         tileCount = baseTileCount + 
             (row_nTiles - 1)*(col_nTiles);
         ACSAGetInputTile(tmp, data, 6, 6, rows-5+ZERO_LENGTH(tail_h), 0, cols, 0, ZERO_LENGTH(tail_h)+1, 1, 0);
         TRANS_BT_FST(BT, tmp, bridge);
-        TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+        TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
 
         // Bottom Right Corner for third region
         tileCount = baseTileCount + 
             (row_nTiles)*(col_nTiles) - 1;
         ACSAGetInputTile(tmp, data, 6, 6, rows-5+ZERO_LENGTH(tail_h), cols-5+ZERO_LENGTH(tail_w), cols, 0, ZERO_LENGTH(tail_h)+1, 0, ZERO_LENGTH(tail_w)+1);
         TRANS_BT_FST(BT, tmp, bridge);
-        TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+        TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
     }
 }
 
@@ -828,7 +840,8 @@ static void inByTransform_padBigScale(const Dtype *in, Dtype *dataDst,
 static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *dataDst,
         const int N, const int C, const int rows, const int cols,
         const int pad_h, const int pad_w,
-        ACSATailMessage *tailMess, const int ntiles, const int mg4x3)
+        ACSATailMessage *tailMess, const int ntiles, const int mg4x3,
+        const long istride)
 {   
     int d1, d2;
     int rows_pad = rows + 2*pad_h;
@@ -869,9 +882,18 @@ static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *d
                 data_pad[(i+1)*(cols_pad) + (j+1)] = data[i*cols+j];
 
         for(i = 0; i < rowSeg1; i += 4){
+            j = 0;
+#ifdef BT_VLEN
+            // BT_VLEN tiles at once, one tile per lane
+            if(typeid(Dtype) == typeid(float))
+                for(; j+4*BT_VLEN <= colSeg1; j += 4*BT_VLEN){
+                    trans_bt_lanes((const float *)data_pad + i*cols_pad + j, cols_pad, (float *)dataDst + tileCount, istride);
+                    tileCount += BT_VLEN;
+                }
+#endif
 #pragma simd
             // Process no tail
-            for(j = 0; j < colSeg1; j += 4){
+            for(; j < colSeg1; j += 4){
                 tmp[0 ] = data_pad[(i+0)*cols_pad + (j+0)]; 
                 tmp[1 ] = data_pad[(i+0)*cols_pad + (j+1)]; 
                 tmp[2 ] = data_pad[(i+0)*cols_pad + (j+2)]; 
@@ -916,7 +938,7 @@ static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *d
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
 
                 tileCount++; 
             }
@@ -927,7 +949,7 @@ static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *d
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
                 tileCount++; 
             }
         }
@@ -980,7 +1002,7 @@ static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *d
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
 
                 tileCount++; 
             }
@@ -1032,7 +1054,7 @@ static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *d
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
 
                 tileCount++; 
             }
@@ -1084,7 +1106,7 @@ static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *d
 
                 // The tranformation manually simplified
                 TRANS_BT_FST(BT, tmp, bridge);
-                TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+                TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
 
                 tileCount++; 
             }
@@ -1096,7 +1118,7 @@ static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *d
 
             // The tranformation manually simplified
             TRANS_BT_FST(BT, tmp, bridge);
-            TRANS_BT_SED(bridge, BT, dataDst, tileCount, ISTRIDE4X3);
+            TRANS_BT_SED(bridge, BT, dataDst, tileCount, istride);
             tileCount++; 
         }
     }
@@ -1105,7 +1127,7 @@ static void inByTransform_padSmallScale(const Dtype *in, Dtype *in_pad, Dtype *d
 /* Compute the bridge data for filter, and transform to form matrix B. */
     template<typename Dtype>
 static void filterByTransform(const Dtype *filter, Dtype *dataDst,
-        const int C, const int K)
+        const int C, const int K, const long fstride)
 {
     int d1, d2, d3; 
 
@@ -1139,42 +1161,42 @@ static void filterByTransform(const Dtype *filter, Dtype *dataDst,
             bridge[17] = G[15]*tmp[ 2] + G[16]*tmp[ 5] + G[17]*tmp[ 8];
 
             // Second transform filter data by G
-            dataDst[ 0*FSTRIDE4X3+d1*C+d2] = bridge[ 0]*G[ 0] + bridge[ 1]*G[ 1] + bridge[ 2]*G[ 2];
-            dataDst[ 1*FSTRIDE4X3+d1*C+d2] = bridge[ 0]*G[ 3] + bridge[ 1]*G[ 4] + bridge[ 2]*G[ 5];
-            dataDst[ 2*FSTRIDE4X3+d1*C+d2] = bridge[ 0]*G[ 6] + bridge[ 1]*G[ 7] + bridge[ 2]*G[ 8];
-            dataDst[ 3*FSTRIDE4X3+d1*C+d2] = bridge[ 0]*G[ 9] + bridge[ 1]*G[10] + bridge[ 2]*G[11];
-            dataDst[ 4*FSTRIDE4X3+d1*C+d2] = bridge[ 0]*G[12] + bridge[ 1]*G[13] + bridge[ 2]*G[14];
-            dataDst[ 5*FSTRIDE4X3+d1*C+d2] = bridge[ 0]*G[15] + bridge[ 1]*G[16] + bridge[ 2]*G[17];
-            dataDst[ 6*FSTRIDE4X3+d1*C+d2] = bridge[ 3]*G[ 0] + bridge[ 4]*G[ 1] + bridge[ 5]*G[ 2];
-            dataDst[ 7*FSTRIDE4X3+d1*C+d2] = bridge[ 3]*G[ 3] + bridge[ 4]*G[ 4] + bridge[ 5]*G[ 5];
-            dataDst[ 8*FSTRIDE4X3+d1*C+d2] = bridge[ 3]*G[ 6] + bridge[ 4]*G[ 7] + bridge[ 5]*G[ 8];
-            dataDst[ 9*FSTRIDE4X3+d1*C+d2] = bridge[ 3]*G[ 9] + bridge[ 4]*G[10] + bridge[ 5]*G[11];
-            dataDst[10*FSTRIDE4X3+d1*C+d2] = bridge[ 3]*G[12] + bridge[ 4]*G[13] + bridge[ 5]*G[14];
-            dataDst[11*FSTRIDE4X3+d1*C+d2] = bridge[ 3]*G[15] + bridge[ 4]*G[16] + bridge[ 5]*G[17];
-            dataDst[12*FSTRIDE4X3+d1*C+d2] = bridge[ 6]*G[ 0] + bridge[ 7]*G[ 1] + bridge[ 8]*G[ 2];
-            dataDst[13*FSTRIDE4X3+d1*C+d2] = bridge[ 6]*G[ 3] + bridge[ 7]*G[ 4] + bridge[ 8]*G[ 5];
-            dataDst[14*FSTRIDE4X3+d1*C+d2] = bridge[ 6]*G[ 6] + bridge[ 7]*G[ 7] + bridge[ 8]*G[ 8];
-            dataDst[15*FSTRIDE4X3+d1*C+d2] = bridge[ 6]*G[ 9] + bridge[ 7]*G[10] + bridge[ 8]*G[11];
-            dataDst[16*FSTRIDE4X3+d1*C+d2] = bridge[ 6]*G[12] + bridge[ 7]*G[13] + bridge[ 8]*G[14];
-            dataDst[17*FSTRIDE4X3+d1*C+d2] = bridge[ 6]*G[15] + bridge[ 7]*G[16] + bridge[ 8]*G[17];
-            dataDst[18*FSTRIDE4X3+d1*C+d2] = bridge[ 9]*G[ 0] + bridge[10]*G[ 1] + bridge[11]*G[ 2];
-            dataDst[19*FSTRIDE4X3+d1*C+d2] = bridge[ 9]*G[ 3] + bridge[10]*G[ 4] + bridge[11]*G[ 5];
-            dataDst[20*FSTRIDE4X3+d1*C+d2] = bridge[ 9]*G[ 6] + bridge[10]*G[ 7] + bridge[11]*G[ 8];
-            dataDst[21*FSTRIDE4X3+d1*C+d2] = bridge[ 9]*G[ 9] + bridge[10]*G[10] + bridge[11]*G[11];
-            dataDst[22*FSTRIDE4X3+d1*C+d2] = bridge[ 9]*G[12] + bridge[10]*G[13] + bridge[11]*G[14];
-            dataDst[23*FSTRIDE4X3+d1*C+d2] = bridge[ 9]*G[15] + bridge[10]*G[16] + bridge[11]*G[17];
-            dataDst[24*FSTRIDE4X3+d1*C+d2] = bridge[12]*G[ 0] + bridge[13]*G[ 1] + bridge[14]*G[ 2];
-            dataDst[25*FSTRIDE4X3+d1*C+d2] = bridge[12]*G[ 3] + bridge[13]*G[ 4] + bridge[14]*G[ 5];
-            dataDst[26*FSTRIDE4X3+d1*C+d2] = bridge[12]*G[ 6] + bridge[13]*G[ 7] + bridge[14]*G[ 8];
-            dataDst[27*FSTRIDE4X3+d1*C+d2] = bridge[12]*G[ 9] + bridge[13]*G[10] + bridge[14]*G[11];
-            dataDst[28*FSTRIDE4X3+d1*C+d2] = bridge[12]*G[12] + bridge[13]*G[13] + bridge[14]*G[14];
-            dataDst[29*FSTRIDE4X3+d1*C+d2] = bridge[12]*G[15] + bridge[13]*G[16] + bridge[14]*G[17];
-            dataDst[30*FSTRIDE4X3+d1*C+d2] = bridge[15]*G[ 0] + bridge[16]*G[ 1] + bridge[17]*G[ 2];
-            dataDst[31*FSTRIDE4X3+d1*C+d2] = bridge[15]*G[ 3] + bridge[16]*G[ 4] + bridge[17]*G[ 5];
-            dataDst[32*FSTRIDE4X3+d1*C+d2] = bridge[15]*G[ 6] + bridge[16]*G[ 7] + bridge[17]*G[ 8];
-            dataDst[33*FSTRIDE4X3+d1*C+d2] = bridge[15]*G[ 9] + bridge[16]*G[10] + bridge[17]*G[11];
-            dataDst[34*FSTRIDE4X3+d1*C+d2] = bridge[15]*G[12] + bridge[16]*G[13] + bridge[17]*G[14];
-            dataDst[35*FSTRIDE4X3+d1*C+d2] = bridge[15]*G[15] + bridge[16]*G[16] + bridge[17]*G[17];
+            dataDst[ 0*fstride+d1*C+d2] = bridge[ 0]*G[ 0] + bridge[ 1]*G[ 1] + bridge[ 2]*G[ 2];
+            dataDst[ 1*fstride+d1*C+d2] = bridge[ 0]*G[ 3] + bridge[ 1]*G[ 4] + bridge[ 2]*G[ 5];
+            dataDst[ 2*fstride+d1*C+d2] = bridge[ 0]*G[ 6] + bridge[ 1]*G[ 7] + bridge[ 2]*G[ 8];
+            dataDst[ 3*fstride+d1*C+d2] = bridge[ 0]*G[ 9] + bridge[ 1]*G[10] + bridge[ 2]*G[11];
+            dataDst[ 4*fstride+d1*C+d2] = bridge[ 0]*G[12] + bridge[ 1]*G[13] + bridge[ 2]*G[14];
+            dataDst[ 5*fstride+d1*C+d2] = bridge[ 0]*G[15] + bridge[ 1]*G[16] + bridge[ 2]*G[17];
+            dataDst[ 6*fstride+d1*C+d2] = bridge[ 3]*G[ 0] + bridge[ 4]*G[ 1] + bridge[ 5]*G[ 2];
+            dataDst[ 7*fstride+d1*C+d2] = bridge[ 3]*G[ 3] + bridge[ 4]*G[ 4] + bridge[ 5]*G[ 5];
+            dataDst[ 8*fstride+d1*C+d2] = bridge[ 3]*G[ 6] + bridge[ 4]*G[ 7] + bridge[ 5]*G[ 8];
+            dataDst[ 9*fstride+d1*C+d2] = bridge[ 3]*G[ 9] + bridge[ 4]*G[10] + bridge[ 5]*G[11];
+            dataDst[10*fstride+d1*C+d2] = bridge[ 3]*G[12] + bridge[ 4]*G[13] + bridge[ 5]*G[14];
+            dataDst[11*fstride+d1*C+d2] = bridge[ 3]*G[15] + bridge[ 4]*G[16] + bridge[ 5]*G[17];
+            dataDst[12*fstride+d1*C+d2] = bridge[ 6]*G[ 0] + bridge[ 7]*G[ 1] + bridge[ 8]*G[ 2];
+            dataDst[13*fstride+d1*C+d2] = bridge[ 6]*G[ 3] + bridge[ 7]*G[ 4] + bridge[ 8]*G[ 5];
+            dataDst[14*fstride+d1*C+d2] = bridge[ 6]*G[ 6] + bridge[ 7]*G[ 7] + bridge[ 8]*G[ 8];
+            dataDst[15*fstride+d1*C+d2] = bridge[ 6]*G[ 9] + bridge[ 7]*G[10] + bridge[ 8]*G[11];
+            dataDst[16*fstride+d1*C+d2] = bridge[ 6]*G[12] + bridge[ 7]*G[13] + bridge[ 8]*G[14];
+            dataDst[17*fstride+d1*C+d2] = bridge[ 6]*G[15] + bridge[ 7]*G[16] + bridge[ 8]*G[17];
+            dataDst[18*fstride+d1*C+d2] = bridge[ 9]*G[ 0] + bridge[10]*G[ 1] + bridge[11]*G[ 2];
+            dataDst[19*fstride+d1*C+d2] = bridge[ 9]*G[ 3] + bridge[10]*G[ 4] + bridge[11]*G[ 5];
+            dataDst[20*fstride+d1*C+d2] = bridge[ 9]*G[ 6] + bridge[10]*G[ 7] + bridge[11]*G[ 8];
+            dataDst[21*fstride+d1*C+d2] = bridge[ 9]*G[ 9] + bridge[10]*G[10] + bridge[11]*G[11];
+            dataDst[22*fstride+d1*C+d2] = bridge[ 9]*G[12] + bridge[10]*G[13] + bridge[11]*G[14];
+            dataDst[23*fstride+d1*C+d2] = bridge[ 9]*G[15] + bridge[10]*G[16] + bridge[11]*G[17];
+            dataDst[24*fstride+d1*C+d2] = bridge[12]*G[ 0] + bridge[13]*G[ 1] + bridge[14]*G[ 2];
+            dataDst[25*fstride+d1*C+d2] = bridge[12]*G[ 3] + bridge[13]*G[ 4] + bridge[14]*G[ 5];
+            dataDst[26*fstride+d1*C+d2] = bridge[12]*G[ 6] + bridge[13]*G[ 7] + bridge[14]*G[ 8];
+            dataDst[27*fstride+d1*C+d2] = bridge[12]*G[ 9] + bridge[13]*G[10] + bridge[14]*G[11];
+            dataDst[28*fstride+d1*C+d2] = bridge[12]*G[12] + bridge[13]*G[13] + bridge[14]*G[14];
+            dataDst[29*fstride+d1*C+d2] = bridge[12]*G[15] + bridge[13]*G[16] + bridge[14]*G[17];
+            dataDst[30*fstride+d1*C+d2] = bridge[15]*G[ 0] + bridge[16]*G[ 1] + bridge[17]*G[ 2];
+            dataDst[31*fstride+d1*C+d2] = bridge[15]*G[ 3] + bridge[16]*G[ 4] + bridge[17]*G[ 5];
+            dataDst[32*fstride+d1*C+d2] = bridge[15]*G[ 6] + bridge[16]*G[ 7] + bridge[17]*G[ 8];
+            dataDst[33*fstride+d1*C+d2] = bridge[15]*G[ 9] + bridge[16]*G[10] + bridge[17]*G[11];
+            dataDst[34*fstride+d1*C+d2] = bridge[15]*G[12] + bridge[16]*G[13] + bridge[17]*G[14];
+            dataDst[35*fstride+d1*C+d2] = bridge[15]*G[15] + bridge[16]*G[16] + bridge[17]*G[17];
         }
     }
 }
@@ -1183,47 +1205,30 @@ static void filterByTransform(const Dtype *filter, Dtype *dataDst,
  * Number of sgemm calls is 36*BATCH. 
  * */ 
     template<typename Dtype>
-static void matrix_compute(const Dtype *in, const int irows, const int icols,
-        const Dtype *filter, const int frows, const int fcols,
-        Dtype *out,
-        const int batch)
+static void matrix_compute(const Dtype *in, const int irows, const int icols, const long istride,
+        const Dtype *filter, const int frows, const int fcols, const long fstride,
+        Dtype *out, const long ostride,
+        const int batch, const ACSAGemmMode gemm)
 {
 
     /* In  - matrix A
      * Filter - matrix B
      * Output - matrix C
+     * All 36 points of every batch are issued as one batched gemm.
      * */
-    int d1, d2; 
-    const char trans ='n'; 
-    const float alpha_f = 1.0; 
-    const float beta_f =  0.0; 
-    const double alpha_d = 1.0; 
-    const double beta_d =  0.0; 
-    const int ldi = irows;
-    const int ldf = frows;
-    const int ldo = irows;
-
-#pragma omp parallel for collapse(2) private(d1, d2)
-    for(d1 = 0; d1 < 36; d1++){
-        for(d2 = 0; d2 < batch; d2++){
-            const Dtype* pin = in+d1*ISTRIDE4X3+d2*irows*icols; 
-            const Dtype* pft = filter+d1*FSTRIDE4X3; 
-            Dtype* pot = out+d1*OSTRIDE4X3+d2*irows*fcols; 
-            if(typeid(Dtype) == typeid(float))
-                sgemm(&trans, &trans, &irows, &fcols, &icols, &alpha_f, 
-                        (const float *)pin, &ldi, (const float *)pft, &ldf, &beta_f, (float *)pot, &ldo); 
-            else if(typeid(Dtype) == typeid(double))
-                dgemm(&trans, &trans, &irows, &fcols, &icols, &alpha_d, 
-                        (const double *)pin, &ldi, (const double *)pft, &ldf, &beta_d, (double *)pot, &ldo); 
-        }
-    }
+    if(gemm == ACSA_GEMM_KERNEL)
+        ACSAWinoGemm(in, irows, icols, istride, filter, fcols, fstride, out, ostride, 36, batch);
+    else
+        ACSABatchGemm(in, irows, icols, istride, filter, fcols, fstride, out, ostride, 36, batch);
 }
 
 /* Compute the bridge data for out, and transform to form matrix C. */
     template<typename Dtype>
 static void outByTransform(Dtype *out, const Dtype *dataSrc,
         const int N, const int K, const int rows, const int cols,
-        ACSATailMessage *tailMess, const int ntiles, const int mg4x3)
+        ACSATailMessage *tailMess, const int ntiles, const int mg4x3,
+        const long ostride,
+        const Dtype *bias, const Dtype slope, const Dtype ceil)
 {
     int d1; 
     int sizeO = rows * cols;
@@ -1250,42 +1255,46 @@ static void outByTransform(Dtype *out, const Dtype *dataSrc,
         const int t3 = d1%mg4x3;
 
         Dtype *dataDst = out + (t1*mg4x3*K + t3*K + t2)*sizeO;
+
+        const Dtype bk = (bias == NULL) ? (Dtype)0 : bias[t2];
         int tileCount = d1*ntiles; 
 
         for(i = 0; i < rowSeg1; i += 4){
 #pragma simd
             for(j = 0; j < colSeg1; j += 4){
-                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, OSTRIDE4X3);
+                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, ostride);
                 // First inverse transform for output by AT
                 TRANS_AT_FST(AT, tmp, bridge);
                 // Second inverse transform for output by AT
-                dataDst[(i+0)*cols + (j+0)] = bridge[ 0]*AT[ 0] + bridge[ 1]*AT[ 1] + bridge[ 2]*AT[ 2] + bridge[ 3]*AT[ 3] + bridge[ 4]*AT[ 4] + bridge[ 5]*AT[ 5];
-                dataDst[(i+0)*cols + (j+1)] = bridge[ 0]*AT[ 6] + bridge[ 1]*AT[ 7] + bridge[ 2]*AT[ 8] + bridge[ 3]*AT[ 9] + bridge[ 4]*AT[10] + bridge[ 5]*AT[11];
-                dataDst[(i+0)*cols + (j+2)] = bridge[ 0]*AT[12] + bridge[ 1]*AT[13] + bridge[ 2]*AT[14] + bridge[ 3]*AT[15] + bridge[ 4]*AT[16] + bridge[ 5]*AT[17];
-                dataDst[(i+0)*cols + (j+3)] = bridge[ 0]*AT[18] + bridge[ 1]*AT[19] + bridge[ 2]*AT[20] + bridge[ 3]*AT[21] + bridge[ 4]*AT[22] + bridge[ 5]*AT[23];
-                dataDst[(i+1)*cols + (j+0)] = bridge[ 6]*AT[ 0] + bridge[ 7]*AT[ 1] + bridge[ 8]*AT[ 2] + bridge[ 9]*AT[ 3] + bridge[10]*AT[ 4] + bridge[11]*AT[ 5];
-                dataDst[(i+1)*cols + (j+1)] = bridge[ 6]*AT[ 6] + bridge[ 7]*AT[ 7] + bridge[ 8]*AT[ 8] + bridge[ 9]*AT[ 9] + bridge[10]*AT[10] + bridge[11]*AT[11];
-                dataDst[(i+1)*cols + (j+2)] = bridge[ 6]*AT[12] + bridge[ 7]*AT[13] + bridge[ 8]*AT[14] + bridge[ 9]*AT[15] + bridge[10]*AT[16] + bridge[11]*AT[17];
-                dataDst[(i+1)*cols + (j+3)] = bridge[ 6]*AT[18] + bridge[ 7]*AT[19] + bridge[ 8]*AT[20] + bridge[ 9]*AT[21] + bridge[10]*AT[22] + bridge[11]*AT[23];
-                dataDst[(i+2)*cols + (j+0)] = bridge[12]*AT[ 0] + bridge[13]*AT[ 1] + bridge[14]*AT[ 2] + bridge[15]*AT[ 3] + bridge[16]*AT[ 4] + bridge[17]*AT[ 5];
-                dataDst[(i+2)*cols + (j+1)] = bridge[12]*AT[ 6] + bridge[13]*AT[ 7] + bridge[14]*AT[ 8] + bridge[15]*AT[ 9] + bridge[16]*AT[10] + bridge[17]*AT[11];
-                dataDst[(i+2)*cols + (j+2)] = bridge[12]*AT[12] + bridge[13]*AT[13] + bridge[14]*AT[14] + bridge[15]*AT[15] + bridge[16]*AT[16] + bridge[17]*AT[17];
-                dataDst[(i+2)*cols + (j+3)] = bridge[12]*AT[18] + bridge[13]*AT[19] + bridge[14]*AT[20] + bridge[15]*AT[21] + bridge[16]*AT[22] + bridge[17]*AT[23];
-                dataDst[(i+3)*cols + (j+0)] = bridge[18]*AT[ 0] + bridge[19]*AT[ 1] + bridge[20]*AT[ 2] + bridge[21]*AT[ 3] + bridge[22]*AT[ 4] + bridge[23]*AT[ 5];
-                dataDst[(i+3)*cols + (j+1)] = bridge[18]*AT[ 6] + bridge[19]*AT[ 7] + bridge[20]*AT[ 8] + bridge[21]*AT[ 9] + bridge[22]*AT[10] + bridge[23]*AT[11];
-                dataDst[(i+3)*cols + (j+2)] = bridge[18]*AT[12] + bridge[19]*AT[13] + bridge[20]*AT[14] + bridge[21]*AT[15] + bridge[22]*AT[16] + bridge[23]*AT[17];
-                dataDst[(i+3)*cols + (j+3)] = bridge[18]*AT[18] + bridge[19]*AT[19] + bridge[20]*AT[20] + bridge[21]*AT[21] + bridge[22]*AT[22] + bridge[23]*AT[23];
+                dataDst[(i+0)*cols + (j+0)] = ACSAActivate<Dtype>(bridge[ 0]*AT[ 0] + bridge[ 1]*AT[ 1] + bridge[ 2]*AT[ 2] + bridge[ 3]*AT[ 3] + bridge[ 4]*AT[ 4] + bridge[ 5]*AT[ 5], bk, slope, ceil);
+                dataDst[(i+0)*cols + (j+1)] = ACSAActivate<Dtype>(bridge[ 0]*AT[ 6] + bridge[ 1]*AT[ 7] + bridge[ 2]*AT[ 8] + bridge[ 3]*AT[ 9] + bridge[ 4]*AT[10] + bridge[ 5]*AT[11], bk, slope, ceil);
+                dataDst[(i+0)*cols + (j+2)] = ACSAActivate<Dtype>(bridge[ 0]*AT[12] + bridge[ 1]*AT[13] + bridge[ 2]*AT[14] + bridge[ 3]*AT[15] + bridge[ 4]*AT[16] + bridge[ 5]*AT[17], bk, slope, ceil);
+                dataDst[(i+0)*cols + (j+3)] = ACSAActivate<Dtype>(bridge[ 0]*AT[18] + bridge[ 1]*AT[19] + bridge[ 2]*AT[20] + bridge[ 3]*AT[21] + bridge[ 4]*AT[22] + bridge[ 5]*AT[23], bk, slope, ceil);
+                dataDst[(i+1)*cols + (j+0)] = ACSAActivate<Dtype>(bridge[ 6]*AT[ 0] + bridge[ 7]*AT[ 1] + bridge[ 8]*AT[ 2] + bridge[ 9]*AT[ 3] + bridge[10]*AT[ 4] + bridge[11]*AT[ 5], bk, slope, ceil);
+                dataDst[(i+1)*cols + (j+1)] = ACSAActivate<Dtype>(bridge[ 6]*AT[ 6] + bridge[ 7]*AT[ 7] + bridge[ 8]*AT[ 8] + bridge[ 9]*AT[ 9] + bridge[10]*AT[10] + bridge[11]*AT[11], bk, slope, ceil);
+                dataDst[(i+1)*cols + (j+2)] = ACSAActivate<Dtype>(bridge[ 6]*AT[12] + bridge[ 7]*AT[13] + bridge[ 8]*AT[14] + bridge[ 9]*AT[15] + bridge[10]*AT[16] + bridge[11]*AT[17], bk, slope, ceil);
+                dataDst[(i+1)*cols + (j+3)] = ACSAActivate<Dtype>(bridge[ 6]*AT[18] + bridge[ 7]*AT[19] + bridge[ 8]*AT[20] + bridge[ 9]*AT[21] + bridge[10]*AT[22] + bridge[11]*AT[23], bk, slope, ceil);
+                dataDst[(i+2)*cols + (j+0)] = ACSAActivate<Dtype>(bridge[12]*AT[ 0] + bridge[13]*AT[ 1] + bridge[14]*AT[ 2] + bridge[15]*AT[ 3] + bridge[16]*AT[ 4] + bridge[17]*AT[ 5], bk, slope, ceil);
+                dataDst[(i+2)*cols + (j+1)] = ACSAActivate<Dtype>(bridge[12]*AT[ 6] + bridge[13]*AT[ 7] + bridge[14]*AT[ 8] + bridge[15]*AT[ 9] + bridge[16]*AT[10] + bridge[17]*AT[11], bk, slope, ceil);
+                dataDst[(i+2)*cols + (j+2)] = ACSAActivate<Dtype>(bridge[12]*AT[12] + bridge[13]*AT[13] + bridge[14]*AT[14] + bridge[15]*AT[15] + bridge[16]*AT[16] + bridge[17]*AT[17], bk, slope, ceil);
+                dataDst[(i+2)*cols + (j+3)] = ACSAActivate<Dtype>(bridge[12]*AT[18] + bridge[13]*AT[19] + bridge[14]*AT[20] + bridge[15]*AT[21] + bridge[16]*AT[22] + bridge[17]*AT[23], bk, slope, ceil);
+                dataDst[(i+3)*cols + (j+0)] = ACSAActivate<Dtype>(bridge[18]*AT[ 0] + bridge[19]*AT[ 1] + bridge[20]*AT[ 2] + bridge[21]*AT[ 3] + bridge[22]*AT[ 4] + bridge[23]*AT[ 5], bk, slope, ceil);
+                dataDst[(i+3)*cols + (j+1)] = ACSAActivate<Dtype>(bridge[18]*AT[ 6] + bridge[19]*AT[ 7] + bridge[20]*AT[ 8] + bridge[21]*AT[ 9] + bridge[22]*AT[10] + bridge[23]*AT[11], bk, slope, ceil);
+                dataDst[(i+3)*cols + (j+2)] = ACSAActivate<Dtype>(bridge[18]*AT[12] + bridge[19]*AT[13] + bridge[20]*AT[14] + bridge[21]*AT[15] + bridge[22]*AT[16] + bridge[23]*AT[17], bk, slope, ceil);
+                dataDst[(i+3)*cols + (j+3)] = ACSAActivate<Dtype>(bridge[18]*AT[18] + bridge[19]*AT[19] + bridge[20]*AT[20] + bridge[21]*AT[21] + bridge[22]*AT[22] + bridge[23]*AT[23], bk, slope, ceil);
                 tileCount++; 
             }
 
             // Process col tail
             if(colSeg2 != 0){
-                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, OSTRIDE4X3);
+                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, ostride);
                 // First inverse transform for output by AT
                 TRANS_AT_FST(AT, tmp, bridge);
                 // Second inverse transform for output by AT
                 TRANS_AT_SED(bridge, AT, middle);
 
+                ACSAActivateTile(middle, 16, bk, slope, ceil);
+
                 ACSAGetFinalOutput(dataDst, middle, 4, 4, i, j, cols, 0, 0, 0, ZERO_LENGTH(colSeg2));
                 tileCount++; 
             }
@@ -1295,72 +1304,118 @@ static void outByTransform(Dtype *out, const Dtype *dataSrc,
         if(rowSeg2 == 1){
 #pragma simd
             for(j = 0; j < colSeg1; j += 4){
-                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, OSTRIDE4X3);
+                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, ostride);
                 // First inverse transform for output by AT
                 TRANS_AT_FST(AT, tmp, bridge);
                 // Second inverse transform for output by AT
-                dataDst[(rowSeg1+0)*cols + (j+0)] = bridge[ 0]*AT[ 0] + bridge[ 1]*AT[ 1] + bridge[ 2]*AT[ 2] + bridge[ 3]*AT[ 3] + bridge[ 4]*AT[ 4] + bridge[ 5]*AT[ 5];
-                dataDst[(rowSeg1+0)*cols + (j+1)] = bridge[ 0]*AT[ 6] + bridge[ 1]*AT[ 7] + bridge[ 2]*AT[ 8] + bridge[ 3]*AT[ 9] + bridge[ 4]*AT[10] + bridge[ 5]*AT[11];
-                dataDst[(rowSeg1+0)*cols + (j+2)] = bridge[ 0]*AT[12] + bridge[ 1]*AT[13] + bridge[ 2]*AT[14] + bridge[ 3]*AT[15] + bridge[ 4]*AT[16] + bridge[ 5]*AT[17];
-                dataDst[(rowSeg1+0)*cols + (j+3)] = bridge[ 0]*AT[18] + bridge[ 1]*AT[19] + bridge[ 2]*AT[20] + bridge[ 3]*AT[21] + bridge[ 4]*AT[22] + bridge[ 5]*AT[23];
+                dataDst[(rowSeg1+0)*cols + (j+0)] = ACSAActivate<Dtype>(bridge[ 0]*AT[ 0] + bridge[ 1]*AT[ 1] + bridge[ 2]*AT[ 2] + bridge[ 3]*AT[ 3] + bridge[ 4]*AT[ 4] + bridge[ 5]*AT[ 5], bk, slope, ceil);
+                dataDst[(rowSeg1+0)*cols + (j+1)] = ACSAActivate<Dtype>(bridge[ 0]*AT[ 6] + bridge[ 1]*AT[ 7] + bridge[ 2]*AT[ 8] + bridge[ 3]*AT[ 9] + bridge[ 4]*AT[10] + bridge[ 5]*AT[11], bk, slope, ceil);
+                dataDst[(rowSeg1+0)*cols + (j+2)] = ACSAActivate<Dtype>(bridge[ 0]*AT[12] + bridge[ 1]*AT[13] + bridge[ 2]*AT[14] + bridge[ 3]*AT[15] + bridge[ 4]*AT[16] + bridge[ 5]*AT[17], bk, slope, ceil);
+                dataDst[(rowSeg1+0)*cols + (j+3)] = ACSAActivate<Dtype>(bridge[ 0]*AT[18] + bridge[ 1]*AT[19] + bridge[ 2]*AT[20] + bridge[ 3]*AT[21] + bridge[ 4]*AT[22] + bridge[ 5]*AT[23], bk, slope, ceil);
                 tileCount++;
             }
         }
         else if(rowSeg2 == 2){
 #pragma simd
             for(j = 0; j < colSeg1; j += 4){
-                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, OSTRIDE4X3);
+                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, ostride);
                 // First inverse transform for output by AT
                 TRANS_AT_FST(AT, tmp, bridge);
                 // Second inverse transform for output by AT
-                dataDst[(rowSeg1+0)*cols + (j+0)] = bridge[ 0]*AT[ 0] + bridge[ 1]*AT[ 1] + bridge[ 2]*AT[ 2] + bridge[ 3]*AT[ 3] + bridge[ 4]*AT[ 4] + bridge[ 5]*AT[ 5];
-                dataDst[(rowSeg1+0)*cols + (j+1)] = bridge[ 0]*AT[ 6] + bridge[ 1]*AT[ 7] + bridge[ 2]*AT[ 8] + bridge[ 3]*AT[ 9] + bridge[ 4]*AT[10] + bridge[ 5]*AT[11];
-                dataDst[(rowSeg1+0)*cols + (j+2)] = bridge[ 0]*AT[12] + bridge[ 1]*AT[13] + bridge[ 2]*AT[14] + bridge[ 3]*AT[15] + bridge[ 4]*AT[16] + bridge[ 5]*AT[17];
-                dataDst[(rowSeg1+0)*cols + (j+3)] = bridge[ 0]*AT[18] + bridge[ 1]*AT[19] + bridge[ 2]*AT[20] + bridge[ 3]*AT[21] + bridge[ 4]*AT[22] + bridge[ 5]*AT[23];
-                dataDst[(rowSeg1+1)*cols + (j+0)] = bridge[ 6]*AT[ 0] + bridge[ 7]*AT[ 1] + bridge[ 8]*AT[ 2] + bridge[ 9]*AT[ 3] + bridge[10]*AT[ 4] + bridge[11]*AT[ 5];
-                dataDst[(rowSeg1+1)*cols + (j+1)] = bridge[ 6]*AT[ 6] + bridge[ 7]*AT[ 7] + bridge[ 8]*AT[ 8] + bridge[ 9]*AT[ 9] + bridge[10]*AT[10] + bridge[11]*AT[11];
-                dataDst[(rowSeg1+1)*cols + (j+2)] = bridge[ 6]*AT[12] + bridge[ 7]*AT[13] + bridge[ 8]*AT[14] + bridge[ 9]*AT[15] + bridge[10]*AT[16] + bridge[11]*AT[17];
-                dataDst[(rowSeg1+1)*cols + (j+3)] = bridge[ 6]*AT[18] + bridge[ 7]*AT[19] + bridge[ 8]*AT[20] + bridge[ 9]*AT[21] + bridge[10]*AT[22] + bridge[11]*AT[23];
+                dataDst[(rowSeg1+0)*cols + (j+0)] = ACSAActivate<Dtype>(bridge[ 0]*AT[ 0] + bridge[ 1]*AT[ 1] + bridge[ 2]*AT[ 2] + bridge[ 3]*AT[ 3] + bridge[ 4]*AT[ 4] + bridge[ 5]*AT[ 5], bk, slope, ceil);
+                dataDst[(rowSeg1+0)*cols + (j+1)] = ACSAActivate<Dtype>(bridge[ 0]*AT[ 6] + bridge[ 1]*AT[ 7] + bridge[ 2]*AT[ 8] + bridge[ 3]*AT[ 9] + bridge[ 4]*AT[10] + bridge[ 5]*AT[11], bk, slope, ceil);
+                dataDst[(rowSeg1+0)*cols + (j+2)] = ACSAActivate<Dtype>(bridge[ 0]*AT[12] + bridge[ 1]*AT[13] + bridge[ 2]*AT[14] + bridge[ 3]*AT[15] + bridge[ 4]*AT[16] + bridge[ 5]*AT[17], bk, slope, ceil);
+                dataDst[(rowSeg1+0)*cols + (j+3)] = ACSAActivate<Dtype>(bridge[ 0]*AT[18] + bridge[ 1]*AT[19] + bridge[ 2]*AT[20] + bridge[ 3]*AT[21] + bridge[ 4]*AT[22] + bridge[ 5]*AT[23], bk, slope, ceil);
+                dataDst[(rowSeg1+1)*cols + (j+0)] = ACSAActivate<Dtype>(bridge[ 6]*AT[ 0] + bridge[ 7]*AT[ 1] + bridge[ 8]*AT[ 2] + bridge[ 9]*AT[ 3] + bridge[10]*AT[ 4] + bridge[11]*AT[ 5], bk, slope, ceil);
+                dataDst[(rowSeg1+1)*cols + (j+1)] = ACSAActivate<Dtype>(bridge[ 6]*AT[ 6] + bridge[ 7]*AT[ 7] + bridge[ 8]*AT[ 8] + bridge[ 9]*AT[ 9] + bridge[10]*AT[10] + bridge[11]*AT[11], bk, slope, ceil);
+                dataDst[(rowSeg1+1)*cols + (j+2)] = ACSAActivate<Dtype>(bridge[ 6]*AT[12] + bridge[ 7]*AT[13] + bridge[ 8]*AT[14] + bridge[ 9]*AT[15] + bridge[10]*AT[16] + bridge[11]*AT[17], bk, slope, ceil);
+                dataDst[(rowSeg1+1)*cols + (j+3)] = ACSAActivate<Dtype>(bridge[ 6]*AT[18] + bridge[ 7]*AT[19] + bridge[ 8]*AT[20] + bridge[ 9]*AT[21] + bridge[10]*AT[22] + bridge[11]*AT[23], bk, slope, ceil);
                 tileCount++;
             }
         }
         else if(rowSeg2 == 3){
 #pragma simd
             for(j = 0; j < colSeg1; j += 4){
-                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, OSTRIDE4X3);
+                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, ostride);
                 // First inverse transform for output by AT
                 TRANS_AT_FST(AT, tmp, bridge);
                 // Second inverse transform for output by AT
-                dataDst[(rowSeg1+0)*cols + (j+0)] = bridge[ 0]*AT[ 0] + bridge[ 1]*AT[ 1] + bridge[ 2]*AT[ 2] + bridge[ 3]*AT[ 3] + bridge[ 4]*AT[ 4] + bridge[ 5]*AT[ 5];
-                dataDst[(rowSeg1+0)*cols + (j+1)] = bridge[ 0]*AT[ 6] + bridge[ 1]*AT[ 7] + bridge[ 2]*AT[ 8] + bridge[ 3]*AT[ 9] + bridge[ 4]*AT[10] + bridge[ 5]*AT[11];
-                dataDst[(rowSeg1+0)*cols + (j+2)] = bridge[ 0]*AT[12] + bridge[ 1]*AT[13] + bridge[ 2]*AT[14] + bridge[ 3]*AT[15] + bridge[ 4]*AT[16] + bridge[ 5]*AT[17];
-                dataDst[(rowSeg1+0)*cols + (j+3)] = bridge[ 0]*AT[18] + bridge[ 1]*AT[19] + bridge[ 2]*AT[20] + bridge[ 3]*AT[21] + bridge[ 4]*AT[22] + bridge[ 5]*AT[23];
-                dataDst[(rowSeg1+1)*cols + (j+0)] = bridge[ 6]*AT[ 0] + bridge[ 7]*AT[ 1] + bridge[ 8]*AT[ 2] + bridge[ 9]*AT[ 3] + bridge[10]*AT[ 4] + bridge[11]*AT[ 5];
-                dataDst[(rowSeg1+1)*cols + (j+1)] = bridge[ 6]*AT[ 6] + bridge[ 7]*AT[ 7] + bridge[ 8]*AT[ 8] + bridge[ 9]*AT[ 9] + bridge[10]*AT[10] + bridge[11]*AT[11];
-                dataDst[(rowSeg1+1)*cols + (j+2)] = bridge[ 6]*AT[12] + bridge[ 7]*AT[13] + bridge[ 8]*AT[14] + bridge[ 9]*AT[15] + bridge[10]*AT[16] + bridge[11]*AT[17];
-                dataDst[(rowSeg1+1)*cols + (j+3)] = bridge[ 6]*AT[18] + bridge[ 7]*AT[19] + bridge[ 8]*AT[20] + bridge[ 9]*AT[21] + bridge[10]*AT[22] + bridge[11]*AT[23];
-                dataDst[(rowSeg1+2)*cols + (j+0)] = bridge[12]*AT[ 0] + bridge[13]*AT[ 1] + bridge[14]*AT[ 2] + bridge[15]*AT[ 3] + bridge[16]*AT[ 4] + bridge[17]*AT[ 5];
-                dataDst[(rowSeg1+2)*cols + (j+1)] = bridge[12]*AT[ 6] + bridge[13]*AT[ 7] + bridge[14]*AT[ 8] + bridge[15]*AT[ 9] + bridge[16]*AT[10] + bridge[17]*AT[11];
-                dataDst[(rowSeg1+2)*cols + (j+2)] = bridge[12]*AT[12] + bridge[13]*AT[13] + bridge[14]*AT[14] + bridge[15]*AT[15] + bridge[16]*AT[16] + bridge[17]*AT[17];
-                dataDst[(rowSeg1+2)*cols + (j+3)] = bridge[12]*AT[18] + bridge[13]*AT[19] + bridge[14]*AT[20] + bridge[15]*AT[21] + bridge[16]*AT[22] + bridge[17]*AT[23];
+                dataDst[(rowSeg1+0)*cols + (j+0)] = ACSAActivate<Dtype>(bridge[ 0]*AT[ 0] + bridge[ 1]*AT[ 1] + bridge[ 2]*AT[ 2] + bridge[ 3]*AT[ 3] + bridge[ 4]*AT[ 4] + bridge[ 5]*AT[ 5], bk, slope, ceil);
+                dataDst[(rowSeg1+0)*cols + (j+1)] = ACSAActivate<Dtype>(bridge[ 0]*AT[ 6] + bridge[ 1]*AT[ 7] + bridge[ 2]*AT[ 8] + bridge[ 3]*AT[ 9] + bridge[ 4]*AT[10] + bridge[ 5]*AT[11], bk, slope, ceil);
+                dataDst[(rowSeg1+0)*cols + (j+2)] = ACSAActivate<Dtype>(bridge[ 0]*AT[12] + bridge[ 1]*AT[13] + bridge[ 2]*AT[14] + bridge[ 3]*AT[15] + bridge[ 4]*AT[16] + bridge[ 5]*AT[17], bk, slope, ceil);
+                dataDst[(rowSeg1+0)*cols + (j+3)] = ACSAActivate<Dtype>(bridge[ 0]*AT[18] + bridge[ 1]*AT[19] + bridge[ 2]*AT[20] + bridge[ 3]*AT[21] + bridge[ 4]*AT[22] + bridge[ 5]*AT[23], bk, slope, ceil);
+                dataDst[(rowSeg1+1)*cols + (j+0)] = ACSAActivate<Dtype>(bridge[ 6]*AT[ 0] + bridge[ 7]*AT[ 1] + bridge[ 8]*AT[ 2] + bridge[ 9]*AT[ 3] + bridge[10]*AT[ 4] + bridge[11]*AT[ 5], bk, slope, ceil);
+                dataDst[(rowSeg1+1)*cols + (j+1)] = ACSAActivate<Dtype>(bridge[ 6]*AT[ 6] + bridge[ 7]*AT[ 7] + bridge[ 8]*AT[ 8] + bridge[ 9]*AT[ 9] + bridge[10]*AT[10] + bridge[11]*AT[11], bk, slope, ceil);
+                dataDst[(rowSeg1+1)*cols + (j+2)] = ACSAActivate<Dtype>(bridge[ 6]*AT[12] + bridge[ 7]*AT[13] + bridge[ 8]*AT[14] + bridge[ 9]*AT[15] + bridge[10]*AT[16] + bridge[11]*AT[17], bk, slope, ceil);
+                dataDst[(rowSeg1+1)*cols + (j+3)] = ACSAActivate<Dtype>(bridge[ 6]*AT[18] + bridge[ 7]*AT[19] + bridge[ 8]*AT[20] + bridge[ 9]*AT[21] + bridge[10]*AT[22] + bridge[11]*AT[23], bk, slope, ceil);
+                dataDst[(rowSeg1+2)*cols + (j+0)] = ACSAActivate<Dtype>(bridge[12]*AT[ 0] + bridge[13]*AT[ 1] + bridge[14]*AT[ 2] + bridge[15]*AT[ 3] + bridge[16]*AT[ 4] + bridge[17]*AT[ 5], bk, slope, ceil);
+                dataDst[(rowSeg1+2)*cols + (j+1)] = ACSAActivate<Dtype>(bridge[12]*AT[ 6] + bridge[13]*AT[ 7] + bridge[14]*AT[ 8] + bridge[15]*AT[ 9] + bridge[16]*AT[10] + bridge[17]*AT[11], bk, slope, ceil);
+                dataDst[(rowSeg1+2)*cols + (j+2)] = ACSAActivate<Dtype>(bridge[12]*AT[12] + bridge[13]*AT[13] + bridge[14]*AT[14] + bridge[15]*AT[15] + bridge[16]*AT[16] + bridge[17]*AT[17], bk, slope, ceil);
+                dataDst[(rowSeg1+2)*cols + (j+3)] = ACSAActivate<Dtype>(bridge[12]*AT[18] + bridge[13]*AT[19] + bridge[14]*AT[20] + bridge[15]*AT[21] + bridge[16]*AT[22] + bridge[17]*AT[23], bk, slope, ceil);
                 tileCount++; 
             }
         }
 
         // Process row&col tail
         if((rowSeg2 != 0) && (colSeg2 != 0)){
-            GET_OUTPUT_TILE(tmp, dataSrc, tileCount, OSTRIDE4X3);
+            GET_OUTPUT_TILE(tmp, dataSrc, tileCount, ostride);
             // First inverse transfrom for output data by AT
             TRANS_AT_FST(AT, tmp, bridge);
             // Second inverse transfrom for output data by AT
             TRANS_AT_SED(bridge, AT, middle);
 
+            ACSAActivateTile(middle, 16, bk, slope, ceil);
+
             ACSAGetFinalOutput(dataDst, middle, 4, 4, rowSeg1, colSeg1, cols, 0, ZERO_LENGTH(rowSeg2), 0, ZERO_LENGTH(colSeg2));
             tileCount++; 
         }
     }
 }
 
+/* Compute the bridge data for out, transform and max pool 2x2 to form the pooled matrix C. */
+    template<typename Dtype>
+static void outByTransformPool(Dtype *out, const Dtype *dataSrc,
+        const int N, const int K, const int rows, const int cols,
+        const int ntiles, const int mg4x3,
+        const long ostride,
+        const Dtype *bias, const Dtype slope, const Dtype ceil)
+{
+    int d1;
+    const int pcols = cols/2;
+    const int sizeP = (rows/2) * pcols;
+
+#pragma omp parallel for private(d1)
+    for(d1 = 0; d1 < N*K; d1++){
+        int i, j;
+        Dtype tmp[36] __attribute__((aligned(64)));
+        Dtype bridge[24] __attribute__((aligned(64)));
+        Dtype middle[16] __attribute__((aligned(64)));
+
+        const int t1 = d1/(K*mg4x3);
+        const int t2 = (d1%(K*mg4x3))/mg4x3;
+        const int t3 = d1%mg4x3;
+
+        Dtype *dataDst = out + (t1*mg4x3*K + t3*K + t2)*sizeP;
+
+        const Dtype bk = (bias == NULL) ? (Dtype)0 : bias[t2];
+        int tileCount = d1*ntiles;
+
+        // Tails are even too, tiles are visited in the same order as outByTransform
+        for(i = 0; i < rows; i += 4){
+            for(j = 0; j < cols; j += 4){
+                GET_OUTPUT_TILE(tmp, dataSrc, tileCount, ostride);
+                TRANS_AT_FST(AT, tmp, bridge);
+                TRANS_AT_SED(bridge, AT, middle);
+
+                ACSAActivateTile(middle, 16, bk, slope, ceil);
+
+                ACSAPoolTileMax(dataDst, middle, 4, std::min(4, rows-i), std::min(4, cols-j), i, j, pcols);
+                tileCount++;
+            }
+        }
+    }
+}
+
 /* Process the data tail. */
 static void tailPreProcess(ACSATensor4d *tensorOut, ACSATailMessage &tailMess, int &ntiles)
 {
@@ -1383,12 +1438,64 @@ static void tailPreProcess(ACSATensor4d *tensorOut, ACSATailMessage &tailMess, i
         ntiles *= out_w/4 +1;
 }
 
-/* API for winograd F(6,3). */
+/* Compute the stride of every transform point for bridge data. */
+    template<typename Dtype>
+static void bridgeStride(ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess, long &istride, long &fstride, long &ostride)
+{
+    const int N = tensorIn->n_;
+    const int C = tensorIn->c_;
+    const int K = tensorFilter->n_;
+    int ntiles;
+    ACSATailMessage tailMess;
+
+    tailPreProcess(tensorOut, tailMess, ntiles);
+
+    int b_bts = winoMess->batch_block_;
+    if(b_bts == 0 || b_bts > N)
+        b_bts = N;
+
+    // Depthwise keeps no bridge data, only the transformed filters
+    if(ACSAIsDepthwise(tensorIn, tensorFilter)){
+        istride = ostride = 0;
+        fstride = no4k_aligned((long)K, sizeof(Dtype));
+        return;
+    }
+
+    // The fused pipeline keeps its blocks after the filter, see ACSAWinoPipelineBytes
+    if(ACSAWinoFused(tensorIn, tensorOut, winoMess)){
+        istride = ostride = 0;
+        fstride = no4k_aligned((long)C*K, sizeof(Dtype));
+        return;
+    }
+
+    istride = no4k_aligned((long)b_bts*ntiles*C, sizeof(Dtype));
+    fstride = no4k_aligned((long)C*K, sizeof(Dtype));
+    ostride = no4k_aligned((long)b_bts*ntiles*K, sizeof(Dtype));
+}
+
+/* Winograd F(4,3) with the filter already transformed. */
     template<typename Dtype>
-ACSAStatus ACSAWinoConvolution_4x3(const Dtype *in, const Dtype *filter, Dtype *out,
+static ACSAStatus winoConvolution(const Dtype *in, const Dtype *wino_filter, const long fstride, const ACSAWinoFilter *wfilter,
+        Dtype *out,
         ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
-        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess)
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        Dtype *wino_in, const long istride, Dtype *wino_out, const long ostride,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
 {
+    // Depthwise has no gemm, the element-wise kernel takes any schedule and layout
+    if(ACSAIsDepthwise(tensorIn, tensorFilter))
+        return ACSAWinoDepthwise<Dtype, 4>(BT, AT, in, wino_filter, fstride, out,
+                tensorIn, tensorFilter, tensorOut, convMess,
+                bias, activMess, poolMess);
+
+    // Only the fused pipeline reads and writes layouts other than NCHW or 16-bit bridges,
+    // its blocks take the place of wino_out
+    if(ACSAWinoFused(tensorIn, tensorOut, winoMess))
+        return ACSAWinoPipeline<Dtype, 4>(BT, AT, in, wino_filter, fstride, wfilter, out,
+                tensorIn, tensorFilter, tensorOut, convMess, winoMess, (void *)wino_out,
+                bias, activMess, poolMess);
+
     const int N = tensorIn->n_;
     const int C = tensorIn->c_;
     const int H = tensorIn->h_;
@@ -1407,20 +1514,24 @@ ACSAStatus ACSAWinoConvolution_4x3(const Dtype *in, const Dtype *filter, Dtype *
 
     tailPreProcess(tensorOut, tailMess, ntiles);
 
+    Dtype slope, ceil;
+    ACSAActivParam(activMess, slope, ceil);
+
     const Dtype *b_in;
     Dtype *b_out;
 
-    int b_bts = 64;
-    if(b_bts == 0)
+    int b_bts = bb4x3;
+    if(b_bts == 0 || b_bts > N)
         b_bts = N;
 
-    Dtype *wino_in = (Dtype *)winoIn;
-    Dtype *wino_filter = (Dtype *)winoFilter; 
-    Dtype *wino_out = (Dtype *)winoOut;
 
     // Check
-    ACSA_CHECK((N%b_bts == 0));
-    ACSA_CHECK(((pad_h < 2) || (pad_w < 2)));
+    ACSA_CHECK(((pad_h < 2) && (pad_w < 2)));
+    if(poolMess != NULL)
+        ACSA_CHECK(ACSAPoolFusible(poolMess, outHeight, outWidth));
+
+    /* Pooled plane is a quarter of the convolution output. */
+    const int sizeO = (poolMess == NULL) ? outHeight*outWidth : (outHeight/2)*(outWidth/2);
 
     /* Get the needed threads number. */
     int num_threads;
@@ -1430,70 +1541,241 @@ ACSAStatus ACSAWinoConvolution_4x3(const Dtype *in, const Dtype *filter, Dtype *
         num_threads = omp_get_num_threads();
     }
 
-    filterByTransform(filter, wino_filter, C, K);
     for(int i = 0; i < N; i += b_bts){
+        // The last block takes the rest of the batch, and the merge
+        // falls back to 1 if it doesn't divide that block.
+        const int nb = std::min(b_bts, N-i);
+        const int mg = (nb%mg4x3 == 0) ? mg4x3 : 1;
+
         b_in = in + i*C*H*W;
-        b_out = out + i*K*outHeight*outWidth;
+        b_out = out + i*K*sizeO;
         if(pad_h == 0 && pad_w == 0)
-            inByTransform_nopad(b_in, wino_in, b_bts, C, H, W, &tailMess, ntiles, mg4x3);
+            inByTransform_nopad(b_in, wino_in, nb, C, H, W, &tailMess, ntiles, mg, istride);
         else if(H*W > 1225)
-            inByTransform_padBigScale(b_in, wino_in, b_bts, C, H, W, pad_h, pad_w, &tailMess, ntiles, mg4x3);
+            inByTransform_padBigScale(b_in, wino_in, nb, C, H, W, pad_h, pad_w, &tailMess, ntiles, mg, istride);
         else{
             Dtype *in_pad = (Dtype *)mkl_malloc(num_threads*(H+2*pad_h)*(W+2*pad_w)*sizeof(Dtype), 64);
             memset(in_pad, 0, num_threads*(H+2*pad_h)*(W+2*pad_w)*sizeof(Dtype));
-            inByTransform_padSmallScale(b_in, in_pad, wino_in, N, C, H, W, pad_h, pad_w, &tailMess, ntiles, mg4x3);
+            inByTransform_padSmallScale(b_in, in_pad, wino_in, nb, C, H, W, pad_h, pad_w, &tailMess, ntiles, mg, istride);
             mkl_free(in_pad);
         }
-        matrix_compute(wino_in, mg4x3*ntiles, C, wino_filter, C, K, wino_out, b_bts/mg4x3);
-        outByTransform(b_out, wino_out, b_bts, K, outHeight, outWidth, &tailMess, ntiles, mg4x3);
+        matrix_compute(wino_in, mg*ntiles, C, istride, wino_filter, C, K, fstride, wino_out, ostride, nb/mg, winoMess->gemm_);
+        if(poolMess == NULL)
+            outByTransform(b_out, wino_out, nb, K, outHeight, outWidth, &tailMess, ntiles, mg, ostride, bias, slope, ceil);
+        else
+            outByTransformPool(b_out, wino_out, nb, K, outHeight, outWidth, ntiles, mg, ostride, bias, slope, ceil);
+    }
+
+    return ACSASUCCESS;
+}
+
+/* Bytes of workspace needed by winograd F(4,3). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_4x3(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess)
+{
+    long istride, fstride, ostride;
+
+    bridgeStride<Dtype>(tensorIn, tensorFilter, tensorOut, winoMess, istride, fstride, ostride);
+    size = 36*(istride+fstride+ostride)*sizeof(Dtype) +
+        ACSAWinoPipelineBytes<Dtype>(4, 4, tensorIn, tensorFilter, tensorOut, winoMess, omp_get_max_threads());
+
+    return ACSASUCCESS;
+}
+
+/* API for winograd F(4,3). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_4x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    const int C = tensorFilter->c_;
+    const int K = tensorFilter->n_;
+    long istride, fstride, ostride;
+
+    bridgeStride<Dtype>(tensorIn, tensorFilter, tensorOut, winoMess, istride, fstride, ostride);
+
+    Dtype *wino_in = (Dtype *)ACSAReserveWorkspace(handle, 36*(istride+fstride+ostride)*sizeof(Dtype) +
+            ACSAWinoPipelineBytes<Dtype>(4, 4, tensorIn, tensorFilter, tensorOut, winoMess, handle->num_threads_));
+    if(wino_in == NULL)
+        return ACSAFAIL;
+    Dtype *wino_filter = wino_in + 36*istride;
+    Dtype *wino_out = wino_filter + 36*fstride;
+
+    const int nthreads = omp_get_max_threads();
+    omp_set_num_threads(handle->num_threads_);
+    filterByTransform(filter, wino_filter, C, K, fstride);
+    ACSAStatus ret = winoConvolution((const Dtype *)in, (const Dtype *)wino_filter, fstride, (const ACSAWinoFilter *)NULL, out,
+            tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+            wino_in, istride, wino_out, ostride,
+            bias, activMess, poolMess);
+    omp_set_num_threads(nthreads);
+
+    return ret;
+}
+
+/* API for winograd F(4,3) with the pre-transformed filter. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_4x3(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    long istride, fstride, ostride;
+
+    // Check
+    ACSA_CHECK((wfilter->algo_ == ACSA_WINOGRAD_4X3));
+    ACSA_CHECK(((wfilter->c_*convMess->groups_ == tensorIn->c_) && (wfilter->k_ == tensorFilter->n_)));
+    if(!ACSAWinoFilterFits<Dtype>(wfilter, winoMess)){
+        ACSA_MESSAGE("ERROR: The filter was transformed for another type or bridge!");
+        return ACSAFAIL;
     }
 
+    bridgeStride<Dtype>(tensorIn, tensorFilter, tensorOut, winoMess, istride, fstride, ostride);
+
+    Dtype *wino_in = (Dtype *)ACSAReserveWorkspace(handle, 36*(istride+fstride+ostride)*sizeof(Dtype) +
+            ACSAWinoPipelineBytes<Dtype>(4, 4, tensorIn, tensorFilter, tensorOut, winoMess, handle->num_threads_));
+    if(wino_in == NULL)
+        return ACSAFAIL;
+    Dtype *wino_out = wino_in + 36*(istride+fstride);
+
+    const int nthreads = omp_get_max_threads();
+    omp_set_num_threads(handle->num_threads_);
+    ACSAStatus ret = winoConvolution(in, (const Dtype *)wfilter->data_, wfilter->stride_, wfilter, out,
+            tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+            wino_in, istride, wino_out, ostride,
+            bias, activMess, poolMess);
+    omp_set_num_threads(nthreads);
+
+    return ret;
+}
+
+/* Transform the filter of F(4,3) into the layout of bridge data. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoFilterTransform_4x3(const Dtype *filter, Dtype *wino_filter,
+        const int C, const int K, const long fstride)
+{
+    filterByTransform(filter, wino_filter, C, K, fstride);
+
     return ACSASUCCESS;
 }
 
+/* Filter gradient of winograd F(4,3). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoBwdFilter_4x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess)
+{
+    return ACSAWinoBwdFilter<Dtype, 4>(BT, AT, G, handle, in, diffOut, diffFilter,
+            tensorIn, tensorFilter, tensorOut, convMess);
+}
+
 /* Instantiate Template */
 template void inByTransform_nopad<float>(const float *, float *,
         const int, const int, const int, const int,
-        ACSATailMessage *, const int, const int);
+        ACSATailMessage *, const int, const int, const long);
 template void inByTransform_padBigScale<float>(const float *, float *,
         const int, const int, const int, const int,
         const int, const int,
-        ACSATailMessage *, const int, const int);
+        ACSATailMessage *, const int, const int, const long);
 template void inByTransform_padSmallScale<float>(const float *, float *, float *,
         const int, const int, const int, const int,
         const int, const int,
-        ACSATailMessage *, const int, const int);
+        ACSATailMessage *, const int, const int, const long);
 template void filterByTransform<float>(const float *, float *,
-        const int, const int);
-template void matrix_compute<float>(const float *, const int, const int,
-        const float *, const int, const int,
-        float *, const int);
+        const int, const int, const long);
+template void matrix_compute<float>(const float *, const int, const int, const long,
+        const float *, const int, const int, const long,
+        float *, const long, const int, const ACSAGemmMode);
 template void outByTransform<float>(float *, const float *,
         const int, const int, const int, const int,
-        ACSATailMessage *, const int, const int);
-template ACSAStatus ACSAWinoConvolution_4x3<float>(const float *, const float *, float *,
+        ACSATailMessage *, const int, const int, const long,
+        const float *, const float, const float);
+template void outByTransformPool<float>(float *, const float *,
+        const int, const int, const int, const int,
+        const int, const int, const long,
+        const float *, const float, const float);
+template void bridgeStride<float>(ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*, long &, long &, long &);
+template ACSAStatus winoConvolution<float>(const float *, const float *, const long, const ACSAWinoFilter *,
+        float *,
         ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
-        ACSAConvMessage*, ACSAWinoMessage*);
+        ACSAConvMessage*, ACSAWinoMessage*,
+        float *, const long, float *, const long,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoWorkspaceSize_4x3<float>(size_t &,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*);
+template ACSAStatus ACSAWinoConvolution_4x3<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoConvolution_4x3<float>(ACSAHandle *,
+        const float *, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoFilterTransform_4x3<float>(const float *, float *,
+        const int, const int, const long);
+template ACSAStatus ACSAWinoBwdFilter_4x3<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
 
 template void inByTransform_nopad<double>(const double *, double *,
         const int, const int, const int, const int,
-        ACSATailMessage *, const int, const int);
+        ACSATailMessage *, const int, const int, const long);
 template void inByTransform_padBigScale<double>(const double *, double *,
         const int, const int, const int, const int,
         const int, const int,
-        ACSATailMessage *, const int, const int);
+        ACSATailMessage *, const int, const int, const long);
 template void inByTransform_padSmallScale<double>(const double *, double *, double *,
         const int, const int, const int, const int,
         const int, const int,
-        ACSATailMessage *, const int, const int);
+        ACSATailMessage *, const int, const int, const long);
 template void filterByTransform<double>(const double *, double *,
-        const int, const int);
-template void matrix_compute<double>(const double *, const int, const int,
-        const double *, const int, const int,
-        double *, const int);
+        const int, const int, const long);
+template void matrix_compute<double>(const double *, const int, const int, const long,
+        const double *, const int, const int, const long,
+        double *, const long, const int, const ACSAGemmMode);
 template void outByTransform<double>(double *, const double *,
         const int, const int, const int, const int,
-        ACSATailMessage *, const int, const int);
-template ACSAStatus ACSAWinoConvolution_4x3<double>(const double *, const double *, double *,
+        ACSATailMessage *, const int, const int, const long,
+        const double *, const double, const double);
+template void outByTransformPool<double>(double *, const double *,
+        const int, const int, const int, const int,
+        const int, const int, const long,
+        const double *, const double, const double);
+template void bridgeStride<double>(ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*, long &, long &, long &);
+template ACSAStatus winoConvolution<double>(const double *, const double *, const long, const ACSAWinoFilter *,
+        double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        double *, const long, double *, const long,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoWorkspaceSize_4x3<double>(size_t &,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*);
+template ACSAStatus ACSAWinoConvolution_4x3<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoConvolution_4x3<double>(ACSAHandle *,
+        const double *, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoFilterTransform_4x3<double>(const double *, double *,
+        const int, const int, const long);
+template ACSAStatus ACSAWinoBwdFilter_4x3<double>(ACSAHandle *,
+        const double *, const double *, double *,
         ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
-        ACSAConvMessage*, ACSAWinoMessage*);
+        ACSAConvMessage*);
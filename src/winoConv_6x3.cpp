@@ -3,9 +3,6 @@
 #include <immintrin.h>
 #include "dnn.hpp"
 
-const long ISTRIDE6X3 = ISTRIDE/64*16;
-const long FSTRIDE6X3 = FSTRIDE;
-const long OSTRIDE6X3 = OSTRIDE/64*16;
 
 static const float AT[48] = {
     1, 1,  1,  1,   1,      1,      1,  0,
@@ -41,72 +38,72 @@ static const float BT[64] = {
 /* Compute transformed data for input by BT.
  * */
     template<typename Dtype>
-static inline void transformByBT(Dtype *dsrc, Dtype *ddst, int tileCount)
+static inline void transformByBT(Dtype *dsrc, Dtype *ddst, int tileCount, const long istride)
 {
-    ddst[tileCount + 0*ISTRIDE6X3] = (dsrc[0 ] - dsrc[6 ] - dsrc[48] + dsrc[54]) + (-dsrc[2 ] + dsrc[4 ] - dsrc[16] + dsrc[22] + dsrc[32] - dsrc[38] + dsrc[50] - dsrc[52])*5.25 + (dsrc[18] - dsrc[20] - dsrc[34] + dsrc[36])*27.5625;
-    ddst[tileCount + 1*ISTRIDE6X3] = (dsrc[1 ] + dsrc[2 ] + dsrc[5 ] + dsrc[6 ] - dsrc[49] - dsrc[50] - dsrc[53] - dsrc[54]) + (-dsrc[3 ] - dsrc[4 ] + dsrc[51] + dsrc[52])*4.25 + (-dsrc[17] - dsrc[18] - dsrc[21] - dsrc[22] + dsrc[33] + dsrc[34] + dsrc[37] + dsrc[38])*5.25 + (dsrc[19] + dsrc[20] - dsrc[35] - dsrc[36])*22.3125;
-    ddst[tileCount + 2*ISTRIDE6X3] = (-dsrc[1 ] + dsrc[2 ] - dsrc[5 ] + dsrc[6 ] + dsrc[49] - dsrc[50] + dsrc[53] - dsrc[54]) + (dsrc[3 ] - dsrc[4 ] - dsrc[51] + dsrc[52])*4.25 + (dsrc[17] - dsrc[18] + dsrc[21] - dsrc[22] - dsrc[33] + dsrc[34] - dsrc[37] + dsrc[38])*5.25 + (-dsrc[19] + dsrc[20] + dsrc[35] - dsrc[36])*22.3125;
-    ddst[tileCount + 3*ISTRIDE6X3] = (dsrc[2 ] - dsrc[50])*0.25 + (dsrc[1 ] - dsrc[49])*0.5 + (dsrc[6 ] - dsrc[54]) + (-dsrc[4 ] + dsrc[52])*1.25 + (-dsrc[18] + dsrc[34])*1.3125 + (dsrc[5 ] - dsrc[53])*2 + (-dsrc[3 ] + dsrc[51])*2.5 + (-dsrc[17] + dsrc[33])*2.625 + (-dsrc[22] + dsrc[38])*5.25 + (dsrc[20] - dsrc[36])*6.5625 + (-dsrc[21] + dsrc[37])*10.5 + (dsrc[19] - dsrc[35])*13.125;
-    ddst[tileCount + 4*ISTRIDE6X3] = (dsrc[2 ] - dsrc[50])*0.25 + (-dsrc[1 ] + dsrc[49])*0.5 + (dsrc[6 ] - dsrc[54]) + (-dsrc[4 ] + dsrc[52])*1.25 + (-dsrc[18] + dsrc[34])*1.3125 + (-dsrc[5 ] + dsrc[53])*2 + (dsrc[3 ] - dsrc[51])*2.5 + (dsrc[17] - dsrc[33])*2.625 + (-dsrc[22] + dsrc[38])*5.25 + (dsrc[20] - dsrc[36])*6.5625 + (dsrc[21] - dsrc[37])*10.5 + (-dsrc[19] + dsrc[35])*13.125;
-    ddst[tileCount + 5*ISTRIDE6X3] = (dsrc[5 ] - dsrc[53])*0.5 + (dsrc[6 ] - dsrc[54]) + (dsrc[1 ] - dsrc[49])*2 + (-dsrc[3 ] + dsrc[51])*2.5 + (-dsrc[21] + dsrc[37])*2.625 + (dsrc[2 ] - dsrc[50])*4 + (-dsrc[4 ] + dsrc[52])*5 + (-dsrc[22] + dsrc[38])*5.25 + (-dsrc[17] + dsrc[33])*10.5 + (dsrc[19] - dsrc[35])*13.125 + (-dsrc[18] + dsrc[34])*21 + (dsrc[20] - dsrc[36])*26.25;
-    ddst[tileCount + 6*ISTRIDE6X3] = (-dsrc[5 ] + dsrc[53])*0.5 + (dsrc[6 ] - dsrc[54]) + (-dsrc[1 ] + dsrc[49])*2 + (dsrc[3 ] - dsrc[51])*2.5 + (dsrc[21] - dsrc[37])*2.625 + (dsrc[2 ] - dsrc[50])*4 + (-dsrc[4 ] + dsrc[52])*5 + (-dsrc[22] + dsrc[38])*5.25 + (dsrc[17] - dsrc[33])*10.5 + (-dsrc[19] + dsrc[35])*13.125 + (-dsrc[18] + dsrc[34])*21 + (dsrc[20] - dsrc[36])*26.25;
-    ddst[tileCount + 7*ISTRIDE6X3] = (-dsrc[1 ] + dsrc[7 ] + dsrc[49] - dsrc[55]) + (dsrc[3 ] - dsrc[5 ] + dsrc[17] - dsrc[23] - dsrc[33] + dsrc[39] - dsrc[51] + dsrc[53])*5.25 + (-dsrc[19] + dsrc[21] + dsrc[35] - dsrc[37])*27.5625;
-    ddst[tileCount + 8*ISTRIDE6X3] = (dsrc[8 ] - dsrc[14] + dsrc[16] - dsrc[22] + dsrc[40] - dsrc[46] + dsrc[48] - dsrc[54]) + (-dsrc[24] + dsrc[30] - dsrc[32] + dsrc[38])*4.25 + (-dsrc[10] + dsrc[12] - dsrc[18] + dsrc[20] - dsrc[42] + dsrc[44] - dsrc[50] + dsrc[52])*5.25 + (dsrc[26] - dsrc[28] + dsrc[34] - dsrc[36])*22.3125;
-    ddst[tileCount + 9*ISTRIDE6X3] = (dsrc[9 ] + dsrc[10] + dsrc[13] + dsrc[14] + dsrc[17] + dsrc[18] + dsrc[21] + dsrc[22] + dsrc[41] + dsrc[42] + dsrc[45] + dsrc[46] + dsrc[49] + dsrc[50] + dsrc[53] + dsrc[54]) + (-dsrc[11] - dsrc[12] - dsrc[19] - dsrc[20] - dsrc[25] - dsrc[26] - dsrc[29] - dsrc[30] - dsrc[33] - dsrc[34] - dsrc[37] - dsrc[38] - dsrc[43] - dsrc[44] - dsrc[51] - dsrc[52])*4.25 + (dsrc[27] + dsrc[28] + dsrc[35] + dsrc[36])*18.0625;
-    ddst[tileCount +10*ISTRIDE6X3] = (-dsrc[9 ] + dsrc[10] - dsrc[13] + dsrc[14] - dsrc[17] + dsrc[18] - dsrc[21] + dsrc[22] - dsrc[41] + dsrc[42] - dsrc[45] + dsrc[46] - dsrc[49] + dsrc[50] - dsrc[53] + dsrc[54]) + (dsrc[11] - dsrc[12] + dsrc[19] - dsrc[20] + dsrc[25] - dsrc[26] + dsrc[29] - dsrc[30] + dsrc[33] - dsrc[34] + dsrc[37] - dsrc[38] + dsrc[43] - dsrc[44] + dsrc[51] - dsrc[52])*4.25 + (-dsrc[27] + dsrc[28] - dsrc[35] + dsrc[36])*18.0625;
-    ddst[tileCount +11*ISTRIDE6X3] = (dsrc[10] + dsrc[18] + dsrc[42] + dsrc[50])*0.25 + (dsrc[9 ] + dsrc[17] + dsrc[41] + dsrc[49])*0.5 + (dsrc[14] + dsrc[22] + dsrc[46] + dsrc[54]) + (-dsrc[26] - dsrc[34])*1.0625 + (-dsrc[12] - dsrc[20] - dsrc[44] - dsrc[52])*1.25 + (dsrc[13] + dsrc[21] + dsrc[45] + dsrc[53])*2 + (-dsrc[25] - dsrc[33])*2.125 + (-dsrc[11] - dsrc[19] - dsrc[43] - dsrc[51])*2.5 + (-dsrc[30] - dsrc[38])*4.25 + (dsrc[28] + dsrc[36])*5.3125 + (-dsrc[29] - dsrc[37])*8.5 + (dsrc[27] + dsrc[35])*10.625;
-    ddst[tileCount +12*ISTRIDE6X3] = (dsrc[10] + dsrc[18] + dsrc[42] + dsrc[50])*0.25 + (-dsrc[9 ] - dsrc[17] - dsrc[41] - dsrc[49])*0.5 + (dsrc[14] + dsrc[22] + dsrc[46] + dsrc[54]) + (-dsrc[26] - dsrc[34])*1.0625 + (-dsrc[12] - dsrc[20] - dsrc[44] - dsrc[52])*1.25 + (-dsrc[13] - dsrc[21] - dsrc[45] - dsrc[53])*2 + (dsrc[25] + dsrc[33])*2.125 + (dsrc[11] + dsrc[19] + dsrc[43] + dsrc[51])*2.5 + (-dsrc[30] - dsrc[38])*4.25 + (dsrc[28] + dsrc[36])*5.3125 + (dsrc[29] + dsrc[37])*8.5 + (-dsrc[27] - dsrc[35])*10.625;
-    ddst[tileCount +13*ISTRIDE6X3] = (dsrc[13] + dsrc[21] + dsrc[45] + dsrc[53])*0.5 + (dsrc[14] + dsrc[22] + dsrc[46] + dsrc[54]) + (dsrc[9 ] + dsrc[17] + dsrc[41] + dsrc[49])*2 + (-dsrc[29] - dsrc[37])*2.125 + (-dsrc[11] - dsrc[19] - dsrc[43] - dsrc[51])*2.5 + (dsrc[10] + dsrc[18] + dsrc[42] + dsrc[50])*4 + (-dsrc[30] - dsrc[38])*4.25 + (-dsrc[12] - dsrc[20] - dsrc[44] - dsrc[52])*5 + (-dsrc[25] - dsrc[33])*8.5 + (dsrc[27] + dsrc[35])*10.625 + (-dsrc[26] - dsrc[34])*17 + (dsrc[28] + dsrc[36])*21.25;
-    ddst[tileCount +14*ISTRIDE6X3] = (-dsrc[13] - dsrc[21] - dsrc[45] - dsrc[53])*0.5 + (dsrc[14] + dsrc[22] + dsrc[46] + dsrc[54]) + (-dsrc[9 ] - dsrc[17] - dsrc[41] - dsrc[49])*2 + (dsrc[29] + dsrc[37])*2.125 + (dsrc[11] + dsrc[19] + dsrc[43] + dsrc[51])*2.5 + (dsrc[10] + dsrc[18] + dsrc[42] + dsrc[50])*4 + (-dsrc[30] - dsrc[38])*4.25 + (-dsrc[12] - dsrc[20] - dsrc[44] - dsrc[52])*5 + (dsrc[25] + dsrc[33])*8.5 + (-dsrc[27] - dsrc[35])*10.625 + (-dsrc[26] - dsrc[34])*17 + (dsrc[28] + dsrc[36])*21.25;
-    ddst[tileCount +15*ISTRIDE6X3] = (-dsrc[9 ] + dsrc[15] - dsrc[17] + dsrc[23] - dsrc[41] + dsrc[47] - dsrc[49] + dsrc[55]) + (dsrc[25] - dsrc[31] + dsrc[33] - dsrc[39])*4.25 + (dsrc[11] - dsrc[13] + dsrc[19] - dsrc[21] + dsrc[43] - dsrc[45] + dsrc[51] - dsrc[53])*5.25 + (-dsrc[27] + dsrc[29] - dsrc[35] + dsrc[37])*22.3125;
-    ddst[tileCount +16*ISTRIDE6X3] = (-dsrc[8 ] + dsrc[14] + dsrc[16] - dsrc[22] - dsrc[40] + dsrc[46] + dsrc[48] - dsrc[54]) + (dsrc[24] - dsrc[30] - dsrc[32] + dsrc[38])*4.25 + (dsrc[10] - dsrc[12] - dsrc[18] + dsrc[20] + dsrc[42] - dsrc[44] - dsrc[50] + dsrc[52])*5.25 + (-dsrc[26] + dsrc[28] + dsrc[34] - dsrc[36])*22.3125;
-    ddst[tileCount +17*ISTRIDE6X3] = (-dsrc[9 ] - dsrc[10] - dsrc[13] - dsrc[14] + dsrc[17] + dsrc[18] + dsrc[21] + dsrc[22] - dsrc[41] - dsrc[42] - dsrc[45] - dsrc[46] + dsrc[49] + dsrc[50] + dsrc[53] + dsrc[54]) + (dsrc[11] + dsrc[12] - dsrc[19] - dsrc[20] + dsrc[25] + dsrc[26] + dsrc[29] + dsrc[30] - dsrc[33] - dsrc[34] - dsrc[37] - dsrc[38] + dsrc[43] + dsrc[44] - dsrc[51] - dsrc[52])*4.25 + (-dsrc[27] - dsrc[28] + dsrc[35] + dsrc[36])*18.0625;
-    ddst[tileCount +18*ISTRIDE6X3] = (dsrc[9 ] - dsrc[10] + dsrc[13] - dsrc[14] - dsrc[17] + dsrc[18] - dsrc[21] + dsrc[22] + dsrc[41] - dsrc[42] + dsrc[45] - dsrc[46] - dsrc[49] + dsrc[50] - dsrc[53] + dsrc[54]) + (-dsrc[11] + dsrc[12] + dsrc[19] - dsrc[20] - dsrc[25] + dsrc[26] - dsrc[29] + dsrc[30] + dsrc[33] - dsrc[34] + dsrc[37] - dsrc[38] - dsrc[43] + dsrc[44] + dsrc[51] - dsrc[52])*4.25 + (dsrc[27] - dsrc[28] - dsrc[35] + dsrc[36])*18.0625;
-    ddst[tileCount +19*ISTRIDE6X3] = (-dsrc[10] + dsrc[18] - dsrc[42] + dsrc[50])*0.25 + (-dsrc[9 ] + dsrc[17] - dsrc[41] + dsrc[49])*0.5 + (-dsrc[14] + dsrc[22] - dsrc[46] + dsrc[54]) + (dsrc[26] - dsrc[34])*1.0625 + (dsrc[12] - dsrc[20] + dsrc[44] - dsrc[52])*1.25 + (-dsrc[13] + dsrc[21] - dsrc[45] + dsrc[53])*2 + (dsrc[25] - dsrc[33])*2.125 + (dsrc[11] - dsrc[19] + dsrc[43] - dsrc[51])*2.5 + (dsrc[30] - dsrc[38])*4.25 + (-dsrc[28] + dsrc[36])*5.3125 + (dsrc[29] - dsrc[37])*8.5 + (-dsrc[27] + dsrc[35])*10.625;
-    ddst[tileCount +20*ISTRIDE6X3] = (-dsrc[10] + dsrc[18] - dsrc[42] + dsrc[50])*0.25 + (dsrc[9 ] - dsrc[17] + dsrc[41] - dsrc[49])*0.5 + (-dsrc[14] + dsrc[22] - dsrc[46] + dsrc[54]) + (dsrc[26] - dsrc[34])*1.0625 + (dsrc[12] - dsrc[20] + dsrc[44] - dsrc[52])*1.25 + (dsrc[13] - dsrc[21] + dsrc[45] - dsrc[53])*2 + (-dsrc[25] + dsrc[33])*2.125 + (-dsrc[11] + dsrc[19] - dsrc[43] + dsrc[51])*2.5 + (dsrc[30] - dsrc[38])*4.25 + (-dsrc[28] + dsrc[36])*5.3125 + (-dsrc[29] + dsrc[37])*8.5 + (dsrc[27] - dsrc[35])*10.625;
-    ddst[tileCount +21*ISTRIDE6X3] = (-dsrc[13] + dsrc[21] - dsrc[45] + dsrc[53])*0.5 + (-dsrc[14] + dsrc[22] - dsrc[46] + dsrc[54]) + (-dsrc[9 ] + dsrc[17] - dsrc[41] + dsrc[49])*2 + (dsrc[29] - dsrc[37])*2.125 + (dsrc[11] - dsrc[19] + dsrc[43] - dsrc[51])*2.5 + (-dsrc[10] + dsrc[18] - dsrc[42] + dsrc[50])*4 + (dsrc[30] - dsrc[38])*4.25 + (dsrc[12] - dsrc[20] + dsrc[44] - dsrc[52])*5 + (dsrc[25] - dsrc[33])*8.5 + (-dsrc[27] + dsrc[35])*10.625 + (dsrc[26] - dsrc[34])*17 + (-dsrc[28] + dsrc[36])*21.25;
-    ddst[tileCount +22*ISTRIDE6X3] = (dsrc[13] - dsrc[21] + dsrc[45] - dsrc[53])*0.5 + (-dsrc[14] + dsrc[22] - dsrc[46] + dsrc[54]) + (dsrc[9 ] - dsrc[17] + dsrc[41] - dsrc[49])*2 + (-dsrc[29] + dsrc[37])*2.125 + (-dsrc[11] + dsrc[19] - dsrc[43] + dsrc[51])*2.5 + (-dsrc[10] + dsrc[18] - dsrc[42] + dsrc[50])*4 + (dsrc[30] - dsrc[38])*4.25 + (dsrc[12] - dsrc[20] + dsrc[44] - dsrc[52])*5 + (-dsrc[25] + dsrc[33])*8.5 + (dsrc[27] - dsrc[35])*10.625 + (dsrc[26] - dsrc[34])*17 + (-dsrc[28] + dsrc[36])*21.25;
-    ddst[tileCount +23*ISTRIDE6X3] = (dsrc[9 ] - dsrc[15] - dsrc[17] + dsrc[23] + dsrc[41] - dsrc[47] - dsrc[49] + dsrc[55]) + (-dsrc[25] + dsrc[31] + dsrc[33] - dsrc[39])*4.25 + (-dsrc[11] + dsrc[13] + dsrc[19] - dsrc[21] - dsrc[43] + dsrc[45] + dsrc[51] - dsrc[53])*5.25 + (dsrc[27] - dsrc[29] - dsrc[35] + dsrc[37])*22.3125;
-    ddst[tileCount +24*ISTRIDE6X3] = (dsrc[16] - dsrc[22])*0.25 + (dsrc[8 ] - dsrc[14])*0.5 + (dsrc[48] - dsrc[54]) + (-dsrc[32] + dsrc[38])*1.25 + (-dsrc[18] + dsrc[20])*1.3125 + (dsrc[40] - dsrc[46])*2 + (-dsrc[24] + dsrc[30])*2.5 + (-dsrc[10] + dsrc[12])*2.625 + (-dsrc[50] + dsrc[52])*5.25 + (dsrc[34] - dsrc[36])*6.5625 + (-dsrc[42] + dsrc[44])*10.5 + (dsrc[26] - dsrc[28])*13.125;
-    ddst[tileCount +25*ISTRIDE6X3] = (dsrc[17] + dsrc[18] + dsrc[21] + dsrc[22])*0.25 + (dsrc[9 ] + dsrc[10] + dsrc[13] + dsrc[14])*0.5 + (dsrc[49] + dsrc[50] + dsrc[53] + dsrc[54]) + (-dsrc[19] - dsrc[20])*1.0625 + (-dsrc[33] - dsrc[34] - dsrc[37] - dsrc[38])*1.25 + (dsrc[41] + dsrc[42] + dsrc[45] + dsrc[46])*2 + (-dsrc[11] - dsrc[12])*2.125 + (-dsrc[25] - dsrc[26] - dsrc[29] - dsrc[30])*2.5 + (-dsrc[51] - dsrc[52])*4.25 + (dsrc[35] + dsrc[36])*5.3125 + (-dsrc[43] - dsrc[44])*8.5 + (dsrc[27] + dsrc[28])*10.625;
-    ddst[tileCount +26*ISTRIDE6X3] = (-dsrc[17] + dsrc[18] - dsrc[21] + dsrc[22])*0.25 + (-dsrc[9 ] + dsrc[10] - dsrc[13] + dsrc[14])*0.5 + (-dsrc[49] + dsrc[50] - dsrc[53] + dsrc[54]) + (dsrc[19] - dsrc[20])*1.0625 + (dsrc[33] - dsrc[34] + dsrc[37] - dsrc[38])*1.25 + (-dsrc[41] + dsrc[42] - dsrc[45] + dsrc[46])*2 + (dsrc[11] - dsrc[12])*2.125 + (dsrc[25] - dsrc[26] + dsrc[29] - dsrc[30])*2.5 + (dsrc[51] - dsrc[52])*4.25 + (-dsrc[35] + dsrc[36])*5.3125 + (dsrc[43] - dsrc[44])*8.5 + (-dsrc[27] + dsrc[28])*10.625;
-    ddst[tileCount +27*ISTRIDE6X3] = (dsrc[18])*0.0625 + (dsrc[10] + dsrc[17])*0.125 + (dsrc[9 ] + dsrc[22] + dsrc[50])*0.25 + (-dsrc[20] - dsrc[34])*0.3125 + (dsrc[14] + dsrc[21] + dsrc[42] + dsrc[49])*0.5 + (-dsrc[12] - dsrc[19] - dsrc[26] - dsrc[33])*0.625 + (dsrc[13] + dsrc[41] + dsrc[54]) + (-dsrc[11] - dsrc[25] - dsrc[38] - dsrc[52])*1.25 + (dsrc[36])*1.5625 + (dsrc[46] + dsrc[53])*2 + (-dsrc[30] - dsrc[37] - dsrc[44] - dsrc[51])*2.5 + (dsrc[28] + dsrc[35])*3.125 + (dsrc[45])*4 + (-dsrc[29] - dsrc[43])*5 + (dsrc[27])*6.25;
-    ddst[tileCount +28*ISTRIDE6X3] = (dsrc[18])*0.0625 + (dsrc[10] - dsrc[17])*0.125 + (-dsrc[9 ] + dsrc[22] + dsrc[50])*0.25 + (-dsrc[20] - dsrc[34])*0.3125 + (dsrc[14] - dsrc[21] + dsrc[42] - dsrc[49])*0.5 + (-dsrc[12] + dsrc[19] - dsrc[26] + dsrc[33])*0.625 + (-dsrc[13] - dsrc[41] + dsrc[54]) + (dsrc[11] + dsrc[25] - dsrc[38] - dsrc[52])*1.25 + (dsrc[36])*1.5625 + (dsrc[46] - dsrc[53])*2 + (-dsrc[30] + dsrc[37] - dsrc[44] + dsrc[51])*2.5 + (dsrc[28] - dsrc[35])*3.125 + (-dsrc[45])*4 + (dsrc[29] + dsrc[43])*5 + (-dsrc[27])*6.25;
-    ddst[tileCount +29*ISTRIDE6X3] = (dsrc[21])*0.125 + (dsrc[13] + dsrc[22])*0.25 + (dsrc[14] + dsrc[17] + dsrc[53])*0.5 + (-dsrc[19] - dsrc[37])*0.625 + (dsrc[9 ] + dsrc[18] + dsrc[45] + dsrc[54]) + (-dsrc[11] - dsrc[20] - dsrc[29] - dsrc[38])*1.25 + (dsrc[10] + dsrc[46] + dsrc[49])*2 + (-dsrc[12] - dsrc[30] - dsrc[33] - dsrc[51])*2.5 + (dsrc[35])*3.125 + (dsrc[41] + dsrc[50])*4 + (-dsrc[25] - dsrc[34] - dsrc[43] - dsrc[52])*5 + (dsrc[27] + dsrc[36])*6.25 + (dsrc[42])*8 + (-dsrc[26] - dsrc[44])*10 + (dsrc[28])*12.5;
-    ddst[tileCount +30*ISTRIDE6X3] = (-dsrc[21])*0.125 + (-dsrc[13] + dsrc[22])*0.25 + (dsrc[14] - dsrc[17] - dsrc[53])*0.5 + (dsrc[19] + dsrc[37])*0.625 + (-dsrc[9 ] + dsrc[18] - dsrc[45] + dsrc[54]) + (dsrc[11] - dsrc[20] + dsrc[29] - dsrc[38])*1.25 + (dsrc[10] + dsrc[46] - dsrc[49])*2 + (-dsrc[12] - dsrc[30] + dsrc[33] + dsrc[51])*2.5 + (-dsrc[35])*3.125 + (-dsrc[41] + dsrc[50])*4 + (dsrc[25] - dsrc[34] + dsrc[43] - dsrc[52])*5 + (-dsrc[27] + dsrc[36])*6.25 + (dsrc[42])*8 + (-dsrc[26] - dsrc[44])*10 + (dsrc[28])*12.5;
-    ddst[tileCount +31*ISTRIDE6X3] = (-dsrc[17] + dsrc[23])*0.25 + (-dsrc[9 ] + dsrc[15])*0.5 + (-dsrc[49] + dsrc[55]) + (dsrc[33] - dsrc[39])*1.25 + (dsrc[19] - dsrc[21])*1.3125 + (-dsrc[41] + dsrc[47])*2 + (dsrc[25] - dsrc[31])*2.5 + (dsrc[11] - dsrc[13])*2.625 + (dsrc[51] - dsrc[53])*5.25 + (-dsrc[35] + dsrc[37])*6.5625 + (dsrc[43] - dsrc[45])*10.5 + (-dsrc[27] + dsrc[29])*13.125;
-    ddst[tileCount +32*ISTRIDE6X3] = (dsrc[16] - dsrc[22])*0.25 + (-dsrc[8 ] + dsrc[14])*0.5 + (dsrc[48] - dsrc[54]) + (-dsrc[32] + dsrc[38])*1.25 + (-dsrc[18] + dsrc[20])*1.3125 + (-dsrc[40] + dsrc[46])*2 + (dsrc[24] - dsrc[30])*2.5 + (dsrc[10] - dsrc[12])*2.625 + (-dsrc[50] + dsrc[52])*5.25 + (dsrc[34] - dsrc[36])*6.5625 + (dsrc[42] - dsrc[44])*10.5 + (-dsrc[26] + dsrc[28])*13.125;
-    ddst[tileCount +33*ISTRIDE6X3] = (dsrc[17] + dsrc[18] + dsrc[21] + dsrc[22])*0.25 + (-dsrc[9 ] - dsrc[10] - dsrc[13] - dsrc[14])*0.5 + (dsrc[49] + dsrc[50] + dsrc[53] + dsrc[54]) + (-dsrc[19] - dsrc[20])*1.0625 + (-dsrc[33] - dsrc[34] - dsrc[37] - dsrc[38])*1.25 + (-dsrc[41] - dsrc[42] - dsrc[45] - dsrc[46])*2 + (dsrc[11] + dsrc[12])*2.125 + (dsrc[25] + dsrc[26] + dsrc[29] + dsrc[30])*2.5 + (-dsrc[51] - dsrc[52])*4.25 + (dsrc[35] + dsrc[36])*5.3125 + (dsrc[43] + dsrc[44])*8.5 + (-dsrc[27] - dsrc[28])*10.625;
-    ddst[tileCount +34*ISTRIDE6X3] = (-dsrc[17] + dsrc[18] - dsrc[21] + dsrc[22])*0.25 + (dsrc[9 ] - dsrc[10] + dsrc[13] - dsrc[14])*0.5 + (-dsrc[49] + dsrc[50] - dsrc[53] + dsrc[54]) + (dsrc[19] - dsrc[20])*1.0625 + (dsrc[33] - dsrc[34] + dsrc[37] - dsrc[38])*1.25 + (dsrc[41] - dsrc[42] + dsrc[45] - dsrc[46])*2 + (-dsrc[11] + dsrc[12])*2.125 + (-dsrc[25] + dsrc[26] - dsrc[29] + dsrc[30])*2.5 + (dsrc[51] - dsrc[52])*4.25 + (-dsrc[35] + dsrc[36])*5.3125 + (-dsrc[43] + dsrc[44])*8.5 + (dsrc[27] - dsrc[28])*10.625;
-    ddst[tileCount +35*ISTRIDE6X3] = (dsrc[18])*0.0625 + (-dsrc[10] + dsrc[17])*0.125 + (-dsrc[9 ] + dsrc[22] + dsrc[50])*0.25 + (-dsrc[20] - dsrc[34])*0.3125 + (-dsrc[14] + dsrc[21] - dsrc[42] + dsrc[49])*0.5 + (dsrc[12] - dsrc[19] + dsrc[26] - dsrc[33])*0.625 + (-dsrc[13] - dsrc[41] + dsrc[54]) + (dsrc[11] + dsrc[25] - dsrc[38] - dsrc[52])*1.25 + (dsrc[36])*1.5625 + (-dsrc[46] + dsrc[53])*2 + (dsrc[30] - dsrc[37] + dsrc[44] - dsrc[51])*2.5 + (-dsrc[28] + dsrc[35])*3.125 + (-dsrc[45])*4 + (dsrc[29] + dsrc[43])*5 + (-dsrc[27])*6.25;
-    ddst[tileCount +36*ISTRIDE6X3] = (dsrc[18])*0.0625 + (-dsrc[10] - dsrc[17])*0.125 + (dsrc[9 ] + dsrc[22] + dsrc[50])*0.25 + (-dsrc[20] - dsrc[34])*0.3125 + (-dsrc[14] - dsrc[21] - dsrc[42] - dsrc[49])*0.5 + (dsrc[12] + dsrc[19] + dsrc[26] + dsrc[33])*0.625 + (dsrc[13] + dsrc[41] + dsrc[54]) + (-dsrc[11] - dsrc[25] - dsrc[38] - dsrc[52])*1.25 + (dsrc[36])*1.5625 + (-dsrc[46] - dsrc[53])*2 + (dsrc[30] + dsrc[37] + dsrc[44] + dsrc[51])*2.5 + (-dsrc[28] - dsrc[35])*3.125 + (dsrc[45])*4 + (-dsrc[29] - dsrc[43])*5 + (dsrc[27])*6.25;
-    ddst[tileCount +37*ISTRIDE6X3] = (dsrc[21])*0.125 + (-dsrc[13] + dsrc[22])*0.25 + (-dsrc[14] + dsrc[17] + dsrc[53])*0.5 + (-dsrc[19] - dsrc[37])*0.625 + (-dsrc[9 ] + dsrc[18] - dsrc[45] + dsrc[54]) + (dsrc[11] - dsrc[20] + dsrc[29] - dsrc[38])*1.25 + (-dsrc[10] - dsrc[46] + dsrc[49])*2 + (dsrc[12] + dsrc[30] - dsrc[33] - dsrc[51])*2.5 + (dsrc[35])*3.125 + (-dsrc[41] + dsrc[50])*4 + (dsrc[25] - dsrc[34] + dsrc[43] - dsrc[52])*5 + (-dsrc[27] + dsrc[36])*6.25 + (-dsrc[42])*8 + (dsrc[26] + dsrc[44])*10 + (-dsrc[28])*12.5;
-    ddst[tileCount +38*ISTRIDE6X3] = (-dsrc[21])*0.125 + (dsrc[13] + dsrc[22])*0.25 + (-dsrc[14] - dsrc[17] - dsrc[53])*0.5 + (dsrc[19] + dsrc[37])*0.625 + (dsrc[9 ] + dsrc[18] + dsrc[45] + dsrc[54]) + (-dsrc[11] - dsrc[20] - dsrc[29] - dsrc[38])*1.25 + (-dsrc[10] - dsrc[46] - dsrc[49])*2 + (dsrc[12] + dsrc[30] + dsrc[33] + dsrc[51])*2.5 + (-dsrc[35])*3.125 + (dsrc[41] + dsrc[50])*4 + (-dsrc[25] - dsrc[34] - dsrc[43] - dsrc[52])*5 + (dsrc[27] + dsrc[36])*6.25 + (-dsrc[42])*8 + (dsrc[26] + dsrc[44])*10 + (-dsrc[28])*12.5;
-    ddst[tileCount +39*ISTRIDE6X3] = (-dsrc[17] + dsrc[23])*0.25 + (dsrc[9 ] - dsrc[15])*0.5 + (-dsrc[49] + dsrc[55]) + (dsrc[33] - dsrc[39])*1.25 + (dsrc[19] - dsrc[21])*1.3125 + (dsrc[41] - dsrc[47])*2 + (-dsrc[25] + dsrc[31])*2.5 + (-dsrc[11] + dsrc[13])*2.625 + (dsrc[51] - dsrc[53])*5.25 + (-dsrc[35] + dsrc[37])*6.5625 + (-dsrc[43] + dsrc[45])*10.5 + (dsrc[27] - dsrc[29])*13.125;
-    ddst[tileCount +40*ISTRIDE6X3] = (dsrc[40] - dsrc[46])*0.5 + (dsrc[48] - dsrc[54]) + (dsrc[8 ] - dsrc[14])*2 + (-dsrc[24] + dsrc[30])*2.5 + (-dsrc[42] + dsrc[44])*2.625 + (dsrc[16] - dsrc[22])*4 + (-dsrc[32] + dsrc[38])*5 + (-dsrc[50] + dsrc[52])*5.25 + (-dsrc[10] + dsrc[12])*10.5 + (dsrc[26] - dsrc[28])*13.125 + (-dsrc[18] + dsrc[20])*21 + (dsrc[34] - dsrc[36])*26.25;
-    ddst[tileCount +41*ISTRIDE6X3] = (dsrc[41] + dsrc[42] + dsrc[45] + dsrc[46])*0.5 + (dsrc[49] + dsrc[50] + dsrc[53] + dsrc[54]) + (dsrc[9 ] + dsrc[10] + dsrc[13] + dsrc[14])*2 + (-dsrc[43] - dsrc[44])*2.125 + (-dsrc[25] - dsrc[26] - dsrc[29] - dsrc[30])*2.5 + (dsrc[17] + dsrc[18] + dsrc[21] + dsrc[22])*4 + (-dsrc[51] - dsrc[52])*4.25 + (-dsrc[33] - dsrc[34] - dsrc[37] - dsrc[38])*5 + (-dsrc[11] - dsrc[12])*8.5 + (dsrc[27] + dsrc[28])*10.625 + (-dsrc[19] - dsrc[20])*17 + (dsrc[35] + dsrc[36])*21.25;
-    ddst[tileCount +42*ISTRIDE6X3] = (-dsrc[41] + dsrc[42] - dsrc[45] + dsrc[46])*0.5 + (-dsrc[49] + dsrc[50] - dsrc[53] + dsrc[54]) + (-dsrc[9 ] + dsrc[10] - dsrc[13] + dsrc[14])*2 + (dsrc[43] - dsrc[44])*2.125 + (dsrc[25] - dsrc[26] + dsrc[29] - dsrc[30])*2.5 + (-dsrc[17] + dsrc[18] - dsrc[21] + dsrc[22])*4 + (dsrc[51] - dsrc[52])*4.25 + (dsrc[33] - dsrc[34] + dsrc[37] - dsrc[38])*5 + (dsrc[11] - dsrc[12])*8.5 + (-dsrc[27] + dsrc[28])*10.625 + (dsrc[19] - dsrc[20])*17 + (-dsrc[35] + dsrc[36])*21.25;
-    ddst[tileCount +43*ISTRIDE6X3] = (dsrc[42])*0.125 + (dsrc[41] + dsrc[50])*0.25 + (dsrc[10] + dsrc[46] + dsrc[49])*0.5 + (-dsrc[26] - dsrc[44])*0.625 + (dsrc[9 ] + dsrc[18] + dsrc[45] + dsrc[54]) + (-dsrc[25] - dsrc[34] - dsrc[43] - dsrc[52])*1.25 + (dsrc[14] + dsrc[17] + dsrc[53])*2 + (-dsrc[12] - dsrc[30] - dsrc[33] - dsrc[51])*2.5 + (dsrc[28])*3.125 + (dsrc[13] + dsrc[22])*4 + (-dsrc[11] - dsrc[20] - dsrc[29] - dsrc[38])*5 + (dsrc[27] + dsrc[36])*6.25 + (dsrc[21])*8 + (-dsrc[19] - dsrc[37])*10 + (dsrc[35])*12.5;
-    ddst[tileCount +44*ISTRIDE6X3] = (dsrc[42])*0.125 + (-dsrc[41] + dsrc[50])*0.25 + (dsrc[10] + dsrc[46] - dsrc[49])*0.5 + (-dsrc[26] - dsrc[44])*0.625 + (-dsrc[9 ] + dsrc[18] - dsrc[45] + dsrc[54]) + (dsrc[25] - dsrc[34] + dsrc[43] - dsrc[52])*1.25 + (dsrc[14] - dsrc[17] - dsrc[53])*2 + (-dsrc[12] - dsrc[30] + dsrc[33] + dsrc[51])*2.5 + (dsrc[28])*3.125 + (-dsrc[13] + dsrc[22])*4 + (dsrc[11] - dsrc[20] + dsrc[29] - dsrc[38])*5 + (-dsrc[27] + dsrc[36])*6.25 + (-dsrc[21])*8 + (dsrc[19] + dsrc[37])*10 + (-dsrc[35])*12.5;
-    ddst[tileCount +45*ISTRIDE6X3] = (dsrc[45])*0.25 + (dsrc[46] + dsrc[53])*0.5 + (dsrc[13] + dsrc[41] + dsrc[54]) + (-dsrc[29] - dsrc[43])*1.25 + (dsrc[14] + dsrc[21] + dsrc[42] + dsrc[49])*2 + (-dsrc[30] - dsrc[37] - dsrc[44] - dsrc[51])*2.5 + (dsrc[9 ] + dsrc[22] + dsrc[50])*4 + (-dsrc[11] - dsrc[25] - dsrc[38] - dsrc[52])*5 + (dsrc[27])*6.25 + (dsrc[10] + dsrc[17])*8 + (-dsrc[12] - dsrc[19] - dsrc[26] - dsrc[33])*10 + (dsrc[28] + dsrc[35])*12.5 + (dsrc[18])*16 + (-dsrc[20] - dsrc[34])*20 + (dsrc[36])*25;
-    ddst[tileCount +46*ISTRIDE6X3] = (-dsrc[45])*0.25 + (dsrc[46] - dsrc[53])*0.5 + (-dsrc[13] - dsrc[41] + dsrc[54]) + (dsrc[29] + dsrc[43])*1.25 + (dsrc[14] - dsrc[21] + dsrc[42] - dsrc[49])*2 + (-dsrc[30] + dsrc[37] - dsrc[44] + dsrc[51])*2.5 + (-dsrc[9 ] + dsrc[22] + dsrc[50])*4 + (dsrc[11] + dsrc[25] - dsrc[38] - dsrc[52])*5 + (-dsrc[27])*6.25 + (dsrc[10] - dsrc[17])*8 + (-dsrc[12] + dsrc[19] - dsrc[26] + dsrc[33])*10 + (dsrc[28] - dsrc[35])*12.5 + (dsrc[18])*16 + (-dsrc[20] - dsrc[34])*20 + (dsrc[36])*25;
-    ddst[tileCount +47*ISTRIDE6X3] = (-dsrc[41] + dsrc[47])*0.5 + (-dsrc[49] + dsrc[55]) + (-dsrc[9 ] + dsrc[15])*2 + (dsrc[25] - dsrc[31])*2.5 + (dsrc[43] - dsrc[45])*2.625 + (-dsrc[17] + dsrc[23])*4 + (dsrc[33] - dsrc[39])*5 + (dsrc[51] - dsrc[53])*5.25 + (dsrc[11] - dsrc[13])*10.5 + (-dsrc[27] + dsrc[29])*13.125 + (dsrc[19] - dsrc[21])*21 + (-dsrc[35] + dsrc[37])*26.25;
-    ddst[tileCount +48*ISTRIDE6X3] = (-dsrc[40] + dsrc[46])*0.5 + (dsrc[48] - dsrc[54]) + (-dsrc[8 ] + dsrc[14])*2 + (dsrc[24] - dsrc[30])*2.5 + (dsrc[42] - dsrc[44])*2.625 + (dsrc[16] - dsrc[22])*4 + (-dsrc[32] + dsrc[38])*5 + (-dsrc[50] + dsrc[52])*5.25 + (dsrc[10] - dsrc[12])*10.5 + (-dsrc[26] + dsrc[28])*13.125 + (-dsrc[18] + dsrc[20])*21 + (dsrc[34] - dsrc[36])*26.25;
-    ddst[tileCount +49*ISTRIDE6X3] = (-dsrc[41] - dsrc[42] - dsrc[45] - dsrc[46])*0.5 + (dsrc[49] + dsrc[50] + dsrc[53] + dsrc[54]) + (-dsrc[9 ] - dsrc[10] - dsrc[13] - dsrc[14])*2 + (dsrc[43] + dsrc[44])*2.125 + (dsrc[25] + dsrc[26] + dsrc[29] + dsrc[30])*2.5 + (dsrc[17] + dsrc[18] + dsrc[21] + dsrc[22])*4 + (-dsrc[51] - dsrc[52])*4.25 + (-dsrc[33] - dsrc[34] - dsrc[37] - dsrc[38])*5 + (dsrc[11] + dsrc[12])*8.5 + (-dsrc[27] - dsrc[28])*10.625 + (-dsrc[19] - dsrc[20])*17 + (dsrc[35] + dsrc[36])*21.25;
-    ddst[tileCount +50*ISTRIDE6X3] = (dsrc[41] - dsrc[42] + dsrc[45] - dsrc[46])*0.5 + (-dsrc[49] + dsrc[50] - dsrc[53] + dsrc[54]) + (dsrc[9 ] - dsrc[10] + dsrc[13] - dsrc[14])*2 + (-dsrc[43] + dsrc[44])*2.125 + (-dsrc[25] + dsrc[26] - dsrc[29] + dsrc[30])*2.5 + (-dsrc[17] + dsrc[18] - dsrc[21] + dsrc[22])*4 + (dsrc[51] - dsrc[52])*4.25 + (dsrc[33] - dsrc[34] + dsrc[37] - dsrc[38])*5 + (-dsrc[11] + dsrc[12])*8.5 + (dsrc[27] - dsrc[28])*10.625 + (dsrc[19] - dsrc[20])*17 + (-dsrc[35] + dsrc[36])*21.25;
-    ddst[tileCount +51*ISTRIDE6X3] = (-dsrc[42])*0.125 + (-dsrc[41] + dsrc[50])*0.25 + (-dsrc[10] - dsrc[46] + dsrc[49])*0.5 + (dsrc[26] + dsrc[44])*0.625 + (-dsrc[9 ] + dsrc[18] - dsrc[45] + dsrc[54]) + (dsrc[25] - dsrc[34] + dsrc[43] - dsrc[52])*1.25 + (-dsrc[14] + dsrc[17] + dsrc[53])*2 + (dsrc[12] + dsrc[30] - dsrc[33] - dsrc[51])*2.5 + (-dsrc[28])*3.125 + (-dsrc[13] + dsrc[22])*4 + (dsrc[11] - dsrc[20] + dsrc[29] - dsrc[38])*5 + (-dsrc[27] + dsrc[36])*6.25 + (dsrc[21])*8 + (-dsrc[19] - dsrc[37])*10 + (dsrc[35])*12.5;
-    ddst[tileCount +52*ISTRIDE6X3] = (-dsrc[42])*0.125 + (dsrc[41] + dsrc[50])*0.25 + (-dsrc[10] - dsrc[46] - dsrc[49])*0.5 + (dsrc[26] + dsrc[44])*0.625 + (dsrc[9 ] + dsrc[18] + dsrc[45] + dsrc[54]) + (-dsrc[25] - dsrc[34] - dsrc[43] - dsrc[52])*1.25 + (-dsrc[14] - dsrc[17] - dsrc[53])*2 + (dsrc[12] + dsrc[30] + dsrc[33] + dsrc[51])*2.5 + (-dsrc[28])*3.125 + (dsrc[13] + dsrc[22])*4 + (-dsrc[11] - dsrc[20] - dsrc[29] - dsrc[38])*5 + (dsrc[27] + dsrc[36])*6.25 + (-dsrc[21])*8 + (dsrc[19] + dsrc[37])*10 + (-dsrc[35])*12.5;
-    ddst[tileCount +53*ISTRIDE6X3] = (-dsrc[45])*0.25 + (-dsrc[46] + dsrc[53])*0.5 + (-dsrc[13] - dsrc[41] + dsrc[54]) + (dsrc[29] + dsrc[43])*1.25 + (-dsrc[14] + dsrc[21] - dsrc[42] + dsrc[49])*2 + (dsrc[30] - dsrc[37] + dsrc[44] - dsrc[51])*2.5 + (-dsrc[9 ] + dsrc[22] + dsrc[50])*4 + (dsrc[11] + dsrc[25] - dsrc[38] - dsrc[52])*5 + (-dsrc[27])*6.25 + (-dsrc[10] + dsrc[17])*8 + (dsrc[12] - dsrc[19] + dsrc[26] - dsrc[33])*10 + (-dsrc[28] + dsrc[35])*12.5 + (dsrc[18])*16 + (-dsrc[20] - dsrc[34])*20 + (dsrc[36])*25;
-    ddst[tileCount +54*ISTRIDE6X3] = (dsrc[45])*0.25 + (-dsrc[46] - dsrc[53])*0.5 + (dsrc[13] + dsrc[41] + dsrc[54]) + (-dsrc[29] - dsrc[43])*1.25 + (-dsrc[14] - dsrc[21] - dsrc[42] - dsrc[49])*2 + (dsrc[30] + dsrc[37] + dsrc[44] + dsrc[51])*2.5 + (dsrc[9 ] + dsrc[22] + dsrc[50])*4 + (-dsrc[11] - dsrc[25] - dsrc[38] - dsrc[52])*5 + (dsrc[27])*6.25 + (-dsrc[10] - dsrc[17])*8 + (dsrc[12] + dsrc[19] + dsrc[26] + dsrc[33])*10 + (-dsrc[28] - dsrc[35])*12.5 + (dsrc[18])*16 + (-dsrc[20] - dsrc[34])*20 + (dsrc[36])*25;
-    ddst[tileCount +55*ISTRIDE6X3] = (dsrc[41] - dsrc[47])*0.5 + (-dsrc[49] + dsrc[55]) + (dsrc[9 ] - dsrc[15])*2 + (-dsrc[25] + dsrc[31])*2.5 + (-dsrc[43] + dsrc[45])*2.625 + (-dsrc[17] + dsrc[23])*4 + (dsrc[33] - dsrc[39])*5 + (dsrc[51] - dsrc[53])*5.25 + (-dsrc[11] + dsrc[13])*10.5 + (dsrc[27] - dsrc[29])*13.125 + (dsrc[19] - dsrc[21])*21 + (-dsrc[35] + dsrc[37])*26.25;
-    ddst[tileCount +56*ISTRIDE6X3] = (-dsrc[8 ] + dsrc[14] + dsrc[56] - dsrc[62]) + (dsrc[10] - dsrc[12] + dsrc[24] - dsrc[30] - dsrc[40] + dsrc[46] - dsrc[58] + dsrc[60])*5.25 + (-dsrc[26] + dsrc[28] + dsrc[42] - dsrc[44])*27.5625;
-    ddst[tileCount +57*ISTRIDE6X3] = (-dsrc[9 ] - dsrc[10] - dsrc[13] - dsrc[14] + dsrc[57] + dsrc[58] + dsrc[61] + dsrc[62]) + (dsrc[11] + dsrc[12] - dsrc[59] - dsrc[60])*4.25 + (dsrc[25] + dsrc[26] + dsrc[29] + dsrc[30] - dsrc[41] - dsrc[42] - dsrc[45] - dsrc[46])*5.25 + (-dsrc[27] - dsrc[28] + dsrc[43] + dsrc[44])*22.3125;
-    ddst[tileCount +58*ISTRIDE6X3] = (dsrc[9 ] - dsrc[10] + dsrc[13] - dsrc[14] - dsrc[57] + dsrc[58] - dsrc[61] + dsrc[62]) + (-dsrc[11] + dsrc[12] + dsrc[59] - dsrc[60])*4.25 + (-dsrc[25] + dsrc[26] - dsrc[29] + dsrc[30] + dsrc[41] - dsrc[42] + dsrc[45] - dsrc[46])*5.25 + (dsrc[27] - dsrc[28] - dsrc[43] + dsrc[44])*22.3125;
-    ddst[tileCount +59*ISTRIDE6X3] = (-dsrc[10] + dsrc[58])*0.25 + (-dsrc[9 ] + dsrc[57])*0.5 + (-dsrc[14] + dsrc[62]) + (dsrc[12] - dsrc[60])*1.25 + (dsrc[26] - dsrc[42])*1.3125 + (-dsrc[13] + dsrc[61])*2 + (dsrc[11] - dsrc[59])*2.5 + (dsrc[25] - dsrc[41])*2.625 + (dsrc[30] - dsrc[46])*5.25 + (-dsrc[28] + dsrc[44])*6.5625 + (dsrc[29] - dsrc[45])*10.5 + (-dsrc[27] + dsrc[43])*13.125;
-    ddst[tileCount +60*ISTRIDE6X3] = (-dsrc[10] + dsrc[58])*0.25 + (dsrc[9 ] - dsrc[57])*0.5 + (-dsrc[14] + dsrc[62]) + (dsrc[12] - dsrc[60])*1.25 + (dsrc[26] - dsrc[42])*1.3125 + (dsrc[13] - dsrc[61])*2 + (-dsrc[11] + dsrc[59])*2.5 + (-dsrc[25] + dsrc[41])*2.625 + (dsrc[30] - dsrc[46])*5.25 + (-dsrc[28] + dsrc[44])*6.5625 + (-dsrc[29] + dsrc[45])*10.5 + (dsrc[27] - dsrc[43])*13.125;
-    ddst[tileCount +61*ISTRIDE6X3] = (-dsrc[13] + dsrc[61])*0.5 + (-dsrc[14] + dsrc[62]) + (-dsrc[9 ] + dsrc[57])*2 + (dsrc[11] - dsrc[59])*2.5 + (dsrc[29] - dsrc[45])*2.625 + (-dsrc[10] + dsrc[58])*4 + (dsrc[12] - dsrc[60])*5 + (dsrc[30] - dsrc[46])*5.25 + (dsrc[25] - dsrc[41])*10.5 + (-dsrc[27] + dsrc[43])*13.125 + (dsrc[26] - dsrc[42])*21 + (-dsrc[28] + dsrc[44])*26.25;
-    ddst[tileCount +62*ISTRIDE6X3] = (dsrc[13] - dsrc[61])*0.5 + (-dsrc[14] + dsrc[62]) + (dsrc[9 ] - dsrc[57])*2 + (-dsrc[11] + dsrc[59])*2.5 + (-dsrc[29] + dsrc[45])*2.625 + (-dsrc[10] + dsrc[58])*4 + (dsrc[12] - dsrc[60])*5 + (dsrc[30] - dsrc[46])*5.25 + (-dsrc[25] + dsrc[41])*10.5 + (dsrc[27] - dsrc[43])*13.125 + (dsrc[26] - dsrc[42])*21 + (-dsrc[28] + dsrc[44])*26.25;
-    ddst[tileCount +63*ISTRIDE6X3] = (dsrc[9 ] - dsrc[15] - dsrc[57] + dsrc[63]) + (-dsrc[11] + dsrc[13] - dsrc[25] + dsrc[31] + dsrc[41] - dsrc[47] + dsrc[59] - dsrc[61])*5.25 + (dsrc[27] - dsrc[29] - dsrc[43] + dsrc[45])*27.5625;
+    ddst[tileCount + 0*istride] = (dsrc[0 ] - dsrc[6 ] - dsrc[48] + dsrc[54]) + (-dsrc[2 ] + dsrc[4 ] - dsrc[16] + dsrc[22] + dsrc[32] - dsrc[38] + dsrc[50] - dsrc[52])*5.25 + (dsrc[18] - dsrc[20] - dsrc[34] + dsrc[36])*27.5625;
+    ddst[tileCount + 1*istride] = (dsrc[1 ] + dsrc[2 ] + dsrc[5 ] + dsrc[6 ] - dsrc[49] - dsrc[50] - dsrc[53] - dsrc[54]) + (-dsrc[3 ] - dsrc[4 ] + dsrc[51] + dsrc[52])*4.25 + (-dsrc[17] - dsrc[18] - dsrc[21] - dsrc[22] + dsrc[33] + dsrc[34] + dsrc[37] + dsrc[38])*5.25 + (dsrc[19] + dsrc[20] - dsrc[35] - dsrc[36])*22.3125;
+    ddst[tileCount + 2*istride] = (-dsrc[1 ] + dsrc[2 ] - dsrc[5 ] + dsrc[6 ] + dsrc[49] - dsrc[50] + dsrc[53] - dsrc[54]) + (dsrc[3 ] - dsrc[4 ] - dsrc[51] + dsrc[52])*4.25 + (dsrc[17] - dsrc[18] + dsrc[21] - dsrc[22] - dsrc[33] + dsrc[34] - dsrc[37] + dsrc[38])*5.25 + (-dsrc[19] + dsrc[20] + dsrc[35] - dsrc[36])*22.3125;
+    ddst[tileCount + 3*istride] = (dsrc[2 ] - dsrc[50])*0.25 + (dsrc[1 ] - dsrc[49])*0.5 + (dsrc[6 ] - dsrc[54]) + (-dsrc[4 ] + dsrc[52])*1.25 + (-dsrc[18] + dsrc[34])*1.3125 + (dsrc[5 ] - dsrc[53])*2 + (-dsrc[3 ] + dsrc[51])*2.5 + (-dsrc[17] + dsrc[33])*2.625 + (-dsrc[22] + dsrc[38])*5.25 + (dsrc[20] - dsrc[36])*6.5625 + (-dsrc[21] + dsrc[37])*10.5 + (dsrc[19] - dsrc[35])*13.125;
+    ddst[tileCount + 4*istride] = (dsrc[2 ] - dsrc[50])*0.25 + (-dsrc[1 ] + dsrc[49])*0.5 + (dsrc[6 ] - dsrc[54]) + (-dsrc[4 ] + dsrc[52])*1.25 + (-dsrc[18] + dsrc[34])*1.3125 + (-dsrc[5 ] + dsrc[53])*2 + (dsrc[3 ] - dsrc[51])*2.5 + (dsrc[17] - dsrc[33])*2.625 + (-dsrc[22] + dsrc[38])*5.25 + (dsrc[20] - dsrc[36])*6.5625 + (dsrc[21] - dsrc[37])*10.5 + (-dsrc[19] + dsrc[35])*13.125;
+    ddst[tileCount + 5*istride] = (dsrc[5 ] - dsrc[53])*0.5 + (dsrc[6 ] - dsrc[54]) + (dsrc[1 ] - dsrc[49])*2 + (-dsrc[3 ] + dsrc[51])*2.5 + (-dsrc[21] + dsrc[37])*2.625 + (dsrc[2 ] - dsrc[50])*4 + (-dsrc[4 ] + dsrc[52])*5 + (-dsrc[22] + dsrc[38])*5.25 + (-dsrc[17] + dsrc[33])*10.5 + (dsrc[19] - dsrc[35])*13.125 + (-dsrc[18] + dsrc[34])*21 + (dsrc[20] - dsrc[36])*26.25;
+    ddst[tileCount + 6*istride] = (-dsrc[5 ] + dsrc[53])*0.5 + (dsrc[6 ] - dsrc[54]) + (-dsrc[1 ] + dsrc[49])*2 + (dsrc[3 ] - dsrc[51])*2.5 + (dsrc[21] - dsrc[37])*2.625 + (dsrc[2 ] - dsrc[50])*4 + (-dsrc[4 ] + dsrc[52])*5 + (-dsrc[22] + dsrc[38])*5.25 + (dsrc[17] - dsrc[33])*10.5 + (-dsrc[19] + dsrc[35])*13.125 + (-dsrc[18] + dsrc[34])*21 + (dsrc[20] - dsrc[36])*26.25;
+    ddst[tileCount + 7*istride] = (-dsrc[1 ] + dsrc[7 ] + dsrc[49] - dsrc[55]) + (dsrc[3 ] - dsrc[5 ] + dsrc[17] - dsrc[23] - dsrc[33] + dsrc[39] - dsrc[51] + dsrc[53])*5.25 + (-dsrc[19] + dsrc[21] + dsrc[35] - dsrc[37])*27.5625;
+    ddst[tileCount + 8*istride] = (dsrc[8 ] - dsrc[14] + dsrc[16] - dsrc[22] + dsrc[40] - dsrc[46] + dsrc[48] - dsrc[54]) + (-dsrc[24] + dsrc[30] - dsrc[32] + dsrc[38])*4.25 + (-dsrc[10] + dsrc[12] - dsrc[18] + dsrc[20] - dsrc[42] + dsrc[44] - dsrc[50] + dsrc[52])*5.25 + (dsrc[26] - dsrc[28] + dsrc[34] - dsrc[36])*22.3125;
+    ddst[tileCount + 9*istride] = (dsrc[9 ] + dsrc[10] + dsrc[13] + dsrc[14] + dsrc[17] + dsrc[18] + dsrc[21] + dsrc[22] + dsrc[41] + dsrc[42] + dsrc[45] + dsrc[46] + dsrc[49] + dsrc[50] + dsrc[53] + dsrc[54]) + (-dsrc[11] - dsrc[12] - dsrc[19] - dsrc[20] - dsrc[25] - dsrc[26] - dsrc[29] - dsrc[30] - dsrc[33] - dsrc[34] - dsrc[37] - dsrc[38] - dsrc[43] - dsrc[44] - dsrc[51] - dsrc[52])*4.25 + (dsrc[27] + dsrc[28] + dsrc[35] + dsrc[36])*18.0625;
+    ddst[tileCount +10*istride] = (-dsrc[9 ] + dsrc[10] - dsrc[13] + dsrc[14] - dsrc[17] + dsrc[18] - dsrc[21] + dsrc[22] - dsrc[41] + dsrc[42] - dsrc[45] + dsrc[46] - dsrc[49] + dsrc[50] - dsrc[53] + dsrc[54]) + (dsrc[11] - dsrc[12] + dsrc[19] - dsrc[20] + dsrc[25] - dsrc[26] + dsrc[29] - dsrc[30] + dsrc[33] - dsrc[34] + dsrc[37] - dsrc[38] + dsrc[43] - dsrc[44] + dsrc[51] - dsrc[52])*4.25 + (-dsrc[27] + dsrc[28] - dsrc[35] + dsrc[36])*18.0625;
+    ddst[tileCount +11*istride] = (dsrc[10] + dsrc[18] + dsrc[42] + dsrc[50])*0.25 + (dsrc[9 ] + dsrc[17] + dsrc[41] + dsrc[49])*0.5 + (dsrc[14] + dsrc[22] + dsrc[46] + dsrc[54]) + (-dsrc[26] - dsrc[34])*1.0625 + (-dsrc[12] - dsrc[20] - dsrc[44] - dsrc[52])*1.25 + (dsrc[13] + dsrc[21] + dsrc[45] + dsrc[53])*2 + (-dsrc[25] - dsrc[33])*2.125 + (-dsrc[11] - dsrc[19] - dsrc[43] - dsrc[51])*2.5 + (-dsrc[30] - dsrc[38])*4.25 + (dsrc[28] + dsrc[36])*5.3125 + (-dsrc[29] - dsrc[37])*8.5 + (dsrc[27] + dsrc[35])*10.625;
+    ddst[tileCount +12*istride] = (dsrc[10] + dsrc[18] + dsrc[42] + dsrc[50])*0.25 + (-dsrc[9 ] - dsrc[17] - dsrc[41] - dsrc[49])*0.5 + (dsrc[14] + dsrc[22] + dsrc[46] + dsrc[54]) + (-dsrc[26] - dsrc[34])*1.0625 + (-dsrc[12] - dsrc[20] - dsrc[44] - dsrc[52])*1.25 + (-dsrc[13] - dsrc[21] - dsrc[45] - dsrc[53])*2 + (dsrc[25] + dsrc[33])*2.125 + (dsrc[11] + dsrc[19] + dsrc[43] + dsrc[51])*2.5 + (-dsrc[30] - dsrc[38])*4.25 + (dsrc[28] + dsrc[36])*5.3125 + (dsrc[29] + dsrc[37])*8.5 + (-dsrc[27] - dsrc[35])*10.625;
+    ddst[tileCount +13*istride] = (dsrc[13] + dsrc[21] + dsrc[45] + dsrc[53])*0.5 + (dsrc[14] + dsrc[22] + dsrc[46] + dsrc[54]) + (dsrc[9 ] + dsrc[17] + dsrc[41] + dsrc[49])*2 + (-dsrc[29] - dsrc[37])*2.125 + (-dsrc[11] - dsrc[19] - dsrc[43] - dsrc[51])*2.5 + (dsrc[10] + dsrc[18] + dsrc[42] + dsrc[50])*4 + (-dsrc[30] - dsrc[38])*4.25 + (-dsrc[12] - dsrc[20] - dsrc[44] - dsrc[52])*5 + (-dsrc[25] - dsrc[33])*8.5 + (dsrc[27] + dsrc[35])*10.625 + (-dsrc[26] - dsrc[34])*17 + (dsrc[28] + dsrc[36])*21.25;
+    ddst[tileCount +14*istride] = (-dsrc[13] - dsrc[21] - dsrc[45] - dsrc[53])*0.5 + (dsrc[14] + dsrc[22] + dsrc[46] + dsrc[54]) + (-dsrc[9 ] - dsrc[17] - dsrc[41] - dsrc[49])*2 + (dsrc[29] + dsrc[37])*2.125 + (dsrc[11] + dsrc[19] + dsrc[43] + dsrc[51])*2.5 + (dsrc[10] + dsrc[18] + dsrc[42] + dsrc[50])*4 + (-dsrc[30] - dsrc[38])*4.25 + (-dsrc[12] - dsrc[20] - dsrc[44] - dsrc[52])*5 + (dsrc[25] + dsrc[33])*8.5 + (-dsrc[27] - dsrc[35])*10.625 + (-dsrc[26] - dsrc[34])*17 + (dsrc[28] + dsrc[36])*21.25;
+    ddst[tileCount +15*istride] = (-dsrc[9 ] + dsrc[15] - dsrc[17] + dsrc[23] - dsrc[41] + dsrc[47] - dsrc[49] + dsrc[55]) + (dsrc[25] - dsrc[31] + dsrc[33] - dsrc[39])*4.25 + (dsrc[11] - dsrc[13] + dsrc[19] - dsrc[21] + dsrc[43] - dsrc[45] + dsrc[51] - dsrc[53])*5.25 + (-dsrc[27] + dsrc[29] - dsrc[35] + dsrc[37])*22.3125;
+    ddst[tileCount +16*istride] = (-dsrc[8 ] + dsrc[14] + dsrc[16] - dsrc[22] - dsrc[40] + dsrc[46] + dsrc[48] - dsrc[54]) + (dsrc[24] - dsrc[30] - dsrc[32] + dsrc[38])*4.25 + (dsrc[10] - dsrc[12] - dsrc[18] + dsrc[20] + dsrc[42] - dsrc[44] - dsrc[50] + dsrc[52])*5.25 + (-dsrc[26] + dsrc[28] + dsrc[34] - dsrc[36])*22.3125;
+    ddst[tileCount +17*istride] = (-dsrc[9 ] - dsrc[10] - dsrc[13] - dsrc[14] + dsrc[17] + dsrc[18] + dsrc[21] + dsrc[22] - dsrc[41] - dsrc[42] - dsrc[45] - dsrc[46] + dsrc[49] + dsrc[50] + dsrc[53] + dsrc[54]) + (dsrc[11] + dsrc[12] - dsrc[19] - dsrc[20] + dsrc[25] + dsrc[26] + dsrc[29] + dsrc[30] - dsrc[33] - dsrc[34] - dsrc[37] - dsrc[38] + dsrc[43] + dsrc[44] - dsrc[51] - dsrc[52])*4.25 + (-dsrc[27] - dsrc[28] + dsrc[35] + dsrc[36])*18.0625;
+    ddst[tileCount +18*istride] = (dsrc[9 ] - dsrc[10] + dsrc[13] - dsrc[14] - dsrc[17] + dsrc[18] - dsrc[21] + dsrc[22] + dsrc[41] - dsrc[42] + dsrc[45] - dsrc[46] - dsrc[49] + dsrc[50] - dsrc[53] + dsrc[54]) + (-dsrc[11] + dsrc[12] + dsrc[19] - dsrc[20] - dsrc[25] + dsrc[26] - dsrc[29] + dsrc[30] + dsrc[33] - dsrc[34] + dsrc[37] - dsrc[38] - dsrc[43] + dsrc[44] + dsrc[51] - dsrc[52])*4.25 + (dsrc[27] - dsrc[28] - dsrc[35] + dsrc[36])*18.0625;
+    ddst[tileCount +19*istride] = (-dsrc[10] + dsrc[18] - dsrc[42] + dsrc[50])*0.25 + (-dsrc[9 ] + dsrc[17] - dsrc[41] + dsrc[49])*0.5 + (-dsrc[14] + dsrc[22] - dsrc[46] + dsrc[54]) + (dsrc[26] - dsrc[34])*1.0625 + (dsrc[12] - dsrc[20] + dsrc[44] - dsrc[52])*1.25 + (-dsrc[13] + dsrc[21] - dsrc[45] + dsrc[53])*2 + (dsrc[25] - dsrc[33])*2.125 + (dsrc[11] - dsrc[19] + dsrc[43] - dsrc[51])*2.5 + (dsrc[30] - dsrc[38])*4.25 + (-dsrc[28] + dsrc[36])*5.3125 + (dsrc[29] - dsrc[37])*8.5 + (-dsrc[27] + dsrc[35])*10.625;
+    ddst[tileCount +20*istride] = (-dsrc[10] + dsrc[18] - dsrc[42] + dsrc[50])*0.25 + (dsrc[9 ] - dsrc[17] + dsrc[41] - dsrc[49])*0.5 + (-dsrc[14] + dsrc[22] - dsrc[46] + dsrc[54]) + (dsrc[26] - dsrc[34])*1.0625 + (dsrc[12] - dsrc[20] + dsrc[44] - dsrc[52])*1.25 + (dsrc[13] - dsrc[21] + dsrc[45] - dsrc[53])*2 + (-dsrc[25] + dsrc[33])*2.125 + (-dsrc[11] + dsrc[19] - dsrc[43] + dsrc[51])*2.5 + (dsrc[30] - dsrc[38])*4.25 + (-dsrc[28] + dsrc[36])*5.3125 + (-dsrc[29] + dsrc[37])*8.5 + (dsrc[27] - dsrc[35])*10.625;
+    ddst[tileCount +21*istride] = (-dsrc[13] + dsrc[21] - dsrc[45] + dsrc[53])*0.5 + (-dsrc[14] + dsrc[22] - dsrc[46] + dsrc[54]) + (-dsrc[9 ] + dsrc[17] - dsrc[41] + dsrc[49])*2 + (dsrc[29] - dsrc[37])*2.125 + (dsrc[11] - dsrc[19] + dsrc[43] - dsrc[51])*2.5 + (-dsrc[10] + dsrc[18] - dsrc[42] + dsrc[50])*4 + (dsrc[30] - dsrc[38])*4.25 + (dsrc[12] - dsrc[20] + dsrc[44] - dsrc[52])*5 + (dsrc[25] - dsrc[33])*8.5 + (-dsrc[27] + dsrc[35])*10.625 + (dsrc[26] - dsrc[34])*17 + (-dsrc[28] + dsrc[36])*21.25;
+    ddst[tileCount +22*istride] = (dsrc[13] - dsrc[21] + dsrc[45] - dsrc[53])*0.5 + (-dsrc[14] + dsrc[22] - dsrc[46] + dsrc[54]) + (dsrc[9 ] - dsrc[17] + dsrc[41] - dsrc[49])*2 + (-dsrc[29] + dsrc[37])*2.125 + (-dsrc[11] + dsrc[19] - dsrc[43] + dsrc[51])*2.5 + (-dsrc[10] + dsrc[18] - dsrc[42] + dsrc[50])*4 + (dsrc[30] - dsrc[38])*4.25 + (dsrc[12] - dsrc[20] + dsrc[44] - dsrc[52])*5 + (-dsrc[25] + dsrc[33])*8.5 + (dsrc[27] - dsrc[35])*10.625 + (dsrc[26] - dsrc[34])*17 + (-dsrc[28] + dsrc[36])*21.25;
+    ddst[tileCount +23*istride] = (dsrc[9 ] - dsrc[15] - dsrc[17] + dsrc[23] + dsrc[41] - dsrc[47] - dsrc[49] + dsrc[55]) + (-dsrc[25] + dsrc[31] + dsrc[33] - dsrc[39])*4.25 + (-dsrc[11] + dsrc[13] + dsrc[19] - dsrc[21] - dsrc[43] + dsrc[45] + dsrc[51] - dsrc[53])*5.25 + (dsrc[27] - dsrc[29] - dsrc[35] + dsrc[37])*22.3125;
+    ddst[tileCount +24*istride] = (dsrc[16] - dsrc[22])*0.25 + (dsrc[8 ] - dsrc[14])*0.5 + (dsrc[48] - dsrc[54]) + (-dsrc[32] + dsrc[38])*1.25 + (-dsrc[18] + dsrc[20])*1.3125 + (dsrc[40] - dsrc[46])*2 + (-dsrc[24] + dsrc[30])*2.5 + (-dsrc[10] + dsrc[12])*2.625 + (-dsrc[50] + dsrc[52])*5.25 + (dsrc[34] - dsrc[36])*6.5625 + (-dsrc[42] + dsrc[44])*10.5 + (dsrc[26] - dsrc[28])*13.125;
+    ddst[tileCount +25*istride] = (dsrc[17] + dsrc[18] + dsrc[21] + dsrc[22])*0.25 + (dsrc[9 ] + dsrc[10] + dsrc[13] + dsrc[14])*0.5 + (dsrc[49] + dsrc[50] + dsrc[53] + dsrc[54]) + (-dsrc[19] - dsrc[20])*1.0625 + (-dsrc[33] - dsrc[34] - dsrc[37] - dsrc[38])*1.25 + (dsrc[41] + dsrc[42] + dsrc[45] + dsrc[46])*2 + (-dsrc[11] - dsrc[12])*2.125 + (-dsrc[25] - dsrc[26] - dsrc[29] - dsrc[30])*2.5 + (-dsrc[51] - dsrc[52])*4.25 + (dsrc[35] + dsrc[36])*5.3125 + (-dsrc[43] - dsrc[44])*8.5 + (dsrc[27] + dsrc[28])*10.625;
+    ddst[tileCount +26*istride] = (-dsrc[17] + dsrc[18] - dsrc[21] + dsrc[22])*0.25 + (-dsrc[9 ] + dsrc[10] - dsrc[13] + dsrc[14])*0.5 + (-dsrc[49] + dsrc[50] - dsrc[53] + dsrc[54]) + (dsrc[19] - dsrc[20])*1.0625 + (dsrc[33] - dsrc[34] + dsrc[37] - dsrc[38])*1.25 + (-dsrc[41] + dsrc[42] - dsrc[45] + dsrc[46])*2 + (dsrc[11] - dsrc[12])*2.125 + (dsrc[25] - dsrc[26] + dsrc[29] - dsrc[30])*2.5 + (dsrc[51] - dsrc[52])*4.25 + (-dsrc[35] + dsrc[36])*5.3125 + (dsrc[43] - dsrc[44])*8.5 + (-dsrc[27] + dsrc[28])*10.625;
+    ddst[tileCount +27*istride] = (dsrc[18])*0.0625 + (dsrc[10] + dsrc[17])*0.125 + (dsrc[9 ] + dsrc[22] + dsrc[50])*0.25 + (-dsrc[20] - dsrc[34])*0.3125 + (dsrc[14] + dsrc[21] + dsrc[42] + dsrc[49])*0.5 + (-dsrc[12] - dsrc[19] - dsrc[26] - dsrc[33])*0.625 + (dsrc[13] + dsrc[41] + dsrc[54]) + (-dsrc[11] - dsrc[25] - dsrc[38] - dsrc[52])*1.25 + (dsrc[36])*1.5625 + (dsrc[46] + dsrc[53])*2 + (-dsrc[30] - dsrc[37] - dsrc[44] - dsrc[51])*2.5 + (dsrc[28] + dsrc[35])*3.125 + (dsrc[45])*4 + (-dsrc[29] - dsrc[43])*5 + (dsrc[27])*6.25;
+    ddst[tileCount +28*istride] = (dsrc[18])*0.0625 + (dsrc[10] - dsrc[17])*0.125 + (-dsrc[9 ] + dsrc[22] + dsrc[50])*0.25 + (-dsrc[20] - dsrc[34])*0.3125 + (dsrc[14] - dsrc[21] + dsrc[42] - dsrc[49])*0.5 + (-dsrc[12] + dsrc[19] - dsrc[26] + dsrc[33])*0.625 + (-dsrc[13] - dsrc[41] + dsrc[54]) + (dsrc[11] + dsrc[25] - dsrc[38] - dsrc[52])*1.25 + (dsrc[36])*1.5625 + (dsrc[46] - dsrc[53])*2 + (-dsrc[30] + dsrc[37] - dsrc[44] + dsrc[51])*2.5 + (dsrc[28] - dsrc[35])*3.125 + (-dsrc[45])*4 + (dsrc[29] + dsrc[43])*5 + (-dsrc[27])*6.25;
+    ddst[tileCount +29*istride] = (dsrc[21])*0.125 + (dsrc[13] + dsrc[22])*0.25 + (dsrc[14] + dsrc[17] + dsrc[53])*0.5 + (-dsrc[19] - dsrc[37])*0.625 + (dsrc[9 ] + dsrc[18] + dsrc[45] + dsrc[54]) + (-dsrc[11] - dsrc[20] - dsrc[29] - dsrc[38])*1.25 + (dsrc[10] + dsrc[46] + dsrc[49])*2 + (-dsrc[12] - dsrc[30] - dsrc[33] - dsrc[51])*2.5 + (dsrc[35])*3.125 + (dsrc[41] + dsrc[50])*4 + (-dsrc[25] - dsrc[34] - dsrc[43] - dsrc[52])*5 + (dsrc[27] + dsrc[36])*6.25 + (dsrc[42])*8 + (-dsrc[26] - dsrc[44])*10 + (dsrc[28])*12.5;
+    ddst[tileCount +30*istride] = (-dsrc[21])*0.125 + (-dsrc[13] + dsrc[22])*0.25 + (dsrc[14] - dsrc[17] - dsrc[53])*0.5 + (dsrc[19] + dsrc[37])*0.625 + (-dsrc[9 ] + dsrc[18] - dsrc[45] + dsrc[54]) + (dsrc[11] - dsrc[20] + dsrc[29] - dsrc[38])*1.25 + (dsrc[10] + dsrc[46] - dsrc[49])*2 + (-dsrc[12] - dsrc[30] + dsrc[33] + dsrc[51])*2.5 + (-dsrc[35])*3.125 + (-dsrc[41] + dsrc[50])*4 + (dsrc[25] - dsrc[34] + dsrc[43] - dsrc[52])*5 + (-dsrc[27] + dsrc[36])*6.25 + (dsrc[42])*8 + (-dsrc[26] - dsrc[44])*10 + (dsrc[28])*12.5;
+    ddst[tileCount +31*istride] = (-dsrc[17] + dsrc[23])*0.25 + (-dsrc[9 ] + dsrc[15])*0.5 + (-dsrc[49] + dsrc[55]) + (dsrc[33] - dsrc[39])*1.25 + (dsrc[19] - dsrc[21])*1.3125 + (-dsrc[41] + dsrc[47])*2 + (dsrc[25] - dsrc[31])*2.5 + (dsrc[11] - dsrc[13])*2.625 + (dsrc[51] - dsrc[53])*5.25 + (-dsrc[35] + dsrc[37])*6.5625 + (dsrc[43] - dsrc[45])*10.5 + (-dsrc[27] + dsrc[29])*13.125;
+    ddst[tileCount +32*istride] = (dsrc[16] - dsrc[22])*0.25 + (-dsrc[8 ] + dsrc[14])*0.5 + (dsrc[48] - dsrc[54]) + (-dsrc[32] + dsrc[38])*1.25 + (-dsrc[18] + dsrc[20])*1.3125 + (-dsrc[40] + dsrc[46])*2 + (dsrc[24] - dsrc[30])*2.5 + (dsrc[10] - dsrc[12])*2.625 + (-dsrc[50] + dsrc[52])*5.25 + (dsrc[34] - dsrc[36])*6.5625 + (dsrc[42] - dsrc[44])*10.5 + (-dsrc[26] + dsrc[28])*13.125;
+    ddst[tileCount +33*istride] = (dsrc[17] + dsrc[18] + dsrc[21] + dsrc[22])*0.25 + (-dsrc[9 ] - dsrc[10] - dsrc[13] - dsrc[14])*0.5 + (dsrc[49] + dsrc[50] + dsrc[53] + dsrc[54]) + (-dsrc[19] - dsrc[20])*1.0625 + (-dsrc[33] - dsrc[34] - dsrc[37] - dsrc[38])*1.25 + (-dsrc[41] - dsrc[42] - dsrc[45] - dsrc[46])*2 + (dsrc[11] + dsrc[12])*2.125 + (dsrc[25] + dsrc[26] + dsrc[29] + dsrc[30])*2.5 + (-dsrc[51] - dsrc[52])*4.25 + (dsrc[35] + dsrc[36])*5.3125 + (dsrc[43] + dsrc[44])*8.5 + (-dsrc[27] - dsrc[28])*10.625;
+    ddst[tileCount +34*istride] = (-dsrc[17] + dsrc[18] - dsrc[21] + dsrc[22])*0.25 + (dsrc[9 ] - dsrc[10] + dsrc[13] - dsrc[14])*0.5 + (-dsrc[49] + dsrc[50] - dsrc[53] + dsrc[54]) + (dsrc[19] - dsrc[20])*1.0625 + (dsrc[33] - dsrc[34] + dsrc[37] - dsrc[38])*1.25 + (dsrc[41] - dsrc[42] + dsrc[45] - dsrc[46])*2 + (-dsrc[11] + dsrc[12])*2.125 + (-dsrc[25] + dsrc[26] - dsrc[29] + dsrc[30])*2.5 + (dsrc[51] - dsrc[52])*4.25 + (-dsrc[35] + dsrc[36])*5.3125 + (-dsrc[43] + dsrc[44])*8.5 + (dsrc[27] - dsrc[28])*10.625;
+    ddst[tileCount +35*istride] = (dsrc[18])*0.0625 + (-dsrc[10] + dsrc[17])*0.125 + (-dsrc[9 ] + dsrc[22] + dsrc[50])*0.25 + (-dsrc[20] - dsrc[34])*0.3125 + (-dsrc[14] + dsrc[21] - dsrc[42] + dsrc[49])*0.5 + (dsrc[12] - dsrc[19] + dsrc[26] - dsrc[33])*0.625 + (-dsrc[13] - dsrc[41] + dsrc[54]) + (dsrc[11] + dsrc[25] - dsrc[38] - dsrc[52])*1.25 + (dsrc[36])*1.5625 + (-dsrc[46] + dsrc[53])*2 + (dsrc[30] - dsrc[37] + dsrc[44] - dsrc[51])*2.5 + (-dsrc[28] + dsrc[35])*3.125 + (-dsrc[45])*4 + (dsrc[29] + dsrc[43])*5 + (-dsrc[27])*6.25;
+    ddst[tileCount +36*istride] = (dsrc[18])*0.0625 + (-dsrc[10] - dsrc[17])*0.125 + (dsrc[9 ] + dsrc[22] + dsrc[50])*0.25 + (-dsrc[20] - dsrc[34])*0.3125 + (-dsrc[14] - dsrc[21] - dsrc[42] - dsrc[49])*0.5 + (dsrc[12] + dsrc[19] + dsrc[26] + dsrc[33])*0.625 + (dsrc[13] + dsrc[41] + dsrc[54]) + (-dsrc[11] - dsrc[25] - dsrc[38] - dsrc[52])*1.25 + (dsrc[36])*1.5625 + (-dsrc[46] - dsrc[53])*2 + (dsrc[30] + dsrc[37] + dsrc[44] + dsrc[51])*2.5 + (-dsrc[28] - dsrc[35])*3.125 + (dsrc[45])*4 + (-dsrc[29] - dsrc[43])*5 + (dsrc[27])*6.25;
+    ddst[tileCount +37*istride] = (dsrc[21])*0.125 + (-dsrc[13] + dsrc[22])*0.25 + (-dsrc[14] + dsrc[17] + dsrc[53])*0.5 + (-dsrc[19] - dsrc[37])*0.625 + (-dsrc[9 ] + dsrc[18] - dsrc[45] + dsrc[54]) + (dsrc[11] - dsrc[20] + dsrc[29] - dsrc[38])*1.25 + (-dsrc[10] - dsrc[46] + dsrc[49])*2 + (dsrc[12] + dsrc[30] - dsrc[33] - dsrc[51])*2.5 + (dsrc[35])*3.125 + (-dsrc[41] + dsrc[50])*4 + (dsrc[25] - dsrc[34] + dsrc[43] - dsrc[52])*5 + (-dsrc[27] + dsrc[36])*6.25 + (-dsrc[42])*8 + (dsrc[26] + dsrc[44])*10 + (-dsrc[28])*12.5;
+    ddst[tileCount +38*istride] = (-dsrc[21])*0.125 + (dsrc[13] + dsrc[22])*0.25 + (-dsrc[14] - dsrc[17] - dsrc[53])*0.5 + (dsrc[19] + dsrc[37])*0.625 + (dsrc[9 ] + dsrc[18] + dsrc[45] + dsrc[54]) + (-dsrc[11] - dsrc[20] - dsrc[29] - dsrc[38])*1.25 + (-dsrc[10] - dsrc[46] - dsrc[49])*2 + (dsrc[12] + dsrc[30] + dsrc[33] + dsrc[51])*2.5 + (-dsrc[35])*3.125 + (dsrc[41] + dsrc[50])*4 + (-dsrc[25] - dsrc[34] - dsrc[43] - dsrc[52])*5 + (dsrc[27] + dsrc[36])*6.25 + (-dsrc[42])*8 + (dsrc[26] + dsrc[44])*10 + (-dsrc[28])*12.5;
+    ddst[tileCount +39*istride] = (-dsrc[17] + dsrc[23])*0.25 + (dsrc[9 ] - dsrc[15])*0.5 + (-dsrc[49] + dsrc[55]) + (dsrc[33] - dsrc[39])*1.25 + (dsrc[19] - dsrc[21])*1.3125 + (dsrc[41] - dsrc[47])*2 + (-dsrc[25] + dsrc[31])*2.5 + (-dsrc[11] + dsrc[13])*2.625 + (dsrc[51] - dsrc[53])*5.25 + (-dsrc[35] + dsrc[37])*6.5625 + (-dsrc[43] + dsrc[45])*10.5 + (dsrc[27] - dsrc[29])*13.125;
+    ddst[tileCount +40*istride] = (dsrc[40] - dsrc[46])*0.5 + (dsrc[48] - dsrc[54]) + (dsrc[8 ] - dsrc[14])*2 + (-dsrc[24] + dsrc[30])*2.5 + (-dsrc[42] + dsrc[44])*2.625 + (dsrc[16] - dsrc[22])*4 + (-dsrc[32] + dsrc[38])*5 + (-dsrc[50] + dsrc[52])*5.25 + (-dsrc[10] + dsrc[12])*10.5 + (dsrc[26] - dsrc[28])*13.125 + (-dsrc[18] + dsrc[20])*21 + (dsrc[34] - dsrc[36])*26.25;
+    ddst[tileCount +41*istride] = (dsrc[41] + dsrc[42] + dsrc[45] + dsrc[46])*0.5 + (dsrc[49] + dsrc[50] + dsrc[53] + dsrc[54]) + (dsrc[9 ] + dsrc[10] + dsrc[13] + dsrc[14])*2 + (-dsrc[43] - dsrc[44])*2.125 + (-dsrc[25] - dsrc[26] - dsrc[29] - dsrc[30])*2.5 + (dsrc[17] + dsrc[18] + dsrc[21] + dsrc[22])*4 + (-dsrc[51] - dsrc[52])*4.25 + (-dsrc[33] - dsrc[34] - dsrc[37] - dsrc[38])*5 + (-dsrc[11] - dsrc[12])*8.5 + (dsrc[27] + dsrc[28])*10.625 + (-dsrc[19] - dsrc[20])*17 + (dsrc[35] + dsrc[36])*21.25;
+    ddst[tileCount +42*istride] = (-dsrc[41] + dsrc[42] - dsrc[45] + dsrc[46])*0.5 + (-dsrc[49] + dsrc[50] - dsrc[53] + dsrc[54]) + (-dsrc[9 ] + dsrc[10] - dsrc[13] + dsrc[14])*2 + (dsrc[43] - dsrc[44])*2.125 + (dsrc[25] - dsrc[26] + dsrc[29] - dsrc[30])*2.5 + (-dsrc[17] + dsrc[18] - dsrc[21] + dsrc[22])*4 + (dsrc[51] - dsrc[52])*4.25 + (dsrc[33] - dsrc[34] + dsrc[37] - dsrc[38])*5 + (dsrc[11] - dsrc[12])*8.5 + (-dsrc[27] + dsrc[28])*10.625 + (dsrc[19] - dsrc[20])*17 + (-dsrc[35] + dsrc[36])*21.25;
+    ddst[tileCount +43*istride] = (dsrc[42])*0.125 + (dsrc[41] + dsrc[50])*0.25 + (dsrc[10] + dsrc[46] + dsrc[49])*0.5 + (-dsrc[26] - dsrc[44])*0.625 + (dsrc[9 ] + dsrc[18] + dsrc[45] + dsrc[54]) + (-dsrc[25] - dsrc[34] - dsrc[43] - dsrc[52])*1.25 + (dsrc[14] + dsrc[17] + dsrc[53])*2 + (-dsrc[12] - dsrc[30] - dsrc[33] - dsrc[51])*2.5 + (dsrc[28])*3.125 + (dsrc[13] + dsrc[22])*4 + (-dsrc[11] - dsrc[20] - dsrc[29] - dsrc[38])*5 + (dsrc[27] + dsrc[36])*6.25 + (dsrc[21])*8 + (-dsrc[19] - dsrc[37])*10 + (dsrc[35])*12.5;
+    ddst[tileCount +44*istride] = (dsrc[42])*0.125 + (-dsrc[41] + dsrc[50])*0.25 + (dsrc[10] + dsrc[46] - dsrc[49])*0.5 + (-dsrc[26] - dsrc[44])*0.625 + (-dsrc[9 ] + dsrc[18] - dsrc[45] + dsrc[54]) + (dsrc[25] - dsrc[34] + dsrc[43] - dsrc[52])*1.25 + (dsrc[14] - dsrc[17] - dsrc[53])*2 + (-dsrc[12] - dsrc[30] + dsrc[33] + dsrc[51])*2.5 + (dsrc[28])*3.125 + (-dsrc[13] + dsrc[22])*4 + (dsrc[11] - dsrc[20] + dsrc[29] - dsrc[38])*5 + (-dsrc[27] + dsrc[36])*6.25 + (-dsrc[21])*8 + (dsrc[19] + dsrc[37])*10 + (-dsrc[35])*12.5;
+    ddst[tileCount +45*istride] = (dsrc[45])*0.25 + (dsrc[46] + dsrc[53])*0.5 + (dsrc[13] + dsrc[41] + dsrc[54]) + (-dsrc[29] - dsrc[43])*1.25 + (dsrc[14] + dsrc[21] + dsrc[42] + dsrc[49])*2 + (-dsrc[30] - dsrc[37] - dsrc[44] - dsrc[51])*2.5 + (dsrc[9 ] + dsrc[22] + dsrc[50])*4 + (-dsrc[11] - dsrc[25] - dsrc[38] - dsrc[52])*5 + (dsrc[27])*6.25 + (dsrc[10] + dsrc[17])*8 + (-dsrc[12] - dsrc[19] - dsrc[26] - dsrc[33])*10 + (dsrc[28] + dsrc[35])*12.5 + (dsrc[18])*16 + (-dsrc[20] - dsrc[34])*20 + (dsrc[36])*25;
+    ddst[tileCount +46*istride] = (-dsrc[45])*0.25 + (dsrc[46] - dsrc[53])*0.5 + (-dsrc[13] - dsrc[41] + dsrc[54]) + (dsrc[29] + dsrc[43])*1.25 + (dsrc[14] - dsrc[21] + dsrc[42] - dsrc[49])*2 + (-dsrc[30] + dsrc[37] - dsrc[44] + dsrc[51])*2.5 + (-dsrc[9 ] + dsrc[22] + dsrc[50])*4 + (dsrc[11] + dsrc[25] - dsrc[38] - dsrc[52])*5 + (-dsrc[27])*6.25 + (dsrc[10] - dsrc[17])*8 + (-dsrc[12] + dsrc[19] - dsrc[26] + dsrc[33])*10 + (dsrc[28] - dsrc[35])*12.5 + (dsrc[18])*16 + (-dsrc[20] - dsrc[34])*20 + (dsrc[36])*25;
+    ddst[tileCount +47*istride] = (-dsrc[41] + dsrc[47])*0.5 + (-dsrc[49] + dsrc[55]) + (-dsrc[9 ] + dsrc[15])*2 + (dsrc[25] - dsrc[31])*2.5 + (dsrc[43] - dsrc[45])*2.625 + (-dsrc[17] + dsrc[23])*4 + (dsrc[33] - dsrc[39])*5 + (dsrc[51] - dsrc[53])*5.25 + (dsrc[11] - dsrc[13])*10.5 + (-dsrc[27] + dsrc[29])*13.125 + (dsrc[19] - dsrc[21])*21 + (-dsrc[35] + dsrc[37])*26.25;
+    ddst[tileCount +48*istride] = (-dsrc[40] + dsrc[46])*0.5 + (dsrc[48] - dsrc[54]) + (-dsrc[8 ] + dsrc[14])*2 + (dsrc[24] - dsrc[30])*2.5 + (dsrc[42] - dsrc[44])*2.625 + (dsrc[16] - dsrc[22])*4 + (-dsrc[32] + dsrc[38])*5 + (-dsrc[50] + dsrc[52])*5.25 + (dsrc[10] - dsrc[12])*10.5 + (-dsrc[26] + dsrc[28])*13.125 + (-dsrc[18] + dsrc[20])*21 + (dsrc[34] - dsrc[36])*26.25;
+    ddst[tileCount +49*istride] = (-dsrc[41] - dsrc[42] - dsrc[45] - dsrc[46])*0.5 + (dsrc[49] + dsrc[50] + dsrc[53] + dsrc[54]) + (-dsrc[9 ] - dsrc[10] - dsrc[13] - dsrc[14])*2 + (dsrc[43] + dsrc[44])*2.125 + (dsrc[25] + dsrc[26] + dsrc[29] + dsrc[30])*2.5 + (dsrc[17] + dsrc[18] + dsrc[21] + dsrc[22])*4 + (-dsrc[51] - dsrc[52])*4.25 + (-dsrc[33] - dsrc[34] - dsrc[37] - dsrc[38])*5 + (dsrc[11] + dsrc[12])*8.5 + (-dsrc[27] - dsrc[28])*10.625 + (-dsrc[19] - dsrc[20])*17 + (dsrc[35] + dsrc[36])*21.25;
+    ddst[tileCount +50*istride] = (dsrc[41] - dsrc[42] + dsrc[45] - dsrc[46])*0.5 + (-dsrc[49] + dsrc[50] - dsrc[53] + dsrc[54]) + (dsrc[9 ] - dsrc[10] + dsrc[13] - dsrc[14])*2 + (-dsrc[43] + dsrc[44])*2.125 + (-dsrc[25] + dsrc[26] - dsrc[29] + dsrc[30])*2.5 + (-dsrc[17] + dsrc[18] - dsrc[21] + dsrc[22])*4 + (dsrc[51] - dsrc[52])*4.25 + (dsrc[33] - dsrc[34] + dsrc[37] - dsrc[38])*5 + (-dsrc[11] + dsrc[12])*8.5 + (dsrc[27] - dsrc[28])*10.625 + (dsrc[19] - dsrc[20])*17 + (-dsrc[35] + dsrc[36])*21.25;
+    ddst[tileCount +51*istride] = (-dsrc[42])*0.125 + (-dsrc[41] + dsrc[50])*0.25 + (-dsrc[10] - dsrc[46] + dsrc[49])*0.5 + (dsrc[26] + dsrc[44])*0.625 + (-dsrc[9 ] + dsrc[18] - dsrc[45] + dsrc[54]) + (dsrc[25] - dsrc[34] + dsrc[43] - dsrc[52])*1.25 + (-dsrc[14] + dsrc[17] + dsrc[53])*2 + (dsrc[12] + dsrc[30] - dsrc[33] - dsrc[51])*2.5 + (-dsrc[28])*3.125 + (-dsrc[13] + dsrc[22])*4 + (dsrc[11] - dsrc[20] + dsrc[29] - dsrc[38])*5 + (-dsrc[27] + dsrc[36])*6.25 + (dsrc[21])*8 + (-dsrc[19] - dsrc[37])*10 + (dsrc[35])*12.5;
+    ddst[tileCount +52*istride] = (-dsrc[42])*0.125 + (dsrc[41] + dsrc[50])*0.25 + (-dsrc[10] - dsrc[46] - dsrc[49])*0.5 + (dsrc[26] + dsrc[44])*0.625 + (dsrc[9 ] + dsrc[18] + dsrc[45] + dsrc[54]) + (-dsrc[25] - dsrc[34] - dsrc[43] - dsrc[52])*1.25 + (-dsrc[14] - dsrc[17] - dsrc[53])*2 + (dsrc[12] + dsrc[30] + dsrc[33] + dsrc[51])*2.5 + (-dsrc[28])*3.125 + (dsrc[13] + dsrc[22])*4 + (-dsrc[11] - dsrc[20] - dsrc[29] - dsrc[38])*5 + (dsrc[27] + dsrc[36])*6.25 + (-dsrc[21])*8 + (dsrc[19] + dsrc[37])*10 + (-dsrc[35])*12.5;
+    ddst[tileCount +53*istride] = (-dsrc[45])*0.25 + (-dsrc[46] + dsrc[53])*0.5 + (-dsrc[13] - dsrc[41] + dsrc[54]) + (dsrc[29] + dsrc[43])*1.25 + (-dsrc[14] + dsrc[21] - dsrc[42] + dsrc[49])*2 + (dsrc[30] - dsrc[37] + dsrc[44] - dsrc[51])*2.5 + (-dsrc[9 ] + dsrc[22] + dsrc[50])*4 + (dsrc[11] + dsrc[25] - dsrc[38] - dsrc[52])*5 + (-dsrc[27])*6.25 + (-dsrc[10] + dsrc[17])*8 + (dsrc[12] - dsrc[19] + dsrc[26] - dsrc[33])*10 + (-dsrc[28] + dsrc[35])*12.5 + (dsrc[18])*16 + (-dsrc[20] - dsrc[34])*20 + (dsrc[36])*25;
+    ddst[tileCount +54*istride] = (dsrc[45])*0.25 + (-dsrc[46] - dsrc[53])*0.5 + (dsrc[13] + dsrc[41] + dsrc[54]) + (-dsrc[29] - dsrc[43])*1.25 + (-dsrc[14] - dsrc[21] - dsrc[42] - dsrc[49])*2 + (dsrc[30] + dsrc[37] + dsrc[44] + dsrc[51])*2.5 + (dsrc[9 ] + dsrc[22] + dsrc[50])*4 + (-dsrc[11] - dsrc[25] - dsrc[38] - dsrc[52])*5 + (dsrc[27])*6.25 + (-dsrc[10] - dsrc[17])*8 + (dsrc[12] + dsrc[19] + dsrc[26] + dsrc[33])*10 + (-dsrc[28] - dsrc[35])*12.5 + (dsrc[18])*16 + (-dsrc[20] - dsrc[34])*20 + (dsrc[36])*25;
+    ddst[tileCount +55*istride] = (dsrc[41] - dsrc[47])*0.5 + (-dsrc[49] + dsrc[55]) + (dsrc[9 ] - dsrc[15])*2 + (-dsrc[25] + dsrc[31])*2.5 + (-dsrc[43] + dsrc[45])*2.625 + (-dsrc[17] + dsrc[23])*4 + (dsrc[33] - dsrc[39])*5 + (dsrc[51] - dsrc[53])*5.25 + (-dsrc[11] + dsrc[13])*10.5 + (dsrc[27] - dsrc[29])*13.125 + (dsrc[19] - dsrc[21])*21 + (-dsrc[35] + dsrc[37])*26.25;
+    ddst[tileCount +56*istride] = (-dsrc[8 ] + dsrc[14] + dsrc[56] - dsrc[62]) + (dsrc[10] - dsrc[12] + dsrc[24] - dsrc[30] - dsrc[40] + dsrc[46] - dsrc[58] + dsrc[60])*5.25 + (-dsrc[26] + dsrc[28] + dsrc[42] - dsrc[44])*27.5625;
+    ddst[tileCount +57*istride] = (-dsrc[9 ] - dsrc[10] - dsrc[13] - dsrc[14] + dsrc[57] + dsrc[58] + dsrc[61] + dsrc[62]) + (dsrc[11] + dsrc[12] - dsrc[59] - dsrc[60])*4.25 + (dsrc[25] + dsrc[26] + dsrc[29] + dsrc[30] - dsrc[41] - dsrc[42] - dsrc[45] - dsrc[46])*5.25 + (-dsrc[27] - dsrc[28] + dsrc[43] + dsrc[44])*22.3125;
+    ddst[tileCount +58*istride] = (dsrc[9 ] - dsrc[10] + dsrc[13] - dsrc[14] - dsrc[57] + dsrc[58] - dsrc[61] + dsrc[62]) + (-dsrc[11] + dsrc[12] + dsrc[59] - dsrc[60])*4.25 + (-dsrc[25] + dsrc[26] - dsrc[29] + dsrc[30] + dsrc[41] - dsrc[42] + dsrc[45] - dsrc[46])*5.25 + (dsrc[27] - dsrc[28] - dsrc[43] + dsrc[44])*22.3125;
+    ddst[tileCount +59*istride] = (-dsrc[10] + dsrc[58])*0.25 + (-dsrc[9 ] + dsrc[57])*0.5 + (-dsrc[14] + dsrc[62]) + (dsrc[12] - dsrc[60])*1.25 + (dsrc[26] - dsrc[42])*1.3125 + (-dsrc[13] + dsrc[61])*2 + (dsrc[11] - dsrc[59])*2.5 + (dsrc[25] - dsrc[41])*2.625 + (dsrc[30] - dsrc[46])*5.25 + (-dsrc[28] + dsrc[44])*6.5625 + (dsrc[29] - dsrc[45])*10.5 + (-dsrc[27] + dsrc[43])*13.125;
+    ddst[tileCount +60*istride] = (-dsrc[10] + dsrc[58])*0.25 + (dsrc[9 ] - dsrc[57])*0.5 + (-dsrc[14] + dsrc[62]) + (dsrc[12] - dsrc[60])*1.25 + (dsrc[26] - dsrc[42])*1.3125 + (dsrc[13] - dsrc[61])*2 + (-dsrc[11] + dsrc[59])*2.5 + (-dsrc[25] + dsrc[41])*2.625 + (dsrc[30] - dsrc[46])*5.25 + (-dsrc[28] + dsrc[44])*6.5625 + (-dsrc[29] + dsrc[45])*10.5 + (dsrc[27] - dsrc[43])*13.125;
+    ddst[tileCount +61*istride] = (-dsrc[13] + dsrc[61])*0.5 + (-dsrc[14] + dsrc[62]) + (-dsrc[9 ] + dsrc[57])*2 + (dsrc[11] - dsrc[59])*2.5 + (dsrc[29] - dsrc[45])*2.625 + (-dsrc[10] + dsrc[58])*4 + (dsrc[12] - dsrc[60])*5 + (dsrc[30] - dsrc[46])*5.25 + (dsrc[25] - dsrc[41])*10.5 + (-dsrc[27] + dsrc[43])*13.125 + (dsrc[26] - dsrc[42])*21 + (-dsrc[28] + dsrc[44])*26.25;
+    ddst[tileCount +62*istride] = (dsrc[13] - dsrc[61])*0.5 + (-dsrc[14] + dsrc[62]) + (dsrc[9 ] - dsrc[57])*2 + (-dsrc[11] + dsrc[59])*2.5 + (-dsrc[29] + dsrc[45])*2.625 + (-dsrc[10] + dsrc[58])*4 + (dsrc[12] - dsrc[60])*5 + (dsrc[30] - dsrc[46])*5.25 + (-dsrc[25] + dsrc[41])*10.5 + (dsrc[27] - dsrc[43])*13.125 + (dsrc[26] - dsrc[42])*21 + (-dsrc[28] + dsrc[44])*26.25;
+    ddst[tileCount +63*istride] = (dsrc[9 ] - dsrc[15] - dsrc[57] + dsrc[63]) + (-dsrc[11] + dsrc[13] - dsrc[25] + dsrc[31] + dsrc[41] - dsrc[47] + dsrc[59] - dsrc[61])*5.25 + (dsrc[27] - dsrc[29] - dsrc[43] + dsrc[45])*27.5625;
 }
 
     template <typename Dtype>
@@ -179,72 +176,72 @@ inline void transformByBT_first(Dtype *dsrc, Dtype *ddst)
 }
 
     template <typename Dtype>
-inline void transformByBT_second(Dtype *dsrc, Dtype *ddst, int tileCount)
+inline void transformByBT_second(Dtype *dsrc, Dtype *ddst, int tileCount, const long istride)
 {
-    ddst[tileCount +  0*ISTRIDE6X3] = dsrc[ 0]*BT[ 0] + dsrc[ 1]*BT[ 1] + dsrc[ 2]*BT[ 2] + dsrc[ 3]*BT[ 3] + dsrc[ 4]*BT[ 4] + dsrc[ 5]*BT[ 5] + dsrc[ 6]*BT[ 6] + dsrc[ 7]*BT[ 7];
-    ddst[tileCount +  1*ISTRIDE6X3] = dsrc[ 0]*BT[ 8] + dsrc[ 1]*BT[ 9] + dsrc[ 2]*BT[10] + dsrc[ 3]*BT[11] + dsrc[ 4]*BT[12] + dsrc[ 5]*BT[13] + dsrc[ 6]*BT[14] + dsrc[ 7]*BT[15];
-    ddst[tileCount +  2*ISTRIDE6X3] = dsrc[ 0]*BT[16] + dsrc[ 1]*BT[17] + dsrc[ 2]*BT[18] + dsrc[ 3]*BT[19] + dsrc[ 4]*BT[20] + dsrc[ 5]*BT[21] + dsrc[ 6]*BT[22] + dsrc[ 7]*BT[23];
-    ddst[tileCount +  3*ISTRIDE6X3] = dsrc[ 0]*BT[24] + dsrc[ 1]*BT[25] + dsrc[ 2]*BT[26] + dsrc[ 3]*BT[27] + dsrc[ 4]*BT[28] + dsrc[ 5]*BT[29] + dsrc[ 6]*BT[30] + dsrc[ 7]*BT[31];
-    ddst[tileCount +  4*ISTRIDE6X3] = dsrc[ 0]*BT[32] + dsrc[ 1]*BT[33] + dsrc[ 2]*BT[34] + dsrc[ 3]*BT[35] + dsrc[ 4]*BT[36] + dsrc[ 5]*BT[37] + dsrc[ 6]*BT[38] + dsrc[ 7]*BT[39];
-    ddst[tileCount +  5*ISTRIDE6X3] = dsrc[ 0]*BT[40] + dsrc[ 1]*BT[41] + dsrc[ 2]*BT[42] + dsrc[ 3]*BT[43] + dsrc[ 4]*BT[44] + dsrc[ 5]*BT[45] + dsrc[ 6]*BT[46] + dsrc[ 7]*BT[47];
-    ddst[tileCount +  6*ISTRIDE6X3] = dsrc[ 0]*BT[48] + dsrc[ 1]*BT[49] + dsrc[ 2]*BT[50] + dsrc[ 3]*BT[51] + dsrc[ 4]*BT[52] + dsrc[ 5]*BT[53] + dsrc[ 6]*BT[54] + dsrc[ 7]*BT[55];
-    ddst[tileCount +  7*ISTRIDE6X3] = dsrc[ 0]*BT[56] + dsrc[ 1]*BT[57] + dsrc[ 2]*BT[58] + dsrc[ 3]*BT[59] + dsrc[ 4]*BT[60] + dsrc[ 5]*BT[61] + dsrc[ 6]*BT[62] + dsrc[ 7]*BT[63];
-    ddst[tileCount +  8*ISTRIDE6X3] = dsrc[ 8]*BT[ 0] + dsrc[ 9]*BT[ 1] + dsrc[10]*BT[ 2] + dsrc[11]*BT[ 3] + dsrc[12]*BT[ 4] + dsrc[13]*BT[ 5] + dsrc[14]*BT[ 6] + dsrc[15]*BT[ 7];
-    ddst[tileCount +  9*ISTRIDE6X3] = dsrc[ 8]*BT[ 8] + dsrc[ 9]*BT[ 9] + dsrc[10]*BT[10] + dsrc[11]*BT[11] + dsrc[12]*BT[12] + dsrc[13]*BT[13] + dsrc[14]*BT[14] + dsrc[15]*BT[15];
-    ddst[tileCount + 10*ISTRIDE6X3] = dsrc[ 8]*BT[16] + dsrc[ 9]*BT[17] + dsrc[10]*BT[18] + dsrc[11]*BT[19] + dsrc[12]*BT[20] + dsrc[13]*BT[21] + dsrc[14]*BT[22] + dsrc[15]*BT[23];
-    ddst[tileCount + 11*ISTRIDE6X3] = dsrc[ 8]*BT[24] + dsrc[ 9]*BT[25] + dsrc[10]*BT[26] + dsrc[11]*BT[27] + dsrc[12]*BT[28] + dsrc[13]*BT[29] + dsrc[14]*BT[30] + dsrc[15]*BT[31];
-    ddst[tileCount + 12*ISTRIDE6X3] = dsrc[ 8]*BT[32] + dsrc[ 9]*BT[33] + dsrc[10]*BT[34] + dsrc[11]*BT[35] + dsrc[12]*BT[36] + dsrc[13]*BT[37] + dsrc[14]*BT[38] + dsrc[15]*BT[39];
-    ddst[tileCount + 13*ISTRIDE6X3] = dsrc[ 8]*BT[40] + dsrc[ 9]*BT[41] + dsrc[10]*BT[42] + dsrc[11]*BT[43] + dsrc[12]*BT[44] + dsrc[13]*BT[45] + dsrc[14]*BT[46] + dsrc[15]*BT[47];
-    ddst[tileCount + 14*ISTRIDE6X3] = dsrc[ 8]*BT[48] + dsrc[ 9]*BT[49] + dsrc[10]*BT[50] + dsrc[11]*BT[51] + dsrc[12]*BT[52] + dsrc[13]*BT[53] + dsrc[14]*BT[54] + dsrc[15]*BT[55];
-    ddst[tileCount + 15*ISTRIDE6X3] = dsrc[ 8]*BT[56] + dsrc[ 9]*BT[57] + dsrc[10]*BT[58] + dsrc[11]*BT[59] + dsrc[12]*BT[60] + dsrc[13]*BT[61] + dsrc[14]*BT[62] + dsrc[15]*BT[63];
-    ddst[tileCount + 16*ISTRIDE6X3] = dsrc[16]*BT[ 0] + dsrc[17]*BT[ 1] + dsrc[18]*BT[ 2] + dsrc[19]*BT[ 3] + dsrc[20]*BT[ 4] + dsrc[21]*BT[ 5] + dsrc[22]*BT[ 6] + dsrc[23]*BT[ 7];
-    ddst[tileCount + 17*ISTRIDE6X3] = dsrc[16]*BT[ 8] + dsrc[17]*BT[ 9] + dsrc[18]*BT[10] + dsrc[19]*BT[11] + dsrc[20]*BT[12] + dsrc[21]*BT[13] + dsrc[22]*BT[14] + dsrc[23]*BT[15];
-    ddst[tileCount + 18*ISTRIDE6X3] = dsrc[16]*BT[16] + dsrc[17]*BT[17] + dsrc[18]*BT[18] + dsrc[19]*BT[19] + dsrc[20]*BT[20] + dsrc[21]*BT[21] + dsrc[22]*BT[22] + dsrc[23]*BT[23];
-    ddst[tileCount + 19*ISTRIDE6X3] = dsrc[16]*BT[24] + dsrc[17]*BT[25] + dsrc[18]*BT[26] + dsrc[19]*BT[27] + dsrc[20]*BT[28] + dsrc[21]*BT[29] + dsrc[22]*BT[30] + dsrc[23]*BT[31];
-    ddst[tileCount + 20*ISTRIDE6X3] = dsrc[16]*BT[32] + dsrc[17]*BT[33] + dsrc[18]*BT[34] + dsrc[19]*BT[35] + dsrc[20]*BT[36] + dsrc[21]*BT[37] + dsrc[22]*BT[38] + dsrc[23]*BT[39];
-    ddst[tileCount + 21*ISTRIDE6X3] = dsrc[16]*BT[40] + dsrc[17]*BT[41] + dsrc[18]*BT[42] + dsrc[19]*BT[43] + dsrc[20]*BT[44] + dsrc[21]*BT[45] + dsrc[22]*BT[46] + dsrc[23]*BT[47];
-    ddst[tileCount + 22*ISTRIDE6X3] = dsrc[16]*BT[48] + dsrc[17]*BT[49] + dsrc[18]*BT[50] + dsrc[19]*BT[51] + dsrc[20]*BT[52] + dsrc[21]*BT[53] + dsrc[22]*BT[54] + dsrc[23]*BT[55];
-    ddst[tileCount + 23*ISTRIDE6X3] = dsrc[16]*BT[56] + dsrc[17]*BT[57] + dsrc[18]*BT[58] + dsrc[19]*BT[59] + dsrc[20]*BT[60] + dsrc[21]*BT[61] + dsrc[22]*BT[62] + dsrc[23]*BT[63];
-    ddst[tileCount + 24*ISTRIDE6X3] = dsrc[24]*BT[ 0] + dsrc[25]*BT[ 1] + dsrc[26]*BT[ 2] + dsrc[27]*BT[ 3] + dsrc[28]*BT[ 4] + dsrc[29]*BT[ 5] + dsrc[30]*BT[ 6] + dsrc[31]*BT[ 7];
-    ddst[tileCount + 25*ISTRIDE6X3] = dsrc[24]*BT[ 8] + dsrc[25]*BT[ 9] + dsrc[26]*BT[10] + dsrc[27]*BT[11] + dsrc[28]*BT[12] + dsrc[29]*BT[13] + dsrc[30]*BT[14] + dsrc[31]*BT[15];
-    ddst[tileCount + 26*ISTRIDE6X3] = dsrc[24]*BT[16] + dsrc[25]*BT[17] + dsrc[26]*BT[18] + dsrc[27]*BT[19] + dsrc[28]*BT[20] + dsrc[29]*BT[21] + dsrc[30]*BT[22] + dsrc[31]*BT[23];
-    ddst[tileCount + 27*ISTRIDE6X3] = dsrc[24]*BT[24] + dsrc[25]*BT[25] + dsrc[26]*BT[26] + dsrc[27]*BT[27] + dsrc[28]*BT[28] + dsrc[29]*BT[29] + dsrc[30]*BT[30] + dsrc[31]*BT[31];
-    ddst[tileCount + 28*ISTRIDE6X3] = dsrc[24]*BT[32] + dsrc[25]*BT[33] + dsrc[26]*BT[34] + dsrc[27]*BT[35] + dsrc[28]*BT[36] + dsrc[29]*BT[37] + dsrc[30]*BT[38] + dsrc[31]*BT[39];
-    ddst[tileCount + 29*ISTRIDE6X3] = dsrc[24]*BT[40] + dsrc[25]*BT[41] + dsrc[26]*BT[42] + dsrc[27]*BT[43] + dsrc[28]*BT[44] + dsrc[29]*BT[45] + dsrc[30]*BT[46] + dsrc[31]*BT[47];
-    ddst[tileCount + 30*ISTRIDE6X3] = dsrc[24]*BT[48] + dsrc[25]*BT[49] + dsrc[26]*BT[50] + dsrc[27]*BT[51] + dsrc[28]*BT[52] + dsrc[29]*BT[53] + dsrc[30]*BT[54] + dsrc[31]*BT[55];
-    ddst[tileCount + 31*ISTRIDE6X3] = dsrc[24]*BT[56] + dsrc[25]*BT[57] + dsrc[26]*BT[58] + dsrc[27]*BT[59] + dsrc[28]*BT[60] + dsrc[29]*BT[61] + dsrc[30]*BT[62] + dsrc[31]*BT[63];
-    ddst[tileCount + 32*ISTRIDE6X3] = dsrc[32]*BT[ 0] + dsrc[33]*BT[ 1] + dsrc[34]*BT[ 2] + dsrc[35]*BT[ 3] + dsrc[36]*BT[ 4] + dsrc[37]*BT[ 5] + dsrc[38]*BT[ 6] + dsrc[39]*BT[ 7];
-    ddst[tileCount + 33*ISTRIDE6X3] = dsrc[32]*BT[ 8] + dsrc[33]*BT[ 9] + dsrc[34]*BT[10] + dsrc[35]*BT[11] + dsrc[36]*BT[12] + dsrc[37]*BT[13] + dsrc[38]*BT[14] + dsrc[39]*BT[15];
-    ddst[tileCount + 34*ISTRIDE6X3] = dsrc[32]*BT[16] + dsrc[33]*BT[17] + dsrc[34]*BT[18] + dsrc[35]*BT[19] + dsrc[36]*BT[20] + dsrc[37]*BT[21] + dsrc[38]*BT[22] + dsrc[39]*BT[23];
-    ddst[tileCount + 35*ISTRIDE6X3] = dsrc[32]*BT[24] + dsrc[33]*BT[25] + dsrc[34]*BT[26] + dsrc[35]*BT[27] + dsrc[36]*BT[28] + dsrc[37]*BT[29] + dsrc[38]*BT[30] + dsrc[39]*BT[31];
-    ddst[tileCount + 36*ISTRIDE6X3] = dsrc[32]*BT[32] + dsrc[33]*BT[33] + dsrc[34]*BT[34] + dsrc[35]*BT[35] + dsrc[36]*BT[36] + dsrc[37]*BT[37] + dsrc[38]*BT[38] + dsrc[39]*BT[39];
-    ddst[tileCount + 37*ISTRIDE6X3] = dsrc[32]*BT[40] + dsrc[33]*BT[41] + dsrc[34]*BT[42] + dsrc[35]*BT[43] + dsrc[36]*BT[44] + dsrc[37]*BT[45] + dsrc[38]*BT[46] + dsrc[39]*BT[47];
-    ddst[tileCount + 38*ISTRIDE6X3] = dsrc[32]*BT[48] + dsrc[33]*BT[49] + dsrc[34]*BT[50] + dsrc[35]*BT[51] + dsrc[36]*BT[52] + dsrc[37]*BT[53] + dsrc[38]*BT[54] + dsrc[39]*BT[55];
-    ddst[tileCount + 39*ISTRIDE6X3] = dsrc[32]*BT[56] + dsrc[33]*BT[57] + dsrc[34]*BT[58] + dsrc[35]*BT[59] + dsrc[36]*BT[60] + dsrc[37]*BT[61] + dsrc[38]*BT[62] + dsrc[39]*BT[63];
-    ddst[tileCount + 40*ISTRIDE6X3] = dsrc[40]*BT[ 0] + dsrc[41]*BT[ 1] + dsrc[42]*BT[ 2] + dsrc[43]*BT[ 3] + dsrc[44]*BT[ 4] + dsrc[45]*BT[ 5] + dsrc[46]*BT[ 6] + dsrc[47]*BT[ 7];
-    ddst[tileCount + 41*ISTRIDE6X3] = dsrc[40]*BT[ 8] + dsrc[41]*BT[ 9] + dsrc[42]*BT[10] + dsrc[43]*BT[11] + dsrc[44]*BT[12] + dsrc[45]*BT[13] + dsrc[46]*BT[14] + dsrc[47]*BT[15];
-    ddst[tileCount + 42*ISTRIDE6X3] = dsrc[40]*BT[16] + dsrc[41]*BT[17] + dsrc[42]*BT[18] + dsrc[43]*BT[19] + dsrc[44]*BT[20] + dsrc[45]*BT[21] + dsrc[46]*BT[22] + dsrc[47]*BT[23];
-    ddst[tileCount + 43*ISTRIDE6X3] = dsrc[40]*BT[24] + dsrc[41]*BT[25] + dsrc[42]*BT[26] + dsrc[43]*BT[27] + dsrc[44]*BT[28] + dsrc[45]*BT[29] + dsrc[46]*BT[30] + dsrc[47]*BT[31];
-    ddst[tileCount + 44*ISTRIDE6X3] = dsrc[40]*BT[32] + dsrc[41]*BT[33] + dsrc[42]*BT[34] + dsrc[43]*BT[35] + dsrc[44]*BT[36] + dsrc[45]*BT[37] + dsrc[46]*BT[38] + dsrc[47]*BT[39];
-    ddst[tileCount + 45*ISTRIDE6X3] = dsrc[40]*BT[40] + dsrc[41]*BT[41] + dsrc[42]*BT[42] + dsrc[43]*BT[43] + dsrc[44]*BT[44] + dsrc[45]*BT[45] + dsrc[46]*BT[46] + dsrc[47]*BT[47];
-    ddst[tileCount + 46*ISTRIDE6X3] = dsrc[40]*BT[48] + dsrc[41]*BT[49] + dsrc[42]*BT[50] + dsrc[43]*BT[51] + dsrc[44]*BT[52] + dsrc[45]*BT[53] + dsrc[46]*BT[54] + dsrc[47]*BT[55];
-    ddst[tileCount + 47*ISTRIDE6X3] = dsrc[40]*BT[56] + dsrc[41]*BT[57] + dsrc[42]*BT[58] + dsrc[43]*BT[59] + dsrc[44]*BT[60] + dsrc[45]*BT[61] + dsrc[46]*BT[62] + dsrc[47]*BT[63];
-    ddst[tileCount + 48*ISTRIDE6X3] = dsrc[48]*BT[ 0] + dsrc[49]*BT[ 1] + dsrc[50]*BT[ 2] + dsrc[51]*BT[ 3] + dsrc[52]*BT[ 4] + dsrc[53]*BT[ 5] + dsrc[54]*BT[ 6] + dsrc[55]*BT[ 7];
-    ddst[tileCount + 49*ISTRIDE6X3] = dsrc[48]*BT[ 8] + dsrc[49]*BT[ 9] + dsrc[50]*BT[10] + dsrc[51]*BT[11] + dsrc[52]*BT[12] + dsrc[53]*BT[13] + dsrc[54]*BT[14] + dsrc[55]*BT[15];
-    ddst[tileCount + 50*ISTRIDE6X3] = dsrc[48]*BT[16] + dsrc[49]*BT[17] + dsrc[50]*BT[18] + dsrc[51]*BT[19] + dsrc[52]*BT[20] + dsrc[53]*BT[21] + dsrc[54]*BT[22] + dsrc[55]*BT[23];
-    ddst[tileCount + 51*ISTRIDE6X3] = dsrc[48]*BT[24] + dsrc[49]*BT[25] + dsrc[50]*BT[26] + dsrc[51]*BT[27] + dsrc[52]*BT[28] + dsrc[53]*BT[29] + dsrc[54]*BT[30] + dsrc[55]*BT[31];
-    ddst[tileCount + 52*ISTRIDE6X3] = dsrc[48]*BT[32] + dsrc[49]*BT[33] + dsrc[50]*BT[34] + dsrc[51]*BT[35] + dsrc[52]*BT[36] + dsrc[53]*BT[37] + dsrc[54]*BT[38] + dsrc[55]*BT[39];
-    ddst[tileCount + 53*ISTRIDE6X3] = dsrc[48]*BT[40] + dsrc[49]*BT[41] + dsrc[50]*BT[42] + dsrc[51]*BT[43] + dsrc[52]*BT[44] + dsrc[53]*BT[45] + dsrc[54]*BT[46] + dsrc[55]*BT[47];
-    ddst[tileCount + 54*ISTRIDE6X3] = dsrc[48]*BT[48] + dsrc[49]*BT[49] + dsrc[50]*BT[50] + dsrc[51]*BT[51] + dsrc[52]*BT[52] + dsrc[53]*BT[53] + dsrc[54]*BT[54] + dsrc[55]*BT[55];
-    ddst[tileCount + 55*ISTRIDE6X3] = dsrc[48]*BT[56] + dsrc[49]*BT[57] + dsrc[50]*BT[58] + dsrc[51]*BT[59] + dsrc[52]*BT[60] + dsrc[53]*BT[61] + dsrc[54]*BT[62] + dsrc[55]*BT[63];
-    ddst[tileCount + 56*ISTRIDE6X3] = dsrc[56]*BT[ 0] + dsrc[57]*BT[ 1] + dsrc[58]*BT[ 2] + dsrc[59]*BT[ 3] + dsrc[60]*BT[ 4] + dsrc[61]*BT[ 5] + dsrc[62]*BT[ 6] + dsrc[63]*BT[ 7];
-    ddst[tileCount + 57*ISTRIDE6X3] = dsrc[56]*BT[ 8] + dsrc[57]*BT[ 9] + dsrc[58]*BT[10] + dsrc[59]*BT[11] + dsrc[60]*BT[12] + dsrc[61]*BT[13] + dsrc[62]*BT[14] + dsrc[63]*BT[15];
-    ddst[tileCount + 58*ISTRIDE6X3] = dsrc[56]*BT[16] + dsrc[57]*BT[17] + dsrc[58]*BT[18] + dsrc[59]*BT[19] + dsrc[60]*BT[20] + dsrc[61]*BT[21] + dsrc[62]*BT[22] + dsrc[63]*BT[23];
-    ddst[tileCount + 59*ISTRIDE6X3] = dsrc[56]*BT[24] + dsrc[57]*BT[25] + dsrc[58]*BT[26] + dsrc[59]*BT[27] + dsrc[60]*BT[28] + dsrc[61]*BT[29] + dsrc[62]*BT[30] + dsrc[63]*BT[31];
-    ddst[tileCount + 60*ISTRIDE6X3] = dsrc[56]*BT[32] + dsrc[57]*BT[33] + dsrc[58]*BT[34] + dsrc[59]*BT[35] + dsrc[60]*BT[36] + dsrc[61]*BT[37] + dsrc[62]*BT[38] + dsrc[63]*BT[39];
-    ddst[tileCount + 61*ISTRIDE6X3] = dsrc[56]*BT[40] + dsrc[57]*BT[41] + dsrc[58]*BT[42] + dsrc[59]*BT[43] + dsrc[60]*BT[44] + dsrc[61]*BT[45] + dsrc[62]*BT[46] + dsrc[63]*BT[47];
-    ddst[tileCount + 62*ISTRIDE6X3] = dsrc[56]*BT[48] + dsrc[57]*BT[49] + dsrc[58]*BT[50] + dsrc[59]*BT[51] + dsrc[60]*BT[52] + dsrc[61]*BT[53] + dsrc[62]*BT[54] + dsrc[63]*BT[55];
-    ddst[tileCount + 63*ISTRIDE6X3] = dsrc[56]*BT[56] + dsrc[57]*BT[57] + dsrc[58]*BT[58] + dsrc[59]*BT[59] + dsrc[60]*BT[60] + dsrc[61]*BT[61] + dsrc[62]*BT[62] + dsrc[63]*BT[63];
+    ddst[tileCount +  0*istride] = dsrc[ 0]*BT[ 0] + dsrc[ 1]*BT[ 1] + dsrc[ 2]*BT[ 2] + dsrc[ 3]*BT[ 3] + dsrc[ 4]*BT[ 4] + dsrc[ 5]*BT[ 5] + dsrc[ 6]*BT[ 6] + dsrc[ 7]*BT[ 7];
+    ddst[tileCount +  1*istride] = dsrc[ 0]*BT[ 8] + dsrc[ 1]*BT[ 9] + dsrc[ 2]*BT[10] + dsrc[ 3]*BT[11] + dsrc[ 4]*BT[12] + dsrc[ 5]*BT[13] + dsrc[ 6]*BT[14] + dsrc[ 7]*BT[15];
+    ddst[tileCount +  2*istride] = dsrc[ 0]*BT[16] + dsrc[ 1]*BT[17] + dsrc[ 2]*BT[18] + dsrc[ 3]*BT[19] + dsrc[ 4]*BT[20] + dsrc[ 5]*BT[21] + dsrc[ 6]*BT[22] + dsrc[ 7]*BT[23];
+    ddst[tileCount +  3*istride] = dsrc[ 0]*BT[24] + dsrc[ 1]*BT[25] + dsrc[ 2]*BT[26] + dsrc[ 3]*BT[27] + dsrc[ 4]*BT[28] + dsrc[ 5]*BT[29] + dsrc[ 6]*BT[30] + dsrc[ 7]*BT[31];
+    ddst[tileCount +  4*istride] = dsrc[ 0]*BT[32] + dsrc[ 1]*BT[33] + dsrc[ 2]*BT[34] + dsrc[ 3]*BT[35] + dsrc[ 4]*BT[36] + dsrc[ 5]*BT[37] + dsrc[ 6]*BT[38] + dsrc[ 7]*BT[39];
+    ddst[tileCount +  5*istride] = dsrc[ 0]*BT[40] + dsrc[ 1]*BT[41] + dsrc[ 2]*BT[42] + dsrc[ 3]*BT[43] + dsrc[ 4]*BT[44] + dsrc[ 5]*BT[45] + dsrc[ 6]*BT[46] + dsrc[ 7]*BT[47];
+    ddst[tileCount +  6*istride] = dsrc[ 0]*BT[48] + dsrc[ 1]*BT[49] + dsrc[ 2]*BT[50] + dsrc[ 3]*BT[51] + dsrc[ 4]*BT[52] + dsrc[ 5]*BT[53] + dsrc[ 6]*BT[54] + dsrc[ 7]*BT[55];
+    ddst[tileCount +  7*istride] = dsrc[ 0]*BT[56] + dsrc[ 1]*BT[57] + dsrc[ 2]*BT[58] + dsrc[ 3]*BT[59] + dsrc[ 4]*BT[60] + dsrc[ 5]*BT[61] + dsrc[ 6]*BT[62] + dsrc[ 7]*BT[63];
+    ddst[tileCount +  8*istride] = dsrc[ 8]*BT[ 0] + dsrc[ 9]*BT[ 1] + dsrc[10]*BT[ 2] + dsrc[11]*BT[ 3] + dsrc[12]*BT[ 4] + dsrc[13]*BT[ 5] + dsrc[14]*BT[ 6] + dsrc[15]*BT[ 7];
+    ddst[tileCount +  9*istride] = dsrc[ 8]*BT[ 8] + dsrc[ 9]*BT[ 9] + dsrc[10]*BT[10] + dsrc[11]*BT[11] + dsrc[12]*BT[12] + dsrc[13]*BT[13] + dsrc[14]*BT[14] + dsrc[15]*BT[15];
+    ddst[tileCount + 10*istride] = dsrc[ 8]*BT[16] + dsrc[ 9]*BT[17] + dsrc[10]*BT[18] + dsrc[11]*BT[19] + dsrc[12]*BT[20] + dsrc[13]*BT[21] + dsrc[14]*BT[22] + dsrc[15]*BT[23];
+    ddst[tileCount + 11*istride] = dsrc[ 8]*BT[24] + dsrc[ 9]*BT[25] + dsrc[10]*BT[26] + dsrc[11]*BT[27] + dsrc[12]*BT[28] + dsrc[13]*BT[29] + dsrc[14]*BT[30] + dsrc[15]*BT[31];
+    ddst[tileCount + 12*istride] = dsrc[ 8]*BT[32] + dsrc[ 9]*BT[33] + dsrc[10]*BT[34] + dsrc[11]*BT[35] + dsrc[12]*BT[36] + dsrc[13]*BT[37] + dsrc[14]*BT[38] + dsrc[15]*BT[39];
+    ddst[tileCount + 13*istride] = dsrc[ 8]*BT[40] + dsrc[ 9]*BT[41] + dsrc[10]*BT[42] + dsrc[11]*BT[43] + dsrc[12]*BT[44] + dsrc[13]*BT[45] + dsrc[14]*BT[46] + dsrc[15]*BT[47];
+    ddst[tileCount + 14*istride] = dsrc[ 8]*BT[48] + dsrc[ 9]*BT[49] + dsrc[10]*BT[50] + dsrc[11]*BT[51] + dsrc[12]*BT[52] + dsrc[13]*BT[53] + dsrc[14]*BT[54] + dsrc[15]*BT[55];
+    ddst[tileCount + 15*istride] = dsrc[ 8]*BT[56] + dsrc[ 9]*BT[57] + dsrc[10]*BT[58] + dsrc[11]*BT[59] + dsrc[12]*BT[60] + dsrc[13]*BT[61] + dsrc[14]*BT[62] + dsrc[15]*BT[63];
+    ddst[tileCount + 16*istride] = dsrc[16]*BT[ 0] + dsrc[17]*BT[ 1] + dsrc[18]*BT[ 2] + dsrc[19]*BT[ 3] + dsrc[20]*BT[ 4] + dsrc[21]*BT[ 5] + dsrc[22]*BT[ 6] + dsrc[23]*BT[ 7];
+    ddst[tileCount + 17*istride] = dsrc[16]*BT[ 8] + dsrc[17]*BT[ 9] + dsrc[18]*BT[10] + dsrc[19]*BT[11] + dsrc[20]*BT[12] + dsrc[21]*BT[13] + dsrc[22]*BT[14] + dsrc[23]*BT[15];
+    ddst[tileCount + 18*istride] = dsrc[16]*BT[16] + dsrc[17]*BT[17] + dsrc[18]*BT[18] + dsrc[19]*BT[19] + dsrc[20]*BT[20] + dsrc[21]*BT[21] + dsrc[22]*BT[22] + dsrc[23]*BT[23];
+    ddst[tileCount + 19*istride] = dsrc[16]*BT[24] + dsrc[17]*BT[25] + dsrc[18]*BT[26] + dsrc[19]*BT[27] + dsrc[20]*BT[28] + dsrc[21]*BT[29] + dsrc[22]*BT[30] + dsrc[23]*BT[31];
+    ddst[tileCount + 20*istride] = dsrc[16]*BT[32] + dsrc[17]*BT[33] + dsrc[18]*BT[34] + dsrc[19]*BT[35] + dsrc[20]*BT[36] + dsrc[21]*BT[37] + dsrc[22]*BT[38] + dsrc[23]*BT[39];
+    ddst[tileCount + 21*istride] = dsrc[16]*BT[40] + dsrc[17]*BT[41] + dsrc[18]*BT[42] + dsrc[19]*BT[43] + dsrc[20]*BT[44] + dsrc[21]*BT[45] + dsrc[22]*BT[46] + dsrc[23]*BT[47];
+    ddst[tileCount + 22*istride] = dsrc[16]*BT[48] + dsrc[17]*BT[49] + dsrc[18]*BT[50] + dsrc[19]*BT[51] + dsrc[20]*BT[52] + dsrc[21]*BT[53] + dsrc[22]*BT[54] + dsrc[23]*BT[55];
+    ddst[tileCount + 23*istride] = dsrc[16]*BT[56] + dsrc[17]*BT[57] + dsrc[18]*BT[58] + dsrc[19]*BT[59] + dsrc[20]*BT[60] + dsrc[21]*BT[61] + dsrc[22]*BT[62] + dsrc[23]*BT[63];
+    ddst[tileCount + 24*istride] = dsrc[24]*BT[ 0] + dsrc[25]*BT[ 1] + dsrc[26]*BT[ 2] + dsrc[27]*BT[ 3] + dsrc[28]*BT[ 4] + dsrc[29]*BT[ 5] + dsrc[30]*BT[ 6] + dsrc[31]*BT[ 7];
+    ddst[tileCount + 25*istride] = dsrc[24]*BT[ 8] + dsrc[25]*BT[ 9] + dsrc[26]*BT[10] + dsrc[27]*BT[11] + dsrc[28]*BT[12] + dsrc[29]*BT[13] + dsrc[30]*BT[14] + dsrc[31]*BT[15];
+    ddst[tileCount + 26*istride] = dsrc[24]*BT[16] + dsrc[25]*BT[17] + dsrc[26]*BT[18] + dsrc[27]*BT[19] + dsrc[28]*BT[20] + dsrc[29]*BT[21] + dsrc[30]*BT[22] + dsrc[31]*BT[23];
+    ddst[tileCount + 27*istride] = dsrc[24]*BT[24] + dsrc[25]*BT[25] + dsrc[26]*BT[26] + dsrc[27]*BT[27] + dsrc[28]*BT[28] + dsrc[29]*BT[29] + dsrc[30]*BT[30] + dsrc[31]*BT[31];
+    ddst[tileCount + 28*istride] = dsrc[24]*BT[32] + dsrc[25]*BT[33] + dsrc[26]*BT[34] + dsrc[27]*BT[35] + dsrc[28]*BT[36] + dsrc[29]*BT[37] + dsrc[30]*BT[38] + dsrc[31]*BT[39];
+    ddst[tileCount + 29*istride] = dsrc[24]*BT[40] + dsrc[25]*BT[41] + dsrc[26]*BT[42] + dsrc[27]*BT[43] + dsrc[28]*BT[44] + dsrc[29]*BT[45] + dsrc[30]*BT[46] + dsrc[31]*BT[47];
+    ddst[tileCount + 30*istride] = dsrc[24]*BT[48] + dsrc[25]*BT[49] + dsrc[26]*BT[50] + dsrc[27]*BT[51] + dsrc[28]*BT[52] + dsrc[29]*BT[53] + dsrc[30]*BT[54] + dsrc[31]*BT[55];
+    ddst[tileCount + 31*istride] = dsrc[24]*BT[56] + dsrc[25]*BT[57] + dsrc[26]*BT[58] + dsrc[27]*BT[59] + dsrc[28]*BT[60] + dsrc[29]*BT[61] + dsrc[30]*BT[62] + dsrc[31]*BT[63];
+    ddst[tileCount + 32*istride] = dsrc[32]*BT[ 0] + dsrc[33]*BT[ 1] + dsrc[34]*BT[ 2] + dsrc[35]*BT[ 3] + dsrc[36]*BT[ 4] + dsrc[37]*BT[ 5] + dsrc[38]*BT[ 6] + dsrc[39]*BT[ 7];
+    ddst[tileCount + 33*istride] = dsrc[32]*BT[ 8] + dsrc[33]*BT[ 9] + dsrc[34]*BT[10] + dsrc[35]*BT[11] + dsrc[36]*BT[12] + dsrc[37]*BT[13] + dsrc[38]*BT[14] + dsrc[39]*BT[15];
+    ddst[tileCount + 34*istride] = dsrc[32]*BT[16] + dsrc[33]*BT[17] + dsrc[34]*BT[18] + dsrc[35]*BT[19] + dsrc[36]*BT[20] + dsrc[37]*BT[21] + dsrc[38]*BT[22] + dsrc[39]*BT[23];
+    ddst[tileCount + 35*istride] = dsrc[32]*BT[24] + dsrc[33]*BT[25] + dsrc[34]*BT[26] + dsrc[35]*BT[27] + dsrc[36]*BT[28] + dsrc[37]*BT[29] + dsrc[38]*BT[30] + dsrc[39]*BT[31];
+    ddst[tileCount + 36*istride] = dsrc[32]*BT[32] + dsrc[33]*BT[33] + dsrc[34]*BT[34] + dsrc[35]*BT[35] + dsrc[36]*BT[36] + dsrc[37]*BT[37] + dsrc[38]*BT[38] + dsrc[39]*BT[39];
+    ddst[tileCount + 37*istride] = dsrc[32]*BT[40] + dsrc[33]*BT[41] + dsrc[34]*BT[42] + dsrc[35]*BT[43] + dsrc[36]*BT[44] + dsrc[37]*BT[45] + dsrc[38]*BT[46] + dsrc[39]*BT[47];
+    ddst[tileCount + 38*istride] = dsrc[32]*BT[48] + dsrc[33]*BT[49] + dsrc[34]*BT[50] + dsrc[35]*BT[51] + dsrc[36]*BT[52] + dsrc[37]*BT[53] + dsrc[38]*BT[54] + dsrc[39]*BT[55];
+    ddst[tileCount + 39*istride] = dsrc[32]*BT[56] + dsrc[33]*BT[57] + dsrc[34]*BT[58] + dsrc[35]*BT[59] + dsrc[36]*BT[60] + dsrc[37]*BT[61] + dsrc[38]*BT[62] + dsrc[39]*BT[63];
+    ddst[tileCount + 40*istride] = dsrc[40]*BT[ 0] + dsrc[41]*BT[ 1] + dsrc[42]*BT[ 2] + dsrc[43]*BT[ 3] + dsrc[44]*BT[ 4] + dsrc[45]*BT[ 5] + dsrc[46]*BT[ 6] + dsrc[47]*BT[ 7];
+    ddst[tileCount + 41*istride] = dsrc[40]*BT[ 8] + dsrc[41]*BT[ 9] + dsrc[42]*BT[10] + dsrc[43]*BT[11] + dsrc[44]*BT[12] + dsrc[45]*BT[13] + dsrc[46]*BT[14] + dsrc[47]*BT[15];
+    ddst[tileCount + 42*istride] = dsrc[40]*BT[16] + dsrc[41]*BT[17] + dsrc[42]*BT[18] + dsrc[43]*BT[19] + dsrc[44]*BT[20] + dsrc[45]*BT[21] + dsrc[46]*BT[22] + dsrc[47]*BT[23];
+    ddst[tileCount + 43*istride] = dsrc[40]*BT[24] + dsrc[41]*BT[25] + dsrc[42]*BT[26] + dsrc[43]*BT[27] + dsrc[44]*BT[28] + dsrc[45]*BT[29] + dsrc[46]*BT[30] + dsrc[47]*BT[31];
+    ddst[tileCount + 44*istride] = dsrc[40]*BT[32] + dsrc[41]*BT[33] + dsrc[42]*BT[34] + dsrc[43]*BT[35] + dsrc[44]*BT[36] + dsrc[45]*BT[37] + dsrc[46]*BT[38] + dsrc[47]*BT[39];
+    ddst[tileCount + 45*istride] = dsrc[40]*BT[40] + dsrc[41]*BT[41] + dsrc[42]*BT[42] + dsrc[43]*BT[43] + dsrc[44]*BT[44] + dsrc[45]*BT[45] + dsrc[46]*BT[46] + dsrc[47]*BT[47];
+    ddst[tileCount + 46*istride] = dsrc[40]*BT[48] + dsrc[41]*BT[49] + dsrc[42]*BT[50] + dsrc[43]*BT[51] + dsrc[44]*BT[52] + dsrc[45]*BT[53] + dsrc[46]*BT[54] + dsrc[47]*BT[55];
+    ddst[tileCount + 47*istride] = dsrc[40]*BT[56] + dsrc[41]*BT[57] + dsrc[42]*BT[58] + dsrc[43]*BT[59] + dsrc[44]*BT[60] + dsrc[45]*BT[61] + dsrc[46]*BT[62] + dsrc[47]*BT[63];
+    ddst[tileCount + 48*istride] = dsrc[48]*BT[ 0] + dsrc[49]*BT[ 1] + dsrc[50]*BT[ 2] + dsrc[51]*BT[ 3] + dsrc[52]*BT[ 4] + dsrc[53]*BT[ 5] + dsrc[54]*BT[ 6] + dsrc[55]*BT[ 7];
+    ddst[tileCount + 49*istride] = dsrc[48]*BT[ 8] + dsrc[49]*BT[ 9] + dsrc[50]*BT[10] + dsrc[51]*BT[11] + dsrc[52]*BT[12] + dsrc[53]*BT[13] + dsrc[54]*BT[14] + dsrc[55]*BT[15];
+    ddst[tileCount + 50*istride] = dsrc[48]*BT[16] + dsrc[49]*BT[17] + dsrc[50]*BT[18] + dsrc[51]*BT[19] + dsrc[52]*BT[20] + dsrc[53]*BT[21] + dsrc[54]*BT[22] + dsrc[55]*BT[23];
+    ddst[tileCount + 51*istride] = dsrc[48]*BT[24] + dsrc[49]*BT[25] + dsrc[50]*BT[26] + dsrc[51]*BT[27] + dsrc[52]*BT[28] + dsrc[53]*BT[29] + dsrc[54]*BT[30] + dsrc[55]*BT[31];
+    ddst[tileCount + 52*istride] = dsrc[48]*BT[32] + dsrc[49]*BT[33] + dsrc[50]*BT[34] + dsrc[51]*BT[35] + dsrc[52]*BT[36] + dsrc[53]*BT[37] + dsrc[54]*BT[38] + dsrc[55]*BT[39];
+    ddst[tileCount + 53*istride] = dsrc[48]*BT[40] + dsrc[49]*BT[41] + dsrc[50]*BT[42] + dsrc[51]*BT[43] + dsrc[52]*BT[44] + dsrc[53]*BT[45] + dsrc[54]*BT[46] + dsrc[55]*BT[47];
+    ddst[tileCount + 54*istride] = dsrc[48]*BT[48] + dsrc[49]*BT[49] + dsrc[50]*BT[50] + dsrc[51]*BT[51] + dsrc[52]*BT[52] + dsrc[53]*BT[53] + dsrc[54]*BT[54] + dsrc[55]*BT[55];
+    ddst[tileCount + 55*istride] = dsrc[48]*BT[56] + dsrc[49]*BT[57] + dsrc[50]*BT[58] + dsrc[51]*BT[59] + dsrc[52]*BT[60] + dsrc[53]*BT[61] + dsrc[54]*BT[62] + dsrc[55]*BT[63];
+    ddst[tileCount + 56*istride] = dsrc[56]*BT[ 0] + dsrc[57]*BT[ 1] + dsrc[58]*BT[ 2] + dsrc[59]*BT[ 3] + dsrc[60]*BT[ 4] + dsrc[61]*BT[ 5] + dsrc[62]*BT[ 6] + dsrc[63]*BT[ 7];
+    ddst[tileCount + 57*istride] = dsrc[56]*BT[ 8] + dsrc[57]*BT[ 9] + dsrc[58]*BT[10] + dsrc[59]*BT[11] + dsrc[60]*BT[12] + dsrc[61]*BT[13] + dsrc[62]*BT[14] + dsrc[63]*BT[15];
+    ddst[tileCount + 58*istride] = dsrc[56]*BT[16] + dsrc[57]*BT[17] + dsrc[58]*BT[18] + dsrc[59]*BT[19] + dsrc[60]*BT[20] + dsrc[61]*BT[21] + dsrc[62]*BT[22] + dsrc[63]*BT[23];
+    ddst[tileCount + 59*istride] = dsrc[56]*BT[24] + dsrc[57]*BT[25] + dsrc[58]*BT[26] + dsrc[59]*BT[27] + dsrc[60]*BT[28] + dsrc[61]*BT[29] + dsrc[62]*BT[30] + dsrc[63]*BT[31];
+    ddst[tileCount + 60*istride] = dsrc[56]*BT[32] + dsrc[57]*BT[33] + dsrc[58]*BT[34] + dsrc[59]*BT[35] + dsrc[60]*BT[36] + dsrc[61]*BT[37] + dsrc[62]*BT[38] + dsrc[63]*BT[39];
+    ddst[tileCount + 61*istride] = dsrc[56]*BT[40] + dsrc[57]*BT[41] + dsrc[58]*BT[42] + dsrc[59]*BT[43] + dsrc[60]*BT[44] + dsrc[61]*BT[45] + dsrc[62]*BT[46] + dsrc[63]*BT[47];
+    ddst[tileCount + 62*istride] = dsrc[56]*BT[48] + dsrc[57]*BT[49] + dsrc[58]*BT[50] + dsrc[59]*BT[51] + dsrc[60]*BT[52] + dsrc[61]*BT[53] + dsrc[62]*BT[54] + dsrc[63]*BT[55];
+    ddst[tileCount + 63*istride] = dsrc[56]*BT[56] + dsrc[57]*BT[57] + dsrc[58]*BT[58] + dsrc[59]*BT[59] + dsrc[60]*BT[60] + dsrc[61]*BT[61] + dsrc[62]*BT[62] + dsrc[63]*BT[63];
 }
 
 /*Compute transformed data for output by AT.
@@ -303,44 +300,45 @@ inline void transformByAT_first(Dtype *dsrc, Dtype *ddst)
 }
 
     template <typename Dtype>
-inline void transformByAT_second(Dtype *dsrc, Dtype *ddst, int rowIdx, int colIdx, int colNum)
+inline void transformByAT_second(Dtype *dsrc, Dtype *ddst, int rowIdx, int colIdx, int colNum,
+        const Dtype b, const Dtype slope, const Dtype ceil)
 {
-    ddst[(rowIdx+0)*colNum + (colIdx+0)] = dsrc[ 0]*AT[ 0] + dsrc[ 1]*AT[ 1] + dsrc[ 2]*AT[ 2] + dsrc[ 3]*AT[ 3] + dsrc[ 4]*AT[ 4] + dsrc[ 5]*AT[ 5] + dsrc[ 6]*AT[ 6] + dsrc[ 7]*AT[ 7];
-    ddst[(rowIdx+0)*colNum + (colIdx+1)] = dsrc[ 0]*AT[ 8] + dsrc[ 1]*AT[ 9] + dsrc[ 2]*AT[10] + dsrc[ 3]*AT[11] + dsrc[ 4]*AT[12] + dsrc[ 5]*AT[13] + dsrc[ 6]*AT[14] + dsrc[ 7]*AT[15];
-    ddst[(rowIdx+0)*colNum + (colIdx+2)] = dsrc[ 0]*AT[16] + dsrc[ 1]*AT[17] + dsrc[ 2]*AT[18] + dsrc[ 3]*AT[19] + dsrc[ 4]*AT[20] + dsrc[ 5]*AT[21] + dsrc[ 6]*AT[22] + dsrc[ 7]*AT[23];
-    ddst[(rowIdx+0)*colNum + (colIdx+3)] = dsrc[ 0]*AT[24] + dsrc[ 1]*AT[25] + dsrc[ 2]*AT[26] + dsrc[ 3]*AT[27] + dsrc[ 4]*AT[28] + dsrc[ 5]*AT[29] + dsrc[ 6]*AT[30] + dsrc[ 7]*AT[31];
-    ddst[(rowIdx+0)*colNum + (colIdx+4)] = dsrc[ 0]*AT[32] + dsrc[ 1]*AT[33] + dsrc[ 2]*AT[34] + dsrc[ 3]*AT[35] + dsrc[ 4]*AT[36] + dsrc[ 5]*AT[37] + dsrc[ 6]*AT[38] + dsrc[ 7]*AT[39];
-    ddst[(rowIdx+0)*colNum + (colIdx+5)] = dsrc[ 0]*AT[40] + dsrc[ 1]*AT[41] + dsrc[ 2]*AT[42] + dsrc[ 3]*AT[43] + dsrc[ 4]*AT[44] + dsrc[ 5]*AT[45] + dsrc[ 6]*AT[46] + dsrc[ 7]*AT[47];
-    ddst[(rowIdx+1)*colNum + (colIdx+0)] = dsrc[ 8]*AT[ 0] + dsrc[ 9]*AT[ 1] + dsrc[10]*AT[ 2] + dsrc[11]*AT[ 3] + dsrc[12]*AT[ 4] + dsrc[13]*AT[ 5] + dsrc[14]*AT[ 6] + dsrc[15]*AT[ 7];
-    ddst[(rowIdx+1)*colNum + (colIdx+1)] = dsrc[ 8]*AT[ 8] + dsrc[ 9]*AT[ 9] + dsrc[10]*AT[10] + dsrc[11]*AT[11] + dsrc[12]*AT[12] + dsrc[13]*AT[13] + dsrc[14]*AT[14] + dsrc[15]*AT[15];
-    ddst[(rowIdx+1)*colNum + (colIdx+2)] = dsrc[ 8]*AT[16] + dsrc[ 9]*AT[17] + dsrc[10]*AT[18] + dsrc[11]*AT[19] + dsrc[12]*AT[20] + dsrc[13]*AT[21] + dsrc[14]*AT[22] + dsrc[15]*AT[23];
-    ddst[(rowIdx+1)*colNum + (colIdx+3)] = dsrc[ 8]*AT[24] + dsrc[ 9]*AT[25] + dsrc[10]*AT[26] + dsrc[11]*AT[27] + dsrc[12]*AT[28] + dsrc[13]*AT[29] + dsrc[14]*AT[30] + dsrc[15]*AT[31];
-    ddst[(rowIdx+1)*colNum + (colIdx+4)] = dsrc[ 8]*AT[32] + dsrc[ 9]*AT[33] + dsrc[10]*AT[34] + dsrc[11]*AT[35] + dsrc[12]*AT[36] + dsrc[13]*AT[37] + dsrc[14]*AT[38] + dsrc[15]*AT[39];
-    ddst[(rowIdx+1)*colNum + (colIdx+5)] = dsrc[ 8]*AT[40] + dsrc[ 9]*AT[41] + dsrc[10]*AT[42] + dsrc[11]*AT[43] + dsrc[12]*AT[44] + dsrc[13]*AT[45] + dsrc[14]*AT[46] + dsrc[15]*AT[47];
-    ddst[(rowIdx+2)*colNum + (colIdx+0)] = dsrc[16]*AT[ 0] + dsrc[17]*AT[ 1] + dsrc[18]*AT[ 2] + dsrc[19]*AT[ 3] + dsrc[20]*AT[ 4] + dsrc[21]*AT[ 5] + dsrc[22]*AT[ 6] + dsrc[23]*AT[ 7];
-    ddst[(rowIdx+2)*colNum + (colIdx+1)] = dsrc[16]*AT[ 8] + dsrc[17]*AT[ 9] + dsrc[18]*AT[10] + dsrc[19]*AT[11] + dsrc[20]*AT[12] + dsrc[21]*AT[13] + dsrc[22]*AT[14] + dsrc[23]*AT[15];
-    ddst[(rowIdx+2)*colNum + (colIdx+2)] = dsrc[16]*AT[16] + dsrc[17]*AT[17] + dsrc[18]*AT[18] + dsrc[19]*AT[19] + dsrc[20]*AT[20] + dsrc[21]*AT[21] + dsrc[22]*AT[22] + dsrc[23]*AT[23];
-    ddst[(rowIdx+2)*colNum + (colIdx+3)] = dsrc[16]*AT[24] + dsrc[17]*AT[25] + dsrc[18]*AT[26] + dsrc[19]*AT[27] + dsrc[20]*AT[28] + dsrc[21]*AT[29] + dsrc[22]*AT[30] + dsrc[23]*AT[31];
-    ddst[(rowIdx+2)*colNum + (colIdx+4)] = dsrc[16]*AT[32] + dsrc[17]*AT[33] + dsrc[18]*AT[34] + dsrc[19]*AT[35] + dsrc[20]*AT[36] + dsrc[21]*AT[37] + dsrc[22]*AT[38] + dsrc[23]*AT[39];
-    ddst[(rowIdx+2)*colNum + (colIdx+5)] = dsrc[16]*AT[40] + dsrc[17]*AT[41] + dsrc[18]*AT[42] + dsrc[19]*AT[43] + dsrc[20]*AT[44] + dsrc[21]*AT[45] + dsrc[22]*AT[46] + dsrc[23]*AT[47];
-    ddst[(rowIdx+3)*colNum + (colIdx+0)] = dsrc[24]*AT[ 0] + dsrc[25]*AT[ 1] + dsrc[26]*AT[ 2] + dsrc[27]*AT[ 3] + dsrc[28]*AT[ 4] + dsrc[29]*AT[ 5] + dsrc[30]*AT[ 6] + dsrc[31]*AT[ 7];
-    ddst[(rowIdx+3)*colNum + (colIdx+1)] = dsrc[24]*AT[ 8] + dsrc[25]*AT[ 9] + dsrc[26]*AT[10] + dsrc[27]*AT[11] + dsrc[28]*AT[12] + dsrc[29]*AT[13] + dsrc[30]*AT[14] + dsrc[31]*AT[15];
-    ddst[(rowIdx+3)*colNum + (colIdx+2)] = dsrc[24]*AT[16] + dsrc[25]*AT[17] + dsrc[26]*AT[18] + dsrc[27]*AT[19] + dsrc[28]*AT[20] + dsrc[29]*AT[21] + dsrc[30]*AT[22] + dsrc[31]*AT[23];
-    ddst[(rowIdx+3)*colNum + (colIdx+3)] = dsrc[24]*AT[24] + dsrc[25]*AT[25] + dsrc[26]*AT[26] + dsrc[27]*AT[27] + dsrc[28]*AT[28] + dsrc[29]*AT[29] + dsrc[30]*AT[30] + dsrc[31]*AT[31];
-    ddst[(rowIdx+3)*colNum + (colIdx+4)] = dsrc[24]*AT[32] + dsrc[25]*AT[33] + dsrc[26]*AT[34] + dsrc[27]*AT[35] + dsrc[28]*AT[36] + dsrc[29]*AT[37] + dsrc[30]*AT[38] + dsrc[31]*AT[39];
-    ddst[(rowIdx+3)*colNum + (colIdx+5)] = dsrc[24]*AT[40] + dsrc[25]*AT[41] + dsrc[26]*AT[42] + dsrc[27]*AT[43] + dsrc[28]*AT[44] + dsrc[29]*AT[45] + dsrc[30]*AT[46] + dsrc[31]*AT[47];
-    ddst[(rowIdx+4)*colNum + (colIdx+0)] = dsrc[32]*AT[ 0] + dsrc[33]*AT[ 1] + dsrc[34]*AT[ 2] + dsrc[35]*AT[ 3] + dsrc[36]*AT[ 4] + dsrc[37]*AT[ 5] + dsrc[38]*AT[ 6] + dsrc[39]*AT[ 7];
-    ddst[(rowIdx+4)*colNum + (colIdx+1)] = dsrc[32]*AT[ 8] + dsrc[33]*AT[ 9] + dsrc[34]*AT[10] + dsrc[35]*AT[11] + dsrc[36]*AT[12] + dsrc[37]*AT[13] + dsrc[38]*AT[14] + dsrc[39]*AT[15];
-    ddst[(rowIdx+4)*colNum + (colIdx+2)] = dsrc[32]*AT[16] + dsrc[33]*AT[17] + dsrc[34]*AT[18] + dsrc[35]*AT[19] + dsrc[36]*AT[20] + dsrc[37]*AT[21] + dsrc[38]*AT[22] + dsrc[39]*AT[23];
-    ddst[(rowIdx+4)*colNum + (colIdx+3)] = dsrc[32]*AT[24] + dsrc[33]*AT[25] + dsrc[34]*AT[26] + dsrc[35]*AT[27] + dsrc[36]*AT[28] + dsrc[37]*AT[29] + dsrc[38]*AT[30] + dsrc[39]*AT[31];
-    ddst[(rowIdx+4)*colNum + (colIdx+4)] = dsrc[32]*AT[32] + dsrc[33]*AT[33] + dsrc[34]*AT[34] + dsrc[35]*AT[35] + dsrc[36]*AT[36] + dsrc[37]*AT[37] + dsrc[38]*AT[38] + dsrc[39]*AT[39];
-    ddst[(rowIdx+4)*colNum + (colIdx+5)] = dsrc[32]*AT[40] + dsrc[33]*AT[41] + dsrc[34]*AT[42] + dsrc[35]*AT[43] + dsrc[36]*AT[44] + dsrc[37]*AT[45] + dsrc[38]*AT[46] + dsrc[39]*AT[47];
-    ddst[(rowIdx+5)*colNum + (colIdx+0)] = dsrc[40]*AT[ 0] + dsrc[41]*AT[ 1] + dsrc[42]*AT[ 2] + dsrc[43]*AT[ 3] + dsrc[44]*AT[ 4] + dsrc[45]*AT[ 5] + dsrc[46]*AT[ 6] + dsrc[47]*AT[ 7];
-    ddst[(rowIdx+5)*colNum + (colIdx+1)] = dsrc[40]*AT[ 8] + dsrc[41]*AT[ 9] + dsrc[42]*AT[10] + dsrc[43]*AT[11] + dsrc[44]*AT[12] + dsrc[45]*AT[13] + dsrc[46]*AT[14] + dsrc[47]*AT[15];
-    ddst[(rowIdx+5)*colNum + (colIdx+2)] = dsrc[40]*AT[16] + dsrc[41]*AT[17] + dsrc[42]*AT[18] + dsrc[43]*AT[19] + dsrc[44]*AT[20] + dsrc[45]*AT[21] + dsrc[46]*AT[22] + dsrc[47]*AT[23];
-    ddst[(rowIdx+5)*colNum + (colIdx+3)] = dsrc[40]*AT[24] + dsrc[41]*AT[25] + dsrc[42]*AT[26] + dsrc[43]*AT[27] + dsrc[44]*AT[28] + dsrc[45]*AT[29] + dsrc[46]*AT[30] + dsrc[47]*AT[31];
-    ddst[(rowIdx+5)*colNum + (colIdx+4)] = dsrc[40]*AT[32] + dsrc[41]*AT[33] + dsrc[42]*AT[34] + dsrc[43]*AT[35] + dsrc[44]*AT[36] + dsrc[45]*AT[37] + dsrc[46]*AT[38] + dsrc[47]*AT[39];
-    ddst[(rowIdx+5)*colNum + (colIdx+5)] = dsrc[40]*AT[40] + dsrc[41]*AT[41] + dsrc[42]*AT[42] + dsrc[43]*AT[43] + dsrc[44]*AT[44] + dsrc[45]*AT[45] + dsrc[46]*AT[46] + dsrc[47]*AT[47];
+    ddst[(rowIdx+0)*colNum + (colIdx+0)] = ACSAActivate<Dtype>(dsrc[ 0]*AT[ 0] + dsrc[ 1]*AT[ 1] + dsrc[ 2]*AT[ 2] + dsrc[ 3]*AT[ 3] + dsrc[ 4]*AT[ 4] + dsrc[ 5]*AT[ 5] + dsrc[ 6]*AT[ 6] + dsrc[ 7]*AT[ 7], b, slope, ceil);
+    ddst[(rowIdx+0)*colNum + (colIdx+1)] = ACSAActivate<Dtype>(dsrc[ 0]*AT[ 8] + dsrc[ 1]*AT[ 9] + dsrc[ 2]*AT[10] + dsrc[ 3]*AT[11] + dsrc[ 4]*AT[12] + dsrc[ 5]*AT[13] + dsrc[ 6]*AT[14] + dsrc[ 7]*AT[15], b, slope, ceil);
+    ddst[(rowIdx+0)*colNum + (colIdx+2)] = ACSAActivate<Dtype>(dsrc[ 0]*AT[16] + dsrc[ 1]*AT[17] + dsrc[ 2]*AT[18] + dsrc[ 3]*AT[19] + dsrc[ 4]*AT[20] + dsrc[ 5]*AT[21] + dsrc[ 6]*AT[22] + dsrc[ 7]*AT[23], b, slope, ceil);
+    ddst[(rowIdx+0)*colNum + (colIdx+3)] = ACSAActivate<Dtype>(dsrc[ 0]*AT[24] + dsrc[ 1]*AT[25] + dsrc[ 2]*AT[26] + dsrc[ 3]*AT[27] + dsrc[ 4]*AT[28] + dsrc[ 5]*AT[29] + dsrc[ 6]*AT[30] + dsrc[ 7]*AT[31], b, slope, ceil);
+    ddst[(rowIdx+0)*colNum + (colIdx+4)] = ACSAActivate<Dtype>(dsrc[ 0]*AT[32] + dsrc[ 1]*AT[33] + dsrc[ 2]*AT[34] + dsrc[ 3]*AT[35] + dsrc[ 4]*AT[36] + dsrc[ 5]*AT[37] + dsrc[ 6]*AT[38] + dsrc[ 7]*AT[39], b, slope, ceil);
+    ddst[(rowIdx+0)*colNum + (colIdx+5)] = ACSAActivate<Dtype>(dsrc[ 0]*AT[40] + dsrc[ 1]*AT[41] + dsrc[ 2]*AT[42] + dsrc[ 3]*AT[43] + dsrc[ 4]*AT[44] + dsrc[ 5]*AT[45] + dsrc[ 6]*AT[46] + dsrc[ 7]*AT[47], b, slope, ceil);
+    ddst[(rowIdx+1)*colNum + (colIdx+0)] = ACSAActivate<Dtype>(dsrc[ 8]*AT[ 0] + dsrc[ 9]*AT[ 1] + dsrc[10]*AT[ 2] + dsrc[11]*AT[ 3] + dsrc[12]*AT[ 4] + dsrc[13]*AT[ 5] + dsrc[14]*AT[ 6] + dsrc[15]*AT[ 7], b, slope, ceil);
+    ddst[(rowIdx+1)*colNum + (colIdx+1)] = ACSAActivate<Dtype>(dsrc[ 8]*AT[ 8] + dsrc[ 9]*AT[ 9] + dsrc[10]*AT[10] + dsrc[11]*AT[11] + dsrc[12]*AT[12] + dsrc[13]*AT[13] + dsrc[14]*AT[14] + dsrc[15]*AT[15], b, slope, ceil);
+    ddst[(rowIdx+1)*colNum + (colIdx+2)] = ACSAActivate<Dtype>(dsrc[ 8]*AT[16] + dsrc[ 9]*AT[17] + dsrc[10]*AT[18] + dsrc[11]*AT[19] + dsrc[12]*AT[20] + dsrc[13]*AT[21] + dsrc[14]*AT[22] + dsrc[15]*AT[23], b, slope, ceil);
+    ddst[(rowIdx+1)*colNum + (colIdx+3)] = ACSAActivate<Dtype>(dsrc[ 8]*AT[24] + dsrc[ 9]*AT[25] + dsrc[10]*AT[26] + dsrc[11]*AT[27] + dsrc[12]*AT[28] + dsrc[13]*AT[29] + dsrc[14]*AT[30] + dsrc[15]*AT[31], b, slope, ceil);
+    ddst[(rowIdx+1)*colNum + (colIdx+4)] = ACSAActivate<Dtype>(dsrc[ 8]*AT[32] + dsrc[ 9]*AT[33] + dsrc[10]*AT[34] + dsrc[11]*AT[35] + dsrc[12]*AT[36] + dsrc[13]*AT[37] + dsrc[14]*AT[38] + dsrc[15]*AT[39], b, slope, ceil);
+    ddst[(rowIdx+1)*colNum + (colIdx+5)] = ACSAActivate<Dtype>(dsrc[ 8]*AT[40] + dsrc[ 9]*AT[41] + dsrc[10]*AT[42] + dsrc[11]*AT[43] + dsrc[12]*AT[44] + dsrc[13]*AT[45] + dsrc[14]*AT[46] + dsrc[15]*AT[47], b, slope, ceil);
+    ddst[(rowIdx+2)*colNum + (colIdx+0)] = ACSAActivate<Dtype>(dsrc[16]*AT[ 0] + dsrc[17]*AT[ 1] + dsrc[18]*AT[ 2] + dsrc[19]*AT[ 3] + dsrc[20]*AT[ 4] + dsrc[21]*AT[ 5] + dsrc[22]*AT[ 6] + dsrc[23]*AT[ 7], b, slope, ceil);
+    ddst[(rowIdx+2)*colNum + (colIdx+1)] = ACSAActivate<Dtype>(dsrc[16]*AT[ 8] + dsrc[17]*AT[ 9] + dsrc[18]*AT[10] + dsrc[19]*AT[11] + dsrc[20]*AT[12] + dsrc[21]*AT[13] + dsrc[22]*AT[14] + dsrc[23]*AT[15], b, slope, ceil);
+    ddst[(rowIdx+2)*colNum + (colIdx+2)] = ACSAActivate<Dtype>(dsrc[16]*AT[16] + dsrc[17]*AT[17] + dsrc[18]*AT[18] + dsrc[19]*AT[19] + dsrc[20]*AT[20] + dsrc[21]*AT[21] + dsrc[22]*AT[22] + dsrc[23]*AT[23], b, slope, ceil);
+    ddst[(rowIdx+2)*colNum + (colIdx+3)] = ACSAActivate<Dtype>(dsrc[16]*AT[24] + dsrc[17]*AT[25] + dsrc[18]*AT[26] + dsrc[19]*AT[27] + dsrc[20]*AT[28] + dsrc[21]*AT[29] + dsrc[22]*AT[30] + dsrc[23]*AT[31], b, slope, ceil);
+    ddst[(rowIdx+2)*colNum + (colIdx+4)] = ACSAActivate<Dtype>(dsrc[16]*AT[32] + dsrc[17]*AT[33] + dsrc[18]*AT[34] + dsrc[19]*AT[35] + dsrc[20]*AT[36] + dsrc[21]*AT[37] + dsrc[22]*AT[38] + dsrc[23]*AT[39], b, slope, ceil);
+    ddst[(rowIdx+2)*colNum + (colIdx+5)] = ACSAActivate<Dtype>(dsrc[16]*AT[40] + dsrc[17]*AT[41] + dsrc[18]*AT[42] + dsrc[19]*AT[43] + dsrc[20]*AT[44] + dsrc[21]*AT[45] + dsrc[22]*AT[46] + dsrc[23]*AT[47], b, slope, ceil);
+    ddst[(rowIdx+3)*colNum + (colIdx+0)] = ACSAActivate<Dtype>(dsrc[24]*AT[ 0] + dsrc[25]*AT[ 1] + dsrc[26]*AT[ 2] + dsrc[27]*AT[ 3] + dsrc[28]*AT[ 4] + dsrc[29]*AT[ 5] + dsrc[30]*AT[ 6] + dsrc[31]*AT[ 7], b, slope, ceil);
+    ddst[(rowIdx+3)*colNum + (colIdx+1)] = ACSAActivate<Dtype>(dsrc[24]*AT[ 8] + dsrc[25]*AT[ 9] + dsrc[26]*AT[10] + dsrc[27]*AT[11] + dsrc[28]*AT[12] + dsrc[29]*AT[13] + dsrc[30]*AT[14] + dsrc[31]*AT[15], b, slope, ceil);
+    ddst[(rowIdx+3)*colNum + (colIdx+2)] = ACSAActivate<Dtype>(dsrc[24]*AT[16] + dsrc[25]*AT[17] + dsrc[26]*AT[18] + dsrc[27]*AT[19] + dsrc[28]*AT[20] + dsrc[29]*AT[21] + dsrc[30]*AT[22] + dsrc[31]*AT[23], b, slope, ceil);
+    ddst[(rowIdx+3)*colNum + (colIdx+3)] = ACSAActivate<Dtype>(dsrc[24]*AT[24] + dsrc[25]*AT[25] + dsrc[26]*AT[26] + dsrc[27]*AT[27] + dsrc[28]*AT[28] + dsrc[29]*AT[29] + dsrc[30]*AT[30] + dsrc[31]*AT[31], b, slope, ceil);
+    ddst[(rowIdx+3)*colNum + (colIdx+4)] = ACSAActivate<Dtype>(dsrc[24]*AT[32] + dsrc[25]*AT[33] + dsrc[26]*AT[34] + dsrc[27]*AT[35] + dsrc[28]*AT[36] + dsrc[29]*AT[37] + dsrc[30]*AT[38] + dsrc[31]*AT[39], b, slope, ceil);
+    ddst[(rowIdx+3)*colNum + (colIdx+5)] = ACSAActivate<Dtype>(dsrc[24]*AT[40] + dsrc[25]*AT[41] + dsrc[26]*AT[42] + dsrc[27]*AT[43] + dsrc[28]*AT[44] + dsrc[29]*AT[45] + dsrc[30]*AT[46] + dsrc[31]*AT[47], b, slope, ceil);
+    ddst[(rowIdx+4)*colNum + (colIdx+0)] = ACSAActivate<Dtype>(dsrc[32]*AT[ 0] + dsrc[33]*AT[ 1] + dsrc[34]*AT[ 2] + dsrc[35]*AT[ 3] + dsrc[36]*AT[ 4] + dsrc[37]*AT[ 5] + dsrc[38]*AT[ 6] + dsrc[39]*AT[ 7], b, slope, ceil);
+    ddst[(rowIdx+4)*colNum + (colIdx+1)] = ACSAActivate<Dtype>(dsrc[32]*AT[ 8] + dsrc[33]*AT[ 9] + dsrc[34]*AT[10] + dsrc[35]*AT[11] + dsrc[36]*AT[12] + dsrc[37]*AT[13] + dsrc[38]*AT[14] + dsrc[39]*AT[15], b, slope, ceil);
+    ddst[(rowIdx+4)*colNum + (colIdx+2)] = ACSAActivate<Dtype>(dsrc[32]*AT[16] + dsrc[33]*AT[17] + dsrc[34]*AT[18] + dsrc[35]*AT[19] + dsrc[36]*AT[20] + dsrc[37]*AT[21] + dsrc[38]*AT[22] + dsrc[39]*AT[23], b, slope, ceil);
+    ddst[(rowIdx+4)*colNum + (colIdx+3)] = ACSAActivate<Dtype>(dsrc[32]*AT[24] + dsrc[33]*AT[25] + dsrc[34]*AT[26] + dsrc[35]*AT[27] + dsrc[36]*AT[28] + dsrc[37]*AT[29] + dsrc[38]*AT[30] + dsrc[39]*AT[31], b, slope, ceil);
+    ddst[(rowIdx+4)*colNum + (colIdx+4)] = ACSAActivate<Dtype>(dsrc[32]*AT[32] + dsrc[33]*AT[33] + dsrc[34]*AT[34] + dsrc[35]*AT[35] + dsrc[36]*AT[36] + dsrc[37]*AT[37] + dsrc[38]*AT[38] + dsrc[39]*AT[39], b, slope, ceil);
+    ddst[(rowIdx+4)*colNum + (colIdx+5)] = ACSAActivate<Dtype>(dsrc[32]*AT[40] + dsrc[33]*AT[41] + dsrc[34]*AT[42] + dsrc[35]*AT[43] + dsrc[36]*AT[44] + dsrc[37]*AT[45] + dsrc[38]*AT[46] + dsrc[39]*AT[47], b, slope, ceil);
+    ddst[(rowIdx+5)*colNum + (colIdx+0)] = ACSAActivate<Dtype>(dsrc[40]*AT[ 0] + dsrc[41]*AT[ 1] + dsrc[42]*AT[ 2] + dsrc[43]*AT[ 3] + dsrc[44]*AT[ 4] + dsrc[45]*AT[ 5] + dsrc[46]*AT[ 6] + dsrc[47]*AT[ 7], b, slope, ceil);
+    ddst[(rowIdx+5)*colNum + (colIdx+1)] = ACSAActivate<Dtype>(dsrc[40]*AT[ 8] + dsrc[41]*AT[ 9] + dsrc[42]*AT[10] + dsrc[43]*AT[11] + dsrc[44]*AT[12] + dsrc[45]*AT[13] + dsrc[46]*AT[14] + dsrc[47]*AT[15], b, slope, ceil);
+    ddst[(rowIdx+5)*colNum + (colIdx+2)] = ACSAActivate<Dtype>(dsrc[40]*AT[16] + dsrc[41]*AT[17] + dsrc[42]*AT[18] + dsrc[43]*AT[19] + dsrc[44]*AT[20] + dsrc[45]*AT[21] + dsrc[46]*AT[22] + dsrc[47]*AT[23], b, slope, ceil);
+    ddst[(rowIdx+5)*colNum + (colIdx+3)] = ACSAActivate<Dtype>(dsrc[40]*AT[24] + dsrc[41]*AT[25] + dsrc[42]*AT[26] + dsrc[43]*AT[27] + dsrc[44]*AT[28] + dsrc[45]*AT[29] + dsrc[46]*AT[30] + dsrc[47]*AT[31], b, slope, ceil);
+    ddst[(rowIdx+5)*colNum + (colIdx+4)] = ACSAActivate<Dtype>(dsrc[40]*AT[32] + dsrc[41]*AT[33] + dsrc[42]*AT[34] + dsrc[43]*AT[35] + dsrc[44]*AT[36] + dsrc[45]*AT[37] + dsrc[46]*AT[38] + dsrc[47]*AT[39], b, slope, ceil);
+    ddst[(rowIdx+5)*colNum + (colIdx+5)] = ACSAActivate<Dtype>(dsrc[40]*AT[40] + dsrc[41]*AT[41] + dsrc[42]*AT[42] + dsrc[43]*AT[43] + dsrc[44]*AT[44] + dsrc[45]*AT[45] + dsrc[46]*AT[46] + dsrc[47]*AT[47], b, slope, ceil);
 }
 
 /* Don't use pad: 
@@ -349,7 +347,8 @@ inline void transformByAT_second(Dtype *dsrc, Dtype *ddst, int rowIdx, int colId
     template<typename Dtype>
 static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
         const int N, const int C, const int rows, const int cols,
-        const int ntiles, const int mg6x3)
+        const int ntiles, const int mg6x3,
+        const long istride)
 {   
     int d1, d2;
     int sizeI = rows*cols;
@@ -446,10 +445,10 @@ static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
 
                 // The tranformation manually simplified
 #if 0
-                transformByBT(tmp, dataDst, tileCount);
+                transformByBT(tmp, dataDst, tileCount, istride);
 #else
                 transformByBT_first(tmp, bridge);
-                transformByBT_second(bridge, dataDst, tileCount);
+                transformByBT_second(bridge, dataDst, tileCount, istride);
 #endif
                 tileCount++; 
             }
@@ -457,10 +456,69 @@ static void inByTransform_nopad(const Dtype *in, Dtype *dataDst,
     }
 }
 
+/* Use pad or process the tails:
+ * the tiles inside the in data are read directly, the tiles crossing
+ * its border are gathered with zeros.
+ * */
+    template<typename Dtype>
+static void inByTransform_pad(const Dtype *in, Dtype *dataDst,
+        const int N, const int C, const int rows, const int cols,
+        const int pad_h, const int pad_w,
+        ACSATailMessage *tailMess, const int ntiles, const int mg6x3,
+        const long istride)
+{
+    int d1;
+    int sizeI = rows*cols;
+    const int outRows = rows + 2*pad_h - 2;
+    const int outCols = cols + 2*pad_w - 2;
+
+    ACSA_CHECK((outRows%6 == tailMess->tail_h_));
+    ACSA_CHECK((outCols%6 == tailMess->tail_w_));
+
+#pragma omp parallel for private(d1)
+    for(d1 = 0; d1 < N*C; d1++){
+        int i, j, k;
+        Dtype tmp[64] __attribute__((aligned(64)));
+        Dtype bridge[64] __attribute__((aligned(64)));
+
+        const int t1 = d1/(C*mg6x3);
+        const int t2 = (d1%(C*mg6x3))/mg6x3;
+        const int t3 = d1%mg6x3;
+
+        // merge value influence the sequence of in data.
+        const Dtype *data = in + (t1*mg6x3*C + t3*C + t2)*sizeI;
+        int tileCount = d1*ntiles;
+
+        for(i = 0; i < outRows; i += 6){
+            // The first row of the tile in data, and the rows out of data
+            const int r0 = i - pad_h;
+            const int r_up = std::max(0, -r0);
+            const int r_down = std::max(0, r0+8-rows);
+
+            for(j = 0; j < outCols; j += 6){
+                const int c0 = j - pad_w;
+                const int c_left = std::max(0, -c0);
+                const int c_right = std::max(0, c0+8-cols);
+
+                if(r_up == 0 && r_down == 0 && c_left == 0 && c_right == 0){
+                    for(k = 0; k < 64; k++)
+                        tmp[k] = data[(r0+k/8)*cols + (c0+k%8)];
+                }
+                else
+                    ACSAGetInputTile(tmp, data, 8, 8, r0+r_up, c0+c_left, cols, r_up, r_down, c_left, c_right);
+
+                transformByBT_first(tmp, bridge);
+                transformByBT_second(bridge, dataDst, tileCount, istride);
+                tileCount++;
+            }
+        }
+    }
+}
+
 /* Compute the bridge data for filter, and transform to form matrix B. */
     template<typename Dtype>
 static void filterByTransform(const Dtype *filter, Dtype *dataDst,
-        const int C, const int K)
+        const int C, const int K, const long fstride)
 {
     int d1, d2, d3; 
     const Dtype *F;
@@ -541,7 +599,7 @@ static void filterByTransform(const Dtype *filter, Dtype *dataDst,
             // scatter
 #pragma unroll(64)
             for(d3 = 0; d3 < 64; d3++){
-                dataDst[d3*FSTRIDE6X3+d1*C+d2] = ddt[d3]; 
+                dataDst[d3*fstride+d1*C+d2] = ddt[d3]; 
             }
         }
     }
@@ -551,47 +609,30 @@ static void filterByTransform(const Dtype *filter, Dtype *dataDst,
  * Number of sgemm calls is 64*BATCH. 
  * */ 
     template<typename Dtype>
-static void matrix_compute(const Dtype *in, const int irows, const int icols,
-        const Dtype *filter, const int frows, const int fcols,
-        Dtype *out,
-        const int batch)
+static void matrix_compute(const Dtype *in, const int irows, const int icols, const long istride,
+        const Dtype *filter, const int frows, const int fcols, const long fstride,
+        Dtype *out, const long ostride,
+        const int batch, const ACSAGemmMode gemm)
 {
 
     /* In  - matrix A
      * Filter - matrix B
      * Output - matrix C
+     * All 64 points of every batch are issued as one batched gemm.
      * */
-    int d1, d2; 
-    const char trans ='n'; 
-    const float alpha_f = 1.0; 
-    const float beta_f =  0.0; 
-    const double alpha_d = 1.0; 
-    const double beta_d =  0.0; 
-    const int ldi = irows;
-    const int ldf = frows;
-    const int ldo = irows;
-
-#pragma omp parallel for collapse(2) private(d1, d2)
-    for(d1 = 0; d1 < 64; d1++){
-        for(d2 = 0; d2 < batch; d2++){
-            const Dtype* pin = in+d1*ISTRIDE6X3+d2*irows*icols; 
-            const Dtype* pft = filter+d1*FSTRIDE6X3; 
-            Dtype* pot = out+d1*OSTRIDE6X3+d2*irows*fcols; 
-            if(typeid(Dtype) == typeid(float))
-                sgemm(&trans, &trans, &irows, &fcols, &icols, &alpha_f, 
-                        (const float *)pin, &ldi, (const float *)pft, &ldf, &beta_f, (float *)pot, &ldo); 
-            else if(typeid(Dtype) == typeid(double))
-                dgemm(&trans, &trans, &irows, &fcols, &icols, &alpha_d, 
-                        (const double *)pin, &ldi, (const double *)pft, &ldf, &beta_d, (double *)pot, &ldo); 
-        }
-    }
+    if(gemm == ACSA_GEMM_KERNEL)
+        ACSAWinoGemm(in, irows, icols, istride, filter, fcols, fstride, out, ostride, 64, batch);
+    else
+        ACSABatchGemm(in, irows, icols, istride, filter, fcols, fstride, out, ostride, 64, batch);
 }
 
 /* Compute the bridge data for out, and transform to form matrix C. */
     template<typename Dtype>
 static void outByTransform(Dtype *out, const Dtype *dataSrc,
         const int N, const int K, const int rows, const int cols,
-        const int ntiles, const int mg6x3)
+        ACSATailMessage *tailMess, const int ntiles, const int mg6x3,
+        const long ostride,
+        const Dtype *bias, const Dtype slope, const Dtype ceil)
 {
     int d1; 
     int sizeO = rows * cols;
@@ -601,88 +642,91 @@ static void outByTransform(Dtype *out, const Dtype *dataSrc,
         int i, j;    
         Dtype ddt[64] __attribute__((aligned(64)));
         Dtype bridge[48] __attribute__((aligned(64)));
+        Dtype middle[36] __attribute__((aligned(64)));
 
         const int t1 = d1/(K*mg6x3);
         const int t2 = (d1%(K*mg6x3))/mg6x3;
         const int t3 = d1%mg6x3;
 
         Dtype *data = out + (t1*mg6x3*K + t3*K + t2)*sizeO;
+
+        const Dtype bk = (bias == NULL) ? (Dtype)0 : bias[t2];
         int tileCount = d1*ntiles; 
 
         for(i = 0; i < rows; i += 6){
             //#pragma simd
             for(j = 0; j < cols; j += 6){
-                ddt[ 0] = dataSrc[tileCount+  0*OSTRIDE6X3]; 
-                ddt[ 1] = dataSrc[tileCount+  1*OSTRIDE6X3]; 
-                ddt[ 2] = dataSrc[tileCount+  2*OSTRIDE6X3]; 
-                ddt[ 3] = dataSrc[tileCount+  3*OSTRIDE6X3]; 
-                ddt[ 4] = dataSrc[tileCount+  4*OSTRIDE6X3]; 
-                ddt[ 5] = dataSrc[tileCount+  5*OSTRIDE6X3]; 
-                ddt[ 6] = dataSrc[tileCount+  6*OSTRIDE6X3]; 
-                ddt[ 7] = dataSrc[tileCount+  7*OSTRIDE6X3]; 
-
-                ddt[ 8] = dataSrc[tileCount+  8*OSTRIDE6X3]; 
-                ddt[ 9] = dataSrc[tileCount+  9*OSTRIDE6X3]; 
-                ddt[10] = dataSrc[tileCount+ 10*OSTRIDE6X3]; 
-                ddt[11] = dataSrc[tileCount+ 11*OSTRIDE6X3]; 
-                ddt[12] = dataSrc[tileCount+ 12*OSTRIDE6X3]; 
-                ddt[13] = dataSrc[tileCount+ 13*OSTRIDE6X3]; 
-                ddt[14] = dataSrc[tileCount+ 14*OSTRIDE6X3]; 
-                ddt[15] = dataSrc[tileCount+ 15*OSTRIDE6X3]; 
-
-                ddt[16] = dataSrc[tileCount+ 16*OSTRIDE6X3]; 
-                ddt[17] = dataSrc[tileCount+ 17*OSTRIDE6X3]; 
-                ddt[18] = dataSrc[tileCount+ 18*OSTRIDE6X3]; 
-                ddt[19] = dataSrc[tileCount+ 19*OSTRIDE6X3]; 
-                ddt[20] = dataSrc[tileCount+ 20*OSTRIDE6X3]; 
-                ddt[21] = dataSrc[tileCount+ 21*OSTRIDE6X3]; 
-                ddt[22] = dataSrc[tileCount+ 22*OSTRIDE6X3]; 
-                ddt[23] = dataSrc[tileCount+ 23*OSTRIDE6X3]; 
-
-                ddt[24] = dataSrc[tileCount+ 24*OSTRIDE6X3]; 
-                ddt[25] = dataSrc[tileCount+ 25*OSTRIDE6X3]; 
-                ddt[26] = dataSrc[tileCount+ 26*OSTRIDE6X3]; 
-                ddt[27] = dataSrc[tileCount+ 27*OSTRIDE6X3]; 
-                ddt[28] = dataSrc[tileCount+ 28*OSTRIDE6X3]; 
-                ddt[29] = dataSrc[tileCount+ 29*OSTRIDE6X3]; 
-                ddt[30] = dataSrc[tileCount+ 30*OSTRIDE6X3]; 
-                ddt[31] = dataSrc[tileCount+ 31*OSTRIDE6X3]; 
-
-                ddt[32] = dataSrc[tileCount+ 32*OSTRIDE6X3]; 
-                ddt[33] = dataSrc[tileCount+ 33*OSTRIDE6X3]; 
-                ddt[34] = dataSrc[tileCount+ 34*OSTRIDE6X3]; 
-                ddt[35] = dataSrc[tileCount+ 35*OSTRIDE6X3]; 
-                ddt[36] = dataSrc[tileCount+ 36*OSTRIDE6X3]; 
-                ddt[37] = dataSrc[tileCount+ 37*OSTRIDE6X3]; 
-                ddt[38] = dataSrc[tileCount+ 38*OSTRIDE6X3]; 
-                ddt[39] = dataSrc[tileCount+ 39*OSTRIDE6X3]; 
-
-                ddt[40] = dataSrc[tileCount+ 40*OSTRIDE6X3]; 
-                ddt[41] = dataSrc[tileCount+ 41*OSTRIDE6X3]; 
-                ddt[42] = dataSrc[tileCount+ 42*OSTRIDE6X3]; 
-                ddt[43] = dataSrc[tileCount+ 43*OSTRIDE6X3]; 
-                ddt[44] = dataSrc[tileCount+ 44*OSTRIDE6X3]; 
-                ddt[45] = dataSrc[tileCount+ 45*OSTRIDE6X3]; 
-                ddt[46] = dataSrc[tileCount+ 46*OSTRIDE6X3]; 
-                ddt[47] = dataSrc[tileCount+ 47*OSTRIDE6X3]; 
-
-                ddt[48] = dataSrc[tileCount+ 48*OSTRIDE6X3]; 
-                ddt[49] = dataSrc[tileCount+ 49*OSTRIDE6X3]; 
-                ddt[50] = dataSrc[tileCount+ 50*OSTRIDE6X3]; 
-                ddt[51] = dataSrc[tileCount+ 51*OSTRIDE6X3]; 
-                ddt[52] = dataSrc[tileCount+ 52*OSTRIDE6X3]; 
-                ddt[53] = dataSrc[tileCount+ 53*OSTRIDE6X3]; 
-                ddt[54] = dataSrc[tileCount+ 54*OSTRIDE6X3]; 
-                ddt[55] = dataSrc[tileCount+ 55*OSTRIDE6X3]; 
-
-                ddt[56] = dataSrc[tileCount+ 56*OSTRIDE6X3]; 
-                ddt[57] = dataSrc[tileCount+ 57*OSTRIDE6X3]; 
-                ddt[58] = dataSrc[tileCount+ 58*OSTRIDE6X3]; 
-                ddt[59] = dataSrc[tileCount+ 59*OSTRIDE6X3]; 
-                ddt[60] = dataSrc[tileCount+ 60*OSTRIDE6X3]; 
-                ddt[61] = dataSrc[tileCount+ 61*OSTRIDE6X3]; 
-                ddt[62] = dataSrc[tileCount+ 62*OSTRIDE6X3]; 
-                ddt[63] = dataSrc[tileCount+ 63*OSTRIDE6X3]; 
+                ddt[ 0] = dataSrc[tileCount+  0*ostride]; 
+                ddt[ 1] = dataSrc[tileCount+  1*ostride]; 
+                ddt[ 2] = dataSrc[tileCount+  2*ostride]; 
+                ddt[ 3] = dataSrc[tileCount+  3*ostride]; 
+                ddt[ 4] = dataSrc[tileCount+  4*ostride]; 
+                ddt[ 5] = dataSrc[tileCount+  5*ostride]; 
+                ddt[ 6] = dataSrc[tileCount+  6*ostride]; 
+                ddt[ 7] = dataSrc[tileCount+  7*ostride]; 
+
+                ddt[ 8] = dataSrc[tileCount+  8*ostride]; 
+                ddt[ 9] = dataSrc[tileCount+  9*ostride]; 
+                ddt[10] = dataSrc[tileCount+ 10*ostride]; 
+                ddt[11] = dataSrc[tileCount+ 11*ostride]; 
+                ddt[12] = dataSrc[tileCount+ 12*ostride]; 
+                ddt[13] = dataSrc[tileCount+ 13*ostride]; 
+                ddt[14] = dataSrc[tileCount+ 14*ostride]; 
+                ddt[15] = dataSrc[tileCount+ 15*ostride]; 
+
+                ddt[16] = dataSrc[tileCount+ 16*ostride]; 
+                ddt[17] = dataSrc[tileCount+ 17*ostride]; 
+                ddt[18] = dataSrc[tileCount+ 18*ostride]; 
+                ddt[19] = dataSrc[tileCount+ 19*ostride]; 
+                ddt[20] = dataSrc[tileCount+ 20*ostride]; 
+                ddt[21] = dataSrc[tileCount+ 21*ostride]; 
+                ddt[22] = dataSrc[tileCount+ 22*ostride]; 
+                ddt[23] = dataSrc[tileCount+ 23*ostride]; 
+
+                ddt[24] = dataSrc[tileCount+ 24*ostride]; 
+                ddt[25] = dataSrc[tileCount+ 25*ostride]; 
+                ddt[26] = dataSrc[tileCount+ 26*ostride]; 
+                ddt[27] = dataSrc[tileCount+ 27*ostride]; 
+                ddt[28] = dataSrc[tileCount+ 28*ostride]; 
+                ddt[29] = dataSrc[tileCount+ 29*ostride]; 
+                ddt[30] = dataSrc[tileCount+ 30*ostride]; 
+                ddt[31] = dataSrc[tileCount+ 31*ostride]; 
+
+                ddt[32] = dataSrc[tileCount+ 32*ostride]; 
+                ddt[33] = dataSrc[tileCount+ 33*ostride]; 
+                ddt[34] = dataSrc[tileCount+ 34*ostride]; 
+                ddt[35] = dataSrc[tileCount+ 35*ostride]; 
+                ddt[36] = dataSrc[tileCount+ 36*ostride]; 
+                ddt[37] = dataSrc[tileCount+ 37*ostride]; 
+                ddt[38] = dataSrc[tileCount+ 38*ostride]; 
+                ddt[39] = dataSrc[tileCount+ 39*ostride]; 
+
+                ddt[40] = dataSrc[tileCount+ 40*ostride]; 
+                ddt[41] = dataSrc[tileCount+ 41*ostride]; 
+                ddt[42] = dataSrc[tileCount+ 42*ostride]; 
+                ddt[43] = dataSrc[tileCount+ 43*ostride]; 
+                ddt[44] = dataSrc[tileCount+ 44*ostride]; 
+                ddt[45] = dataSrc[tileCount+ 45*ostride]; 
+                ddt[46] = dataSrc[tileCount+ 46*ostride]; 
+                ddt[47] = dataSrc[tileCount+ 47*ostride]; 
+
+                ddt[48] = dataSrc[tileCount+ 48*ostride]; 
+                ddt[49] = dataSrc[tileCount+ 49*ostride]; 
+                ddt[50] = dataSrc[tileCount+ 50*ostride]; 
+                ddt[51] = dataSrc[tileCount+ 51*ostride]; 
+                ddt[52] = dataSrc[tileCount+ 52*ostride]; 
+                ddt[53] = dataSrc[tileCount+ 53*ostride]; 
+                ddt[54] = dataSrc[tileCount+ 54*ostride]; 
+                ddt[55] = dataSrc[tileCount+ 55*ostride]; 
+
+                ddt[56] = dataSrc[tileCount+ 56*ostride]; 
+                ddt[57] = dataSrc[tileCount+ 57*ostride]; 
+                ddt[58] = dataSrc[tileCount+ 58*ostride]; 
+                ddt[59] = dataSrc[tileCount+ 59*ostride]; 
+                ddt[60] = dataSrc[tileCount+ 60*ostride]; 
+                ddt[61] = dataSrc[tileCount+ 61*ostride]; 
+                ddt[62] = dataSrc[tileCount+ 62*ostride]; 
+                ddt[63] = dataSrc[tileCount+ 63*ostride]; 
 
 #if 0
                 data[(i+0)*cols + (j+0)] = (ddt[0 ] + ddt[1 ] + ddt[2 ] + ddt[3 ] + ddt[4 ] + ddt[5 ] + ddt[6 ] + ddt[8 ] + ddt[9 ] + ddt[10] + ddt[11] + ddt[12] + ddt[13] + ddt[14] + ddt[16] + ddt[17] + ddt[18] + ddt[19] + ddt[20] + ddt[21] + ddt[22] + ddt[24] + ddt[25] + ddt[26] + ddt[27] + ddt[28] + ddt[29] + ddt[30] + ddt[32] + ddt[33] + ddt[34] + ddt[35] + ddt[36] + ddt[37] + ddt[38] + ddt[40] + ddt[41] + ddt[42] + ddt[43] + ddt[44] + ddt[45] + ddt[46] + ddt[48] + ddt[49] + ddt[50] + ddt[51] + ddt[52] + ddt[53] + ddt[54])*1;
@@ -728,7 +772,14 @@ static void outByTransform(Dtype *out, const Dtype *dataSrc,
                 data[(i+5)*cols + (j+5)] = (ddt[45] - ddt[46] - ddt[53] + ddt[54])*0.000976562 + (ddt[13] - ddt[14] - ddt[21] + ddt[22] + ddt[41] - ddt[42] + ddt[47] - ddt[49] + ddt[50] - ddt[55] + ddt[61] - ddt[62])*0.03125 + (ddt[9 ] - ddt[10] + ddt[15] - ddt[17] + ddt[18] - ddt[23] + ddt[29] - ddt[30] - ddt[37] + ddt[38] + ddt[43] - ddt[44] - ddt[51] + ddt[52] + ddt[57] - ddt[58] + ddt[63]) + (ddt[11] - ddt[12] - ddt[19] + ddt[20] + ddt[25] - ddt[26] + ddt[31] - ddt[33] + ddt[34] - ddt[39] + ddt[59] - ddt[60])*32 + (ddt[27] - ddt[28] - ddt[35] + ddt[36])*1024;
 #else
                 transformByAT_first(ddt, bridge);
-                transformByAT_second(bridge, data, i, j, cols);
+                if((i+6 <= rows) && (j+6 <= cols))
+                    transformByAT_second(bridge, data, i, j, cols, bk, slope, ceil);
+                else{
+                    // Tail tile, only the part inside out is written
+                    transformByAT_second(bridge, middle, 0, 0, 6, bk, slope, ceil);
+                    ACSAGetFinalOutput(data, middle, 6, 6, i, j, cols,
+                            0, std::max(0, i+6-rows), 0, std::max(0, j+6-cols));
+                }
 #endif
                 tileCount++; 
             }
@@ -736,12 +787,129 @@ static void outByTransform(Dtype *out, const Dtype *dataSrc,
     }
 }
 
-/* API for winograd F(6,3). */
+/* Compute the bridge data for out, transform and max pool 2x2 to form the pooled matrix C. */
     template<typename Dtype>
-ACSAStatus ACSAWinoConvolution_6x3(const Dtype *in, const Dtype *filter, Dtype *out,
+static void outByTransformPool(Dtype *out, const Dtype *dataSrc,
+        const int N, const int K, const int rows, const int cols,
+        ACSATailMessage *tailMess, const int ntiles, const int mg6x3,
+        const long ostride,
+        const Dtype *bias, const Dtype slope, const Dtype ceil)
+{
+    int d1;
+    const int pcols = cols/2;
+    const int sizeP = (rows/2) * pcols;
+
+#pragma omp parallel for private(d1)
+    for(d1 = 0; d1 < N*K; d1++){
+        int i, j, k;
+        Dtype ddt[64] __attribute__((aligned(64)));
+        Dtype bridge[48] __attribute__((aligned(64)));
+        Dtype middle[36] __attribute__((aligned(64)));
+
+        const int t1 = d1/(K*mg6x3);
+        const int t2 = (d1%(K*mg6x3))/mg6x3;
+        const int t3 = d1%mg6x3;
+
+        Dtype *data = out + (t1*mg6x3*K + t3*K + t2)*sizeP;
+
+        const Dtype bk = (bias == NULL) ? (Dtype)0 : bias[t2];
+        int tileCount = d1*ntiles;
+
+        for(i = 0; i < rows; i += 6){
+            for(j = 0; j < cols; j += 6){
+                for(k = 0; k < 64; k++)
+                    ddt[k] = dataSrc[tileCount + k*ostride];
+                transformByAT_first(ddt, bridge);
+                transformByAT_second(bridge, middle, 0, 0, 6, bk, slope, ceil);
+
+                // The tail tiles keep even rows and cols as out is even
+                ACSAPoolTileMax(data, middle, 6, std::min(6, rows-i), std::min(6, cols-j), i, j, pcols);
+                tileCount++;
+            }
+        }
+    }
+}
+
+/* Process the data tail. */
+static void tailPreProcess(ACSATensor4d *tensorOut, ACSATailMessage &tailMess, int &ntiles)
+{
+    int out_h = tensorOut->h_;
+    int out_w = tensorOut->w_;
+    int tail_h = out_h % 6;
+    int tail_w = out_w % 6;
+
+    tailMess.tail_h_ = tail_h;
+    tailMess.tail_w_ = tail_w;
+
+    if(tail_h == 0)
+        ntiles = out_h/6;
+    else
+        ntiles = out_h/6 + 1;
+
+    if(tail_w == 0)
+        ntiles *= out_w/6;
+    else
+        ntiles *= out_w/6 + 1;
+}
+
+/* Compute the stride of every transform point for bridge data. */
+    template<typename Dtype>
+static void bridgeStride(ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess, long &istride, long &fstride, long &ostride)
+{
+    const int N = tensorIn->n_;
+    const int C = tensorIn->c_;
+    const int K = tensorFilter->n_;
+    int ntiles;
+    ACSATailMessage tailMess;
+
+    tailPreProcess(tensorOut, tailMess, ntiles);
+
+    int b_bts = winoMess->batch_block_;
+    if(b_bts == 0 || b_bts > N)
+        b_bts = N;
+
+    // Depthwise keeps no bridge data, only the transformed filters
+    if(ACSAIsDepthwise(tensorIn, tensorFilter)){
+        istride = ostride = 0;
+        fstride = no4k_aligned((long)K, sizeof(Dtype));
+        return;
+    }
+
+    // The fused pipeline keeps its blocks after the filter, see ACSAWinoPipelineBytes
+    if(ACSAWinoFused(tensorIn, tensorOut, winoMess)){
+        istride = ostride = 0;
+        fstride = no4k_aligned((long)C*K, sizeof(Dtype));
+        return;
+    }
+
+    istride = no4k_aligned((long)b_bts*ntiles*C, sizeof(Dtype));
+    fstride = no4k_aligned((long)C*K, sizeof(Dtype));
+    ostride = no4k_aligned((long)b_bts*ntiles*K, sizeof(Dtype));
+}
+
+/* Winograd F(6,3) with the filter already transformed. */
+    template<typename Dtype>
+static ACSAStatus winoConvolution(const Dtype *in, const Dtype *wino_filter, const long fstride, const ACSAWinoFilter *wfilter,
+        Dtype *out,
         ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
-        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess)
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        Dtype *wino_in, const long istride, Dtype *wino_out, const long ostride,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
 {
+    // Depthwise has no gemm, the element-wise kernel takes any schedule and layout
+    if(ACSAIsDepthwise(tensorIn, tensorFilter))
+        return ACSAWinoDepthwise<Dtype, 6>(BT, AT, in, wino_filter, fstride, out,
+                tensorIn, tensorFilter, tensorOut, convMess,
+                bias, activMess, poolMess);
+
+    // Only the fused pipeline reads and writes layouts other than NCHW or 16-bit bridges,
+    // its blocks take the place of wino_out
+    if(ACSAWinoFused(tensorIn, tensorOut, winoMess))
+        return ACSAWinoPipeline<Dtype, 6>(BT, AT, in, wino_filter, fstride, wfilter, out,
+                tensorIn, tensorFilter, tensorOut, convMess, winoMess, (void *)wino_out,
+                bias, activMess, poolMess);
+
     const int N = tensorIn->n_;
     const int C = tensorIn->c_;
     const int H = tensorIn->h_;
@@ -753,23 +921,29 @@ ACSAStatus ACSAWinoConvolution_6x3(const Dtype *in, const Dtype *filter, Dtype *
     const int mg6x3 = winoMess->merge_;
     const int outHeight = tensorOut->h_; 
     const int outWidth = tensorOut->w_; 
-    const int ntiles = (outHeight/6)*(outWidth/6);
+    int ntiles;
+    ACSATailMessage tailMess;
+
+    tailPreProcess(tensorOut, tailMess, ntiles);
+
+    Dtype slope, ceil;
+    ACSAActivParam(activMess, slope, ceil);
 
     const Dtype *b_in;
     Dtype *b_out;
 
-    int b_bts = 64;
-    if(b_bts == 0)
+    int b_bts = bb6x3;
+    if(b_bts == 0 || b_bts > N)
         b_bts = N;
 
-    Dtype *wino_in = (Dtype *)winoIn;
-    Dtype *wino_filter = (Dtype *)winoFilter; 
-    Dtype *wino_out = (Dtype *)winoOut;
 
     // Check
-    ACSA_CHECK((N%b_bts == 0));
-    ACSA_CHECK(((pad_h < 2) || (pad_w < 2)));
-    ACSA_CHECK(((outHeight%6 == 0) && (outWidth%6 == 0)));
+    ACSA_CHECK(((pad_h < 2) && (pad_w < 2)));
+    if(poolMess != NULL)
+        ACSA_CHECK(ACSAPoolFusible(poolMess, outHeight, outWidth));
+
+    /* Pooled plane is a quarter of the convolution output. */
+    const int sizeO = (poolMess == NULL) ? outHeight*outWidth : (outHeight/2)*(outWidth/2);
 
     /* Get the needed threads number. */
     int num_threads;
@@ -779,95 +953,239 @@ ACSAStatus ACSAWinoConvolution_6x3(const Dtype *in, const Dtype *filter, Dtype *
         num_threads = omp_get_num_threads();
     }
 
-    filterByTransform(filter, wino_filter, C, K);
     for(int i = 0; i < N; i += b_bts){
+        // The last block takes the rest of the batch, and the merge
+        // falls back to 1 if it doesn't divide that block.
+        const int nb = std::min(b_bts, N-i);
+        const int mg = (nb%mg6x3 == 0) ? mg6x3 : 1;
+
         b_in = in + i*C*H*W;
-        b_out = out + i*K*outHeight*outWidth;
-        if(pad_h == 0 && pad_w == 0)
-            inByTransform_nopad(b_in, wino_in, b_bts, C, H, W, ntiles, mg6x3);
-#if 0
-        else if(H*W > 1225)
-            //else if(H*W > 1)
-            inByTransform_padBigScale(b_in, wino_in, b_bts, C, H, W, pad_h, pad_w, ntiles, mg6x3);
-        else{
-            Dtype *in_pad = (Dtype *)mkl_malloc(num_threads*(H+2*pad_h)*(W+2*pad_w)*sizeof(Dtype), 64);
-            memset(in_pad, 0, num_threads*(H+2*pad_h)*(W+2*pad_w)*sizeof(Dtype));
-            inByTransform_padSmallScale(b_in, in_pad, wino_in, N, C, H, W, pad_h, pad_w, ntiles, mg6x3);
-            mkl_free(in_pad);
-        }
-#endif
-        matrix_compute(wino_in, mg6x3*ntiles, C, wino_filter, C, K, wino_out, b_bts/mg6x3);
-        outByTransform(b_out, wino_out, b_bts, K, outHeight, outWidth, ntiles, mg6x3);
+        b_out = out + i*K*sizeO;
+        if(pad_h == 0 && pad_w == 0 && tailMess.tail_h_ == 0 && tailMess.tail_w_ == 0)
+            inByTransform_nopad(b_in, wino_in, nb, C, H, W, ntiles, mg, istride);
+        else
+            inByTransform_pad(b_in, wino_in, nb, C, H, W, pad_h, pad_w, &tailMess, ntiles, mg, istride);
+        matrix_compute(wino_in, mg*ntiles, C, istride, wino_filter, C, K, fstride, wino_out, ostride, nb/mg, winoMess->gemm_);
+        if(poolMess == NULL)
+            outByTransform(b_out, wino_out, nb, K, outHeight, outWidth, &tailMess, ntiles, mg, ostride, bias, slope, ceil);
+        else
+            outByTransformPool(b_out, wino_out, nb, K, outHeight, outWidth, &tailMess, ntiles, mg, ostride, bias, slope, ceil);
+    }
+
+    return ACSASUCCESS;
+}
+
+/* Bytes of workspace needed by winograd F(6,3). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_6x3(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess)
+{
+    long istride, fstride, ostride;
+
+    bridgeStride<Dtype>(tensorIn, tensorFilter, tensorOut, winoMess, istride, fstride, ostride);
+    size = 64*(istride+fstride+ostride)*sizeof(Dtype) +
+        ACSAWinoPipelineBytes<Dtype>(6, 6, tensorIn, tensorFilter, tensorOut, winoMess, omp_get_max_threads());
+
+    return ACSASUCCESS;
+}
+
+/* API for winograd F(6,3). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_6x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    const int C = tensorFilter->c_;
+    const int K = tensorFilter->n_;
+    long istride, fstride, ostride;
+
+    bridgeStride<Dtype>(tensorIn, tensorFilter, tensorOut, winoMess, istride, fstride, ostride);
+
+    Dtype *wino_in = (Dtype *)ACSAReserveWorkspace(handle, 64*(istride+fstride+ostride)*sizeof(Dtype) +
+            ACSAWinoPipelineBytes<Dtype>(6, 6, tensorIn, tensorFilter, tensorOut, winoMess, handle->num_threads_));
+    if(wino_in == NULL)
+        return ACSAFAIL;
+    Dtype *wino_filter = wino_in + 64*istride;
+    Dtype *wino_out = wino_filter + 64*fstride;
+
+    const int nthreads = omp_get_max_threads();
+    omp_set_num_threads(handle->num_threads_);
+    filterByTransform(filter, wino_filter, C, K, fstride);
+    ACSAStatus ret = winoConvolution((const Dtype *)in, (const Dtype *)wino_filter, fstride, (const ACSAWinoFilter *)NULL, out,
+            tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+            wino_in, istride, wino_out, ostride,
+            bias, activMess, poolMess);
+    omp_set_num_threads(nthreads);
+
+    return ret;
+}
+
+/* API for winograd F(6,3) with the pre-transformed filter. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_6x3(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    long istride, fstride, ostride;
+
+    // Check
+    ACSA_CHECK((wfilter->algo_ == ACSA_WINOGRAD_6X3));
+    ACSA_CHECK(((wfilter->c_*convMess->groups_ == tensorIn->c_) && (wfilter->k_ == tensorFilter->n_)));
+    if(!ACSAWinoFilterFits<Dtype>(wfilter, winoMess)){
+        ACSA_MESSAGE("ERROR: The filter was transformed for another type or bridge!");
+        return ACSAFAIL;
     }
 
+    bridgeStride<Dtype>(tensorIn, tensorFilter, tensorOut, winoMess, istride, fstride, ostride);
+
+    Dtype *wino_in = (Dtype *)ACSAReserveWorkspace(handle, 64*(istride+fstride+ostride)*sizeof(Dtype) +
+            ACSAWinoPipelineBytes<Dtype>(6, 6, tensorIn, tensorFilter, tensorOut, winoMess, handle->num_threads_));
+    if(wino_in == NULL)
+        return ACSAFAIL;
+    Dtype *wino_out = wino_in + 64*(istride+fstride);
+
+    const int nthreads = omp_get_max_threads();
+    omp_set_num_threads(handle->num_threads_);
+    ACSAStatus ret = winoConvolution(in, (const Dtype *)wfilter->data_, wfilter->stride_, wfilter, out,
+            tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+            wino_in, istride, wino_out, ostride,
+            bias, activMess, poolMess);
+    omp_set_num_threads(nthreads);
+
+    return ret;
+}
+
+/* Transform the filter of F(6,3) into the layout of bridge data. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoFilterTransform_6x3(const Dtype *filter, Dtype *wino_filter,
+        const int C, const int K, const long fstride)
+{
+    filterByTransform(filter, wino_filter, C, K, fstride);
+
     return ACSASUCCESS;
 }
 
+/* Filter gradient of winograd F(6,3). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoBwdFilter_6x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess)
+{
+    return ACSAWinoBwdFilter<Dtype, 6>(BT, AT, G, handle, in, diffOut, diffFilter,
+            tensorIn, tensorFilter, tensorOut, convMess);
+}
+
 /* Instantiate Template */
-template inline void transformByBT<float>(float *, float *, int);
+template inline void transformByBT<float>(float *, float *, int, const long);
 template inline void transformByBT_first(float *, float *);
-template inline void transformByBT_second(float *, float *, int);
+template inline void transformByBT_second(float *, float *, int, const long);
 template inline void transformByAT_first(float *, float *);
-template inline void transformByAT_second(float *, float *, int, int, int);
-#if 0
+template inline void transformByAT_second(float *, float *, int, int, int,
+        const float, const float, const float);
 template void inByTransform_pad<float>(const float *, float *,
         const int, const int, const int, const int,
         const int, const int,
-        const int, const int);
-template void inByTransform_padBigScale<float>(const float *, float *,
-        const int, const int, const int, const int,
-        const int, const int,
-        const int, const int);
-template void inByTransform_padSmallScale<float>(const float *, float *, float *,
-        const int, const int, const int, const int,
-        const int, const int,
-        const int, const int);
-#endif
+        ACSATailMessage *, const int, const int, const long);
 template void inByTransform_nopad<float>(const float *, float *,
         const int, const int, const int, const int,
-        const int, const int);
+        const int, const int, const long);
 template void filterByTransform<float>(const float *, float *,
-        const int, const int);
-template void matrix_compute<float>(const float *, const int, const int,
-        const float *, const int, const int,
-        float *, const int);
+        const int, const int, const long);
+template void matrix_compute<float>(const float *, const int, const int, const long,
+        const float *, const int, const int, const long,
+        float *, const long, const int, const ACSAGemmMode);
 template void outByTransform<float>(float *, const float *,
         const int, const int, const int, const int,
-        const int, const int);
-template ACSAStatus ACSAWinoConvolution_6x3<float>(const float *, const float *, float *,
+        ACSATailMessage *, const int, const int, const long,
+        const float *, const float, const float);
+template void outByTransformPool<float>(float *, const float *,
+        const int, const int, const int, const int,
+        ACSATailMessage *, const int, const int, const long,
+        const float *, const float, const float);
+template void bridgeStride<float>(ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*, long &, long &, long &);
+template ACSAStatus winoConvolution<float>(const float *, const float *, const long, const ACSAWinoFilter *,
+        float *,
         ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
-        ACSAConvMessage*, ACSAWinoMessage*);
+        ACSAConvMessage*, ACSAWinoMessage*,
+        float *, const long, float *, const long,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoWorkspaceSize_6x3<float>(size_t &,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*);
+template ACSAStatus ACSAWinoConvolution_6x3<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoConvolution_6x3<float>(ACSAHandle *,
+        const float *, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoFilterTransform_6x3<float>(const float *, float *,
+        const int, const int, const long);
+template ACSAStatus ACSAWinoBwdFilter_6x3<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
 
-template inline void transformByBT<double>(double *, double *, int);
+template inline void transformByBT<double>(double *, double *, int, const long);
 template inline void transformByBT_first(double *, double *);
-template inline void transformByBT_second(double *, double *, int);
+template inline void transformByBT_second(double *, double *, int, const long);
 template inline void transformByAT_first(double *, double *);
-template inline void transformByAT_second(double *, double *, int, int, int);
+template inline void transformByAT_second(double *, double *, int, int, int,
+        const double, const double, const double);
 template void inByTransform_nopad<double>(const double *, double *,
         const int, const int, const int, const int,
-        const int, const int);
-#if 0
+        const int, const int, const long);
 template void inByTransform_pad<double>(const double *, double *,
         const int, const int, const int, const int,
         const int, const int,
-        const int, const int);
-template void inByTransform_padBigScale<double>(const double *, double *,
-        const int, const int, const int, const int,
-        const int, const int,
-        const int, const int);
-template void inByTransform_padSmallScale<double>(const double *, double *, double *,
-        const int, const int, const int, const int,
-        const int, const int,
-        const int, const int);
-#endif
+        ACSATailMessage *, const int, const int, const long);
 template void filterByTransform<double>(const double *, double *,
-        const int, const int);
-template void matrix_compute<double>(const double *, const int, const int,
-        const double *, const int, const int,
-        double *, const int);
+        const int, const int, const long);
+template void matrix_compute<double>(const double *, const int, const int, const long,
+        const double *, const int, const int, const long,
+        double *, const long, const int, const ACSAGemmMode);
 template void outByTransform<double>(double *, const double *,
         const int, const int, const int, const int,
-        const int, const int);
-template ACSAStatus ACSAWinoConvolution_6x3<double>(const double *, const double *, double *,
+        ACSATailMessage *, const int, const int, const long,
+        const double *, const double, const double);
+template void outByTransformPool<double>(double *, const double *,
+        const int, const int, const int, const int,
+        ACSATailMessage *, const int, const int, const long,
+        const double *, const double, const double);
+template void bridgeStride<double>(ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*, long &, long &, long &);
+template ACSAStatus winoConvolution<double>(const double *, const double *, const long, const ACSAWinoFilter *,
+        double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        double *, const long, double *, const long,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoWorkspaceSize_6x3<double>(size_t &,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*);
+template ACSAStatus ACSAWinoConvolution_6x3<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoConvolution_6x3<double>(ACSAHandle *,
+        const double *, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoFilterTransform_6x3<double>(const double *, double *,
+        const int, const int, const long);
+template ACSAStatus ACSAWinoBwdFilter_6x3<double>(ACSAHandle *,
+        const double *, const double *, double *,
         ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
-        ACSAConvMessage*, ACSAWinoMessage*);
+        ACSAConvMessage*);
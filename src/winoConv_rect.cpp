@@ -0,0 +1,902 @@
+/* F(2x2,5x5), F(4x4,5x5), F(5x5,3x3), F(8x8,3x3) and 1D F(4,3) implementations for winograd.
+ * A tile is TH x TW with TH = M_H+R_H-1 and TW = M_W+R_W-1, rows and columns
+ * transform by their own matrixes. The 1D algorithm runs F(1x4,1x3) for 1x3
+ * filters and F(4x1,3x1) for 3x1 filters, the other axis uses F(1,1) = [1].
+ * The matrixes are generated from the Cook-Toom points by ACSAWinoCookToom,
+ * a new F(m,r) is one more CookToom<m, r> and its APIs. The transforms loop
+ * over the matrixes and skip their zeros, instead of the unrolled macros of
+ * the 3x3 algorithms.
+ * */
+
+#include "dnn.hpp"
+
+
+/* AT-G-BT of F(M,R), filled when the library loads.
+ * dim-AT: M, TILE
+ * dim-G : TILE, R
+ * dim-BT: TILE, TILE
+ */
+template<int M, int R>
+struct CookToom {
+    float AT[M*(M+R-1)];
+    float G[(M+R-1)*R];
+    float BT[(M+R-1)*(M+R-1)];
+
+    CookToom() { ACSAWinoCookToom(M, R, AT, G, BT); }
+};
+
+static const CookToom<2, 5> F_2x5;
+static const CookToom<4, 5> F_4x5;
+static const CookToom<4, 3> F_4x3;
+static const CookToom<5, 3> F_5x3;
+static const CookToom<8, 3> F_8x3;
+
+/* Transform of the axis a 1D algorithm doesn't tile. */
+static const CookToom<1, 1> F_1x1;
+
+/* y = Mh * x * Mw^T for one tile, x is XH x XW, Mh is YH x XH and Mw is YW x XW. */
+template<typename Dtype, int YH, int XH, int YW, int XW>
+static inline void tileTransform(const float *Mh, const float *Mw, const Dtype *x, Dtype *y)
+{
+    int i, j, k;
+    Dtype bridge[YH*XW];
+
+    for(i = 0; i < YH; i++)
+        for(j = 0; j < XW; j++)
+            bridge[i*XW + j] = 0;
+    for(i = 0; i < YH; i++)
+        for(k = 0; k < XH; k++){
+            const Dtype a = Mh[i*XH + k];
+            if(a == 0)
+                continue;
+            for(j = 0; j < XW; j++)
+                bridge[i*XW + j] += a*x[k*XW + j];
+        }
+
+    for(i = 0; i < YH*YW; i++)
+        y[i] = 0;
+    for(j = 0; j < YW; j++)
+        for(k = 0; k < XW; k++){
+            const Dtype a = Mw[j*XW + k];
+            if(a == 0)
+                continue;
+            for(i = 0; i < YH; i++)
+                y[i*YW + j] += a*bridge[i*XW + k];
+        }
+}
+
+/* Compute the bridge data for input, and transform to form matrix A.
+ * Tiles inside the input are read directly, the ones over the pad or the
+ * tail are gathered with zeros.
+ * */
+    template<typename Dtype, int M_H, int R_H, int M_W, int R_W>
+static void inByTransform(const float *BTh, const float *BTw, const Dtype *in, Dtype *dataDst,
+        const int N, const int C, const int rows, const int cols,
+        const int pad_h, const int pad_w, const int outHeight, const int outWidth,
+        const int ntiles, const int mg, const long istride)
+{
+    const int TH = M_H+R_H-1;
+    const int TW = M_W+R_W-1;
+    int d1;
+    int sizeI = rows*cols;
+
+#pragma omp parallel for private(d1)
+    for(d1 = 0; d1 < N*C; d1++){
+        int i, j, u, v, p;
+        Dtype tmp[TH*TW] __attribute__((aligned(64)));
+        Dtype bridge[TH*TW] __attribute__((aligned(64)));
+
+        const int t1 = d1/(C*mg);
+        const int t2 = (d1%(C*mg))/mg;
+        const int t3 = d1%mg;
+
+        // merge value influence the sequence of in data.
+        const Dtype *data = in + (t1*mg*C + t3*C + t2)*sizeI;
+        int tileCount = d1*ntiles;
+
+        for(i = 0; i < outHeight; i += M_H){
+            const int r_init = i - pad_h;
+            for(j = 0; j < outWidth; j += M_W){
+                const int c_init = j - pad_w;
+                if(r_init >= 0 && r_init+TH <= rows && c_init >= 0 && c_init+TW <= cols){
+                    for(u = 0; u < TH; u++)
+                        for(v = 0; v < TW; v++)
+                            tmp[u*TW + v] = data[(r_init+u)*cols + c_init+v];
+                }
+                else{
+                    for(u = 0; u < TH; u++)
+                        for(v = 0; v < TW; v++){
+                            const int r = r_init+u;
+                            const int s = c_init+v;
+                            tmp[u*TW + v] = (r >= 0 && r < rows && s >= 0 && s < cols) ?
+                                data[r*cols + s] : (Dtype)0;
+                        }
+                }
+
+                tileTransform<Dtype, TH, TH, TW, TW>(BTh, BTw, tmp, bridge);
+                for(p = 0; p < TH*TW; p++)
+                    dataDst[tileCount + p*istride] = bridge[p];
+                tileCount++;
+            }
+        }
+    }
+}
+
+/* Kernel compute for bridge data by sgemm, all points of every batch as one batched gemm. */
+    template<typename Dtype>
+static void matrix_compute(const Dtype *in, const int irows, const int icols, const long istride,
+        const Dtype *filter, const int frows, const int fcols, const long fstride,
+        Dtype *out, const long ostride,
+        const int points, const int batch, const ACSAGemmMode gemm)
+{
+    if(gemm == ACSA_GEMM_KERNEL)
+        ACSAWinoGemm(in, irows, icols, istride, filter, fcols, fstride, out, ostride, points, batch);
+    else
+        ACSABatchGemm(in, irows, icols, istride, filter, fcols, fstride, out, ostride, points, batch);
+}
+
+/* Compute the bridge data for out, and transform to form matrix C.
+ * With pool set out holds the 2x2 max pooling of the output.
+ * */
+    template<typename Dtype, int M_H, int R_H, int M_W, int R_W>
+static void outByTransform(const float *ATh, const float *ATw, Dtype *out, const Dtype *dataSrc,
+        const int N, const int K, const int rows, const int cols,
+        const int ntiles, const int mg, const long ostride, const int pool,
+        const Dtype *bias, const Dtype slope, const Dtype ceil)
+{
+    const int TH = M_H+R_H-1;
+    const int TW = M_W+R_W-1;
+    int d1;
+    const int ocols = pool ? cols/2 : cols;
+    const int sizeO = pool ? (rows/2)*(cols/2) : rows*cols;
+
+#pragma omp parallel for private(d1)
+    for(d1 = 0; d1 < N*K; d1++){
+        int i, j, u, v, p;
+        Dtype tmp[TH*TW] __attribute__((aligned(64)));
+        Dtype middle[M_H*M_W] __attribute__((aligned(64)));
+
+        const int t1 = d1/(K*mg);
+        const int t2 = (d1%(K*mg))/mg;
+        const int t3 = d1%mg;
+
+        Dtype *dataDst = out + (t1*mg*K + t3*K + t2)*sizeO;
+
+        const Dtype bk = (bias == NULL) ? (Dtype)0 : bias[t2];
+        int tileCount = d1*ntiles;
+
+        for(i = 0; i < rows; i += M_H){
+            const int r_out = std::min(M_H, rows-i);
+            for(j = 0; j < cols; j += M_W){
+                const int c_out = std::min(M_W, cols-j);
+                for(p = 0; p < TH*TW; p++)
+                    tmp[p] = dataSrc[tileCount + p*ostride];
+
+                tileTransform<Dtype, M_H, TH, M_W, TW>(ATh, ATw, tmp, middle);
+                ACSAActivateTile(middle, M_H*M_W, bk, slope, ceil);
+
+                if(!pool)
+                    for(u = 0; u < r_out; u++)
+                        for(v = 0; v < c_out; v++)
+                            dataDst[(i+u)*cols + j+v] = middle[u*M_W + v];
+                // Even tiles only, the branch is compiled out of the 1D and F(5,3) ones
+                else if(M_H%2 == 0 && M_W%2 == 0)
+                    ACSAPoolTileMax(dataDst, middle, M_W, r_out, c_out, i, j, ocols);
+                tileCount++;
+            }
+        }
+    }
+}
+
+/* Compute the stride of every transform point for bridge data. */
+    template<typename Dtype, int M_H, int M_W>
+static void bridgeStride(ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess, long &istride, long &fstride, long &ostride)
+{
+    const int N = tensorIn->n_;
+    const int C = tensorIn->c_;
+    const int K = tensorFilter->n_;
+    const int ntiles = ((tensorOut->h_+M_H-1)/M_H) * ((tensorOut->w_+M_W-1)/M_W);
+
+    int b_bts = winoMess->batch_block_;
+    if(b_bts == 0 || b_bts > N)
+        b_bts = N;
+
+    // Depthwise keeps no bridge data, only the transformed filters
+    if(ACSAIsDepthwise(tensorIn, tensorFilter)){
+        istride = ostride = 0;
+        fstride = no4k_aligned((long)K, sizeof(Dtype));
+        return;
+    }
+
+    // The fused pipeline keeps its blocks after the filter, see ACSAWinoPipelineBytes
+    if(ACSAWinoFused(tensorIn, tensorOut, winoMess)){
+        istride = ostride = 0;
+        fstride = no4k_aligned((long)C*K, sizeof(Dtype));
+        return;
+    }
+
+    istride = no4k_aligned((long)b_bts*ntiles*C, sizeof(Dtype));
+    fstride = no4k_aligned((long)C*K, sizeof(Dtype));
+    ostride = no4k_aligned((long)b_bts*ntiles*K, sizeof(Dtype));
+}
+
+/* Winograd F(M_H x M_W, R_H x R_W) with the filter already transformed. */
+    template<typename Dtype, int M_H, int R_H, int M_W, int R_W>
+static ACSAStatus winoConvolution(const float *BTh, const float *ATh, const float *BTw, const float *ATw,
+        const Dtype *in, const Dtype *wino_filter, const long fstride, const ACSAWinoFilter *wfilter,
+        Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        Dtype *wino_in, const long istride, Dtype *wino_out, const long ostride,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    // Depthwise has no gemm, the element-wise kernel takes any schedule and layout
+    if(ACSAIsDepthwise(tensorIn, tensorFilter))
+        return ACSAWinoDepthwiseRect<Dtype, M_H, R_H, M_W, R_W>(BTh, ATh, BTw, ATw,
+                in, wino_filter, fstride, out,
+                tensorIn, tensorFilter, tensorOut, convMess,
+                bias, activMess, poolMess);
+
+    // Only the fused pipeline reads and writes layouts other than NCHW or 16-bit bridges,
+    // its blocks take the place of wino_out
+    if(ACSAWinoFused(tensorIn, tensorOut, winoMess))
+        return ACSAWinoPipelineRect<Dtype, M_H, R_H, M_W, R_W>(BTh, ATh, BTw, ATw,
+                in, wino_filter, fstride, wfilter, out,
+                tensorIn, tensorFilter, tensorOut, convMess, winoMess, (void *)wino_out,
+                bias, activMess, poolMess);
+
+    const int P = (M_H+R_H-1)*(M_W+R_W-1);
+    const int N = tensorIn->n_;
+    const int C = tensorIn->c_;
+    const int H = tensorIn->h_;
+    const int W = tensorIn->w_;
+    const int K = tensorFilter->n_;
+    const int pad_h = convMess->pad_h_;
+    const int pad_w = convMess->pad_w_;
+    const int outHeight = tensorOut->h_;
+    const int outWidth = tensorOut->w_;
+    const int ntiles = ((outHeight+M_H-1)/M_H) * ((outWidth+M_W-1)/M_W);
+
+    Dtype slope, ceil;
+    ACSAActivParam(activMess, slope, ceil);
+
+    int b_bts = winoMess->batch_block_;
+    if(b_bts == 0 || b_bts > N)
+        b_bts = N;
+
+    // Check
+    ACSA_CHECK(((tensorFilter->h_ == R_H) && (tensorFilter->w_ == R_W)));
+    ACSA_CHECK(((outHeight == H+2*pad_h-R_H+1) && (outWidth == W+2*pad_w-R_W+1)));
+    if(poolMess != NULL){
+        if(M_H != M_W || M_H%2 != 0){
+            ACSA_MESSAGE("ERROR: Odd output tiles can not fuse pooling!\n");
+            return ACSAFAIL;
+        }
+        ACSA_CHECK(ACSAPoolFusible(poolMess, outHeight, outWidth));
+    }
+
+    /* Pooled plane is a quarter of the convolution output. */
+    const int sizeO = (poolMess == NULL) ? outHeight*outWidth : (outHeight/2)*(outWidth/2);
+
+    for(int i = 0; i < N; i += b_bts){
+        // The last block takes the rest of the batch, and the merge
+        // falls back to 1 if it doesn't divide that block.
+        const int nb = std::min(b_bts, N-i);
+        const int mg = (nb%winoMess->merge_ == 0) ? winoMess->merge_ : 1;
+
+        inByTransform<Dtype, M_H, R_H, M_W, R_W>(BTh, BTw, in + (long)i*C*H*W, wino_in, nb, C, H, W,
+                pad_h, pad_w, outHeight, outWidth, ntiles, mg, istride);
+        matrix_compute(wino_in, mg*ntiles, C, istride, wino_filter, C, K, fstride, wino_out, ostride,
+                P, nb/mg, winoMess->gemm_);
+        outByTransform<Dtype, M_H, R_H, M_W, R_W>(ATh, ATw, out + (long)i*K*sizeO, wino_out, nb, K,
+                outHeight, outWidth, ntiles, mg, ostride, poolMess != NULL, bias, slope, ceil);
+    }
+
+    return ACSASUCCESS;
+}
+
+/* Shared body of the APIs: transform the filter into the workspace and convolve. */
+    template<typename Dtype, int M_H, int R_H, int M_W, int R_W>
+static ACSAStatus rectConvolution(const float *BTh, const float *ATh, const float *Gh,
+        const float *BTw, const float *ATw, const float *Gw,
+        ACSAHandle *handle, const Dtype *in, const Dtype *filter, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    const int P = (M_H+R_H-1)*(M_W+R_W-1);
+    const int C = tensorFilter->c_;
+    const int K = tensorFilter->n_;
+    long istride, fstride, ostride;
+
+    bridgeStride<Dtype, M_H, M_W>(tensorIn, tensorFilter, tensorOut, winoMess, istride, fstride, ostride);
+
+    Dtype *wino_in = (Dtype *)ACSAReserveWorkspace(handle, P*(istride+fstride+ostride)*sizeof(Dtype) +
+            ACSAWinoPipelineBytes<Dtype>(M_H, M_W, tensorIn, tensorFilter, tensorOut, winoMess, handle->num_threads_));
+    if(wino_in == NULL)
+        return ACSAFAIL;
+    Dtype *wino_filter = wino_in + P*istride;
+    Dtype *wino_out = wino_filter + P*fstride;
+
+    const int nthreads = omp_get_max_threads();
+    omp_set_num_threads(handle->num_threads_);
+    if(wfilter == NULL)
+        ACSAWinoFilterRect<Dtype, M_H, R_H, M_W, R_W>(Gh, Gw, filter, wino_filter, C, K, fstride);
+    else{
+        wino_filter = (Dtype *)wfilter->data_;
+        fstride = wfilter->stride_;
+    }
+    ACSAStatus ret = winoConvolution<Dtype, M_H, R_H, M_W, R_W>(BTh, ATh, BTw, ATw,
+            in, (const Dtype *)wino_filter, fstride, wfilter, out,
+            tensorIn, tensorFilter, tensorOut, convMess, winoMess,
+            wino_in, istride, wino_out, ostride,
+            bias, activMess, poolMess);
+    omp_set_num_threads(nthreads);
+
+    return ret;
+}
+
+/* Bytes of workspace needed by winograd F(2,5). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_2x5(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess)
+{
+    long istride, fstride, ostride;
+
+    bridgeStride<Dtype, 2, 2>(tensorIn, tensorFilter, tensorOut, winoMess, istride, fstride, ostride);
+    size = 36*(istride+fstride+ostride)*sizeof(Dtype) +
+        ACSAWinoPipelineBytes<Dtype>(2, 2, tensorIn, tensorFilter, tensorOut, winoMess, omp_get_max_threads());
+
+    return ACSASUCCESS;
+}
+
+/* API for winograd F(2,5). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_2x5(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    return rectConvolution<Dtype, 2, 5, 2, 5>(F_2x5.BT, F_2x5.AT, F_2x5.G, F_2x5.BT, F_2x5.AT, F_2x5.G,
+            handle, in, filter, NULL, out, tensorIn, tensorFilter, tensorOut,
+            convMess, winoMess, bias, activMess, poolMess);
+}
+
+/* API for winograd F(2,5) with the pre-transformed filter. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_2x5(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    // Check
+    ACSA_CHECK((wfilter->algo_ == ACSA_WINOGRAD_2X5));
+    ACSA_CHECK(((wfilter->c_*convMess->groups_ == tensorIn->c_) && (wfilter->k_ == tensorFilter->n_)));
+    if(!ACSAWinoFilterFits<Dtype>(wfilter, winoMess)){
+        ACSA_MESSAGE("ERROR: The filter was transformed for another type or bridge!");
+        return ACSAFAIL;
+    }
+
+    return rectConvolution<Dtype, 2, 5, 2, 5>(F_2x5.BT, F_2x5.AT, F_2x5.G, F_2x5.BT, F_2x5.AT, F_2x5.G,
+            handle, in, NULL, wfilter, out, tensorIn, tensorFilter, tensorOut,
+            convMess, winoMess, bias, activMess, poolMess);
+}
+
+/* Transform the filter of F(2,5) into the layout of bridge data. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoFilterTransform_2x5(const Dtype *filter, Dtype *wino_filter,
+        const int C, const int K, const long fstride)
+{
+    return ACSAWinoFilterRect<Dtype, 2, 5, 2, 5>(F_2x5.G, F_2x5.G, filter, wino_filter, C, K, fstride);
+}
+
+/* Filter gradient of winograd F(2,5). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoBwdFilter_2x5(ACSAHandle *handle,
+        const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess)
+{
+    return ACSAWinoBwdFilterRect<Dtype, 2, 5, 2, 5>(F_2x5.BT, F_2x5.AT, F_2x5.G, F_2x5.BT, F_2x5.AT, F_2x5.G,
+            handle, in, diffOut, diffFilter, tensorIn, tensorFilter, tensorOut, convMess);
+}
+
+/* Bytes of workspace needed by winograd F(4,5). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_4x5(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess)
+{
+    long istride, fstride, ostride;
+
+    bridgeStride<Dtype, 4, 4>(tensorIn, tensorFilter, tensorOut, winoMess, istride, fstride, ostride);
+    size = 64*(istride+fstride+ostride)*sizeof(Dtype) +
+        ACSAWinoPipelineBytes<Dtype>(4, 4, tensorIn, tensorFilter, tensorOut, winoMess, omp_get_max_threads());
+
+    return ACSASUCCESS;
+}
+
+/* API for winograd F(4,5). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_4x5(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    return rectConvolution<Dtype, 4, 5, 4, 5>(F_4x5.BT, F_4x5.AT, F_4x5.G, F_4x5.BT, F_4x5.AT, F_4x5.G,
+            handle, in, filter, NULL, out, tensorIn, tensorFilter, tensorOut,
+            convMess, winoMess, bias, activMess, poolMess);
+}
+
+/* API for winograd F(4,5) with the pre-transformed filter. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_4x5(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    // Check
+    ACSA_CHECK((wfilter->algo_ == ACSA_WINOGRAD_4X5));
+    ACSA_CHECK(((wfilter->c_*convMess->groups_ == tensorIn->c_) && (wfilter->k_ == tensorFilter->n_)));
+    if(!ACSAWinoFilterFits<Dtype>(wfilter, winoMess)){
+        ACSA_MESSAGE("ERROR: The filter was transformed for another type or bridge!");
+        return ACSAFAIL;
+    }
+
+    return rectConvolution<Dtype, 4, 5, 4, 5>(F_4x5.BT, F_4x5.AT, F_4x5.G, F_4x5.BT, F_4x5.AT, F_4x5.G,
+            handle, in, NULL, wfilter, out, tensorIn, tensorFilter, tensorOut,
+            convMess, winoMess, bias, activMess, poolMess);
+}
+
+/* Transform the filter of F(4,5) into the layout of bridge data. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoFilterTransform_4x5(const Dtype *filter, Dtype *wino_filter,
+        const int C, const int K, const long fstride)
+{
+    return ACSAWinoFilterRect<Dtype, 4, 5, 4, 5>(F_4x5.G, F_4x5.G, filter, wino_filter, C, K, fstride);
+}
+
+/* Filter gradient of winograd F(4,5). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoBwdFilter_4x5(ACSAHandle *handle,
+        const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess)
+{
+    return ACSAWinoBwdFilterRect<Dtype, 4, 5, 4, 5>(F_4x5.BT, F_4x5.AT, F_4x5.G, F_4x5.BT, F_4x5.AT, F_4x5.G,
+            handle, in, diffOut, diffFilter, tensorIn, tensorFilter, tensorOut, convMess);
+}
+
+/* Bytes of workspace needed by winograd F(5,3). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_5x3(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess)
+{
+    long istride, fstride, ostride;
+
+    bridgeStride<Dtype, 5, 5>(tensorIn, tensorFilter, tensorOut, winoMess, istride, fstride, ostride);
+    size = 49*(istride+fstride+ostride)*sizeof(Dtype) +
+        ACSAWinoPipelineBytes<Dtype>(5, 5, tensorIn, tensorFilter, tensorOut, winoMess, omp_get_max_threads());
+
+    return ACSASUCCESS;
+}
+
+/* API for winograd F(5,3). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_5x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    return rectConvolution<Dtype, 5, 3, 5, 3>(F_5x3.BT, F_5x3.AT, F_5x3.G, F_5x3.BT, F_5x3.AT, F_5x3.G,
+            handle, in, filter, NULL, out, tensorIn, tensorFilter, tensorOut,
+            convMess, winoMess, bias, activMess, poolMess);
+}
+
+/* API for winograd F(5,3) with the pre-transformed filter. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_5x3(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    // Check
+    ACSA_CHECK((wfilter->algo_ == ACSA_WINOGRAD_5X3));
+    ACSA_CHECK(((wfilter->c_*convMess->groups_ == tensorIn->c_) && (wfilter->k_ == tensorFilter->n_)));
+    if(!ACSAWinoFilterFits<Dtype>(wfilter, winoMess)){
+        ACSA_MESSAGE("ERROR: The filter was transformed for another type or bridge!");
+        return ACSAFAIL;
+    }
+
+    return rectConvolution<Dtype, 5, 3, 5, 3>(F_5x3.BT, F_5x3.AT, F_5x3.G, F_5x3.BT, F_5x3.AT, F_5x3.G,
+            handle, in, NULL, wfilter, out, tensorIn, tensorFilter, tensorOut,
+            convMess, winoMess, bias, activMess, poolMess);
+}
+
+/* Transform the filter of F(5,3) into the layout of bridge data. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoFilterTransform_5x3(const Dtype *filter, Dtype *wino_filter,
+        const int C, const int K, const long fstride)
+{
+    return ACSAWinoFilterRect<Dtype, 5, 3, 5, 3>(F_5x3.G, F_5x3.G, filter, wino_filter, C, K, fstride);
+}
+
+/* Filter gradient of winograd F(5,3). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoBwdFilter_5x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess)
+{
+    return ACSAWinoBwdFilterRect<Dtype, 5, 3, 5, 3>(F_5x3.BT, F_5x3.AT, F_5x3.G, F_5x3.BT, F_5x3.AT, F_5x3.G,
+            handle, in, diffOut, diffFilter, tensorIn, tensorFilter, tensorOut, convMess);
+}
+
+/* Bytes of workspace needed by winograd F(8,3). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_8x3(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess)
+{
+    long istride, fstride, ostride;
+
+    bridgeStride<Dtype, 8, 8>(tensorIn, tensorFilter, tensorOut, winoMess, istride, fstride, ostride);
+    size = 100*(istride+fstride+ostride)*sizeof(Dtype) +
+        ACSAWinoPipelineBytes<Dtype>(8, 8, tensorIn, tensorFilter, tensorOut, winoMess, omp_get_max_threads());
+
+    return ACSASUCCESS;
+}
+
+/* API for winograd F(8,3). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_8x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    return rectConvolution<Dtype, 8, 3, 8, 3>(F_8x3.BT, F_8x3.AT, F_8x3.G, F_8x3.BT, F_8x3.AT, F_8x3.G,
+            handle, in, filter, NULL, out, tensorIn, tensorFilter, tensorOut,
+            convMess, winoMess, bias, activMess, poolMess);
+}
+
+/* API for winograd F(8,3) with the pre-transformed filter. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_8x3(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    // Check
+    ACSA_CHECK((wfilter->algo_ == ACSA_WINOGRAD_8X3));
+    ACSA_CHECK(((wfilter->c_*convMess->groups_ == tensorIn->c_) && (wfilter->k_ == tensorFilter->n_)));
+    if(!ACSAWinoFilterFits<Dtype>(wfilter, winoMess)){
+        ACSA_MESSAGE("ERROR: The filter was transformed for another type or bridge!");
+        return ACSAFAIL;
+    }
+
+    return rectConvolution<Dtype, 8, 3, 8, 3>(F_8x3.BT, F_8x3.AT, F_8x3.G, F_8x3.BT, F_8x3.AT, F_8x3.G,
+            handle, in, NULL, wfilter, out, tensorIn, tensorFilter, tensorOut,
+            convMess, winoMess, bias, activMess, poolMess);
+}
+
+/* Transform the filter of F(8,3) into the layout of bridge data. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoFilterTransform_8x3(const Dtype *filter, Dtype *wino_filter,
+        const int C, const int K, const long fstride)
+{
+    return ACSAWinoFilterRect<Dtype, 8, 3, 8, 3>(F_8x3.G, F_8x3.G, filter, wino_filter, C, K, fstride);
+}
+
+/* Filter gradient of winograd F(8,3). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoBwdFilter_8x3(ACSAHandle *handle,
+        const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess)
+{
+    return ACSAWinoBwdFilterRect<Dtype, 8, 3, 8, 3>(F_8x3.BT, F_8x3.AT, F_8x3.G, F_8x3.BT, F_8x3.AT, F_8x3.G,
+            handle, in, diffOut, diffFilter, tensorIn, tensorFilter, tensorOut, convMess);
+}
+
+/* Bytes of workspace needed by winograd 1D F(4,3), the tiles run along the long side of the filter. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_4x3_1d(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess)
+{
+    long istride, fstride, ostride;
+
+    if(tensorFilter->h_ == 1){
+        bridgeStride<Dtype, 1, 4>(tensorIn, tensorFilter, tensorOut, winoMess, istride, fstride, ostride);
+        size = ACSAWinoPipelineBytes<Dtype>(1, 4, tensorIn, tensorFilter, tensorOut, winoMess, omp_get_max_threads());
+    }
+    else{
+        bridgeStride<Dtype, 4, 1>(tensorIn, tensorFilter, tensorOut, winoMess, istride, fstride, ostride);
+        size = ACSAWinoPipelineBytes<Dtype>(4, 1, tensorIn, tensorFilter, tensorOut, winoMess, omp_get_max_threads());
+    }
+    size += 6*(istride+fstride+ostride)*sizeof(Dtype);
+
+    return ACSASUCCESS;
+}
+
+/* API for winograd 1D F(4,3), F(1x4,1x3) for 1x3 filters and F(4x1,3x1) for 3x1 filters. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_4x3_1d(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    if(tensorFilter->h_ == 1)
+        return rectConvolution<Dtype, 1, 1, 4, 3>(F_1x1.BT, F_1x1.AT, F_1x1.G, F_4x3.BT, F_4x3.AT, F_4x3.G,
+                handle, in, filter, NULL, out, tensorIn, tensorFilter, tensorOut,
+                convMess, winoMess, bias, activMess, poolMess);
+    else
+        return rectConvolution<Dtype, 4, 3, 1, 1>(F_4x3.BT, F_4x3.AT, F_4x3.G, F_1x1.BT, F_1x1.AT, F_1x1.G,
+                handle, in, filter, NULL, out, tensorIn, tensorFilter, tensorOut,
+                convMess, winoMess, bias, activMess, poolMess);
+}
+
+/* API for winograd 1D F(4,3) with the pre-transformed filter. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolution_4x3_1d(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    // Check
+    ACSA_CHECK((wfilter->algo_ == ACSA_WINOGRAD_4X3_1D));
+    ACSA_CHECK(((wfilter->c_*convMess->groups_ == tensorIn->c_) && (wfilter->k_ == tensorFilter->n_)));
+    if(!ACSAWinoFilterFits<Dtype>(wfilter, winoMess)){
+        ACSA_MESSAGE("ERROR: The filter was transformed for another type or bridge!");
+        return ACSAFAIL;
+    }
+
+    if(tensorFilter->h_ == 1)
+        return rectConvolution<Dtype, 1, 1, 4, 3>(F_1x1.BT, F_1x1.AT, F_1x1.G, F_4x3.BT, F_4x3.AT, F_4x3.G,
+                handle, in, NULL, wfilter, out, tensorIn, tensorFilter, tensorOut,
+                convMess, winoMess, bias, activMess, poolMess);
+    else
+        return rectConvolution<Dtype, 4, 3, 1, 1>(F_4x3.BT, F_4x3.AT, F_4x3.G, F_1x1.BT, F_1x1.AT, F_1x1.G,
+                handle, in, NULL, wfilter, out, tensorIn, tensorFilter, tensorOut,
+                convMess, winoMess, bias, activMess, poolMess);
+}
+
+/* Transform the 1x3 (vertical = 0) or 3x1 (vertical = 1) filter of 1D F(4,3). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoFilterTransform_4x3_1d(const Dtype *filter, Dtype *wino_filter,
+        const int C, const int K, const long fstride, const int vertical)
+{
+    if(!vertical)
+        return ACSAWinoFilterRect<Dtype, 1, 1, 4, 3>(F_1x1.G, F_4x3.G, filter, wino_filter, C, K, fstride);
+    else
+        return ACSAWinoFilterRect<Dtype, 4, 3, 1, 1>(F_4x3.G, F_1x1.G, filter, wino_filter, C, K, fstride);
+}
+
+/* Filter gradient of winograd 1D F(4,3). */
+    template<typename Dtype>
+ACSAStatus ACSAWinoBwdFilter_4x3_1d(ACSAHandle *handle,
+        const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess)
+{
+    if(tensorFilter->h_ == 1)
+        return ACSAWinoBwdFilterRect<Dtype, 1, 1, 4, 3>(F_1x1.BT, F_1x1.AT, F_1x1.G, F_4x3.BT, F_4x3.AT, F_4x3.G,
+                handle, in, diffOut, diffFilter, tensorIn, tensorFilter, tensorOut, convMess);
+    else
+        return ACSAWinoBwdFilterRect<Dtype, 4, 3, 1, 1>(F_4x3.BT, F_4x3.AT, F_4x3.G, F_1x1.BT, F_1x1.AT, F_1x1.G,
+                handle, in, diffOut, diffFilter, tensorIn, tensorFilter, tensorOut, convMess);
+}
+
+/* Instantiate Template */
+template ACSAStatus ACSAWinoWorkspaceSize_2x5<float>(size_t &,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*);
+template ACSAStatus ACSAWinoConvolution_2x5<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoConvolution_2x5<float>(ACSAHandle *,
+        const float *, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoFilterTransform_2x5<float>(const float *, float *,
+        const int, const int, const long);
+template ACSAStatus ACSAWinoBwdFilter_2x5<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+
+template ACSAStatus ACSAWinoWorkspaceSize_4x5<float>(size_t &,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*);
+template ACSAStatus ACSAWinoConvolution_4x5<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoConvolution_4x5<float>(ACSAHandle *,
+        const float *, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoFilterTransform_4x5<float>(const float *, float *,
+        const int, const int, const long);
+template ACSAStatus ACSAWinoBwdFilter_4x5<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+
+template ACSAStatus ACSAWinoWorkspaceSize_5x3<float>(size_t &,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*);
+template ACSAStatus ACSAWinoConvolution_5x3<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoConvolution_5x3<float>(ACSAHandle *,
+        const float *, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoFilterTransform_5x3<float>(const float *, float *,
+        const int, const int, const long);
+template ACSAStatus ACSAWinoBwdFilter_5x3<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+
+template ACSAStatus ACSAWinoWorkspaceSize_8x3<float>(size_t &,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*);
+template ACSAStatus ACSAWinoConvolution_8x3<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoConvolution_8x3<float>(ACSAHandle *,
+        const float *, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoFilterTransform_8x3<float>(const float *, float *,
+        const int, const int, const long);
+template ACSAStatus ACSAWinoBwdFilter_8x3<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+
+template ACSAStatus ACSAWinoWorkspaceSize_4x3_1d<float>(size_t &,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*);
+template ACSAStatus ACSAWinoConvolution_4x3_1d<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoConvolution_4x3_1d<float>(ACSAHandle *,
+        const float *, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoFilterTransform_4x3_1d<float>(const float *, float *,
+        const int, const int, const long, const int);
+template ACSAStatus ACSAWinoBwdFilter_4x3_1d<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+
+template ACSAStatus ACSAWinoWorkspaceSize_2x5<double>(size_t &,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*);
+template ACSAStatus ACSAWinoConvolution_2x5<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoConvolution_2x5<double>(ACSAHandle *,
+        const double *, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoFilterTransform_2x5<double>(const double *, double *,
+        const int, const int, const long);
+template ACSAStatus ACSAWinoBwdFilter_2x5<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+
+template ACSAStatus ACSAWinoWorkspaceSize_4x5<double>(size_t &,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*);
+template ACSAStatus ACSAWinoConvolution_4x5<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoConvolution_4x5<double>(ACSAHandle *,
+        const double *, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoFilterTransform_4x5<double>(const double *, double *,
+        const int, const int, const long);
+template ACSAStatus ACSAWinoBwdFilter_4x5<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+
+template ACSAStatus ACSAWinoWorkspaceSize_5x3<double>(size_t &,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*);
+template ACSAStatus ACSAWinoConvolution_5x3<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoConvolution_5x3<double>(ACSAHandle *,
+        const double *, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoFilterTransform_5x3<double>(const double *, double *,
+        const int, const int, const long);
+template ACSAStatus ACSAWinoBwdFilter_5x3<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+
+template ACSAStatus ACSAWinoWorkspaceSize_8x3<double>(size_t &,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*);
+template ACSAStatus ACSAWinoConvolution_8x3<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoConvolution_8x3<double>(ACSAHandle *,
+        const double *, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoFilterTransform_8x3<double>(const double *, double *,
+        const int, const int, const long);
+template ACSAStatus ACSAWinoBwdFilter_8x3<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+
+template ACSAStatus ACSAWinoWorkspaceSize_4x3_1d<double>(size_t &,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAWinoMessage*);
+template ACSAStatus ACSAWinoConvolution_4x3_1d<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoConvolution_4x3_1d<double>(ACSAHandle *,
+        const double *, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoFilterTransform_4x3_1d<double>(const double *, double *,
+        const int, const int, const long, const int);
+template ACSAStatus ACSAWinoBwdFilter_4x3_1d<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
@@ -0,0 +1,79 @@
+/* Cook-Toom matrixes of winograd F(m,r) from its interpolation points.
+ * The tile of F(m,r) is a = m+r-1, it takes the first a-1 points of
+ * CT_POINTS and the point at infinity, then
+ *   AT[i][j] = p_j^i, column a-1 is the infinity, [0 ... 0 1]^T
+ *   G[i][j]  = p_i^j / N_i, N_i = prod(p_i - p_k) over k != i, row a-1 is [0 ... 0 1]
+ *   BT[i]    = coefficients of prod(x - p_k) over k != i, row a-1 of the product over all k
+ * so Y = AT * [(G * g) .* (BT * d)] is the correlation of d and g.
+ * The points of F(2,5), F(4,5), F(4,3) and the 3x3 family come first in
+ * the order of their tables, 4 and -1/4 follow as the most accurate in fp32
+ * for F(8,3). The matrixes are computed in double, exactly for these points,
+ * and rounded once to float.
+ * */
+
+#include "dnn.hpp"
+
+#define CT_NPOINTS 11
+
+static const double CT_POINTS[CT_NPOINTS] = {
+    0, 1, -1, 2, -2, 1.0/2, -1.0/2, 4, -1.0/4, -4, 1.0/4
+};
+
+/* Generate AT (m x a), G (a x r) and BT (a x a) of F(m,r). */
+ACSAStatus ACSAWinoCookToom(const int m, const int r, float *AT, float *G, float *BT)
+{
+    const int a = m+r-1;
+    const int n = a-1;     // finite points, the last one is the infinity
+    double poly[CT_NPOINTS+1];
+    int i, j, k, d;
+
+    // Check
+    ACSA_CHECK(((m >= 1) && (r >= 1)));
+    if(n > CT_NPOINTS){
+        ACSA_MESSAGE("ERROR: The tile of winograd is too large for the Cook-Toom points!");
+        return ACSAFAIL;
+    }
+
+    for(i = 0; i < m; i++){
+        for(j = 0; j < n; j++){
+            double v = 1;
+            for(k = 0; k < i; k++)
+                v *= CT_POINTS[j];
+            AT[i*a + j] = (float)v;
+        }
+        AT[i*a + n] = (i == m-1) ? 1 : 0;
+    }
+
+    for(i = 0; i < n; i++){
+        double norm = 1, v = 1;
+        for(k = 0; k < n; k++)
+            if(k != i)
+                norm *= CT_POINTS[i] - CT_POINTS[k];
+        for(j = 0; j < r; j++){
+            G[i*r + j] = (float)(v/norm);
+            v *= CT_POINTS[i];
+        }
+    }
+    for(j = 0; j < r; j++)
+        G[n*r + j] = (j == r-1) ? 1 : 0;
+
+    // Row i < n leaves out point i, row n takes all of them
+    for(i = 0; i <= n; i++){
+        poly[0] = 1;
+        for(j = 1; j < a; j++)
+            poly[j] = 0;
+        d = 0;
+        for(k = 0; k < n; k++){
+            if(k == i)
+                continue;
+            for(j = d+1; j > 0; j--)
+                poly[j] = poly[j-1] - CT_POINTS[k]*poly[j];
+            poly[0] = -CT_POINTS[k]*poly[0];
+            d++;
+        }
+        for(j = 0; j < a; j++)
+            BT[i*a + j] = (float)poly[j];
+    }
+
+    return ACSASUCCESS;
+}
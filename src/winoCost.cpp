@@ -0,0 +1,195 @@
+/* Analytic cost model of winograd convolution, it picks the variant of
+ * ACSA_WINOGRAD_AUTO without running anything.
+ * The cost of a variant is the time of its phases in cycles of one core:
+ * flops of the gemm scaled by its shape efficiency, flops of the transforms
+ * and the bytes of bridge data against the bandwidth of the level holding them.
+ * */
+
+#include <unistd.h>
+#include "dnn.hpp"
+
+#define GEMM_FLOPS  32.0    // fp32 flops per cycle of the gemm at full efficiency
+#define TRANS_FLOPS 8.0     // fp32 flops per cycle of the scalar-heavy transforms
+#define CACHE_BW    32.0    // bytes per cycle when the bridge data stays in cache
+#define DRAM_BW     4.0     // bytes per cycle when it goes to memory
+#define DIRECT_EFF  0.5     // efficiency of the direct convolution kernel against the gemm
+#define DIRECT_KB   6       // filters of a register block of the direct convolution
+#define DIRECT_VLEN 16      // a row of the direct convolution is computed in whole vectors
+#define GEMM_EFF    0.6     // efficiency of the gemm on im2col columns against the winograd blocks
+
+struct WinoVariant {
+    ACSAWinogradAlgo algo_;
+    int m_;         // output of one tile is m x m
+    int r_;         // filter is r x r
+    int nnzBT_;     // nonzeros of BT and AT, the transforms skip the zeros
+    int nnzAT_;
+};
+
+static const WinoVariant variants[7] = {
+    {ACSA_WINOGRAD_2X3, 2, 3,  8,  6},
+    {ACSA_WINOGRAD_3X3, 3, 3, 16, 11},
+    {ACSA_WINOGRAD_4X3, 4, 3, 22, 18},
+    {ACSA_WINOGRAD_6X3, 6, 3, 44, 38},
+    {ACSA_WINOGRAD_2X5, 2, 5, 22, 10},
+    {ACSA_WINOGRAD_4X5, 4, 5, 44, 26},
+    {ACSA_WINOGRAD_5X3, 5, 3, 34, 27}
+};
+
+/* Bytes of the cache level, a common size if the system doesn't tell. */
+static double cacheBytes(int name, long dft)
+{
+    long size = sysconf(name);
+
+    return (double)((size > 0) ? size : dft);
+}
+
+/* Estimated cycles of one variant. */
+    template<typename Dtype>
+static double variantCost(const WinoVariant &v,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess)
+{
+    const int N = tensorIn->n_;
+    const double C = tensorIn->c_;
+    const double K = tensorFilter->n_;
+    const double Cg = tensorFilter->c_;     // channels met by one filter, C/groups
+    const double Kg = K*Cg/C;               // filters of one group
+    const bool depthwise = ACSAIsDepthwise(tensorIn, tensorFilter);
+    const int tile = v.m_ + v.r_ - 1;
+    const double P = tile*tile;
+    const int block = (winoMess->batch_block_ == 0 || winoMess->batch_block_ > N) ? N : winoMess->batch_block_;
+    const int merge = (winoMess->merge_ > 0 && block%winoMess->merge_ == 0) ? winoMess->merge_ : 1;
+    const double scale = sizeof(float)/(double)sizeof(Dtype);
+    const bool half = (winoMess->bridge_ != ACSA_BRIDGE_FP32) && (sizeof(Dtype) == sizeof(float));
+    const bool int8 = half && (winoMess->bridge_ == ACSA_BRIDGE_INT8);
+    const double isize = int8 ? 1.0 : (half ? 2.0 : sizeof(Dtype));    // bytes of the transformed input
+    const double mac = int8 ? 2.0 : 1.0;    // the 8-bit dot products double the gemm rate
+
+    /* The tails are computed as whole tiles, as tailPreProcess counts them,
+     * so the waste of a variant shows in every phase.
+     * */
+    const double ntiles = (double)((tensorOut->h_+v.m_-1)/v.m_) * ((tensorOut->w_+v.m_-1)/v.m_);
+
+    // BT*d*B and AT*M*A of one tile
+    const double fin = 4.0*v.nnzBT_*tile;
+    const double fout = 2.0*v.nnzAT_*(tile+v.m_);
+    const double trans = N*ntiles*(C*fin + K*fout);
+
+    // The gemm of a point is (merge*ntiles x Cg) * (Cg x Kg) per group, small sides waste the kernel.
+    // Depthwise multiplies element-wise in full vectors instead.
+    const double rows = merge*ntiles;
+    const double eff = depthwise ? 1.0 : (rows/(rows+32)) * (Cg/(Cg+16)) * (Kg/(Kg+16));
+    const double gemm = 2.0*P*N*ntiles*Cg*K;
+
+    // Bridge data is written and read once, it stays in cache if the block fits,
+    // depthwise keeps its tiles in registers and stack
+    const double bytes = depthwise ? 0.0 : 2.0*P*N*ntiles*(C*isize + K*sizeof(Dtype));
+    const double scratch = P*block*ntiles*(C*isize + K*sizeof(Dtype));
+    const double bw = (winoMess->schedule_ == ACSA_SCHEDULE_FUSED || half ||
+            scratch <= cacheBytes(_SC_LEVEL3_CACHE_SIZE, 32L << 20)) ? CACHE_BW : DRAM_BW;
+
+    return gemm/(GEMM_FLOPS*scale*mac*eff) + trans/(TRANS_FLOPS*scale) + bytes/bw;
+}
+
+/* Estimated cycles of the direct convolution, all nine taps are multiplied
+ * but there is no transform, and the only data moved is the window of the input.
+ * */
+    template<typename Dtype>
+static double directCost(ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut)
+{
+    const double N = tensorIn->n_;
+    const double C = tensorIn->c_;
+    const double K = tensorFilter->n_;
+    const double Cg = tensorFilter->c_;
+    const double OH = tensorOut->h_;
+    const double OW = tensorOut->w_;
+    const double OWp = ((tensorOut->w_+DIRECT_VLEN-1)/DIRECT_VLEN)*DIRECT_VLEN;
+    const double scale = sizeof(float)/(double)sizeof(Dtype);
+
+    // The filters go by blocks, the last one is padded with zeros, and so is the row
+    const double Kp = ((tensorFilter->n_+DIRECT_KB-1)/DIRECT_KB)*DIRECT_KB;
+    const double flops = 2.0*N*OH*OW*Cg*9*K;
+    const double eff = DIRECT_EFF*(K/Kp)*(OW/OWp);
+    const double bytes = N*OH*(OW+2)*C*2*sizeof(Dtype);
+
+    return flops/(GEMM_FLOPS*scale*eff) + bytes/CACHE_BW;
+}
+
+/* Estimated cycles of im2col and gemm, every tap is multiplied, the gemm of an
+ * image and group is (pixels x C/G*R*S) * (C/G*R*S x K/G), and the columns and
+ * the result are written and read back once in cache.
+ * */
+    template<typename Dtype>
+static double gemmCost(ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut)
+{
+    const double N = tensorIn->n_;
+    const double C = tensorIn->c_;
+    const double K = tensorFilter->n_;
+    const double CRS = (double)tensorFilter->c_*tensorFilter->h_*tensorFilter->w_;
+    const double Kg = K*tensorFilter->c_/C;
+    const double pixels = (double)tensorOut->h_*tensorOut->w_;
+    const double scale = sizeof(float)/(double)sizeof(Dtype);
+
+    const double eff = GEMM_EFF * (pixels/(pixels+32)) * (CRS/(CRS+16)) * (Kg/(Kg+16));
+    const double flops = 2.0*N*pixels*CRS*K;
+    const double bytes = 2.0*N*pixels*(C*tensorFilter->h_*tensorFilter->w_ + K)*sizeof(Dtype);
+
+    return flops/(GEMM_FLOPS*scale*eff) + bytes/CACHE_BW;
+}
+
+/* Pick the cheapest variant for the shape. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoSelect(ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess, ACSAPoolMessage *poolMess)
+{
+    double cost, best_cost = std::numeric_limits<double>::max();
+    ACSAWinogradAlgo best = ACSA_WINOGRAD_2X3;
+
+    // The only algorithm of 1x3 and 3x1 filters
+    if(ACSAWinoAlgoFits(ACSA_WINOGRAD_4X3_1D, tensorFilter)){
+        winoMess->algo_ = ACSA_WINOGRAD_4X3_1D;
+        return ACSASUCCESS;
+    }
+
+    for(int i = 0; i < 7; i++){
+        if(!ACSAWinoAlgoFits(variants[i].algo_, tensorFilter))
+            continue;
+        // The INT8 bridge quantizes F(2x3) only
+        if(ACSAWinoInt8<Dtype>(winoMess) && ACSAWinoAlgoFits(ACSA_WINOGRAD_2X3, tensorFilter) &&
+                variants[i].algo_ != ACSA_WINOGRAD_2X3)
+            continue;
+        // Fusing the pooling is not supported by the odd tiles of F(3,3) and F(5,3)
+        if(variants[i].m_%2 != 0 && poolMess != NULL)
+            continue;
+        cost = variantCost<Dtype>(variants[i], tensorIn, tensorFilter, tensorOut, winoMess);
+        if(cost < best_cost){
+            best_cost = cost;
+            best = variants[i].algo_;
+        }
+    }
+
+    // Few channels make thin gemms and a transform for few products, the direct convolution wins there
+    if(ACSAWinoAlgoFits(ACSA_CONV_DIRECT, tensorFilter) && !ACSAIsDepthwise(tensorIn, tensorFilter)){
+        cost = directCost<Dtype>(tensorIn, tensorFilter, tensorOut);
+        if(cost < best_cost){
+            best_cost = cost;
+            best = ACSA_CONV_DIRECT;
+        }
+    }
+
+    // Tiny images and thin layers waste the tiles, the gemm of all taps may be cheaper
+    cost = gemmCost<Dtype>(tensorIn, tensorFilter, tensorOut);
+    if(cost < best_cost){
+        best_cost = cost;
+        best = ACSA_CONV_GEMM;
+    }
+    winoMess->algo_ = best;
+
+    return ACSASUCCESS;
+}
+
+/* Instantiate Template */
+template ACSAStatus ACSAWinoSelect<float>(ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAWinoMessage *, ACSAPoolMessage *);
+template ACSAStatus ACSAWinoSelect<double>(ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAWinoMessage *, ACSAPoolMessage *);
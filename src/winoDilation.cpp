@@ -0,0 +1,237 @@
+/* Dilated convolution by winograd.
+ * With dilation d, output (d*i+u, d*j+v) only reads the padded input at rows
+ * d*(i+a)+u and columns d*(j+b)+v, so the d_h*d_w interleaved sub-images
+ * in(d*i+u, d*j+v) each go through the plain filter. They run as one stride-1
+ * convolution of N*d_h*d_w images, and the outputs are interleaved back.
+ * */
+
+#include "dnn.hpp"
+
+/* Shapes of the interleaved convolution of a dilated layer. */
+void ACSADilationPhaseTensors(ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSATensor4d &phaseIn, ACSATensor4d &phaseOut)
+{
+    const int dh = convMess->dilation_h_;
+    const int dw = convMess->dilation_w_;
+    const int oh = (tensorOut->h_+dh-1)/dh;
+    const int ow = (tensorOut->w_+dw-1)/dw;
+
+    ACSASetTensor4d(phaseIn, tensorIn->n_*dh*dw, tensorIn->c_, oh+tensorFilter->h_-1, ow+tensorFilter->w_-1);
+    ACSASetTensor4d(phaseOut, tensorIn->n_*dh*dw, tensorFilter->n_, oh, ow);
+}
+
+/* Bytes of the sub-images in and out, the convolution of the sub-images takes the workspace after them. */
+template<typename Dtype>
+static size_t phaseBytes(const ACSATensor4d &phaseIn, const ACSATensor4d &phaseOut)
+{
+    return (ACSATensorSize(&phaseIn)*sizeof(Dtype) + 63)/64*64 +
+        (ACSATensorSize(&phaseOut)*sizeof(Dtype) + 63)/64*64;
+}
+
+/* Winograd convolution with dilation, Filter is the raw filter or ACSAWinoFilter.
+ * The sub-images use the filter as it is, so a pre-transformed one works too.
+ * */
+    template<typename Dtype, typename Filter>
+static ACSAStatus dilatedConvolution(ACSAHandle *handle,
+        const Dtype *in, const Filter *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    const int N = tensorIn->n_;
+    const int C = tensorIn->c_;
+    const int H = tensorIn->h_;
+    const int W = tensorIn->w_;
+    const int K = tensorFilter->n_;
+    const int R_H = tensorFilter->h_;
+    const int R_W = tensorFilter->w_;
+    const int pad_h = convMess->pad_h_;
+    const int pad_w = convMess->pad_w_;
+    const int dh = convMess->dilation_h_;
+    const int dw = convMess->dilation_w_;
+    const int outHeight = tensorOut->h_;
+    const int outWidth = tensorOut->w_;
+
+    if(convMess->stride_h_ != 1 || convMess->stride_w_ != 1){
+        ACSA_MESSAGE("ERROR: The dilation only supports stride 1!");
+        return ACSAFAIL;
+    }
+    if(poolMess != NULL && !ACSAPoolFusible(poolMess, outHeight, outWidth)){
+        ACSA_MESSAGE("ERROR: The dilation only fuses the 2x2 pooling of stride 2 on an even output!");
+        return ACSAFAIL;
+    }
+
+    // Check
+    ACSA_CHECK(((outHeight == H+2*pad_h-dh*(R_H-1)) && (outWidth == W+2*pad_w-dw*(R_W-1))));
+
+    ACSATensor4d phaseIn, phaseOut;
+    ACSAConvMessage phaseConv;
+    ACSADilationPhaseTensors(tensorIn, tensorFilter, tensorOut, convMess, phaseIn, phaseOut);
+    ACSASetConvMessage(phaseConv, R_H, R_W, 0, 0, 1, 1);
+    phaseConv.groups_ = convMess->groups_;
+
+    const int PH = phaseIn.h_;
+    const int PW = phaseIn.w_;
+    const int OH = phaseOut.h_;
+    const int OW = phaseOut.w_;
+    const long sizeP = (long)PH*PW;
+    const long sizeO = (long)OH*OW;
+
+    // The size is asked for the threads of handle, the sub-images run by them
+    size_t size;
+    const int nthreads = omp_get_max_threads();
+    omp_set_num_threads(handle->num_threads_);
+    ACSAWinoWorkspaceSize_dilation<Dtype>(size, tensorIn, tensorFilter, tensorOut, convMess, winoMess);
+    omp_set_num_threads(nthreads);
+    char *work = (char *)ACSAReserveWorkspace(handle, size);
+    if(work == NULL)
+        return ACSAFAIL;
+    Dtype *phase_in = (Dtype *)work;
+    Dtype *phase_out = (Dtype *)(work + (ACSATensorSize(&phaseIn)*sizeof(Dtype) + 63)/64*64);
+
+    // The sub-images run in the rest of the workspace, it never grows under them
+    const size_t pbytes = phaseBytes<Dtype>(phaseIn, phaseOut);
+    ACSAHandle phaseHandle = *handle;
+    phaseHandle.workspace_ = work + pbytes;
+    phaseHandle.workspace_size_ = size - pbytes;
+    phaseHandle.own_workspace_ = 0;
+
+    /* Sub-image uv of image n is the image (n*dh + u)*dw + v,
+     * the pad and the rows beyond the input are zero.
+     * */
+    int d1;
+#pragma omp parallel for private(d1) num_threads(handle->num_threads_)
+    for(d1 = 0; d1 < N*C; d1++){
+        const int n = d1/C;
+        const int c = d1%C;
+
+        for(int uv = 0; uv < dh*dw; uv++){
+            Dtype *dst = phase_in + ((long)(n*dh*dw + uv)*C + c)*sizeP;
+            for(int i = 0; i < PH; i++){
+                const int r = dh*i + uv/dw - pad_h;
+                for(int j = 0; j < PW; j++){
+                    const int s = dw*j + uv%dw - pad_w;
+                    dst[i*PW + j] = (r >= 0 && r < H && s >= 0 && s < W) ?
+                        in[ACSATensorOffset(tensorIn, n, c, r, s)] : (Dtype)0;
+                }
+            }
+        }
+    }
+
+    // Bias and activation go with the sub-images, the pooling needs the whole output
+    ACSAStatus ret = ACSAWinoConvolutionFwd(&phaseHandle, (const Dtype *)phase_in, filter, phase_out,
+            &phaseIn, tensorFilter, &phaseOut, &phaseConv, winoMess,
+            bias, activMess, (ACSAPoolMessage *)NULL);
+
+    if(poolMess == NULL){
+#pragma omp parallel for private(d1) num_threads(handle->num_threads_)
+        for(d1 = 0; d1 < N*K; d1++){
+            const int n = d1/K;
+            const int k = d1%K;
+
+            for(int uv = 0; uv < dh*dw; uv++){
+                const Dtype *src = phase_out + ((long)(n*dh*dw + uv)*K + k)*sizeO;
+                for(int i = 0; i < OH && dh*i + uv/dw < outHeight; i++)
+                    for(int j = 0; j < OW && dw*j + uv%dw < outWidth; j++)
+                        out[ACSATensorOffset(tensorOut, n, k, dh*i + uv/dw, dw*j + uv%dw)] = src[i*OW + j];
+            }
+        }
+        return ret;
+    }
+
+    /* Output (r, s) is (r/dh, s/dw) of sub-image (r%dh)*dw + s%dw,
+     * the 2x2 windows are pooled straight from the sub-images.
+     * */
+    ACSATensor4d tensorDst = *tensorOut;
+    tensorDst.h_ = outHeight/2;
+    tensorDst.w_ = outWidth/2;
+#pragma omp parallel for private(d1) num_threads(handle->num_threads_)
+    for(d1 = 0; d1 < N*K; d1++){
+        const int n = d1/K;
+        const int k = d1%K;
+
+        for(int i = 0; i < outHeight/2; i++)
+            for(int j = 0; j < outWidth/2; j++){
+                Dtype m = -std::numeric_limits<Dtype>::max();
+                for(int a = 0; a < 4; a++){
+                    const int r = 2*i + a/2;
+                    const int s = 2*j + a%2;
+                    const int uv = (r%dh)*dw + s%dw;
+                    m = std::max(m, phase_out[((long)(n*dh*dw + uv)*K + k)*sizeO + (r/dh)*OW + s/dw]);
+                }
+                out[ACSATensorOffset(&tensorDst, n, k, i, j)] = m;
+            }
+    }
+
+    return ret;
+}
+
+/* API for winograd convolution with dilation. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolutionDilated(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    return dilatedConvolution(handle, in, filter, out, tensorIn, tensorFilter, tensorOut,
+            convMess, winoMess, bias, activMess, poolMess);
+}
+
+/* API for winograd convolution with dilation and the pre-transformed filter. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolutionDilated(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    return dilatedConvolution(handle, in, wfilter, out, tensorIn, tensorFilter, tensorOut,
+            convMess, winoMess, bias, activMess, poolMess);
+}
+
+/* Bytes of workspace of a dilated layer, its sub-images and their convolution. */
+template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_dilation(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess)
+{
+    ACSATensor4d phaseIn, phaseOut;
+    ACSAConvMessage phaseConv;
+    ACSADilationPhaseTensors(tensorIn, tensorFilter, tensorOut, convMess, phaseIn, phaseOut);
+    ACSASetConvMessage(phaseConv, tensorFilter->h_, tensorFilter->w_, 0, 0, 1, 1);
+    phaseConv.groups_ = convMess->groups_;
+
+    ACSAStatus ret = ACSAGetWinoWorkspaceSize<Dtype>(size, &phaseIn, tensorFilter, &phaseOut, &phaseConv, winoMess);
+    size += phaseBytes<Dtype>(phaseIn, phaseOut);
+
+    return ret;
+}
+
+/* Instantiate Template */
+template ACSAStatus ACSAWinoConvolutionDilated<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *,
+        const float *, ACSAActivMessage *, ACSAPoolMessage *);
+template ACSAStatus ACSAWinoConvolutionDilated<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *,
+        const double *, ACSAActivMessage *, ACSAPoolMessage *);
+template ACSAStatus ACSAWinoConvolutionDilated<float>(ACSAHandle *,
+        const float *, const ACSAWinoFilter *, float *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *,
+        const float *, ACSAActivMessage *, ACSAPoolMessage *);
+template ACSAStatus ACSAWinoConvolutionDilated<double>(ACSAHandle *,
+        const double *, const ACSAWinoFilter *, double *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *,
+        const double *, ACSAActivMessage *, ACSAPoolMessage *);
+template ACSAStatus ACSAWinoWorkspaceSize_dilation<float>(size_t &,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *);
+template ACSAStatus ACSAWinoWorkspaceSize_dilation<double>(size_t &,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *);
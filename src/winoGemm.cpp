@@ -0,0 +1,372 @@
+/* Register-blocked kernel for the element-wise gemm of winograd.
+ * The gemms are tall-skinny, out(irows, K) = in(irows, C) * filter(C, K),
+ * all column major and repeated for every transform point and batch.
+ * in and filter may be 16-bit bridges, they widen to fp32 as they load
+ * and the products accumulate in fp32.
+ * The INT8 bridge multiplies 4 channels of u8 and s8 at a time into int32,
+ * a vector holds the 4 channels of VLEN rows.
+ * */
+
+#include "dnn.hpp"
+#include <immintrin.h>
+
+#if defined(__AVX512F__)
+#define VLEN 16     // floats of one vector
+#define NR 12       // columns of one filter panel, 2*12 accumulators of 32 zmm
+typedef __m512 vec_t;
+#define VZERO() _mm512_setzero_ps()
+#define VLOAD(p) _mm512_loadu_ps(p)
+#define VSTORE(p, v) _mm512_storeu_ps(p, v)
+#define VBCAST(p) _mm512_set1_ps(*(p))
+#define VFMA(a, b, c) _mm512_fmadd_ps(a, b, c)
+#define VLOAD_BF16(p) _mm512_castsi512_ps(_mm512_slli_epi32( \
+            _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *)(p))), 16))
+#define VLOAD_FP16(p) _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *)(p)))
+#elif defined(__AVX2__) && defined(__FMA__)
+#define VLEN 8
+#define NR 6        // 2*6 accumulators of 16 ymm
+typedef __m256 vec_t;
+#define VZERO() _mm256_setzero_ps()
+#define VLOAD(p) _mm256_loadu_ps(p)
+#define VSTORE(p, v) _mm256_storeu_ps(p, v)
+#define VBCAST(p) _mm256_broadcast_ss(p)
+#define VFMA(a, b, c) _mm256_fmadd_ps(a, b, c)
+#define VLOAD_BF16(p) _mm256_castsi256_ps(_mm256_slli_epi32( \
+            _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(p))), 16))
+#ifdef __F16C__
+#define VLOAD_FP16(p) _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(p)))
+#endif
+#endif
+
+#if defined(__AVX512BW__)
+#define IVLEN 16    // int32 lanes of one vector
+#define INR 12
+typedef __m512i ivec_t;
+#define IZERO() _mm512_setzero_si512()
+#define ILOAD(p) _mm512_loadu_si512((const void *)(p))
+#define ISET1(x) _mm512_set1_epi32(x)
+#ifdef __AVX512VNNI__
+#define IDOT(c, a, b) _mm512_dpbusd_epi32(c, a, b)
+#else
+#define IDOT(c, a, b) _mm512_add_epi32(c, _mm512_madd_epi16(_mm512_maddubs_epi16(a, b), _mm512_set1_epi16(1)))
+#endif
+#define ISTORE_PS(p, v, o, s) _mm512_storeu_ps(p, _mm512_mul_ps(_mm512_cvtepi32_ps( \
+            _mm512_sub_epi32(v, _mm512_set1_epi32(o))), _mm512_set1_ps(s)))
+#elif defined(__AVX2__)
+#define IVLEN 8
+#define INR 6
+typedef __m256i ivec_t;
+#define IZERO() _mm256_setzero_si256()
+#define ILOAD(p) _mm256_loadu_si256((const __m256i *)(p))
+#define ISET1(x) _mm256_set1_epi32(x)
+#define IDOT(c, a, b) _mm256_add_epi32(c, _mm256_madd_epi16(_mm256_maddubs_epi16(a, b), _mm256_set1_epi16(1)))
+#define ISTORE_PS(p, v, o, s) _mm256_storeu_ps(p, _mm256_mul_ps(_mm256_cvtepi32_ps( \
+            _mm256_sub_epi32(v, _mm256_set1_epi32(o))), _mm256_set1_ps(s)))
+#endif
+
+#ifdef VLEN
+/* Loads of in and filter by the type of the bridge. */
+struct load_fp32 {
+    typedef float type;
+    static inline vec_t vec(const float *p) { return VLOAD(p); }
+    static inline float one(const float x) { return x; }
+};
+struct load_bf16 {
+    typedef uint16_t type;
+    static inline vec_t vec(const uint16_t *p) { return VLOAD_BF16(p); }
+    static inline float one(const uint16_t x) { return ACSABf16ToFloat(x); }
+};
+#ifdef VLOAD_FP16
+struct load_fp16 {
+    typedef uint16_t type;
+    static inline vec_t vec(const uint16_t *p) { return VLOAD_FP16(p); }
+    static inline float one(const uint16_t x) { return ACSAHalfToFloat(x); }
+};
+#endif
+
+/* c(MV*VLEN, n) = a(MV*VLEN, C) * bp(C, NR), bp is the packed filter panel. */
+template<typename L, int MV>
+static inline void micro_kernel(const typename L::type *a, const int lda, const float *bp, const int C,
+        float *c, const int ldc, const int n)
+{
+    int p, v, j;
+    vec_t acc[MV][NR];
+    vec_t av[MV];
+
+    for(v = 0; v < MV; v++)
+        for(j = 0; j < NR; j++)
+            acc[v][j] = VZERO();
+
+    for(p = 0; p < C; p++){
+        for(v = 0; v < MV; v++)
+            av[v] = L::vec(a + p*lda + v*VLEN);
+        for(j = 0; j < NR; j++){
+            const vec_t bv = VBCAST(bp + p*NR + j);
+            for(v = 0; v < MV; v++)
+                acc[v][j] = VFMA(av[v], bv, acc[v][j]);
+        }
+    }
+
+    for(j = 0; j < n; j++)
+        for(v = 0; v < MV; v++)
+            VSTORE(c + j*ldc + v*VLEN, acc[v][j]);
+}
+
+/* Rows left by the vector kernels. */
+template<typename L>
+static inline void tail_kernel(const typename L::type *a, const int lda, const float *bp, const int C,
+        float *c, const int ldc, const int m, const int n)
+{
+    for(int i = 0; i < m; i++)
+        for(int j = 0; j < n; j++){
+            float sum = 0;
+            for(int p = 0; p < C; p++)
+                sum += L::one(a[i + p*lda]) * bp[p*NR + j];
+            c[i + j*ldc] = sum;
+        }
+}
+
+/* All points and batches in one loop nest.
+ * Every task packs a filter panel of NR columns once, keeps it in cache
+ * and streams the tiles of one batch through it.
+ * */
+template<typename L>
+static void wino_sgemm(const typename L::type *in, const int irows, const int icols, const long istride,
+        const typename L::type *filter, const int fcols, const long fstride,
+        float *out, const long ostride,
+        const int points, const int batch)
+{
+    const int nkb = (fcols+NR-1)/NR;
+
+#pragma omp parallel
+    {
+        int d1, d2, kb;
+        float *bp = (float *)mkl_malloc(icols*NR*sizeof(float), 64);
+
+#pragma omp for collapse(3) schedule(static)
+        for(d1 = 0; d1 < points; d1++){
+            for(kb = 0; kb < nkb; kb++){
+                for(d2 = 0; d2 < batch; d2++){
+                    const typename L::type *pft = filter + d1*fstride + (long)kb*NR*icols;
+                    const typename L::type *pin = in + d1*istride + (long)d2*irows*icols;
+                    float *pot = out + d1*ostride + (long)d2*irows*fcols + (long)kb*NR*irows;
+                    const int n = std::min(NR, fcols-kb*NR);
+                    int i, p, j;
+
+                    // Pack the filter panel, the missing columns are zero
+                    for(p = 0; p < icols; p++)
+                        for(j = 0; j < NR; j++)
+                            bp[p*NR + j] = (j < n) ? L::one(pft[p + j*icols]) : 0;
+
+                    for(i = 0; i+2*VLEN <= irows; i += 2*VLEN)
+                        micro_kernel<L, 2>(pin+i, irows, bp, icols, pot+i, irows, n);
+                    for(; i+VLEN <= irows; i += VLEN)
+                        micro_kernel<L, 1>(pin+i, irows, bp, icols, pot+i, irows, n);
+                    tail_kernel<L>(pin+i, irows, bp, icols, pot+i, irows, irows-i, n);
+                }
+            }
+        }
+
+        mkl_free(bp);
+    }
+}
+#endif
+
+#ifdef IVLEN
+/* c(MV*IVLEN, n) of the INT8 bridge, bp holds 4 channels of a column in one int32. */
+template<int MV>
+static inline void micro_kernel_s8(const uint8_t *a, const int lda, const int32_t *bp, const int ng,
+        float *c, const int ldc, const int n, const float *scale, const int32_t *comp)
+{
+    int g, v, j;
+    ivec_t acc[MV][INR];
+    ivec_t av[MV];
+
+    for(v = 0; v < MV; v++)
+        for(j = 0; j < INR; j++)
+            acc[v][j] = IZERO();
+
+    for(g = 0; g < ng; g++){
+        for(v = 0; v < MV; v++)
+            av[v] = ILOAD(a + ((long)g*lda + v*IVLEN)*4);
+        for(j = 0; j < INR; j++){
+            const ivec_t bv = ISET1(bp[g*INR + j]);
+            for(v = 0; v < MV; v++)
+                acc[v][j] = IDOT(acc[v][j], av[v], bv);
+        }
+    }
+
+    for(j = 0; j < n; j++)
+        for(v = 0; v < MV; v++)
+            ISTORE_PS(c + j*ldc + v*IVLEN, acc[v][j], comp[j], scale[j]);
+}
+
+/* Rows left by the INT8 vector kernels. */
+static inline void tail_kernel_s8(const uint8_t *a, const int lda, const int32_t *bp, const int ng,
+        float *c, const int ldc, const int m, const int n, const float *scale, const int32_t *comp)
+{
+    for(int i = 0; i < m; i++)
+        for(int j = 0; j < n; j++){
+            int32_t sum = 0;
+            for(int g = 0; g < ng; g++){
+                const int8_t *b = (const int8_t *)(bp + g*INR + j);
+                for(int u = 0; u < 4; u++)
+                    sum += a[((long)g*lda + i)*4 + u] * b[u];
+            }
+            c[i + j*ldc] = (sum - comp[j]) * scale[j];
+        }
+}
+
+/* Same loop nest as wino_sgemm, the panel packs 4 channels of a column in one int32. */
+static void wino_s8gemm(const uint8_t *in, const int irows, const int icols, const long istride,
+        const int8_t *filter, const int fcols, const long fstride,
+        float *out, const long ostride,
+        const int points, const int batch,
+        const float *scale, const int32_t *comp)
+{
+    const int nkb = (fcols+INR-1)/INR;
+    const int ng = icols/4;
+
+#pragma omp parallel
+    {
+        int d1, d2, kb;
+        int32_t *bp = (int32_t *)mkl_malloc(ng*INR*sizeof(int32_t), 64);
+
+#pragma omp for collapse(3) schedule(static)
+        for(d1 = 0; d1 < points; d1++){
+            for(kb = 0; kb < nkb; kb++){
+                for(d2 = 0; d2 < batch; d2++){
+                    const int8_t *pft = filter + d1*fstride + (long)kb*INR*icols;
+                    const uint8_t *pin = in + d1*istride + (long)d2*irows*icols;
+                    float *pot = out + d1*ostride + (long)d2*irows*fcols + (long)kb*INR*irows;
+                    const float *ps = scale + (long)d1*fcols + kb*INR;
+                    const int32_t *pc = comp + (long)d1*fcols + kb*INR;
+                    const int n = std::min(INR, fcols-kb*INR);
+                    int i, g, j;
+
+                    // Pack the filter panel, the missing columns are zero
+                    for(g = 0; g < ng; g++)
+                        for(j = 0; j < INR; j++){
+                            bp[g*INR + j] = 0;
+                            if(j < n)
+                                memcpy(bp + g*INR + j, pft + (long)j*icols + 4*g, 4);
+                        }
+
+                    for(i = 0; i+2*IVLEN <= irows; i += 2*IVLEN)
+                        micro_kernel_s8<2>(pin+4*i, irows, bp, ng, pot+i, irows, n, ps, pc);
+                    for(; i+IVLEN <= irows; i += IVLEN)
+                        micro_kernel_s8<1>(pin+4*i, irows, bp, ng, pot+i, irows, n, ps, pc);
+                    tail_kernel_s8(pin+4*i, irows, bp, ng, pot+i, irows, irows-i, n, ps, pc);
+                }
+            }
+        }
+
+        mkl_free(bp);
+    }
+}
+#endif
+
+/* Element-wise gemm by the kernel, double or a build without AVX2 goes to MKL. */
+template<typename Dtype>
+ACSAStatus ACSAWinoGemm(const Dtype *in, const int irows, const int icols, const long istride,
+        const Dtype *filter, const int fcols, const long fstride,
+        Dtype *out, const long ostride,
+        const int points, const int batch)
+{
+#ifdef VLEN
+    if(typeid(Dtype) == typeid(float)){
+        wino_sgemm<load_fp32>((const float *)in, irows, icols, istride,
+                (const float *)filter, fcols, fstride,
+                (float *)out, ostride, points, batch);
+        return ACSASUCCESS;
+    }
+#endif
+
+    return ACSABatchGemm(in, irows, icols, istride, filter, fcols, fstride, out, ostride, points, batch);
+}
+
+/* Element-wise gemm of 16-bit bridges with fp32 accumulation.
+ * Without the vector loads, both sides widen to fp32 and go to MKL.
+ * */
+ACSAStatus ACSAWinoGemmHalf(const uint16_t *in, const int irows, const int icols, const long istride,
+        const uint16_t *filter, const int fcols, const long fstride,
+        float *out, const long ostride,
+        const int points, const int batch, const ACSABridgeType bridge)
+{
+#ifdef VLEN
+    if(bridge == ACSA_BRIDGE_BF16){
+        wino_sgemm<load_bf16>(in, irows, icols, istride, filter, fcols, fstride,
+                out, ostride, points, batch);
+        return ACSASUCCESS;
+    }
+#ifdef VLOAD_FP16
+    wino_sgemm<load_fp16>(in, irows, icols, istride, filter, fcols, fstride,
+            out, ostride, points, batch);
+    return ACSASUCCESS;
+#endif
+#endif
+
+    const long isize = (points-1)*istride + (long)batch*irows*icols;
+    const long fsize = (points-1)*fstride + (long)icols*fcols;
+    float *in32 = (float *)mkl_malloc((isize+fsize)*sizeof(float), 64);
+    float *filter32 = in32 + isize;
+    long i;
+
+    assert(in32 != NULL);
+#pragma omp parallel for private(i)
+    for(i = 0; i < isize; i++)
+        in32[i] = (bridge == ACSA_BRIDGE_BF16) ? ACSABf16ToFloat(in[i]) : ACSAHalfToFloat(in[i]);
+#pragma omp parallel for private(i)
+    for(i = 0; i < fsize; i++)
+        filter32[i] = (bridge == ACSA_BRIDGE_BF16) ? ACSABf16ToFloat(filter[i]) : ACSAHalfToFloat(filter[i]);
+    ACSABatchGemm((const float *)in32, irows, icols, istride, (const float *)filter32, fcols, fstride,
+            out, ostride, points, batch);
+    mkl_free(in32);
+
+    return ACSASUCCESS;
+}
+
+/* Element-wise gemm of the INT8 bridge, plain loops without AVX2. */
+ACSAStatus ACSAWinoGemmInt8(const uint8_t *in, const int irows, const int icols, const long istride,
+        const int8_t *filter, const int fcols, const long fstride,
+        float *out, const long ostride,
+        const int points, const int batch,
+        const float *scale, const int32_t *comp)
+{
+    // Check
+    ACSA_CHECK((icols%4 == 0));
+
+#ifdef IVLEN
+    wino_s8gemm(in, irows, icols, istride, filter, fcols, fstride,
+            out, ostride, points, batch, scale, comp);
+#else
+    int d1;
+#pragma omp parallel for private(d1)
+    for(d1 = 0; d1 < points*batch; d1++){
+        const int p = d1/batch;
+        const uint8_t *pin = in + p*istride + (long)(d1%batch)*irows*icols;
+        const int8_t *pft = filter + p*fstride;
+        float *pot = out + p*ostride + (long)(d1%batch)*irows*fcols;
+
+        for(int j = 0; j < fcols; j++)
+            for(int i = 0; i < irows; i++){
+                int32_t sum = 0;
+                for(int c = 0; c < icols; c++)
+                    sum += pin[((long)(c/4)*irows + i)*4 + c%4] * pft[(long)j*icols + c];
+                pot[i + (long)j*irows] = (sum - comp[p*fcols + j]) * scale[p*fcols + j];
+            }
+    }
+#endif
+
+    return ACSASUCCESS;
+}
+
+/* Instantiate Template */
+template ACSAStatus ACSAWinoGemm<float>(const float *, const int, const int, const long,
+        const float *, const int, const long,
+        float *, const long,
+        const int, const int);
+template ACSAStatus ACSAWinoGemm<double>(const double *, const int, const int, const long,
+        const double *, const int, const long,
+        double *, const long,
+        const int, const int);
@@ -0,0 +1,214 @@
+/* Grouped convolution by winograd.
+ * Group g convolves the channels [g*C/groups, (g+1)*C/groups) of in with the
+ * filters [g*K/groups, (g+1)*K/groups), so every group is a dense convolution
+ * of its own. The groups run one after another on the same workspace, their
+ * channels are gathered from in and scattered back to out.
+ * Depthwise layers of stride 1 don't come here, see ACSAWinoDepthwise.
+ * */
+
+#include "dnn.hpp"
+
+/* Shapes of one group of a grouped layer, convMess keeps the layer's pad, stride and dilation. */
+void ACSAGroupTensors(ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSATensor4d &groupIn, ACSATensor4d &groupFilter, ACSATensor4d &groupOut)
+{
+    const int G = convMess->groups_;
+
+    ACSASetTensor4d(groupIn, tensorIn->n_, tensorIn->c_/G, tensorIn->h_, tensorIn->w_);
+    ACSASetTensor4d(groupFilter, tensorFilter->n_/G, tensorFilter->c_, tensorFilter->h_, tensorFilter->w_);
+    ACSASetTensor4d(groupOut, tensorOut->n_, tensorFilter->n_/G, tensorOut->h_, tensorOut->w_);
+}
+
+/* Filters of group g, a run of K/groups filters of the raw filter. */
+    template<typename Dtype>
+static const Dtype* groupFilter(const Dtype *filter, ACSATensor4d *groupFilt, const int g,
+        ACSAWinoFilter &view)
+{
+    return filter + g*ACSATensorSize(groupFilt);
+}
+
+/* Filters of group g as a view of the transformed filter, point p of
+ * filter (k, c) is at p*stride_ + k*c_ + c, so a group is a run of k in every point.
+ * */
+    template<typename Dtype>
+static const ACSAWinoFilter* groupFilter(const ACSAWinoFilter *wfilter, ACSATensor4d *groupFilt, const int g,
+        ACSAWinoFilter &view)
+{
+    view = *wfilter;
+    view.k_ = groupFilt->n_;
+    view.data_ = (Dtype *)wfilter->data_ + (long)g*groupFilt->n_*groupFilt->c_;
+    if(wfilter->bdata_ != NULL)
+        view.bdata_ = (uint16_t *)wfilter->bdata_ + (long)g*groupFilt->n_*groupFilt->c_;
+    if(wfilter->qdata_ != NULL){
+        view.qdata_ = (int8_t *)wfilter->qdata_ + (long)g*groupFilt->n_*((groupFilt->c_+3)/4*4);
+        view.qscale_ = (float *)wfilter->qscale_ + (long)g*groupFilt->n_*wfilter->points_;
+        view.qcomp_ = (int32_t *)wfilter->qcomp_ + (long)g*groupFilt->n_*wfilter->points_;
+    }
+
+    return &view;
+}
+
+/* Bytes of the channels of one group in and out, out as it is before pooling.
+ * The convolution of a group takes the workspace after them.
+ * */
+template<typename Dtype>
+static size_t groupBytes(const ACSATensor4d &groupIn, const ACSATensor4d &groupOut)
+{
+    return ((long)groupIn.n_*groupIn.c_*groupIn.h_*groupIn.w_*sizeof(Dtype) + 63)/64*64 +
+        ((long)groupOut.n_*groupOut.c_*groupOut.h_*groupOut.w_*sizeof(Dtype) + 63)/64*64;
+}
+
+/* Grouped winograd convolution, Filter is the raw filter or ACSAWinoFilter. */
+    template<typename Dtype, typename Filter>
+static ACSAStatus groupedConvolution(ACSAHandle *handle,
+        const Dtype *in, const Filter *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    const int G = convMess->groups_;
+
+    // Check
+    ACSA_CHECK(((tensorIn->c_%G == 0) && (tensorFilter->n_%G == 0)));
+    ACSA_CHECK((tensorFilter->c_*G == tensorIn->c_));
+
+    ACSATensor4d groupIn, groupFilt, groupOut;
+    ACSAConvMessage groupConv = *convMess;
+    ACSAGroupTensors(tensorIn, tensorFilter, tensorOut, convMess, groupIn, groupFilt, groupOut);
+    groupConv.groups_ = 1;
+
+    const int N = tensorIn->n_;
+    const int Cg = groupIn.c_;
+    const int Kg = groupOut.c_;
+    const int H = groupIn.h_;
+    const int W = groupIn.w_;
+
+    /* Layout and shape of out, the pooled one when pool is set. */
+    ACSATensor4d tensorDst = *tensorOut;
+    if(poolMess != NULL){
+        tensorDst.h_ = tensorOut->h_/2;
+        tensorDst.w_ = tensorOut->w_/2;
+    }
+    const int OH = tensorDst.h_;
+    const int OW = tensorDst.w_;
+
+    // The size is asked for the threads of handle, the groups run by them
+    size_t size;
+    const int nthreads = omp_get_max_threads();
+    omp_set_num_threads(handle->num_threads_);
+    ACSAWinoWorkspaceSize_grouped<Dtype>(size, tensorIn, tensorFilter, tensorOut, convMess, winoMess);
+    omp_set_num_threads(nthreads);
+    char *work = (char *)ACSAReserveWorkspace(handle, size);
+    if(work == NULL)
+        return ACSAFAIL;
+    Dtype *group_in = (Dtype *)work;
+    Dtype *group_out = (Dtype *)(work + ((long)N*Cg*H*W*sizeof(Dtype) + 63)/64*64);
+
+    // Every group runs in the rest of the workspace, it never grows under them
+    const size_t gbytes = groupBytes<Dtype>(groupIn, groupOut);
+    ACSAHandle groupHandle = *handle;
+    groupHandle.workspace_ = work + gbytes;
+    groupHandle.workspace_size_ = size - gbytes;
+    groupHandle.own_workspace_ = 0;
+
+    ACSAStatus ret = ACSASUCCESS;
+    for(int g = 0; g < G && ret == ACSASUCCESS; g++){
+        int d1;
+#pragma omp parallel for private(d1) num_threads(handle->num_threads_)
+        for(d1 = 0; d1 < N*Cg; d1++){
+            const int n = d1/Cg;
+            const int c = d1%Cg;
+            Dtype *dst = group_in + (long)d1*H*W;
+            for(int i = 0; i < H; i++)
+                for(int j = 0; j < W; j++)
+                    dst[i*W + j] = in[ACSATensorOffset(tensorIn, n, g*Cg + c, i, j)];
+        }
+
+        ACSAWinoFilter view;
+        ret = ACSAWinoConvolutionFwd(&groupHandle, (const Dtype *)group_in,
+                groupFilter<Dtype>(filter, &groupFilt, g, view),
+                group_out, &groupIn, &groupFilt, &groupOut, &groupConv, winoMess,
+                (bias == NULL) ? (const Dtype *)NULL : bias + g*Kg, activMess, poolMess);
+
+#pragma omp parallel for private(d1) num_threads(handle->num_threads_)
+        for(d1 = 0; d1 < N*Kg; d1++){
+            const int n = d1/Kg;
+            const int k = d1%Kg;
+            const Dtype *src = group_out + (long)d1*OH*OW;
+            for(int i = 0; i < OH; i++)
+                for(int j = 0; j < OW; j++)
+                    out[ACSATensorOffset(&tensorDst, n, g*Kg + k, i, j)] = src[i*OW + j];
+        }
+    }
+
+    return ret;
+}
+
+/* API for grouped winograd convolution. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolutionGrouped(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    return groupedConvolution(handle, in, filter, out, tensorIn, tensorFilter, tensorOut,
+            convMess, winoMess, bias, activMess, poolMess);
+}
+
+/* API for grouped winograd convolution with the pre-transformed filter. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolutionGrouped(ACSAHandle *handle,
+        const Dtype *in, const ACSAWinoFilter *wfilter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    return groupedConvolution(handle, in, wfilter, out, tensorIn, tensorFilter, tensorOut,
+            convMess, winoMess, bias, activMess, poolMess);
+}
+
+/* Bytes of workspace of a grouped layer, the channels of a group and its convolution. */
+template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_grouped(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess)
+{
+    ACSATensor4d groupIn, groupFilt, groupOut;
+    ACSAConvMessage groupConv = *convMess;
+    ACSAGroupTensors(tensorIn, tensorFilter, tensorOut, convMess, groupIn, groupFilt, groupOut);
+    groupConv.groups_ = 1;
+
+    ACSAStatus ret = ACSAGetWinoWorkspaceSize<Dtype>(size, &groupIn, &groupFilt, &groupOut, &groupConv, winoMess);
+    size += groupBytes<Dtype>(groupIn, groupOut);
+
+    return ret;
+}
+
+/* Instantiate Template */
+template ACSAStatus ACSAWinoConvolutionGrouped<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *,
+        const float *, ACSAActivMessage *, ACSAPoolMessage *);
+template ACSAStatus ACSAWinoConvolutionGrouped<float>(ACSAHandle *,
+        const float *, const ACSAWinoFilter *, float *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *,
+        const float *, ACSAActivMessage *, ACSAPoolMessage *);
+template ACSAStatus ACSAWinoConvolutionGrouped<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *,
+        const double *, ACSAActivMessage *, ACSAPoolMessage *);
+template ACSAStatus ACSAWinoConvolutionGrouped<double>(ACSAHandle *,
+        const double *, const ACSAWinoFilter *, double *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *,
+        const double *, ACSAActivMessage *, ACSAPoolMessage *);
+template ACSAStatus ACSAWinoWorkspaceSize_grouped<float>(size_t &,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *);
+template ACSAStatus ACSAWinoWorkspaceSize_grouped<double>(size_t &,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *);
@@ -0,0 +1,1534 @@
+/* Fused pipeline for winograd.
+ * A block of tiles goes through the input transform, gemm and output transform
+ * before the next block, so its bridge data stays in L2 instead of memory.
+ * A tile is TH x TW with TH = M_H+R_H-1 and TW = M_W+R_W-1, rows and columns
+ * transform by their own matrixes, a 1D algorithm uses [1] for the other axis.
+ * Stride S reads tiles of TH = S*(M_H-1)+R_H, S*M_H rows apart, see
+ * ACSAWinoPipelineStride2 for the matrixes of S = 2.
+ * The depthwise kernel shares the tile transforms, with channels in the lanes.
+ * With a bf16 or fp16 bridge the transformed input and filter are kept in
+ * 16 bits, a block holds twice the tiles and the gemm accumulates in fp32.
+ * The INT8 bridge of F(2x3) quantizes them to u8 and s8, the gemm accumulates
+ * in int32 and scales the products back to float as it stores them.
+ * The filter gradient runs the same input transform, the output gradient
+ * through the transposed output transform and dU through the transposed G.
+ * */
+
+#include "dnn.hpp"
+
+#define L2_BUDGET (512*1024)    // bytes of bridge data for one block
+#define MIN_BLOCK 16            // fewest tiles of one block, keep the gemm fat enough
+#define CV_BLOCK 16             // channels transformed together for NHWC and nChw16c
+#define BWD_KB 64               // filters of one gemm task of the filter gradient
+
+#ifndef BWD_CHUNK_BYTES
+#define BWD_CHUNK_BYTES (64L << 20) // transformed tiles of the filter gradient between two gemm phases
+#endif
+
+/* v = BTh * d * BTw^T for CV channels of one tile, d and v are [TH*TW][CV]. */
+template<typename Dtype, int TH, int TW, int CV>
+static inline void tile_trans_in(const float *BTh, const float *BTw, const Dtype *d, Dtype *v)
+{
+    int i, j, k, l;
+    Dtype bridge[TH*TW*CV];
+
+    for(i = 0; i < TH; i++)
+        for(j = 0; j < TW; j++){
+            Dtype *b = bridge + (i*TW + j)*CV;
+            for(l = 0; l < CV; l++)
+                b[l] = 0;
+            for(k = 0; k < TH; k++){
+                const Dtype a = BTh[i*TH + k];
+                const Dtype *src = d + (k*TW + j)*CV;
+                for(l = 0; l < CV; l++)
+                    b[l] += a*src[l];
+            }
+        }
+    for(i = 0; i < TH; i++)
+        for(j = 0; j < TW; j++){
+            Dtype *dst = v + (i*TW + j)*CV;
+            for(l = 0; l < CV; l++)
+                dst[l] = 0;
+            for(k = 0; k < TW; k++){
+                const Dtype a = BTw[j*TW + k];
+                const Dtype *b = bridge + (i*TW + k)*CV;
+                for(l = 0; l < CV; l++)
+                    dst[l] += a*b[l];
+            }
+        }
+}
+
+/* y = ATh * t * ATw^T for CV channels of one output tile, t is [TH*TW][CV] and y is [M_H*M_W][CV]. */
+template<typename Dtype, int M_H, int TH, int M_W, int TW, int CV>
+static inline void tile_trans_out(const float *ATh, const float *ATw, const Dtype *t, Dtype *y)
+{
+    int i, j, k, l;
+    Dtype bridge[M_H*TW*CV];
+
+    for(i = 0; i < M_H; i++)
+        for(j = 0; j < TW; j++){
+            Dtype *b = bridge + (i*TW + j)*CV;
+            for(l = 0; l < CV; l++)
+                b[l] = 0;
+            for(k = 0; k < TH; k++){
+                const Dtype a = ATh[i*TH + k];
+                const Dtype *src = t + (k*TW + j)*CV;
+                for(l = 0; l < CV; l++)
+                    b[l] += a*src[l];
+            }
+        }
+    for(i = 0; i < M_H; i++)
+        for(j = 0; j < M_W; j++){
+            Dtype *dst = y + (i*M_W + j)*CV;
+            for(l = 0; l < CV; l++)
+                dst[l] = 0;
+            for(k = 0; k < TW; k++){
+                const Dtype a = ATw[j*TW + k];
+                const Dtype *b = bridge + (i*TW + k)*CV;
+                for(l = 0; l < CV; l++)
+                    dst[l] += a*b[l];
+            }
+        }
+}
+
+/* Scales of the INT8 bridge, see pipelineInt8. */
+struct wino_quant {
+    const float *in_scale;      // P, transformed input to int8
+    const float *out_scale;     // P*K, int32 products back to float
+    const int32_t *comp;        // P*K, 128 times the channel sum of the int8 filter
+};
+
+/* x*s rounded to the nearest int8 of [-qmax, qmax]. */
+static inline int quantize(const float x, const float s, const int qmax)
+{
+    const float y = x*s;
+    const int q = (int)(y + ((y < 0) ? -0.5f : 0.5f));
+
+    return std::min(std::max(q, -qmax), qmax);
+}
+
+/* Store one value of bridge data, as it is, rounded to 16 bits,
+ * or quantized by qs to int8 and kept as u8 plus 128 for INT8.
+ * */
+template<typename Dtype>
+static inline void bridge_store(Dtype *dst, const Dtype x, const ACSABridgeType btype, const float qs)
+{
+    *dst = x;
+}
+
+template<typename Dtype>
+static inline void bridge_store(uint16_t *dst, const Dtype x, const ACSABridgeType btype, const float qs)
+{
+    *dst = (btype == ACSA_BRIDGE_BF16) ? ACSAFloatToBf16(x) : ACSAFloatToHalf(x);
+}
+
+template<typename Dtype>
+static inline void bridge_store(uint8_t *dst, const Dtype x, const ACSABridgeType btype, const float qs)
+{
+    *dst = (uint8_t)(quantize(x, qs, 127) + 128);
+}
+
+/* Channels of a tile at one point, the INT8 bridge pads them to a multiple of 4. */
+template<typename Bt>
+static inline int bridge_cols(const int C)
+{
+    return (sizeof(Bt) == 1) ? (C+3)/4*4 : C;
+}
+
+/* Offset of channel c of tile t at point p in a block of nt tiles.
+ * The INT8 bridge keeps 4 channels of a tile together for the 8-bit dot products.
+ * */
+template<typename Bt>
+static inline long bridge_offset(const int p, const int c, const int t, const int nt, const int C)
+{
+    if(sizeof(Bt) == 1)
+        return (long)p*nt*bridge_cols<Bt>(C) + ((long)(c/4)*nt + t)*4 + c%4;
+
+    return (long)p*nt*C + (long)c*nt + t;
+}
+
+/* Input transform of tiles [t0, t0+nt) of image n, matrix A of point p is nt*C.
+ * CV channels of one pixel are loaded together, they are contiguous when CV > 1.
+ * Bt is Dtype, uint16_t for the 16-bit bridges of btype or uint8_t for INT8,
+ * which quantizes point p by qscale[p]. Tiles of stride S start S*M_H rows apart.
+ * */
+template<typename Dtype, typename Bt, int M_H, int R_H, int M_W, int R_W, int CV, int S>
+static void blockByTransformIn(const float *BTh, const float *BTw, const Dtype *in, ACSATensor4d *tensorIn,
+        const int n, const int t0, const int nt, const int col_nTiles,
+        const int pad_h, const int pad_w, Bt *wino_in, const ACSABridgeType btype, const float *qscale)
+{
+    const int TH = S*(M_H-1)+R_H;
+    const int TW = S*(M_W-1)+R_W;
+    const int P = TH*TW;
+    const int C = tensorIn->c_;
+    const int H = tensorIn->h_;
+    const int W = tensorIn->w_;
+    int c0, t, i, j, l, p;
+    Dtype tmp[P*CV] __attribute__((aligned(64)));
+    Dtype bridge[P*CV] __attribute__((aligned(64)));
+
+    for(c0 = 0; c0 < C; c0 += CV){
+        const int cv = std::min(CV, C-c0);
+        for(t = 0; t < nt; t++){
+            const int r_init = ((t0+t)/col_nTiles)*M_H*S - pad_h;
+            const int c_init = ((t0+t)%col_nTiles)*M_W*S - pad_w;
+            for(i = 0; i < TH; i++)
+                for(j = 0; j < TW; j++){
+                    const int r = r_init+i;
+                    const int s = c_init+j;
+                    Dtype *d = tmp + (i*TW + j)*CV;
+                    if(r >= 0 && r < H && s >= 0 && s < W){
+                        const Dtype *src = in + ACSATensorOffset(tensorIn, n, c0, r, s);
+                        for(l = 0; l < cv; l++)
+                            d[l] = src[l];
+                        for(; l < CV; l++)
+                            d[l] = 0;
+                    }
+                    else
+                        for(l = 0; l < CV; l++)
+                            d[l] = 0;
+                }
+            tile_trans_in<Dtype, TH, TW, CV>(BTh, BTw, tmp, bridge);
+            for(p = 0; p < P; p++){
+                const float qs = (qscale == NULL) ? 0 : qscale[p];
+                for(l = 0; l < cv; l++)
+                    bridge_store(wino_in + bridge_offset<Bt>(p, c0+l, t, nt, C), bridge[p*CV + l], btype, qs);
+            }
+        }
+    }
+}
+
+/* Output transform of tiles [t0, t0+nt) of image n, with bias, activation and pooling.
+ * tensorDst describes out, the pooled shape when pool is set.
+ * */
+template<typename Dtype, int M_H, int R_H, int M_W, int R_W, int CV, int S>
+static void blockByTransformOut(const float *ATh, const float *ATw, const Dtype *wino_out, const int K,
+        const int n, const int t0, const int nt, const int col_nTiles,
+        const int outHeight, const int outWidth,
+        Dtype *out, ACSATensor4d *tensorDst, const int pool,
+        const Dtype *bias, const Dtype slope, const Dtype ceil)
+{
+    const int TH = S*(M_H-1)+R_H;
+    const int TW = S*(M_W-1)+R_W;
+    const int P = TH*TW;
+    int k0, t, i, j, l, p;
+    Dtype tmp[P*CV] __attribute__((aligned(64)));
+    Dtype middle[M_H*M_W*CV] __attribute__((aligned(64)));
+    Dtype bk[CV];
+
+    for(k0 = 0; k0 < K; k0 += CV){
+        const int kv = std::min(CV, K-k0);
+        for(l = 0; l < CV; l++)
+            bk[l] = (bias == NULL || l >= kv) ? (Dtype)0 : bias[k0+l];
+        for(t = 0; t < nt; t++){
+            const int r_init = ((t0+t)/col_nTiles)*M_H;
+            const int c_init = ((t0+t)%col_nTiles)*M_W;
+            const int r_out = std::min(M_H, outHeight-r_init);
+            const int c_out = std::min(M_W, outWidth-c_init);
+            for(p = 0; p < P; p++){
+                for(l = 0; l < kv; l++)
+                    tmp[p*CV + l] = wino_out[(long)p*nt*K + (k0+l)*nt + t];
+                for(; l < CV; l++)
+                    tmp[p*CV + l] = 0;
+            }
+            tile_trans_out<Dtype, M_H, TH, M_W, TW, CV>(ATh, ATw, tmp, middle);
+
+            for(p = 0; p < M_H*M_W; p++)
+                for(l = 0; l < CV; l++)
+                    middle[p*CV + l] = ACSAActivate<Dtype>(middle[p*CV + l], bk[l], slope, ceil);
+
+            if(!pool){
+                for(i = 0; i < r_out; i++)
+                    for(j = 0; j < c_out; j++){
+                        Dtype *dst = out + ACSATensorOffset(tensorDst, n, k0, r_init+i, c_init+j);
+                        for(l = 0; l < kv; l++)
+                            dst[l] = middle[(i*M_W + j)*CV + l];
+                    }
+            }
+            // Odd tiles never fuse pooling, their branch is compiled out
+            else if(M_H%2 == 0 && M_W%2 == 0){
+                for(i = 0; i < r_out; i += 2)
+                    for(j = 0; j < c_out; j += 2){
+                        const Dtype *m0 = middle + (i*M_W + j)*CV;
+                        const Dtype *m1 = m0 + M_W*CV;
+                        Dtype *dst = out + ACSATensorOffset(tensorDst, n, k0, (r_init+i)/2, (c_init+j)/2);
+                        for(l = 0; l < kv; l++)
+                            dst[l] = std::max(std::max(m0[l], m0[CV+l]), std::max(m1[l], m1[CV+l]));
+                    }
+            }
+        }
+    }
+}
+
+/* Gemm of one block, on this thread only. The 16-bit and INT8 bridges always
+ * run on the kernels of this library, MKL has no gemm of them.
+ * */
+template<typename Dtype>
+static inline void block_gemm(const Dtype *a, const int nt, const int C,
+        const Dtype *f, const int K, const long fstride, Dtype *o, const int P,
+        const ACSAGemmMode gemm, const ACSABridgeType btype, const wino_quant *quant)
+{
+    if(gemm == ACSA_GEMM_KERNEL)
+        ACSAWinoGemm(a, nt, C, (long)nt*C, f, K, fstride, o, (long)nt*K, P, 1);
+    else
+        ACSABatchGemm(a, nt, C, (long)nt*C, f, K, fstride, o, (long)nt*K, P, 1);
+}
+
+static inline void block_gemm(const uint16_t *a, const int nt, const int C,
+        const uint16_t *f, const int K, const long fstride, float *o, const int P,
+        const ACSAGemmMode gemm, const ACSABridgeType btype, const wino_quant *quant)
+{
+    ACSAWinoGemmHalf(a, nt, C, (long)nt*C, f, K, fstride, o, (long)nt*K, P, 1, btype);
+}
+
+static inline void block_gemm(const uint8_t *a, const int nt, const int C,
+        const int8_t *f, const int K, const long fstride, float *o, const int P,
+        const ACSAGemmMode gemm, const ACSABridgeType btype, const wino_quant *quant)
+{
+    const int C4 = bridge_cols<uint8_t>(C);
+
+    ACSAWinoGemmInt8(a, nt, C4, (long)nt*C4, f, K, fstride, o, (long)nt*K, P, 1,
+            quant->out_scale, quant->comp);
+}
+
+/* Tiles of a block, a tile is C values of bsize bytes in and K values of dsize out. */
+static int pipelineTiles(const int P, const int C, const int K, const size_t bsize, const size_t dsize,
+        const int ntiles)
+{
+    const int tb = L2_BUDGET/(P*(C*bsize + K*dsize));
+
+    return std::min(std::max(tb, MIN_BLOCK), ntiles);
+}
+
+/* Bytes of the blocks of one thread, the transformed input and the gemm output start on a cache line. */
+static long pipelineSlot(const int P, const int tb, const int C, const int K, const size_t bsize,
+        const size_t dsize, long &isize)
+{
+    const int cols = (bsize == 1) ? (C+3)/4*4 : C;
+
+    isize = ((long)P*tb*cols*bsize + 63)/64*64;
+
+    return isize + ((long)P*tb*K*dsize + 63)/64*64;
+}
+
+/* Bytes of a raw filter rounded to a 16-bit bridge at the start of the work. */
+static long filter16Bytes(const int P, const int C, const int K)
+{
+    return ((long)P*no4k_aligned((long)K*C, sizeof(uint16_t))*sizeof(uint16_t) + 63)/64*64;
+}
+
+/* Blocks of tiles through the three phases, the transformed input is Bt,
+ * wino_filter is Ft and the gemm output is Dtype. quant is only for INT8.
+ * Thread t keeps its blocks in slot t of work.
+ * */
+template<typename Dtype, typename Bt, typename Ft, int M_H, int R_H, int M_W, int R_W, int S>
+static void pipelineBlocks(const float *BTh, const float *ATh, const float *BTw, const float *ATw,
+        const Dtype *in, const Ft *wino_filter, const long fstride, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut, ACSATensor4d* tensorDst,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess, void *work,
+        const Dtype *bias, const Dtype slope, const Dtype ceil, const int pool,
+        const wino_quant *quant)
+{
+    const int P = (S*(M_H-1)+R_H)*(S*(M_W-1)+R_W);
+    const int N = tensorIn->n_;
+    const int C = tensorIn->c_;
+    const int K = tensorFilter->n_;
+    const int pad_h = convMess->pad_h_;
+    const int pad_w = convMess->pad_w_;
+    const int outHeight = tensorOut->h_;
+    const int outWidth = tensorOut->w_;
+    const int col_nTiles = (outWidth+M_W-1)/M_W;
+    const int ntiles = ((outHeight+M_H-1)/M_H)*col_nTiles;
+    const ACSAGemmMode gemm = winoMess->gemm_;
+    const ACSABridgeType btype = winoMess->bridge_;
+    const int vec_in = (tensorIn->format_ != ACSA_TENSOR_NCHW);
+    const int vec_out = (tensorOut->format_ != ACSA_TENSOR_NCHW);
+
+    const int tb = pipelineTiles(P, C, K, sizeof(Bt), sizeof(Dtype), ntiles);
+    const int nblocks = (ntiles+tb-1)/tb;
+    long isize;
+    const long slot = pipelineSlot(P, tb, C, K, sizeof(Bt), sizeof(Dtype), isize);
+
+#pragma omp parallel
+    {
+        int n, b;
+        Bt *wino_in = (Bt *)((char *)work + omp_get_thread_num()*slot);
+        Dtype *wino_out = (Dtype *)((char *)wino_in + isize);
+        const float *qscale = (quant == NULL) ? NULL : quant->in_scale;
+
+        // The padded channels of INT8 meet zero filters, they only need to be defined
+        memset(wino_in, 0, isize);
+
+#pragma omp for collapse(2) schedule(dynamic)
+        for(n = 0; n < N; n++){
+            for(b = 0; b < nblocks; b++){
+                const int t0 = b*tb;
+                const int nt = std::min(tb, ntiles-t0);
+
+                if(vec_in)
+                    blockByTransformIn<Dtype, Bt, M_H, R_H, M_W, R_W, CV_BLOCK, S>(BTh, BTw, in, tensorIn,
+                            n, t0, nt, col_nTiles, pad_h, pad_w, wino_in, btype, qscale);
+                else
+                    blockByTransformIn<Dtype, Bt, M_H, R_H, M_W, R_W, 1, S>(BTh, BTw, in, tensorIn,
+                            n, t0, nt, col_nTiles, pad_h, pad_w, wino_in, btype, qscale);
+
+                block_gemm(wino_in, nt, C, wino_filter, K, fstride, wino_out, P, gemm, btype, quant);
+
+                if(vec_out)
+                    blockByTransformOut<Dtype, M_H, R_H, M_W, R_W, CV_BLOCK, S>(ATh, ATw, wino_out, K, n, t0, nt, col_nTiles,
+                            outHeight, outWidth, out, tensorDst, pool, bias, slope, ceil);
+                else
+                    blockByTransformOut<Dtype, M_H, R_H, M_W, R_W, 1, S>(ATh, ATw, wino_out, K, n, t0, nt, col_nTiles,
+                            outHeight, outWidth, out, tensorDst, pool, bias, slope, ceil);
+            }
+        }
+    }
+}
+
+/* Quantize the transformed filter for the INT8 bridge, see dnn.hpp. */
+void ACSAWinoQuantizeFilter(const float *wino_filter, const long fstride, const int P, const int C, const int K,
+        int8_t *filter8, const long fstride8, float *fscale, int32_t *comp)
+{
+    const int C4 = bridge_cols<uint8_t>(C);
+    int d1;
+
+#pragma omp parallel for private(d1)
+    for(d1 = 0; d1 < P*K; d1++){
+        const int p = d1/K;
+        const int k = d1%K;
+        const float *u = wino_filter + (long)p*fstride + (long)k*C;
+        int8_t *u8 = filter8 + (long)p*fstride8 + (long)k*C4;
+        float umax = 0;
+        int32_t sum = 0;
+        int c;
+
+        for(c = 0; c < C; c++)
+            umax = std::max(umax, (u[c] < 0) ? -u[c] : u[c]);
+        const float su = (umax > 0) ? ACSA_INT8_FILTER_MAX/umax : 1.0f;
+        for(c = 0; c < C; c++){
+            u8[c] = (int8_t)quantize(u[c], su, ACSA_INT8_FILTER_MAX);
+            sum += u8[c];
+        }
+        for(; c < C4; c++)
+            u8[c] = 0;
+        // comp takes out the 128 added to the input
+        comp[(long)k*P + p] = 128*sum;
+        fscale[(long)k*P + p] = 1.0f/su;
+    }
+}
+
+/* Bytes of the INT8 scales of a call, and of the filter when it is quantized into the work. */
+static long int8Bytes(const int P, const int C, const int K, const bool raw)
+{
+    const long pk = ((long)P*K*sizeof(float) + 63)/64*64;
+    long bytes = ((long)P*sizeof(float) + 63)/64*64 + 2*pk;
+
+    if(raw)
+        bytes += ((long)P*ACSAWinoInt8Stride(C, K) + 63)/64*64 + 2*pk;
+
+    return bytes;
+}
+
+/* The fused pipeline with the INT8 bridge.
+ * Point (i, j) of a tile sums rows i of BTh and j of BTw over the input, so
+ * |v| <= |BTh(i)|_1 * |BTw(j)|_1 * max|in|, which scales v to [-127, 127].
+ * F(2x3) keeps the bound at 4 times the input, and so does its tile of stride 2,
+ * the larger tiles lose too many bits.
+ * Every point and filter of wino_filter scales by its own largest magnitude.
+ * */
+template<int M_H, int R_H, int M_W, int R_W, int S>
+static ACSAStatus pipelineInt8(const float *BTh, const float *ATh, const float *BTw, const float *ATw,
+        const float *in, const float *wino_filter, const long fstride, const ACSAWinoFilter *wfilter,
+        float *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut, ACSATensor4d* tensorDst,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess, void *work,
+        const float *bias, const float slope, const float ceil, const int pool)
+{
+    const int TH = S*(M_H-1)+R_H;
+    const int TW = S*(M_W-1)+R_W;
+    const int P = TH*TW;
+    const int N = tensorIn->n_;
+    const int C = tensorIn->c_;
+    const int H = tensorIn->h_;
+    const int W = tensorIn->w_;
+    const int K = tensorFilter->n_;
+
+    if(M_H != 2 || R_H != 3 || M_W != 2 || R_W != 3){
+        ACSA_MESSAGE("ERROR: The INT8 bridge only supports F(2x3)!");
+        return ACSAFAIL;
+    }
+
+    // The padded lanes of nChw16c are not channels, they never count
+    float amax = 0;
+    int d1;
+#pragma omp parallel for private(d1) reduction(max:amax)
+    for(d1 = 0; d1 < N*C; d1++)
+        for(int h = 0; h < H; h++)
+            for(int w = 0; w < W; w++){
+                const float x = in[ACSATensorOffset(tensorIn, d1/C, d1%C, h, w)];
+                amax = std::max(amax, (x < 0) ? -x : x);
+            }
+
+    char *base = (char *)work;
+    float *in_scale = (float *)base;
+    base += ((long)P*sizeof(float) + 63)/64*64;
+    float *out_scale = (float *)base;
+    base += ((long)P*K*sizeof(float) + 63)/64*64;
+    int32_t *comp = (int32_t *)base;
+    base += ((long)P*K*sizeof(int32_t) + 63)/64*64;
+
+    // The filter of ACSACreateWinoFilter is quantized already, the raw one is quantized into work
+    const int8_t *filter8;
+    const float *fscale;
+    const int32_t *fcomp;
+    long fstride8;
+    if(wfilter != NULL && wfilter->qdata_ != NULL){
+        filter8 = (const int8_t *)wfilter->qdata_;
+        fscale = (const float *)wfilter->qscale_;
+        fcomp = (const int32_t *)wfilter->qcomp_;
+        fstride8 = wfilter->qstride_;
+    }else{
+        int8_t *q8 = (int8_t *)base;
+        fstride8 = ACSAWinoInt8Stride(C, K);
+        base += ((long)P*fstride8 + 63)/64*64;
+        float *qs = (float *)base;
+        base += ((long)P*K*sizeof(float) + 63)/64*64;
+        int32_t *qc = (int32_t *)base;
+        base += ((long)P*K*sizeof(int32_t) + 63)/64*64;
+
+        ACSAWinoQuantizeFilter(wino_filter, fstride, P, C, K, q8, fstride8, qs, qc);
+        filter8 = q8;
+        fscale = qs;
+        fcomp = qc;
+    }
+
+    for(int p = 0; p < P; p++){
+        float nh = 0, nw = 0;
+        for(int k = 0; k < TH; k++)
+            nh += (BTh[(p/TW)*TH + k] < 0) ? -BTh[(p/TW)*TH + k] : BTh[(p/TW)*TH + k];
+        for(int k = 0; k < TW; k++)
+            nw += (BTw[(p%TW)*TW + k] < 0) ? -BTw[(p%TW)*TW + k] : BTw[(p%TW)*TW + k];
+        in_scale[p] = (amax > 0) ? 127.0f/(nh*nw*amax) : 1.0f;
+    }
+    for(d1 = 0; d1 < P*K; d1++){
+        const int p = d1/K;
+        const int k = d1%K;
+        out_scale[d1] = fscale[(long)k*P + p]/in_scale[p];
+        comp[d1] = fcomp[(long)k*P + p];
+    }
+
+    wino_quant quant = {in_scale, out_scale, comp};
+    pipelineBlocks<float, uint8_t, int8_t, M_H, R_H, M_W, R_W, S>(BTh, ATh, BTw, ATw,
+            in, filter8, fstride8, out, tensorIn, tensorFilter, tensorOut, tensorDst,
+            convMess, winoMess, (void *)base, bias, slope, ceil, pool, &quant);
+
+    return ACSASUCCESS;
+}
+
+/* The fused pipeline of stride S, see ACSAWinoPipelineRect. */
+template<typename Dtype, int M_H, int R_H, int M_W, int R_W, int S>
+static ACSAStatus pipelineRun(const float *BTh, const float *ATh, const float *BTw, const float *ATw,
+        const Dtype *in, const Dtype *wino_filter, const long fstride, const ACSAWinoFilter *wfilter,
+        Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess, void *work,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    const int P = (S*(M_H-1)+R_H)*(S*(M_W-1)+R_W);
+    const int C = tensorIn->c_;
+    const int K = tensorFilter->n_;
+    const int outHeight = tensorOut->h_;
+    const int outWidth = tensorOut->w_;
+
+    // Check
+    ACSA_CHECK(((tensorFilter->h_ == R_H) && (tensorFilter->w_ == R_W)));
+    if(poolMess != NULL){
+        if(M_H%2 != 0 || M_W%2 != 0){
+            ACSA_MESSAGE("ERROR: Odd output tiles can not fuse pooling!\n");
+            return ACSAFAIL;
+        }
+        ACSA_CHECK(ACSAPoolFusible(poolMess, outHeight, outWidth));
+    }
+
+    Dtype slope, ceil;
+    ACSAActivParam(activMess, slope, ceil);
+
+    /* Layout and shape of out. */
+    ACSATensor4d tensorDst = *tensorOut;
+    if(poolMess != NULL){
+        tensorDst.h_ = outHeight/2;
+        tensorDst.w_ = outWidth/2;
+    }
+
+    if(winoMess->bridge_ == ACSA_BRIDGE_FP32 || typeid(Dtype) != typeid(float)){
+        pipelineBlocks<Dtype, Dtype, Dtype, M_H, R_H, M_W, R_W, S>(BTh, ATh, BTw, ATw,
+                in, wino_filter, fstride, out, tensorIn, tensorFilter, tensorOut, &tensorDst,
+                convMess, winoMess, work, bias, slope, ceil, poolMess != NULL, (const wino_quant *)NULL);
+        return ACSASUCCESS;
+    }
+
+    if(winoMess->bridge_ == ACSA_BRIDGE_INT8)
+        return pipelineInt8<M_H, R_H, M_W, R_W, S>(BTh, ATh, BTw, ATw,
+                (const float *)in, (const float *)wino_filter, fstride, wfilter, (float *)out,
+                tensorIn, tensorFilter, tensorOut, &tensorDst, convMess, winoMess, work,
+                (const float *)bias, (float)slope, (float)ceil, poolMess != NULL);
+
+    // The filter of ACSACreateWinoFilter keeps its 16-bit copy, the raw one is rounded into work
+    const uint16_t *filter16;
+    long fstride16;
+    if(wfilter != NULL && wfilter->bdata_ != NULL){
+        filter16 = (const uint16_t *)wfilter->bdata_;
+        fstride16 = fstride;
+    }else{
+        uint16_t *rounded = (uint16_t *)work;
+        int d1;
+
+        fstride16 = no4k_aligned((long)K*C, sizeof(uint16_t));
+#pragma omp parallel for private(d1)
+        for(d1 = 0; d1 < P*K; d1++){
+            const int p = d1/K;
+            const long k = d1%K;
+            for(int c = 0; c < C; c++)
+                bridge_store(rounded + p*fstride16 + k*C + c, (float)wino_filter[p*fstride + k*C + c],
+                        winoMess->bridge_, 0);
+        }
+        filter16 = rounded;
+        work = (char *)work + filter16Bytes(P, C, K);
+    }
+
+    pipelineBlocks<float, uint16_t, uint16_t, M_H, R_H, M_W, R_W, S>(BTh, ATh, BTw, ATw,
+            (const float *)in, filter16, fstride16, (float *)out,
+            tensorIn, tensorFilter, tensorOut, &tensorDst, convMess, winoMess, work,
+            (const float *)bias, (float)slope, (float)ceil, poolMess != NULL, (const wino_quant *)NULL);
+
+    return ACSASUCCESS;
+}
+
+/* Winograd F(M_H x M_W, R_H x R_W) by the fused pipeline.
+ * BTh/ATh transform the rows of a tile and BTw/ATw its columns, wino_filter
+ * is the filter transformed by the G matrixes of the same algorithm.
+ * in and out may be NCHW, NHWC or nChw16c, see ACSATensor4d::format_.
+ * The 16-bit and INT8 bridges of winoMess->bridge_ apply to float, double keeps its own.
+ * */
+template<typename Dtype, int M_H, int R_H, int M_W, int R_W>
+ACSAStatus ACSAWinoPipelineRect(const float *BTh, const float *ATh, const float *BTw, const float *ATw,
+        const Dtype *in, const Dtype *wino_filter, const long fstride, const ACSAWinoFilter *wfilter,
+        Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess, void *work,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    return pipelineRun<Dtype, M_H, R_H, M_W, R_W, 1>(BTh, ATh, BTw, ATw,
+            in, wino_filter, fstride, wfilter, out, tensorIn, tensorFilter, tensorOut,
+            convMess, winoMess, work, bias, activMess, poolMess);
+}
+
+/* Winograd F(F_M,3) by the fused pipeline, the same matrixes for rows and columns. */
+template<typename Dtype, int F_M>
+ACSAStatus ACSAWinoPipeline(const float *BT, const float *AT,
+        const Dtype *in, const Dtype *wino_filter, const long fstride, const ACSAWinoFilter *wfilter,
+        Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess, void *work,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    return ACSAWinoPipelineRect<Dtype, F_M, 3, F_M, 3>(BT, AT, BT, AT,
+            in, wino_filter, fstride, wfilter, out, tensorIn, tensorFilter, tensorOut,
+            convMess, winoMess, work, bias, activMess, poolMess);
+}
+
+/* Winograd of stride 2 with the F(F_M,3) tiles by the fused pipeline,
+ * BT and AT are the (2*F_M+1)-point matrixes of ACSAWinoConvolutionStride2.
+ * */
+template<typename Dtype, int F_M>
+ACSAStatus ACSAWinoPipelineStride2(const float *BT, const float *AT,
+        const Dtype *in, const Dtype *wino_filter, const long fstride, const ACSAWinoFilter *wfilter,
+        Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess, void *work,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    return pipelineRun<Dtype, F_M, 3, F_M, 3, 2>(BT, AT, BT, AT,
+            in, wino_filter, fstride, wfilter, out, tensorIn, tensorFilter, tensorOut,
+            convMess, winoMess, work, bias, activMess, poolMess);
+}
+
+/* Bytes of the work of the fused pipeline, the blocks of every thread.
+ * Stride 2 always runs by the pipeline.
+ * */
+template<typename Dtype>
+size_t ACSAWinoPipelineBytes(const int M_H, const int M_W, ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter,
+        ACSATensor4d* tensorOut, ACSAWinoMessage *winoMess, const int nthreads, const int stride)
+{
+    const int P = (stride*(M_H-1)+tensorFilter->h_)*(stride*(M_W-1)+tensorFilter->w_);
+    const int C = tensorIn->c_;
+    const int K = tensorFilter->n_;
+    const int ntiles = ((tensorOut->h_+M_H-1)/M_H)*((tensorOut->w_+M_W-1)/M_W);
+    const ACSABridgeType btype = ACSAWinoBridge<Dtype>(winoMess);
+    size_t bsize = sizeof(Dtype);
+    long isize;
+
+    if((stride == 1 && !ACSAWinoFused(tensorIn, tensorOut, winoMess)) || ACSAIsDepthwise(tensorIn, tensorFilter))
+        return 0;
+
+    if(btype == ACSA_BRIDGE_INT8)
+        bsize = sizeof(uint8_t);
+    else if(btype != ACSA_BRIDGE_FP32)
+        bsize = sizeof(uint16_t);
+
+    const int tb = pipelineTiles(P, C, K, bsize, sizeof(Dtype), ntiles);
+    const size_t blocks = nthreads*pipelineSlot(P, tb, C, K, bsize, sizeof(Dtype), isize);
+    // A raw filter goes in front of the blocks in its bridge, so do the INT8 scales of the call
+    // The filter of a raw filter in the bridge and the INT8 scales of the call go in front of the blocks
+    if(btype == ACSA_BRIDGE_BF16 || btype == ACSA_BRIDGE_FP16)
+        return filter16Bytes(P, C, K) + blocks;
+    if(btype == ACSA_BRIDGE_INT8)
+        return int8Bytes(P, C, K, true) + blocks;
+
+    return blocks;
+}
+
+/* Depthwise winograd F(M_H x M_W, R_H x R_W), channel c only meets filter c.
+ * There is no gemm: CV channels of one tile go through the input transform
+ * together, are multiplied point by point with their transformed filters in
+ * the lanes, and go straight through the output transform. wino_filter is the
+ * C x 1 x R_H x R_W filter transformed by ACSAWinoFilterRect, point p of
+ * channel c at wino_filter[p*fstride + c].
+ * */
+template<typename Dtype, int M_H, int R_H, int M_W, int R_W>
+ACSAStatus ACSAWinoDepthwiseRect(const float *BTh, const float *ATh, const float *BTw, const float *ATw,
+        const Dtype *in, const Dtype *wino_filter, const long fstride, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    const int TH = M_H+R_H-1;
+    const int TW = M_W+R_W-1;
+    const int P = TH*TW;
+    const int N = tensorIn->n_;
+    const int C = tensorIn->c_;
+    const int H = tensorIn->h_;
+    const int W = tensorIn->w_;
+    const int pad_h = convMess->pad_h_;
+    const int pad_w = convMess->pad_w_;
+    const int outHeight = tensorOut->h_;
+    const int outWidth = tensorOut->w_;
+    const int col_nTiles = (outWidth+M_W-1)/M_W;
+    const int ntiles = ((outHeight+M_H-1)/M_H)*col_nTiles;
+    const int ncb = (C+CV_BLOCK-1)/CV_BLOCK;
+
+    // Check
+    ACSA_CHECK((ACSAIsDepthwise(tensorIn, tensorFilter)));
+    ACSA_CHECK(((tensorFilter->h_ == R_H) && (tensorFilter->w_ == R_W)));
+    ACSA_CHECK(((outHeight == H+2*pad_h-R_H+1) && (outWidth == W+2*pad_w-R_W+1)));
+    if(poolMess != NULL){
+        if(M_H%2 != 0 || M_W%2 != 0){
+            ACSA_MESSAGE("ERROR: Odd output tiles can not fuse pooling!\n");
+            return ACSAFAIL;
+        }
+        ACSA_CHECK(ACSAPoolFusible(poolMess, outHeight, outWidth));
+    }
+
+    Dtype slope, ceil;
+    ACSAActivParam(activMess, slope, ceil);
+
+    /* Layout and shape of out. */
+    ACSATensor4d tensorDst = *tensorOut;
+    if(poolMess != NULL){
+        tensorDst.h_ = outHeight/2;
+        tensorDst.w_ = outWidth/2;
+    }
+
+    /* The lanes of a pixel are its channels, one plane apart in NCHW. */
+    const long istep = (tensorIn->format_ == ACSA_TENSOR_NCHW) ? (long)H*W : 1;
+    const long ostep = (tensorOut->format_ == ACSA_TENSOR_NCHW) ? (long)tensorDst.h_*tensorDst.w_ : 1;
+
+    int d1;
+#pragma omp parallel for private(d1) schedule(dynamic)
+    for(d1 = 0; d1 < N*ncb; d1++){
+        const int n = d1/ncb;
+        const int c0 = (d1%ncb)*CV_BLOCK;
+        const int cv = std::min(CV_BLOCK, C-c0);
+        int t, i, j, l, p;
+        Dtype u[P*CV_BLOCK] __attribute__((aligned(64)));
+        Dtype tmp[P*CV_BLOCK] __attribute__((aligned(64)));
+        Dtype bridge[P*CV_BLOCK] __attribute__((aligned(64)));
+        Dtype middle[M_H*M_W*CV_BLOCK] __attribute__((aligned(64)));
+        Dtype bk[CV_BLOCK];
+
+        for(p = 0; p < P; p++)
+            for(l = 0; l < CV_BLOCK; l++)
+                u[p*CV_BLOCK + l] = (l < cv) ? wino_filter[(long)p*fstride + c0+l] : (Dtype)0;
+        for(l = 0; l < CV_BLOCK; l++)
+            bk[l] = (bias == NULL || l >= cv) ? (Dtype)0 : bias[c0+l];
+
+        for(t = 0; t < ntiles; t++){
+            const int r_init = (t/col_nTiles)*M_H;
+            const int c_init = (t%col_nTiles)*M_W;
+            const int r_out = std::min(M_H, outHeight-r_init);
+            const int c_out = std::min(M_W, outWidth-c_init);
+
+            for(i = 0; i < TH; i++)
+                for(j = 0; j < TW; j++){
+                    const int r = r_init+i-pad_h;
+                    const int s = c_init+j-pad_w;
+                    Dtype *d = tmp + (i*TW + j)*CV_BLOCK;
+                    if(r >= 0 && r < H && s >= 0 && s < W){
+                        const Dtype *src = in + ACSATensorOffset(tensorIn, n, c0, r, s);
+                        for(l = 0; l < cv; l++)
+                            d[l] = src[l*istep];
+                        for(; l < CV_BLOCK; l++)
+                            d[l] = 0;
+                    }
+                    else
+                        for(l = 0; l < CV_BLOCK; l++)
+                            d[l] = 0;
+                }
+            tile_trans_in<Dtype, TH, TW, CV_BLOCK>(BTh, BTw, tmp, bridge);
+
+            // The element-wise product takes the place of the gemm
+            for(p = 0; p < P*CV_BLOCK; p++)
+                bridge[p] *= u[p];
+
+            tile_trans_out<Dtype, M_H, TH, M_W, TW, CV_BLOCK>(ATh, ATw, bridge, middle);
+            for(p = 0; p < M_H*M_W; p++)
+                for(l = 0; l < CV_BLOCK; l++)
+                    middle[p*CV_BLOCK + l] = ACSAActivate<Dtype>(middle[p*CV_BLOCK + l], bk[l], slope, ceil);
+
+            if(poolMess == NULL){
+                for(i = 0; i < r_out; i++)
+                    for(j = 0; j < c_out; j++){
+                        Dtype *dst = out + ACSATensorOffset(&tensorDst, n, c0, r_init+i, c_init+j);
+                        for(l = 0; l < cv; l++)
+                            dst[l*ostep] = middle[(i*M_W + j)*CV_BLOCK + l];
+                    }
+            }
+            else if(M_H%2 == 0 && M_W%2 == 0){
+                for(i = 0; i < r_out; i += 2)
+                    for(j = 0; j < c_out; j += 2){
+                        const Dtype *m0 = middle + (i*M_W + j)*CV_BLOCK;
+                        const Dtype *m1 = m0 + M_W*CV_BLOCK;
+                        Dtype *dst = out + ACSATensorOffset(&tensorDst, n, c0, (r_init+i)/2, (c_init+j)/2);
+                        for(l = 0; l < cv; l++)
+                            dst[l*ostep] = std::max(std::max(m0[l], m0[CV_BLOCK+l]), std::max(m1[l], m1[CV_BLOCK+l]));
+                    }
+            }
+        }
+    }
+
+    return ACSASUCCESS;
+}
+
+/* Depthwise winograd F(F_M,3), the same matrixes for rows and columns. */
+template<typename Dtype, int F_M>
+ACSAStatus ACSAWinoDepthwise(const float *BT, const float *AT,
+        const Dtype *in, const Dtype *wino_filter, const long fstride, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    return ACSAWinoDepthwiseRect<Dtype, F_M, 3, F_M, 3>(BT, AT, BT, AT,
+            in, wino_filter, fstride, out, tensorIn, tensorFilter, tensorOut,
+            convMess, bias, activMess, poolMess);
+}
+
+/* Transform the K x C x R_H x R_W filter to U = Gh * g * Gw^T,
+ * point p of filter (k, c) is wino_filter[p*fstride + k*C + c].
+ * */
+template<typename Dtype, int M_H, int R_H, int M_W, int R_W>
+ACSAStatus ACSAWinoFilterRect(const float *Gh, const float *Gw,
+        const Dtype *filter, Dtype *wino_filter, const int C, const int K, const long fstride)
+{
+    const int TH = M_H+R_H-1;
+    const int TW = M_W+R_W-1;
+    int d1;
+
+#pragma omp parallel for private(d1)
+    for(d1 = 0; d1 < K*C; d1++){
+        const Dtype *g = filter + (long)d1*R_H*R_W;
+        Dtype bridge[TH*R_W];
+        int i, j, k;
+
+        for(i = 0; i < TH; i++)
+            for(j = 0; j < R_W; j++){
+                Dtype s = 0;
+                for(k = 0; k < R_H; k++)
+                    s += Gh[i*R_H + k]*g[k*R_W + j];
+                bridge[i*R_W + j] = s;
+            }
+        for(i = 0; i < TH; i++)
+            for(j = 0; j < TW; j++){
+                Dtype s = 0;
+                for(k = 0; k < R_W; k++)
+                    s += bridge[i*R_W + k]*Gw[j*R_W + k];
+                wino_filter[(long)(i*TW + j)*fstride + d1] = s;
+            }
+    }
+
+    return ACSASUCCESS;
+}
+
+/* Tiles of a block and blocks of a chunk for the filter gradient of
+ * F(M_H x M_W, r x s), the chunk is capped by BWD_CHUNK_BYTES and the batch.
+ * */
+static void bwdFilterBlocks(const int M_H, const int M_W, ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter,
+        ACSATensor4d* tensorGrad, const size_t dsize, int &tb, int &nc)
+{
+    const int P = (M_H+tensorFilter->h_-1)*(M_W+tensorFilter->w_-1);
+    const int C = tensorIn->c_;
+    const int K = tensorFilter->n_;
+    const int ntiles = ((tensorGrad->h_+M_H-1)/M_H)*((tensorGrad->w_+M_W-1)/M_W);
+
+    tb = L2_BUDGET/(P*(C+K)*dsize);
+    tb = std::min(std::max(tb, MIN_BLOCK), ntiles);
+    const long nitems = (long)tensorIn->n_*((ntiles+tb-1)/tb);
+    nc = (int)std::max(1L, std::min(nitems, BWD_CHUNK_BYTES/(long)(P*tb*(C+K)*dsize)));
+}
+
+/* Bytes of workspace of ACSAWinoBwdFilterRect, tensorGrad is the stride-1 shape of diffOut. */
+size_t ACSAWinoBwdFilterBytes(const int M_H, const int M_W, ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter,
+        ACSATensor4d* tensorGrad, const size_t dsize)
+{
+    const int P = (M_H+tensorFilter->h_-1)*(M_W+tensorFilter->w_-1);
+    int tb, nc;
+
+    bwdFilterBlocks(M_H, M_W, tensorIn, tensorFilter, tensorGrad, dsize, tb, nc);
+
+    return ((long)nc*P*tb*(tensorIn->c_+tensorFilter->n_) + (long)P*tensorFilter->n_*tensorFilter->c_)*dsize;
+}
+
+/* y = Mh^T * x * Mw for CV channels of one tile, x is [XH*XW][CV] and y is [YH*YW][CV].
+ * Mh is XH x YH and Mw is XW x YW, the transposes of the matrixes of tile_trans_out.
+ * */
+template<typename Dtype, int XH, int YH, int XW, int YW, int CV>
+static inline void tile_trans_t(const float *Mh, const float *Mw, const Dtype *x, Dtype *y)
+{
+    int i, j, k, l;
+    Dtype bridge[YH*XW*CV];
+
+    for(i = 0; i < YH; i++)
+        for(j = 0; j < XW; j++){
+            Dtype *b = bridge + (i*XW + j)*CV;
+            for(l = 0; l < CV; l++)
+                b[l] = 0;
+            for(k = 0; k < XH; k++){
+                const Dtype a = Mh[k*YH + i];
+                const Dtype *src = x + (k*XW + j)*CV;
+                for(l = 0; l < CV; l++)
+                    b[l] += a*src[l];
+            }
+        }
+    for(i = 0; i < YH; i++)
+        for(j = 0; j < YW; j++){
+            Dtype *dst = y + (i*YW + j)*CV;
+            for(l = 0; l < CV; l++)
+                dst[l] = 0;
+            for(k = 0; k < XW; k++){
+                const Dtype a = Mw[k*YW + j];
+                const Dtype *b = bridge + (i*XW + k)*CV;
+                for(l = 0; l < CV; l++)
+                    dst[l] += a*b[l];
+            }
+        }
+}
+
+/* Transform of the output gradient, tiles [t0, t0+nt) of image n by ATh^T * dy * ATw,
+ * matrix of point p is nt*K as the gemm output of the forward pipeline.
+ * */
+template<typename Dtype, int M_H, int R_H, int M_W, int R_W, int CV>
+static void blockByTransformGrad(const float *ATh, const float *ATw, const Dtype *grad, ACSATensor4d *tensorGrad,
+        const int n, const int t0, const int nt, const int col_nTiles, Dtype *wino_grad)
+{
+    const int TH = M_H+R_H-1;
+    const int TW = M_W+R_W-1;
+    const int P = TH*TW;
+    const int K = tensorGrad->c_;
+    const int outHeight = tensorGrad->h_;
+    const int outWidth = tensorGrad->w_;
+    int k0, t, i, j, l, p;
+    Dtype tmp[M_H*M_W*CV] __attribute__((aligned(64)));
+    Dtype bridge[P*CV] __attribute__((aligned(64)));
+
+    for(k0 = 0; k0 < K; k0 += CV){
+        const int kv = std::min(CV, K-k0);
+        for(t = 0; t < nt; t++){
+            const int r_init = ((t0+t)/col_nTiles)*M_H;
+            const int c_init = ((t0+t)%col_nTiles)*M_W;
+            for(i = 0; i < M_H; i++)
+                for(j = 0; j < M_W; j++){
+                    Dtype *d = tmp + (i*M_W + j)*CV;
+                    if(r_init+i < outHeight && c_init+j < outWidth){
+                        const Dtype *src = grad + ACSATensorOffset(tensorGrad, n, k0, r_init+i, c_init+j);
+                        for(l = 0; l < kv; l++)
+                            d[l] = src[l];
+                        for(; l < CV; l++)
+                            d[l] = 0;
+                    }
+                    else
+                        for(l = 0; l < CV; l++)
+                            d[l] = 0;
+                }
+            tile_trans_t<Dtype, M_H, TH, M_W, TW, CV>(ATh, ATw, tmp, bridge);
+            for(p = 0; p < P; p++)
+                for(l = 0; l < kv; l++)
+                    wino_grad[(long)p*nt*K + (long)(k0+l)*nt + t] = bridge[p*CV + l];
+        }
+    }
+}
+
+/* c(m, n) += a(k, m)^T * b(k, n) of column major, on this thread only. */
+template<typename Dtype>
+static inline void gemm_tn(const int m, const int n, const int k, const Dtype *a, const int lda,
+        const Dtype *b, const int ldb, Dtype *c, const int ldc)
+{
+    const char transa = 't';
+    const char transb = 'n';
+    const Dtype one = 1.0;
+
+    if(typeid(Dtype) == typeid(float))
+        sgemm(&transa, &transb, &m, &n, &k, (const float *)&one, (const float *)a, &lda,
+                (const float *)b, &ldb, (const float *)&one, (float *)c, &ldc);
+    else if(typeid(Dtype) == typeid(double))
+        dgemm(&transa, &transb, &m, &n, &k, (const double *)&one, (const double *)a, &lda,
+                (const double *)b, &ldb, (const double *)&one, (double *)c, &ldc);
+}
+
+/* Filter gradient of winograd F(M_H x M_W, R_H x R_W), the transpose of the forward algorithm.
+ * With V = BTh * d * BTw^T of the input tiles and M = ATh^T * dy * ATw of the output
+ * gradient tiles, the gradient in the winograd domain is dU(p) = V(p)^T * M(p) summed
+ * over all tiles of the batch, and the filter gradient is Gh^T * dU * Gw.
+ * A chunk of tile blocks is transformed in parallel into the workspace, then every task
+ * owns a point, a group and a block of filters of dU and adds the blocks of the chunk in
+ * order, so the sum is the same for any number of threads. diffOut is stride 1, its
+ * shape is tensorOut, and it may be shorter than in+2*pad-r+1 as a spread strided gradient.
+ * */
+template<typename Dtype, int M_H, int R_H, int M_W, int R_W>
+ACSAStatus ACSAWinoBwdFilterRect(const float *BTh, const float *ATh, const float *Gh,
+        const float *BTw, const float *ATw, const float *Gw,
+        ACSAHandle *handle, const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess)
+{
+    const int TH = M_H+R_H-1;
+    const int TW = M_W+R_W-1;
+    const int P = TH*TW;
+    const int N = tensorIn->n_;
+    const int C = tensorIn->c_;
+    const int K = tensorFilter->n_;
+    const int G = convMess->groups_;
+    const int Cg = C/G;
+    const int Kg = K/G;
+    const int pad_h = convMess->pad_h_;
+    const int pad_w = convMess->pad_w_;
+    const int outHeight = tensorOut->h_;
+    const int outWidth = tensorOut->w_;
+    const int col_nTiles = (outWidth+M_W-1)/M_W;
+    const int ntiles = ((outHeight+M_H-1)/M_H)*col_nTiles;
+    const int vec_in = (tensorIn->format_ != ACSA_TENSOR_NCHW);
+    const int vec_out = (tensorOut->format_ != ACSA_TENSOR_NCHW);
+    const int nkb = (Kg+BWD_KB-1)/BWD_KB;
+    int tb, nc, i0, d1;
+
+    // Check
+    ACSA_CHECK(((tensorFilter->h_ == R_H) && (tensorFilter->w_ == R_W)));
+    ACSA_CHECK(((tensorFilter->c_ == Cg) && (K%G == 0) && (tensorOut->c_ == K)));
+    ACSA_CHECK(((outHeight <= tensorIn->h_+2*pad_h-R_H+1) && (outWidth <= tensorIn->w_+2*pad_w-R_W+1)));
+
+    bwdFilterBlocks(M_H, M_W, tensorIn, tensorFilter, tensorOut, sizeof(Dtype), tb, nc);
+    const int nblocks = (ntiles+tb-1)/tb;
+    const int nitems = N*nblocks;
+
+    Dtype *wino_in = (Dtype *)ACSAReserveWorkspace(handle,
+            ACSAWinoBwdFilterBytes(M_H, M_W, tensorIn, tensorFilter, tensorOut, sizeof(Dtype)));
+    if(wino_in == NULL)
+        return ACSAFAIL;
+    Dtype *wino_grad = wino_in + (long)nc*P*tb*C;
+    Dtype *wino_diff = wino_grad + (long)nc*P*tb*K;
+
+    memset(wino_diff, 0, (long)P*K*Cg*sizeof(Dtype));
+
+    for(i0 = 0; i0 < nitems; i0 += nc){
+        const int ni = std::min(nc, nitems-i0);
+
+        /* Block i of the chunk is tiles [t0, t0+nt) of image n. */
+#pragma omp parallel for private(d1) schedule(dynamic)
+        for(d1 = 0; d1 < ni; d1++){
+            const int n = (i0+d1)/nblocks;
+            const int t0 = (i0+d1)%nblocks*tb;
+            const int nt = std::min(tb, ntiles-t0);
+            Dtype *v = wino_in + (long)d1*P*tb*C;
+            Dtype *m = wino_grad + (long)d1*P*tb*K;
+
+            if(vec_in)
+                blockByTransformIn<Dtype, Dtype, M_H, R_H, M_W, R_W, CV_BLOCK, 1>(BTh, BTw, in, tensorIn,
+                        n, t0, nt, col_nTiles, pad_h, pad_w, v, ACSA_BRIDGE_FP32, NULL);
+            else
+                blockByTransformIn<Dtype, Dtype, M_H, R_H, M_W, R_W, 1, 1>(BTh, BTw, in, tensorIn,
+                        n, t0, nt, col_nTiles, pad_h, pad_w, v, ACSA_BRIDGE_FP32, NULL);
+
+            if(vec_out)
+                blockByTransformGrad<Dtype, M_H, R_H, M_W, R_W, CV_BLOCK>(ATh, ATw, diffOut, tensorOut,
+                        n, t0, nt, col_nTiles, m);
+            else
+                blockByTransformGrad<Dtype, M_H, R_H, M_W, R_W, 1>(ATh, ATw, diffOut, tensorOut,
+                        n, t0, nt, col_nTiles, m);
+        }
+
+        /* dU(p) of filters [k0, k0+kb) of group g, Cg x kb, adds V^T * M of the blocks in order. */
+#pragma omp parallel for private(d1) schedule(dynamic)
+        for(d1 = 0; d1 < P*G*nkb; d1++){
+            const int p = d1/(G*nkb);
+            const int g = d1/nkb%G;
+            const int k0 = g*Kg + d1%nkb*BWD_KB;
+            const int kb = std::min(BWD_KB, (g+1)*Kg-k0);
+            Dtype *du = wino_diff + (long)p*K*Cg + (long)k0*Cg;
+
+            for(int i = 0; i < ni; i++){
+                const int nt = std::min(tb, ntiles-(i0+i)%nblocks*tb);
+                const Dtype *v = wino_in + (long)i*P*tb*C + (long)p*nt*C + (long)g*Cg*nt;
+                const Dtype *m = wino_grad + (long)i*P*tb*K + (long)p*nt*K + (long)k0*nt;
+
+                gemm_tn(Cg, kb, nt, v, nt, m, nt, du, Cg);
+            }
+        }
+    }
+
+    /* Filter (k, c) of the gradient is Gh^T * dU * Gw. */
+#pragma omp parallel for private(d1)
+    for(d1 = 0; d1 < K*Cg; d1++){
+        Dtype du[P];
+
+        for(int p = 0; p < P; p++)
+            du[p] = wino_diff[(long)p*K*Cg + d1];
+        tile_trans_t<Dtype, TH, R_H, TW, R_W, 1>(Gh, Gw, du, diffFilter + (long)d1*R_H*R_W);
+    }
+
+    return ACSASUCCESS;
+}
+
+/* Filter gradient of winograd F(F_M,3), the same matrixes for rows and columns. */
+template<typename Dtype, int F_M>
+ACSAStatus ACSAWinoBwdFilter(const float *BT, const float *AT, const float *G,
+        ACSAHandle *handle, const Dtype *in, const Dtype *diffOut, Dtype *diffFilter,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess)
+{
+    return ACSAWinoBwdFilterRect<Dtype, F_M, 3, F_M, 3>(BT, AT, G, BT, AT, G,
+            handle, in, diffOut, diffFilter, tensorIn, tensorFilter, tensorOut, convMess);
+}
+
+/* Instantiate Template */
+template size_t ACSAWinoPipelineBytes<float>(const int, const int, ACSATensor4d*, ACSATensor4d*,
+        ACSATensor4d*, ACSAWinoMessage*, const int, const int);
+template size_t ACSAWinoPipelineBytes<double>(const int, const int, ACSATensor4d*, ACSATensor4d*,
+        ACSATensor4d*, ACSAWinoMessage*, const int, const int);
+
+template ACSAStatus ACSAWinoPipeline<float, 2>(const float *, const float *,
+        const float *, const float *, const long, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipeline<float, 3>(const float *, const float *,
+        const float *, const float *, const long, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipeline<float, 4>(const float *, const float *,
+        const float *, const float *, const long, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipeline<float, 6>(const float *, const float *,
+        const float *, const float *, const long, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+
+template ACSAStatus ACSAWinoPipeline<double, 2>(const float *, const float *,
+        const double *, const double *, const long, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipeline<double, 3>(const float *, const float *,
+        const double *, const double *, const long, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipeline<double, 4>(const float *, const float *,
+        const double *, const double *, const long, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipeline<double, 6>(const float *, const float *,
+        const double *, const double *, const long, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+
+template ACSAStatus ACSAWinoPipelineStride2<float, 2>(const float *, const float *,
+        const float *, const float *, const long, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipelineStride2<float, 3>(const float *, const float *,
+        const float *, const float *, const long, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipelineStride2<float, 4>(const float *, const float *,
+        const float *, const float *, const long, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipelineStride2<float, 5>(const float *, const float *,
+        const float *, const float *, const long, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipelineStride2<float, 6>(const float *, const float *,
+        const float *, const float *, const long, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipelineStride2<float, 8>(const float *, const float *,
+        const float *, const float *, const long, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+
+template ACSAStatus ACSAWinoPipelineStride2<double, 2>(const float *, const float *,
+        const double *, const double *, const long, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipelineStride2<double, 3>(const float *, const float *,
+        const double *, const double *, const long, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipelineStride2<double, 4>(const float *, const float *,
+        const double *, const double *, const long, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipelineStride2<double, 5>(const float *, const float *,
+        const double *, const double *, const long, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipelineStride2<double, 6>(const float *, const float *,
+        const double *, const double *, const long, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipelineStride2<double, 8>(const float *, const float *,
+        const double *, const double *, const long, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+
+template ACSAStatus ACSAWinoPipelineRect<float, 2, 5, 2, 5>(const float *, const float *, const float *, const float *,
+        const float *, const float *, const long, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipelineRect<float, 4, 5, 4, 5>(const float *, const float *, const float *, const float *,
+        const float *, const float *, const long, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipelineRect<float, 5, 3, 5, 3>(const float *, const float *, const float *, const float *,
+        const float *, const float *, const long, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipelineRect<float, 8, 3, 8, 3>(const float *, const float *, const float *, const float *,
+        const float *, const float *, const long, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipelineRect<float, 1, 1, 4, 3>(const float *, const float *, const float *, const float *,
+        const float *, const float *, const long, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipelineRect<float, 4, 3, 1, 1>(const float *, const float *, const float *, const float *,
+        const float *, const float *, const long, const ACSAWinoFilter *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+
+template ACSAStatus ACSAWinoPipelineRect<double, 2, 5, 2, 5>(const float *, const float *, const float *, const float *,
+        const double *, const double *, const long, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipelineRect<double, 4, 5, 4, 5>(const float *, const float *, const float *, const float *,
+        const double *, const double *, const long, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipelineRect<double, 5, 3, 5, 3>(const float *, const float *, const float *, const float *,
+        const double *, const double *, const long, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipelineRect<double, 8, 3, 8, 3>(const float *, const float *, const float *, const float *,
+        const double *, const double *, const long, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipelineRect<double, 1, 1, 4, 3>(const float *, const float *, const float *, const float *,
+        const double *, const double *, const long, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoPipelineRect<double, 4, 3, 1, 1>(const float *, const float *, const float *, const float *,
+        const double *, const double *, const long, const ACSAWinoFilter *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*, ACSAWinoMessage*, void *,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+
+template ACSAStatus ACSAWinoDepthwise<float, 2>(const float *, const float *,
+        const float *, const float *, const long, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoDepthwise<float, 3>(const float *, const float *,
+        const float *, const float *, const long, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoDepthwise<float, 4>(const float *, const float *,
+        const float *, const float *, const long, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoDepthwise<float, 6>(const float *, const float *,
+        const float *, const float *, const long, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+
+template ACSAStatus ACSAWinoDepthwise<double, 2>(const float *, const float *,
+        const double *, const double *, const long, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoDepthwise<double, 3>(const float *, const float *,
+        const double *, const double *, const long, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoDepthwise<double, 4>(const float *, const float *,
+        const double *, const double *, const long, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoDepthwise<double, 6>(const float *, const float *,
+        const double *, const double *, const long, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+
+template ACSAStatus ACSAWinoDepthwiseRect<float, 2, 5, 2, 5>(const float *, const float *, const float *, const float *,
+        const float *, const float *, const long, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoDepthwiseRect<float, 4, 5, 4, 5>(const float *, const float *, const float *, const float *,
+        const float *, const float *, const long, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoDepthwiseRect<float, 5, 3, 5, 3>(const float *, const float *, const float *, const float *,
+        const float *, const float *, const long, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoDepthwiseRect<float, 8, 3, 8, 3>(const float *, const float *, const float *, const float *,
+        const float *, const float *, const long, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoDepthwiseRect<float, 1, 1, 4, 3>(const float *, const float *, const float *, const float *,
+        const float *, const float *, const long, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoDepthwiseRect<float, 4, 3, 1, 1>(const float *, const float *, const float *, const float *,
+        const float *, const float *, const long, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*,
+        const float *, ACSAActivMessage*, ACSAPoolMessage*);
+
+template ACSAStatus ACSAWinoDepthwiseRect<double, 2, 5, 2, 5>(const float *, const float *, const float *, const float *,
+        const double *, const double *, const long, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoDepthwiseRect<double, 4, 5, 4, 5>(const float *, const float *, const float *, const float *,
+        const double *, const double *, const long, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoDepthwiseRect<double, 5, 3, 5, 3>(const float *, const float *, const float *, const float *,
+        const double *, const double *, const long, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoDepthwiseRect<double, 8, 3, 8, 3>(const float *, const float *, const float *, const float *,
+        const double *, const double *, const long, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoDepthwiseRect<double, 1, 1, 4, 3>(const float *, const float *, const float *, const float *,
+        const double *, const double *, const long, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+template ACSAStatus ACSAWinoDepthwiseRect<double, 4, 3, 1, 1>(const float *, const float *, const float *, const float *,
+        const double *, const double *, const long, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*,
+        const double *, ACSAActivMessage*, ACSAPoolMessage*);
+
+template ACSAStatus ACSAWinoFilterRect<float, 2, 5, 2, 5>(const float *, const float *,
+        const float *, float *, const int, const int, const long);
+template ACSAStatus ACSAWinoFilterRect<float, 4, 5, 4, 5>(const float *, const float *,
+        const float *, float *, const int, const int, const long);
+template ACSAStatus ACSAWinoFilterRect<float, 5, 3, 5, 3>(const float *, const float *,
+        const float *, float *, const int, const int, const long);
+template ACSAStatus ACSAWinoFilterRect<float, 8, 3, 8, 3>(const float *, const float *,
+        const float *, float *, const int, const int, const long);
+template ACSAStatus ACSAWinoFilterRect<float, 1, 1, 4, 3>(const float *, const float *,
+        const float *, float *, const int, const int, const long);
+template ACSAStatus ACSAWinoFilterRect<float, 4, 3, 1, 1>(const float *, const float *,
+        const float *, float *, const int, const int, const long);
+template ACSAStatus ACSAWinoFilterRect<float, 3, 3, 3, 3>(const float *, const float *,
+        const float *, float *, const int, const int, const long);
+template ACSAStatus ACSAWinoFilterRect<float, 7, 3, 7, 3>(const float *, const float *,
+        const float *, float *, const int, const int, const long);
+template ACSAStatus ACSAWinoFilterRect<float, 9, 3, 9, 3>(const float *, const float *,
+        const float *, float *, const int, const int, const long);
+template ACSAStatus ACSAWinoFilterRect<float, 11, 3, 11, 3>(const float *, const float *,
+        const float *, float *, const int, const int, const long);
+template ACSAStatus ACSAWinoFilterRect<float, 15, 3, 15, 3>(const float *, const float *,
+        const float *, float *, const int, const int, const long);
+
+template ACSAStatus ACSAWinoFilterRect<double, 2, 5, 2, 5>(const float *, const float *,
+        const double *, double *, const int, const int, const long);
+template ACSAStatus ACSAWinoFilterRect<double, 4, 5, 4, 5>(const float *, const float *,
+        const double *, double *, const int, const int, const long);
+template ACSAStatus ACSAWinoFilterRect<double, 5, 3, 5, 3>(const float *, const float *,
+        const double *, double *, const int, const int, const long);
+template ACSAStatus ACSAWinoFilterRect<double, 8, 3, 8, 3>(const float *, const float *,
+        const double *, double *, const int, const int, const long);
+template ACSAStatus ACSAWinoFilterRect<double, 1, 1, 4, 3>(const float *, const float *,
+        const double *, double *, const int, const int, const long);
+template ACSAStatus ACSAWinoFilterRect<double, 4, 3, 1, 1>(const float *, const float *,
+        const double *, double *, const int, const int, const long);
+template ACSAStatus ACSAWinoFilterRect<double, 3, 3, 3, 3>(const float *, const float *,
+        const double *, double *, const int, const int, const long);
+template ACSAStatus ACSAWinoFilterRect<double, 7, 3, 7, 3>(const float *, const float *,
+        const double *, double *, const int, const int, const long);
+template ACSAStatus ACSAWinoFilterRect<double, 9, 3, 9, 3>(const float *, const float *,
+        const double *, double *, const int, const int, const long);
+template ACSAStatus ACSAWinoFilterRect<double, 11, 3, 11, 3>(const float *, const float *,
+        const double *, double *, const int, const int, const long);
+template ACSAStatus ACSAWinoFilterRect<double, 15, 3, 15, 3>(const float *, const float *,
+        const double *, double *, const int, const int, const long);
+
+template ACSAStatus ACSAWinoBwdFilter<float, 2>(const float *, const float *, const float *,
+        ACSAHandle *, const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+template ACSAStatus ACSAWinoBwdFilter<float, 3>(const float *, const float *, const float *,
+        ACSAHandle *, const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+template ACSAStatus ACSAWinoBwdFilter<float, 4>(const float *, const float *, const float *,
+        ACSAHandle *, const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+template ACSAStatus ACSAWinoBwdFilter<float, 6>(const float *, const float *, const float *,
+        ACSAHandle *, const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+template ACSAStatus ACSAWinoBwdFilterRect<float, 2, 5, 2, 5>(const float *, const float *, const float *,
+        const float *, const float *, const float *,
+        ACSAHandle *, const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+template ACSAStatus ACSAWinoBwdFilterRect<float, 4, 5, 4, 5>(const float *, const float *, const float *,
+        const float *, const float *, const float *,
+        ACSAHandle *, const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+template ACSAStatus ACSAWinoBwdFilterRect<float, 5, 3, 5, 3>(const float *, const float *, const float *,
+        const float *, const float *, const float *,
+        ACSAHandle *, const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+template ACSAStatus ACSAWinoBwdFilterRect<float, 8, 3, 8, 3>(const float *, const float *, const float *,
+        const float *, const float *, const float *,
+        ACSAHandle *, const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+template ACSAStatus ACSAWinoBwdFilterRect<float, 1, 1, 4, 3>(const float *, const float *, const float *,
+        const float *, const float *, const float *,
+        ACSAHandle *, const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+template ACSAStatus ACSAWinoBwdFilterRect<float, 4, 3, 1, 1>(const float *, const float *, const float *,
+        const float *, const float *, const float *,
+        ACSAHandle *, const float *, const float *, float *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+
+template ACSAStatus ACSAWinoBwdFilter<double, 2>(const float *, const float *, const float *,
+        ACSAHandle *, const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+template ACSAStatus ACSAWinoBwdFilter<double, 3>(const float *, const float *, const float *,
+        ACSAHandle *, const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+template ACSAStatus ACSAWinoBwdFilter<double, 4>(const float *, const float *, const float *,
+        ACSAHandle *, const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+template ACSAStatus ACSAWinoBwdFilter<double, 6>(const float *, const float *, const float *,
+        ACSAHandle *, const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+template ACSAStatus ACSAWinoBwdFilterRect<double, 2, 5, 2, 5>(const float *, const float *, const float *,
+        const float *, const float *, const float *,
+        ACSAHandle *, const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+template ACSAStatus ACSAWinoBwdFilterRect<double, 4, 5, 4, 5>(const float *, const float *, const float *,
+        const float *, const float *, const float *,
+        ACSAHandle *, const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+template ACSAStatus ACSAWinoBwdFilterRect<double, 5, 3, 5, 3>(const float *, const float *, const float *,
+        const float *, const float *, const float *,
+        ACSAHandle *, const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+template ACSAStatus ACSAWinoBwdFilterRect<double, 8, 3, 8, 3>(const float *, const float *, const float *,
+        const float *, const float *, const float *,
+        ACSAHandle *, const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+template ACSAStatus ACSAWinoBwdFilterRect<double, 1, 1, 4, 3>(const float *, const float *, const float *,
+        const float *, const float *, const float *,
+        ACSAHandle *, const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
+template ACSAStatus ACSAWinoBwdFilterRect<double, 4, 3, 1, 1>(const float *, const float *, const float *,
+        const float *, const float *, const float *,
+        ACSAHandle *, const double *, const double *, double *,
+        ACSATensor4d*, ACSATensor4d*, ACSATensor4d*,
+        ACSAConvMessage*);
@@ -0,0 +1,238 @@
+/* Stride-2 convolution by winograd.
+ * Output y(i) of stride 2 is d(2i)g0 + d(2i+2)g2 + d(2i+1)g1: the even
+ * inputs meet the even taps as a stride-1 correlation of 2 taps, and the odd
+ * inputs meet the middle tap alone. A tile of m outputs reads 2m+1 inputs,
+ * F(m,2) takes the m+1 even ones and F(m,1) = [1] the m odd ones, so the
+ * matrixes of the tile are
+ *   BT[i][2k] = BT2[i][k], BT[m+1+j][2j+1] = 1
+ *   G[i][0] = G2[i][0], G[i][2] = G2[i][1], G[m+1+j][1] = 1
+ *   AT[i][k] = AT2[i][k], AT[i][m+1+i] = 1
+ * with i, k <= m and j < m. In 2D they run the four phases of the filter,
+ * 2x2, 2x1, 1x2 and 1x1 taps, as their own sub-kernels in (2m+1)^2 points,
+ * 6.25, 5.06 and 4.69 products of an output for m = 2, 4 and 6 against the
+ * 9 of the direct convolution. The tiles run by the fused pipeline, which
+ * reads them from in as it is, in any layout.
+ * */
+
+#include "dnn.hpp"
+
+
+/* AT-G-BT of the stride-2 tile of F(M,3), filled when the library loads.
+ * dim-AT: M, TILE
+ * dim-G : TILE, 3
+ * dim-BT: TILE, TILE
+ */
+template<int M>
+struct StrideToom {
+    float AT[M*(2*M+1)];
+    float G[(2*M+1)*3];
+    float BT[(2*M+1)*(2*M+1)];
+
+    StrideToom()
+    {
+        const int T = 2*M+1;
+        float AT2[M*(M+1)], G2[(M+1)*2], BT2[(M+1)*(M+1)];
+        int i, j, k;
+
+        ACSAWinoCookToom(M, 2, AT2, G2, BT2);
+        for(i = 0; i < M*T; i++)
+            AT[i] = 0;
+        for(i = 0; i < T*3; i++)
+            G[i] = 0;
+        for(i = 0; i < T*T; i++)
+            BT[i] = 0;
+
+        for(i = 0; i <= M; i++){
+            for(k = 0; k <= M; k++)
+                BT[i*T + 2*k] = BT2[i*(M+1) + k];
+            G[i*3] = G2[i*2];
+            G[i*3 + 2] = G2[i*2 + 1];
+        }
+        for(j = 0; j < M; j++){
+            BT[(M+1+j)*T + 2*j+1] = 1;
+            G[(M+1+j)*3 + 1] = 1;
+        }
+        for(i = 0; i < M; i++){
+            for(k = 0; k <= M; k++)
+                AT[i*T + k] = AT2[i*(M+1) + k];
+            AT[i*T + M+1+i] = 1;
+        }
+    }
+};
+
+static const StrideToom<2> S_2x3;
+static const StrideToom<3> S_3x3;
+static const StrideToom<4> S_4x3;
+static const StrideToom<5> S_5x3;
+static const StrideToom<6> S_6x3;
+static const StrideToom<8> S_8x3;
+
+/* The algorithm of a stride-2 layer, AUTO and TUNE take F(4,3) unless
+ * INT8 needs F(2,3) or the output is smaller than its tile.
+ * */
+template<typename Dtype>
+static ACSAWinogradAlgo strideAlgo(ACSATensor4d* tensorOut, ACSAWinoMessage *winoMess)
+{
+    const ACSAWinogradAlgo algo = winoMess->algo_;
+
+    if(algo != ACSA_WINOGRAD_AUTO && algo != ACSA_WINOGRAD_TUNE)
+        return algo;
+    if(ACSAWinoInt8<Dtype>(winoMess) || tensorOut->h_ < 4 || tensorOut->w_ < 4)
+        return ACSA_WINOGRAD_2X3;
+
+    return ACSA_WINOGRAD_4X3;
+}
+
+/* Bytes of the transformed filter and the blocks of the pipeline, points of F(M,3) of stride 2. */
+template<typename Dtype, int M>
+static size_t strideBytes(ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess, const int nthreads)
+{
+    const int P = (2*M+1)*(2*M+1);
+    const long fstride = no4k_aligned((long)tensorIn->c_*tensorFilter->n_, sizeof(Dtype));
+
+    return P*fstride*sizeof(Dtype) +
+        ACSAWinoPipelineBytes<Dtype>(M, M, tensorIn, tensorFilter, tensorOut, winoMess, nthreads, 2);
+}
+
+/* Stride-2 convolution of the F(M,3) tiles. */
+    template<typename Dtype, int M>
+static ACSAStatus strideConvolution(const StrideToom<M> &F, ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    const int P = (2*M+1)*(2*M+1);
+    const int C = tensorIn->c_;
+    const int K = tensorFilter->n_;
+    const long fstride = no4k_aligned((long)C*K, sizeof(Dtype));
+
+    Dtype *wino_filter = (Dtype *)ACSAReserveWorkspace(handle,
+            strideBytes<Dtype, M>(tensorIn, tensorFilter, tensorOut, winoMess, handle->num_threads_));
+    if(wino_filter == NULL)
+        return ACSAFAIL;
+
+    // The tile of stride 2 has the 2M+1 points of F(2M-1,3)
+    ACSAWinoFilterRect<Dtype, 2*M-1, 3, 2*M-1, 3>(F.G, F.G, filter, wino_filter, C, K, fstride);
+
+    return ACSAWinoPipelineStride2<Dtype, M>(F.BT, F.AT, in, wino_filter, fstride, (const ACSAWinoFilter *)NULL, out,
+            tensorIn, tensorFilter, tensorOut, convMess, winoMess, (void *)(wino_filter + P*fstride),
+            bias, activMess, poolMess);
+}
+
+/* Winograd convolution of stride 2. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoConvolutionStride2(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    const int C = tensorIn->c_;
+    const int H = tensorIn->h_;
+    const int W = tensorIn->w_;
+    const int pad_h = convMess->pad_h_;
+    const int pad_w = convMess->pad_w_;
+    const int outHeight = tensorOut->h_;
+    const int outWidth = tensorOut->w_;
+
+    if(convMess->stride_h_ != 2 || convMess->stride_w_ != 2){
+        ACSA_MESSAGE("ERROR: Only the stride 1 and 2 are supported!");
+        return ACSAFAIL;
+    }
+
+    if(tensorFilter->h_ != 3 || tensorFilter->w_ != 3){
+        ACSA_MESSAGE("ERROR: The stride 2 only supports the 3x3 filters!");
+        return ACSAFAIL;
+    }
+
+    // Check
+    ACSA_CHECK((tensorFilter->c_ == C));
+    ACSA_CHECK(((outHeight == (H+2*pad_h-3)/2+1) && (outWidth == (W+2*pad_w-3)/2+1)));
+
+    const ACSAWinogradAlgo algo = strideAlgo<Dtype>(tensorOut, winoMess);
+    const ACSABridgeType btype = ACSAWinoBridge<Dtype>(winoMess);
+    if(algo == ACSA_WINOGRAD_6X3 && (btype == ACSA_BRIDGE_BF16 || btype == ACSA_BRIDGE_FP16)){
+        ACSA_MESSAGE("ERROR: The stride 2 of winograd F(6,3) only supports the FP32 bridge!");
+        return ACSAFAIL;
+    }
+
+    switch(algo)
+    {
+        case ACSA_WINOGRAD_2X3:
+            return strideConvolution<Dtype, 2>(S_2x3, handle, in, filter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess, bias, activMess, poolMess);
+        case ACSA_WINOGRAD_3X3:
+            return strideConvolution<Dtype, 3>(S_3x3, handle, in, filter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess, bias, activMess, poolMess);
+        case ACSA_WINOGRAD_4X3:
+            return strideConvolution<Dtype, 4>(S_4x3, handle, in, filter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess, bias, activMess, poolMess);
+        case ACSA_WINOGRAD_5X3:
+            return strideConvolution<Dtype, 5>(S_5x3, handle, in, filter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess, bias, activMess, poolMess);
+        case ACSA_WINOGRAD_6X3:
+            return strideConvolution<Dtype, 6>(S_6x3, handle, in, filter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess, bias, activMess, poolMess);
+        case ACSA_WINOGRAD_8X3:
+            return strideConvolution<Dtype, 8>(S_8x3, handle, in, filter, out,
+                    tensorIn, tensorFilter, tensorOut, convMess, winoMess, bias, activMess, poolMess);
+        default:
+            ACSA_MESSAGE("ERROR: The stride 2 only supports the winograd algorithms of 3x3 filters!");
+            return ACSAFAIL;
+    }
+}
+
+/* Bytes of workspace of a stride-2 layer. */
+template<typename Dtype>
+ACSAStatus ACSAWinoWorkspaceSize_stride2(size_t &size,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAWinoMessage *winoMess)
+{
+    const int nthreads = omp_get_max_threads();
+
+    switch(strideAlgo<Dtype>(tensorOut, winoMess))
+    {
+        case ACSA_WINOGRAD_2X3:
+            size = strideBytes<Dtype, 2>(tensorIn, tensorFilter, tensorOut, winoMess, nthreads);
+            break;
+        case ACSA_WINOGRAD_3X3:
+            size = strideBytes<Dtype, 3>(tensorIn, tensorFilter, tensorOut, winoMess, nthreads);
+            break;
+        case ACSA_WINOGRAD_4X3:
+            size = strideBytes<Dtype, 4>(tensorIn, tensorFilter, tensorOut, winoMess, nthreads);
+            break;
+        case ACSA_WINOGRAD_5X3:
+            size = strideBytes<Dtype, 5>(tensorIn, tensorFilter, tensorOut, winoMess, nthreads);
+            break;
+        case ACSA_WINOGRAD_6X3:
+            size = strideBytes<Dtype, 6>(tensorIn, tensorFilter, tensorOut, winoMess, nthreads);
+            break;
+        case ACSA_WINOGRAD_8X3:
+            size = strideBytes<Dtype, 8>(tensorIn, tensorFilter, tensorOut, winoMess, nthreads);
+            break;
+        default:
+            // The convolution returns ACSAFAIL without touching the workspace
+            size = 0;
+            break;
+    }
+
+    return ACSASUCCESS;
+}
+
+/* Instantiate Template */
+template ACSAStatus ACSAWinoConvolutionStride2<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *,
+        const float *, ACSAActivMessage *, ACSAPoolMessage *);
+template ACSAStatus ACSAWinoConvolutionStride2<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *,
+        const double *, ACSAActivMessage *, ACSAPoolMessage *);
+template ACSAStatus ACSAWinoWorkspaceSize_stride2<float>(size_t &,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *, ACSAWinoMessage *);
+template ACSAStatus ACSAWinoWorkspaceSize_stride2<double>(size_t &,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *, ACSAWinoMessage *);
@@ -0,0 +1,248 @@
+/* Auto-tuning of winograd convolution for one layer.
+ * The candidates of (algorithm, merge, batch block) are timed on the data of
+ * the caller, the winner is kept in memory and in a cache file, one line per
+ * layer: "algo batch_block merge key".
+ * */
+
+#include <map>
+#include <string>
+#include "dnn.hpp"
+
+#define TUNE_REPEAT 3
+#define TUNE_CACHE_FILE "acsa_wino_tune.cache"
+
+struct TuneEntry {
+    ACSAWinogradAlgo algo_;
+    int batch_block_;
+    int merge_;
+};
+
+static std::map<std::string, TuneEntry> tuneCache;
+static int tuneCacheLoaded = 0;
+static std::string tuneCpu;    // model name of the CPU, read with the cache
+
+/* Path of the cache file. */
+static const char* tuneCachePath()
+{
+    const char *path = getenv("ACSA_TUNE_CACHE");
+
+    return (path != NULL && path[0] != '\0') ? path : TUNE_CACHE_FILE;
+}
+
+/* Model name of the CPU, tuning results don't carry over other machines. */
+static std::string cpuModel()
+{
+    std::string model = "unknown";
+    char line[256];
+    FILE *fp = fopen("/proc/cpuinfo", "r");
+
+    if(fp == NULL)
+        return model;
+    while(fgets(line, sizeof(line), fp) != NULL){
+        if(strncmp(line, "model name", 10) == 0){
+            const char *s = strchr(line, ':');
+            if(s != NULL){
+                model = s + 2;
+                model.erase(model.find_last_not_of(" \n") + 1);
+            }
+            break;
+        }
+    }
+    fclose(fp);
+
+    return model;
+}
+
+/* Key of one layer, everything changing the best choice is in it.
+ * The number of algorithms keeps the entries of an older enum from decoding to other ones.
+ * */
+    template<typename Dtype>
+static std::string tuneKey(ACSAHandle *handle,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        ACSAPoolMessage *poolMess, const std::string &cpu)
+{
+    char key[512];
+
+    snprintf(key, sizeof(key), "N%d C%d H%d W%d K%d R%dx%dx%d P%dx%d D%d F%d/%d G%d S%d B%d L%d T%d A%d %s",
+            tensorIn->n_, tensorIn->c_, tensorIn->h_, tensorIn->w_, tensorFilter->n_,
+            tensorFilter->c_, tensorFilter->h_, tensorFilter->w_,
+            convMess->pad_h_, convMess->pad_w_, (int)sizeof(Dtype),
+            tensorIn->format_, tensorOut->format_, winoMess->gemm_, winoMess->schedule_, winoMess->bridge_,
+            poolMess != NULL, handle->num_threads_, (int)ACSA_WINOGRAD_AUTO, cpu.c_str());
+
+    return std::string(key);
+}
+
+/* Read the cache file and the CPU model once, the caller holds the lock. */
+static void loadTuneCache()
+{
+    char line[1024];
+    int algo, bb, mg, n;
+    FILE *fp;
+
+    tuneCacheLoaded = 1;
+    tuneCpu = cpuModel();
+    fp = fopen(tuneCachePath(), "r");
+    if(fp == NULL)
+        return;
+    while(fgets(line, sizeof(line), fp) != NULL){
+        if(sscanf(line, "%d %d %d %n", &algo, &bb, &mg, &n) != 3)
+            continue;
+        std::string key = line + n;
+        key.erase(key.find_last_not_of("\n") + 1);
+
+        TuneEntry entry = {(ACSAWinogradAlgo)algo, bb, mg};
+        tuneCache[key] = entry;
+    }
+    fclose(fp);
+}
+
+/* Best time of one candidate, the first run warms up the workspace.
+ * A candidate that fails takes the largest time, so it is never chosen.
+ * */
+    template<typename Dtype>
+static double tuneTime(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    double best = std::numeric_limits<double>::max();
+
+    if(ACSAWinoConvolutionFwd(handle, in, filter, out, tensorIn, tensorFilter, tensorOut,
+                convMess, winoMess, bias, activMess, poolMess) != ACSASUCCESS)
+        return best;
+    for(int r = 0; r < TUNE_REPEAT; r++){
+        double stime = dsecnd();
+        ACSAWinoConvolutionFwd(handle, in, filter, out, tensorIn, tensorFilter, tensorOut,
+                convMess, winoMess, bias, activMess, poolMess);
+        best = std::min(best, dsecnd() - stime);
+    }
+
+    return best;
+}
+
+/* Tune the layer, or take the result from the cache. */
+    template<typename Dtype>
+ACSAStatus ACSAWinoTune(ACSAHandle *handle,
+        const Dtype *in, const Dtype *filter, Dtype *out,
+        ACSATensor4d* tensorIn, ACSATensor4d* tensorFilter, ACSATensor4d* tensorOut,
+        ACSAConvMessage* convMess, ACSAWinoMessage *winoMess,
+        const Dtype *bias, ACSAActivMessage *activMess, ACSAPoolMessage *poolMess)
+{
+    const int N = tensorIn->n_;
+    std::string key;
+    int found = 0;
+    TuneEntry best;
+
+    // The key is made under the lock, the CPU model is read by the first load only
+#pragma omp critical(acsa_tune_cache)
+    {
+        if(!tuneCacheLoaded)
+            loadTuneCache();
+        key = tuneKey<Dtype>(handle, tensorIn, tensorFilter, tensorOut,
+                convMess, winoMess, poolMess, tuneCpu);
+        std::map<std::string, TuneEntry>::iterator it = tuneCache.find(key);
+        if(it != tuneCache.end()){
+            best = it->second;
+            found = 1;
+        }
+    }
+
+    if(!found){
+        const ACSAWinogradAlgo algos[10] = {ACSA_WINOGRAD_2X3, ACSA_WINOGRAD_3X3,
+            ACSA_WINOGRAD_4X3, ACSA_WINOGRAD_6X3, ACSA_WINOGRAD_2X5, ACSA_WINOGRAD_4X5,
+            ACSA_WINOGRAD_4X3_1D, ACSA_WINOGRAD_5X3, ACSA_CONV_DIRECT, ACSA_CONV_GEMM};
+        const int merges[4] = {1, 2, 4, 8};
+        const int blocks[4] = {8, 16, 32, 64};
+        ACSAWinoMessage cand = *winoMess;
+        double t, best_time = std::numeric_limits<double>::max();
+        int i, j;
+
+        /* Algorithm and merge over the whole batch first,
+         * then the batch block for the winner of them.
+         * */
+        for(i = 0; i < 10; i++){
+            if(!ACSAWinoAlgoFits(algos[i], tensorFilter))
+                continue;
+            // Fusing the pooling is not supported by the odd tiles of F(3,3) and F(5,3)
+            if((algos[i] == ACSA_WINOGRAD_3X3 || algos[i] == ACSA_WINOGRAD_5X3) && poolMess != NULL)
+                continue;
+            // The INT8 bridge quantizes F(2x3) only, the direct and im2col ones stay in float
+            if(ACSAWinoInt8<Dtype>(winoMess) && ACSAWinoAlgoFits(ACSA_WINOGRAD_2X3, tensorFilter) &&
+                    algos[i] != ACSA_WINOGRAD_2X3 && algos[i] < ACSA_CONV_DIRECT)
+                continue;
+            // Depthwise has its own winograd kernel, the direct convolution would go group by group
+            if(algos[i] == ACSA_CONV_DIRECT && ACSAIsDepthwise(tensorIn, tensorFilter))
+                continue;
+            // The direct and im2col convolutions don't merge the images, nor take batch blocks
+            for(j = 0; j < 4 && merges[j] <= N && (j == 0 || algos[i] < ACSA_CONV_DIRECT); j++){
+                ACSASetWinoMessage(cand, algos[i], 0, merges[j]);
+                ACSASetWinoGemm(cand, winoMess->gemm_);
+                ACSASetWinoSchedule(cand, winoMess->schedule_);
+                ACSASetWinoBridge(cand, winoMess->bridge_);
+                t = tuneTime(handle, in, filter, out, tensorIn, tensorFilter, tensorOut,
+                        convMess, &cand, bias, activMess, poolMess);
+                if(t < best_time){
+                    best_time = t;
+                    best.algo_ = algos[i];
+                    best.batch_block_ = 0;
+                    best.merge_ = merges[j];
+                }
+            }
+        }
+
+        for(j = 0; j < 4 && blocks[j] < N && best.algo_ < ACSA_CONV_DIRECT; j++){
+            // A block the merge doesn't divide runs without merge
+            if(blocks[j]%best.merge_ != 0)
+                continue;
+            ACSASetWinoMessage(cand, best.algo_, blocks[j], best.merge_);
+            ACSASetWinoGemm(cand, winoMess->gemm_);
+            ACSASetWinoSchedule(cand, winoMess->schedule_);
+            ACSASetWinoBridge(cand, winoMess->bridge_);
+            t = tuneTime(handle, in, filter, out, tensorIn, tensorFilter, tensorOut,
+                    convMess, &cand, bias, activMess, poolMess);
+            if(t < best_time){
+                best_time = t;
+                best.batch_block_ = blocks[j];
+            }
+        }
+
+        // No candidate ran, nothing is cached
+        if(best_time == std::numeric_limits<double>::max()){
+            ACSA_MESSAGE("ERROR: No candidate of the tuning runs this layer!");
+            return ACSAFAIL;
+        }
+
+#pragma omp critical(acsa_tune_cache)
+        {
+            tuneCache[key] = best;
+            FILE *fp = fopen(tuneCachePath(), "a");
+            if(fp != NULL){
+                fprintf(fp, "%d %d %d %s\n", best.algo_, best.batch_block_, best.merge_, key.c_str());
+                fclose(fp);
+            }
+            else
+                ACSA_MESSAGE("WARNING: The tuning cache can't be written!");
+        }
+    }
+
+    winoMess->algo_ = best.algo_;
+    winoMess->batch_block_ = best.batch_block_;
+    winoMess->merge_ = best.merge_;
+
+    return ACSASUCCESS;
+}
+
+/* Instantiate Template */
+template ACSAStatus ACSAWinoTune<float>(ACSAHandle *,
+        const float *, const float *, float *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *,
+        const float *, ACSAActivMessage *, ACSAPoolMessage *);
+template ACSAStatus ACSAWinoTune<double>(ACSAHandle *,
+        const double *, const double *, double *,
+        ACSATensor4d *, ACSATensor4d *, ACSATensor4d *,
+        ACSAConvMessage *, ACSAWinoMessage *,
+        const double *, ACSAActivMessage *, ACSAPoolMessage *);
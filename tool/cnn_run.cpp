@@ -12,6 +12,7 @@
 #include <mkl.h>
 #include "dnn.hpp"
 
+#define DIRECT          1
 #define F2X3            2
 #define F3X3            3
 #define F4X3            4
@@ -29,6 +30,7 @@ class layer {
         ACSALayerType type_;
         char *name_;
         layer<Dtype> *prv_layer_;
+        ACSAHandle *handle_;
 
         virtual ACSATensor4d* get_output_tensor() = 0;
         virtual Dtype* get_output_pdata() = 0;
@@ -132,14 +134,20 @@ class convLayer : public layer<Dtype> {
     public:
         ACSATensor4d t_in_;
         ACSATensor4d t_filter_;
+        ACSATensor4d t_conv_;
         ACSATensor4d t_out_;
         ACSAConvMessage conv_mess_;
         ACSAWinoMessage wino_mess_;
+        ACSAWinoFilter wino_filter_;
+        ACSAActivMessage activ_mess_;
+        ACSAPoolMessage pool_mess_;
         int nfilters_;
+        int fuse_pool_;
 
-        Dtype *in_, *filter_, *out_;
+        Dtype *in_, *filter_, *bias_, *out_;
 
-        convLayer(int k, int algo, int bb, int mg, char *name = "no_name");
+        convLayer(int k, int algo, int bb, int mg, char *name = "no_name",
+                ACSAActivationMode activ = ACSA_ACTIVATION_NONE, int fuse_pool = 0);
         ~convLayer();
         ACSATensor4d* get_output_tensor() { return &t_out_; }
         Dtype* get_output_pdata() { return out_; }
@@ -149,13 +157,23 @@ class convLayer : public layer<Dtype> {
 };
 
     template <typename Dtype>
-convLayer<Dtype>::convLayer(int k, int algo, int bb, int mg, char *name)
+convLayer<Dtype>::convLayer(int k, int algo, int bb, int mg, char *name,
+        ACSAActivationMode activ, int fuse_pool)
 {
     ACSASetConvMessage(conv_mess_, 3, 3, 1, 1, 1, 1);
+    ACSASetActivMessage(activ_mess_, activ, 0.0, 0.0);
+    ACSASetPoolMessage(pool_mess_, 2, 2, 0, 0, 2, 2);
     nfilters_ = k;
+    fuse_pool_ = fuse_pool;
+    wino_filter_.data_ = NULL;
+    wino_filter_.bdata_ = NULL;
+    wino_filter_.qdata_ = NULL;
 
     switch(algo)
     {
+        case DIRECT:
+            ACSASetWinoMessage(wino_mess_, ACSA_CONV_DIRECT, bb, mg);
+            break;
         case F2X3:
             ACSASetWinoMessage(wino_mess_, ACSA_WINOGRAD_2X3, bb, mg);
             break;                    
@@ -179,6 +197,9 @@ convLayer<Dtype>::~convLayer()
 {
     if(filter_ != NULL)
         mkl_free(filter_);
+    if(bias_ != NULL)
+        mkl_free(bias_);
+    ACSADestroyWinoFilter(wino_filter_);
     if(out_ != NULL)
         mkl_free(out_);
 }
@@ -201,7 +222,12 @@ ACSAStatus convLayer<Dtype>::set_message()
 
     ACSASetTensor4d(t_in_, N, C, H, W);
     ACSASetTensor4d(t_filter_, K, C, 3, 3);
-    ACSASetTensor4d(t_out_, N, K, H+2*pad_h-2, W+2*pad_w-2);
+    ACSASetTensor4d(t_conv_, N, K, H+2*pad_h-2, W+2*pad_w-2);
+    // with fused max pooling only the pooled result is kept
+    if(fuse_pool_)
+        ACSASetTensor4d(t_out_, N, K, t_conv_.h_/2, t_conv_.w_/2);
+    else
+        t_out_ = t_conv_;
 
     inSize = N*C*H*W;
     filterSize = K*C*3*3;
@@ -209,11 +235,17 @@ ACSAStatus convLayer<Dtype>::set_message()
 
     in_ = this->prv_layer_->get_output_pdata();
     filter_ = (Dtype *)mkl_malloc(filterSize*sizeof(Dtype), 64);
+    bias_ = (Dtype *)mkl_malloc(K*sizeof(Dtype), 64);
     out_ = (Dtype *)mkl_malloc(outSize*sizeof(Dtype), 64);
 
     // random data for weight
     for(int i = 0; i < filterSize; i++)
         filter_[i] = rand()%3-1;//1.0*(rand()%10)/4000;
+    for(int i = 0; i < K; i++)
+        bias_[i] = rand()%3-1;
+
+    // weight is fixed, transform it only once
+    ACSACreateWinoFilter(wino_filter_, filter_, &t_filter_, &wino_mess_);
 
 #if 0
     printf("%10s: in-add=%X, out-add=%X\n", this->name_, in_, out_);
@@ -225,24 +257,10 @@ ACSAStatus convLayer<Dtype>::set_message()
     template <typename Dtype>
 ACSAStatus convLayer<Dtype>::forward()
 {
-    switch(wino_mess_.algo_)
-    {
-        case ACSA_WINOGRAD_2X3:
-            ACSAWinoConvolution_2x3<Dtype>(in_, filter_, out_,
-                    &t_in_, &t_filter_, &t_out_, &conv_mess_, &wino_mess_);
-            break;
-        case ACSA_WINOGRAD_3X3:
-            ACSAWinoConvolution_3x3<Dtype>(in_, filter_, out_,
-                    &t_in_, &t_filter_, &t_out_, &conv_mess_, &wino_mess_);
-            break;
-        case ACSA_WINOGRAD_4X3:
-            ACSAWinoConvolution_4x3<Dtype>(in_, filter_, out_,
-                    &t_in_, &t_filter_, &t_out_, &conv_mess_, &wino_mess_);
-            break;
-        default:
-            ACSA_CHECK(0);
-            break;
-    }
+    // bias, activation and pooling are fused into the output transform
+    ACSAWinoConvolutionFwd<Dtype>(this->handle_, in_, &wino_filter_, out_,
+            &t_in_, &t_filter_, &t_conv_, &conv_mess_, &wino_mess_,
+            bias_, &activ_mess_, fuse_pool_ ? &pool_mess_ : NULL);
 
     return ACSASUCCESS;
 }
@@ -364,10 +382,10 @@ ACSAStatus reluLayer<Dtype>::forward()
     switch(place_type_)
     {
         case IN_PLACE:
-            ACSAReLUInplaceFwd<Dtype>(in_, &t_in_);
+            ACSAReLUInplaceFwd<Dtype>(this->handle_, in_, &t_in_);
             break;
         case OUT_PLACE:
-            ACSAReLUOutplaceFwd<Dtype>(in_, out_, &t_in_);
+            ACSAReLUOutplaceFwd<Dtype>(this->handle_, in_, out_, &t_in_);
             break;
         default:
             ACSA_CHECK(0);
@@ -491,10 +509,10 @@ ACSAStatus poolLayer<Dtype>::forward()
     switch(algo_)
     {
         case MAX:
-            ACSAMaxPoolingFwd<Dtype>(in_, out_, &t_in_, &pool_mess_);
+            ACSAMaxPoolingFwd<Dtype>(this->handle_, in_, out_, &t_in_, &pool_mess_);
             break;
         case AVG:
-            ACSAAvePoolingFwd<Dtype>(in_, out_, &t_in_, &pool_mess_);
+            ACSAAvePoolingFwd<Dtype>(this->handle_, in_, out_, &t_in_, &pool_mess_);
             break;
         default:
             ACSA_CHECK(0);
@@ -537,6 +555,7 @@ template <typename Dtype>
 class model {
     public:
         std::vector<layer<Dtype> *> graph_;
+        ACSAHandle handle_;
 
         model();
         ~model();        
@@ -548,14 +567,14 @@ class model {
 model<Dtype>::model()
 {
     // Prapared environment for acsa cnn
-    ACSACnnInitLib<Dtype>();
+    ACSACreateHandle(handle_, 0);
 }
 
     template <typename Dtype>
 model<Dtype>::~model()
 {
     // Free environment for acsa cnn
-    ACSACnnFreeLib<Dtype>();
+    ACSADestroyHandle(handle_);
 }
 
     template <typename Dtype>
@@ -564,6 +583,7 @@ ACSAStatus model<Dtype>::add(layer<Dtype> *new_layer)
     ACSA_CHECK(new_layer != NULL);
 
     graph_.push_back(new_layer);
+    new_layer->handle_ = &handle_;
     if(graph_.size() == 1){
         new_layer->prv_layer_ = NULL;
     }
@@ -612,52 +632,49 @@ int main(int argc, char *argv[]){
     const int K_arr[16] = {64, 64, 64, 128, 128, 256, 256, 256, 256, 512, 512, 512, 512, 512, 512, 512}; 
     const int mg_arr[16] = {2, 1, 2, 2, 4, 4, 4, 4, 4, 8, 8, 8, 8, 8, 8, 8};
     const int bb_arr[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-    const int algo_arr[16]  = {4, 4, 4, 4, 3, 4, 4, 4, 3, 3, 3, 3, 3, 3, 3, 3};
+    const int algo_arr[16]  = {1, 4, 4, 4, 3, 4, 4, 4, 3, 3, 3, 3, 3, 3, 3, 3};
 
     model<float> *md = new model<float>();
 
 #if 1
     md->add(new inputLayer<float>(64, 3, HW, HW, "input"));
-    md->add(new convLayer<float>(K_arr[ 0], algo_arr[ 0], bb_arr[ 0], mg_arr[ 0], "conv1_1"));
-    md->add(new reluLayer<float>(OUT_PLACE, "relu1_1"));                                  
-    md->add(new convLayer<float>(K_arr[ 1], algo_arr[ 1], bb_arr[ 1], mg_arr[ 1], "conv1_2"));
-    md->add(new reluLayer<float>(OUT_PLACE, "relu1_2"));                                  
-    md->add(new poolLayer<float>(MAX, "pool1"));
-
-    md->add(new convLayer<float>(K_arr[ 2], algo_arr[ 2], bb_arr[ 2], mg_arr[ 2], "conv2_1"));
-    md->add(new reluLayer<float>(OUT_PLACE, "relu2_1"));                                  
-    md->add(new convLayer<float>(K_arr[ 3], algo_arr[ 3], bb_arr[ 3], mg_arr[ 3], "conv2_2"));
-    md->add(new reluLayer<float>(OUT_PLACE, "relu2_2"));                                  
-    md->add(new poolLayer<float>(MAX, "pool2"));                                    
-
-    md->add(new convLayer<float>(K_arr[ 4], algo_arr[ 4], bb_arr[ 4], mg_arr[ 4], "conv3_1"));
-    md->add(new reluLayer<float>(OUT_PLACE, "relu3_1"));                                  
-    md->add(new convLayer<float>(K_arr[ 5], algo_arr[ 5], bb_arr[ 5], mg_arr[ 5], "conv3_2"));
-    md->add(new reluLayer<float>(OUT_PLACE, "relu3_2"));                                  
-    md->add(new convLayer<float>(K_arr[ 6], algo_arr[ 6], bb_arr[ 6], mg_arr[ 6], "conv3_3"));
-    md->add(new reluLayer<float>(OUT_PLACE, "relu3_3"));                                  
-    md->add(new convLayer<float>(K_arr[ 7], algo_arr[ 7], bb_arr[ 7], mg_arr[ 7], "conv3_4"));
-    md->add(new reluLayer<float>(OUT_PLACE, "relu3_4"));                                  
-    md->add(new poolLayer<float>(MAX, "pool3"));                                    
-
-    md->add(new convLayer<float>(K_arr[ 8], algo_arr[ 8], bb_arr[ 8], mg_arr[ 8], "conv4_1"));
-    md->add(new reluLayer<float>(OUT_PLACE, "relu4_1"));                                  
-    md->add(new convLayer<float>(K_arr[ 9], algo_arr[ 9], bb_arr[ 9], mg_arr[ 9], "conv4_2"));
-    md->add(new reluLayer<float>(OUT_PLACE, "relu4_2"));                                  
-    md->add(new convLayer<float>(K_arr[10], algo_arr[10], bb_arr[10], mg_arr[10], "conv4_3"));
-    md->add(new reluLayer<float>(OUT_PLACE, "relu4_3"));                                  
-    md->add(new convLayer<float>(K_arr[11], algo_arr[11], bb_arr[11], mg_arr[11], "conv4_4"));
-    md->add(new reluLayer<float>(OUT_PLACE, "relu4_4"));                                  
+    md->add(new convLayer<float>(K_arr[ 0], algo_arr[ 0], bb_arr[ 0], mg_arr[ 0], "conv1_1",
+                ACSA_ACTIVATION_RELU));
+    md->add(new convLayer<float>(K_arr[ 1], algo_arr[ 1], bb_arr[ 1], mg_arr[ 1], "conv1_2",
+                ACSA_ACTIVATION_RELU, 1)); // pool1 fused
+
+    md->add(new convLayer<float>(K_arr[ 2], algo_arr[ 2], bb_arr[ 2], mg_arr[ 2], "conv2_1",
+                ACSA_ACTIVATION_RELU));
+    md->add(new convLayer<float>(K_arr[ 3], algo_arr[ 3], bb_arr[ 3], mg_arr[ 3], "conv2_2",
+                ACSA_ACTIVATION_RELU, 1)); // pool2 fused
+
+    md->add(new convLayer<float>(K_arr[ 4], algo_arr[ 4], bb_arr[ 4], mg_arr[ 4], "conv3_1",
+                ACSA_ACTIVATION_RELU));
+    md->add(new convLayer<float>(K_arr[ 5], algo_arr[ 5], bb_arr[ 5], mg_arr[ 5], "conv3_2",
+                ACSA_ACTIVATION_RELU));
+    md->add(new convLayer<float>(K_arr[ 6], algo_arr[ 6], bb_arr[ 6], mg_arr[ 6], "conv3_3",
+                ACSA_ACTIVATION_RELU));
+    md->add(new convLayer<float>(K_arr[ 7], algo_arr[ 7], bb_arr[ 7], mg_arr[ 7], "conv3_4",
+                ACSA_ACTIVATION_RELU, 1)); // pool3 fused
+
+    md->add(new convLayer<float>(K_arr[ 8], algo_arr[ 8], bb_arr[ 8], mg_arr[ 8], "conv4_1",
+                ACSA_ACTIVATION_RELU));
+    md->add(new convLayer<float>(K_arr[ 9], algo_arr[ 9], bb_arr[ 9], mg_arr[ 9], "conv4_2",
+                ACSA_ACTIVATION_RELU));
+    md->add(new convLayer<float>(K_arr[10], algo_arr[10], bb_arr[10], mg_arr[10], "conv4_3",
+                ACSA_ACTIVATION_RELU));
+    md->add(new convLayer<float>(K_arr[11], algo_arr[11], bb_arr[11], mg_arr[11], "conv4_4",
+                ACSA_ACTIVATION_RELU));
     md->add(new poolLayer<float>(MAX, "pool4"));                                    
 
-    md->add(new convLayer<float>(K_arr[12], algo_arr[12], bb_arr[12], mg_arr[12], "conv5_1"));
-    md->add(new reluLayer<float>(OUT_PLACE, "relu5_1"));                                  
-    md->add(new convLayer<float>(K_arr[13], algo_arr[13], bb_arr[13], mg_arr[13], "conv5_2"));
-    md->add(new reluLayer<float>(OUT_PLACE, "relu5_2"));                                  
-    md->add(new convLayer<float>(K_arr[14], algo_arr[14], bb_arr[14], mg_arr[14], "conv5_3"));
-    md->add(new reluLayer<float>(OUT_PLACE, "relu5_3"));                                  
-    md->add(new convLayer<float>(K_arr[15], algo_arr[15], bb_arr[15], mg_arr[15], "conv5_4"));
-    md->add(new reluLayer<float>(OUT_PLACE, "relu5_4"));
+    md->add(new convLayer<float>(K_arr[12], algo_arr[12], bb_arr[12], mg_arr[12], "conv5_1",
+                ACSA_ACTIVATION_RELU));
+    md->add(new convLayer<float>(K_arr[13], algo_arr[13], bb_arr[13], mg_arr[13], "conv5_2",
+                ACSA_ACTIVATION_RELU));
+    md->add(new convLayer<float>(K_arr[14], algo_arr[14], bb_arr[14], mg_arr[14], "conv5_3",
+                ACSA_ACTIVATION_RELU));
+    md->add(new convLayer<float>(K_arr[15], algo_arr[15], bb_arr[15], mg_arr[15], "conv5_4",
+                ACSA_ACTIVATION_RELU));
     md->add(new poolLayer<float>(MAX, "pool5"));
 #else
     md->add(new inputLayer<float>(2, 1, 6, 6, "input"));
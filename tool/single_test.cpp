@@ -35,7 +35,8 @@ void print4d(Dtype *data, int N, int C, int H, int W){
 int main(int argc, char *argv[]){
     srand((unsigned int)time(NULL));
 
-    ACSACnnInitLib<float>(); 
+    ACSAHandle handle;
+    ACSACreateHandle(handle, 0); 
 
     int N, C, H, W, K;
     int pad_h, pad_w;
@@ -81,7 +82,7 @@ int main(int argc, char *argv[]){
     ACSASetConvMessage(convMess, 3, 3, pad_h, pad_w, 1, 1);
     ACSASetWinoMessage(winoMess, ACSA_WINOGRAD_4X3, bb, mg);
 
-    ACSAWinoConvolution_4x3<float>(in, filter, out,
+    ACSAWinoConvolution_4x3<float>(&handle, in, filter, out,
             &tensorIn, &tensorFilter, &tensorOut, &convMess, &winoMess);
 
     printf(">>>>>>>>>> The data for input <<<<<<<<<<\n");
@@ -95,7 +96,7 @@ int main(int argc, char *argv[]){
     mkl_free(filter);
     mkl_free(out);
 
-    ACSACnnFreeLib<float>(); 
+    ACSADestroyHandle(handle); 
 
     return 0;
 }
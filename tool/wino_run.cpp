@@ -19,44 +19,143 @@
 #define F_4X3			4
 #define F_6X3			6
 #define F_HYBRID		0
+#define F_TUNE			1
+#define F_GEMM			7
+
+/* Verify modes, 1 is the forward of the layers as they are. */
+#define V_FWD			1
+#define V_BWD_DATA		2
+#define V_BWD_FILTER	3
+#define V_STRIDE		4
+#define V_DILATION		5
+#define V_GROUP			6
+#define V_DEPTHWISE		7
+#define V_NHWC			8
+#define V_NCHW16C		9
+#define V_INT8			10
 
 int counter = 0;
-
-/* Direct manual convolution. */
+ACSAGemmMode gemm_mode = ACSA_GEMM_MKL;
+ACSAWinoSchedule schedule_mode = ACSA_SCHEDULE_PHASED;
+ACSABridgeType bridge_mode = ACSA_BRIDGE_FP32;
+int tune_mode = 0;
+int gemm_base = 0;
+
+/* Direct manual convolution, in is padded by ph and pw.
+ * Group g of G convolves the channels [g*C/G, (g+1)*C/G) with the filters
+ * [g*K/G, (g+1)*K/G), kn is (K, C/G, 3, 3).
+ */
 int myDirectConv(float *in, float *kn, float *out,
         const int N, const int C, const int H, const int W, const int K,
-        const int ph, const int pw)
+        const int ph, const int pw,
+        const int sh = 1, const int sw = 1, const int dh = 1, const int dw = 1, const int G = 1)
 {
     int inpos, knpos, outpos;
 
     int dimIn[4]  = {N, C, H+2*ph, W+2*pw};
-    int dimKn[4]  = {K, C, 3, 3};
-    int dimOut[4] = {N, K, H+2*ph-2, W+2*pw-2};
+    int dimKn[4]  = {K, C/G, 3, 3};
+    int dimOut[4] = {N, K, (H+2*ph-2*dh-1)/sh+1, (W+2*pw-2*dw-1)/sw+1};
 
     int ingap[3] = {dimIn[1]*dimIn[2]*dimIn[3], dimIn[2]*dimIn[3], dimIn[3]};
     int kngap[3] = {dimKn[1]*dimKn[2]*dimKn[3], dimKn[2]*dimKn[3], dimKn[3]};
     int outgap[3] = {dimOut[1]*dimOut[2]*dimOut[3], dimOut[2]*dimOut[3], dimOut[3]};
 
 #pragma omp parallel for private(inpos, knpos, outpos)
-    for(int inn = 0; inn < dimIn[0]; inn++)
-        for(int knn = 0; knn < dimKn[0]; knn++)
-            for(int inc = 0; inc < dimIn[1]; inc++){
-                for(int outh = 0; outh < dimOut[2]; outh++)
-                    for(int outw = 0; outw < dimOut[3]; outw++){
-                        outpos = inn*outgap[0] + knn*outgap[1] + outh*outgap[2] + outw;
-                        for(int knh = 0; knh < dimKn[2]; knh++)
-                            for(int knw = 0; knw < dimKn[3]; knw++){
-                                inpos = inn*ingap[0] + inc*ingap[1] + (outh+knh)*ingap[2] + (outw+knw);
-                                //knpos = knn*kngap[0] + inc*kngap[1] + 8 - (knh*kngap[2] + knw);
-                                knpos = knn*kngap[0] + inc*kngap[1] + knh*kngap[2] + knw;
-                                out[outpos] += in[inpos] * kn[knpos];
-                            }
-                    }
+    for(int nk = 0; nk < dimIn[0]*dimKn[0]; nk++){
+        const int inn = nk/dimKn[0];
+        const int knn = nk%dimKn[0];
+        const int g = knn/(K/G);
+        for(int inc = 0; inc < dimKn[1]; inc++){
+            for(int outh = 0; outh < dimOut[2]; outh++)
+                for(int outw = 0; outw < dimOut[3]; outw++){
+                    outpos = inn*outgap[0] + knn*outgap[1] + outh*outgap[2] + outw;
+                    for(int knh = 0; knh < dimKn[2]; knh++)
+                        for(int knw = 0; knw < dimKn[3]; knw++){
+                            inpos = inn*ingap[0] + (g*dimKn[1] + inc)*ingap[1] +
+                                (outh*sh + knh*dh)*ingap[2] + (outw*sw + knw*dw);
+                            knpos = knn*kngap[0] + inc*kngap[1] + knh*kngap[2] + knw;
+                            out[outpos] += in[inpos] * kn[knpos];
+                        }
+                }
+        }
+    }
+
+    return 0;
+}
+
+/* Direct backward data of myDirectConv, diffIn (N, C, H, W) gathers diffOut (N, K, OH, OW). */
+int myDirectBwdData(const float *diffOut, const float *kn, float *diffIn,
+        const int N, const int C, const int H, const int W, const int K, const int OH, const int OW,
+        const int ph, const int pw, const int sh, const int sw, const int dh, const int dw, const int G)
+{
+    const int Cg = C/G;
+    const int Kg = K/G;
+
+#pragma omp parallel for
+    for(int nc = 0; nc < N*C; nc++){
+        const int n = nc/C;
+        const int c = nc%C;
+        const int g = c/Cg;
+        for(int y = 0; y < H; y++)
+            for(int x = 0; x < W; x++){
+                double sum = 0;
+                for(int k = g*Kg; k < (g+1)*Kg; k++)
+                    for(int a = 0; a < 3; a++)
+                        for(int b = 0; b < 3; b++){
+                            const int oy = y + ph - a*dh;
+                            const int ox = x + pw - b*dw;
+                            if(oy < 0 || ox < 0 || oy%sh != 0 || ox%sw != 0 || oy/sh >= OH || ox/sw >= OW)
+                                continue;
+                            sum += diffOut[(((long)n*K + k)*OH + oy/sh)*OW + ox/sw] *
+                                kn[(((long)k*Cg + c%Cg)*3 + a)*3 + b];
+                        }
+                diffIn[(((long)n*C + c)*H + y)*W + x] = sum;
             }
+    }
 
     return 0;
 }
 
+/* Direct filter gradient of myDirectConv, every tap sums over the whole batch. */
+int myDirectBwdFilter(const float *in, const float *diffOut, float *diffFilter,
+        const int N, const int C, const int H, const int W, const int K, const int OH, const int OW,
+        const int ph, const int pw, const int sh, const int sw, const int G)
+{
+    const int Cg = C/G;
+    const int Kg = K/G;
+
+#pragma omp parallel for
+    for(int kc = 0; kc < K*Cg; kc++){
+        const int k = kc/Cg;
+        const int c = (k/Kg)*Cg + kc%Cg;
+        for(int a = 0; a < 3; a++)
+            for(int b = 0; b < 3; b++){
+                double sum = 0;
+                for(int n = 0; n < N; n++)
+                    for(int oy = 0; oy < OH; oy++)
+                        for(int ox = 0; ox < OW; ox++){
+                            const int y = oy*sh + a - ph;
+                            const int x = ox*sw + b - pw;
+                            if(y < 0 || x < 0 || y >= H || x >= W)
+                                continue;
+                            sum += in[(((long)n*C + c)*H + y)*W + x] * diffOut[(((long)n*K + k)*OH + oy)*OW + ox];
+                        }
+                diffFilter[(long)kc*9 + a*3 + b] = sum;
+            }
+    }
+
+    return 0;
+}
+
+/* Tolerance of the bridge, the 16-bit ones keep 8 or 11 bits of mantissa,
+ * INT8 about 6 bits of the transformed input.
+ */
+double bridgeTol(const ACSABridgeType bridge)
+{
+    return (bridge == ACSA_BRIDGE_FP32) ? 1e-4 : ((bridge == ACSA_BRIDGE_BF16) ? 3e-2 :
+            ((bridge == ACSA_BRIDGE_FP16) ? 4e-3 : 5e-2));
+}
+
 /* Verity */
 int verity(int counter,
         float *v_in, float *v_filter, float *out,
@@ -73,8 +172,9 @@ int verity(int counter,
     printf("Conv[%2d]: Tensor(%-3d %-3d %-3d %-3d %-3d) Pad(%-2d %-2d) ##  ",
             counter, N, C, H, W, K, ph, pw);
 
+    const double tol = bridgeTol(bridge_mode);
     for(int i = 0; i < N*sizeO*K; i++){
-        if(fabs((out[i] - v_out[i])/v_out[i]) > 1e-4){
+        if(fabs((out[i] - v_out[i])/v_out[i]) > tol){
             printf("Output Error!!! [Index=%d, data[input]=%g | data[verity]=%g]\n", i, out[i], v_out[i]);
             accury = 0;
             break; 
@@ -89,8 +189,164 @@ int verity(int counter,
     return 0;
 }
 
+/* Verify one path of the library against the direct convolution, mode is one of V_*.
+ * The data has both signs, the largest error is taken relative to the largest value.
+ * The padded lanes of nChw16c hold garbage, no path may read them.
+ */
+void verify_path(ACSAHandle *handle, const int mode,
+        const int N, const int C, const int H, const int W, int K,
+        const int ph, const int pw)
+{
+    const int s = (mode == V_STRIDE) ? 2 : 1;
+    const int d = (mode == V_DILATION) ? 2 : 1;
+    const int outHeight = (H+2*ph-2*d-1)/s+1;
+    const int outWidth = (W+2*pw-2*d-1)/s+1;
+    const ACSABridgeType bridge = (mode == V_INT8) ? ACSA_BRIDGE_INT8 : bridge_mode;
+    int G = 1;
+
+    if(mode == V_GROUP && C%4 == 0 && K%4 == 0)
+        G = 4;
+    if(mode == V_DEPTHWISE){
+        K = C;
+        G = C;
+    }
+
+    ACSATensor4d tensorIn, tensorFilter, tensorOut;
+    ACSAConvMessage convMess;
+    ACSAWinoMessage winoMess;
+
+    ACSASetTensor4d(tensorIn, N, C, H, W);
+    ACSASetTensor4d(tensorFilter, K, C/G, 3, 3);
+    ACSASetTensor4d(tensorOut, N, K, outHeight, outWidth);
+    if(mode == V_NHWC){
+        ACSASetTensor4dFormat(tensorIn, ACSA_TENSOR_NHWC);
+        ACSASetTensor4dFormat(tensorOut, ACSA_TENSOR_NHWC);
+    }
+    else if(mode == V_NCHW16C || mode == V_INT8){
+        ACSASetTensor4dFormat(tensorIn, ACSA_TENSOR_NCHW16C);
+        ACSASetTensor4dFormat(tensorOut, ACSA_TENSOR_NCHW16C);
+    }
+    ACSASetConvMessage(convMess, 3, 3, ph, pw, s, s);
+    ACSASetConvDilation(convMess, d, d);
+    ACSASetConvGroups(convMess, G);
+    ACSASetWinoMessage(winoMess, tune_mode ? ACSA_WINOGRAD_TUNE : ACSA_WINOGRAD_AUTO, 0, 1);
+    ACSASetWinoGemm(winoMess, gemm_mode);
+    ACSASetWinoSchedule(winoMess, schedule_mode);
+    ACSASetWinoBridge(winoMess, bridge);
+
+    /* NCHW data of the reference, and the same in the layouts of the library. */
+    const long sizeI = (long)N*C*H*W;
+    const long sizeO = (long)N*K*outHeight*outWidth;
+    const long sizeF = (long)K*(C/G)*9;
+    const long v_sizeI = (long)(H+2*ph)*(W+2*pw);
+    float *in = (float *)mkl_malloc(sizeI*sizeof(float), 64);
+    float *v_in = (float *)mkl_malloc(N*C*v_sizeI*sizeof(float), 64);
+    float *filter = (float *)mkl_malloc(sizeF*sizeof(float), 64);
+    float *diffOut = (float *)mkl_malloc(sizeO*sizeof(float), 64);
+    float *l_in = (float *)mkl_malloc(ACSATensorSize(&tensorIn)*sizeof(float), 64);
+    float *l_out = (float *)mkl_malloc(ACSATensorSize(&tensorOut)*sizeof(float), 64);
+    assert(in != NULL && v_in != NULL && filter != NULL && diffOut != NULL && l_in != NULL && l_out != NULL);
+    memset(v_in, 0, N*C*v_sizeI*sizeof(float));
+
+    for(long i = 0; i < ACSATensorSize(&tensorIn); i++)
+        l_in[i] = 1000.0f;
+    for(long i = 0; i < ACSATensorSize(&tensorOut); i++)
+        l_out[i] = 1000.0f;
+#pragma omp parallel for
+    for(int i = 0; i < N*C; i++)
+        for(int j = 0; j < H*W; j++){
+            const float x = (float)((i*H*W + j)%13 - 6)*0.1f;
+            in[(long)i*H*W + j] = x;
+            v_in[i*v_sizeI + (j/W + ph)*(W+2*pw) + j%W + pw] = x;
+            l_in[ACSATensorOffset(&tensorIn, i/C, i%C, j/W, j%W)] = x;
+        }
+    for(long i = 0; i < sizeF; i++)
+        filter[i] = (float)(i%5 - 2)*0.25f;
+    for(long i = 0; i < sizeO; i++)
+        diffOut[i] = (float)(i%11 - 5)*0.2f;
+
+    const char *name[] = {"", "forward", "backward data", "backward filter", "stride 2", "dilation 2",
+        "groups", "depthwise", "NHWC", "nChw16c", "INT8 nChw16c"};
+    float *ref, *res;
+    long count;
+    ACSAStatus ret;
+    double tol = bridgeTol(bridge);
+
+    if(mode == V_BWD_DATA){
+        // diffOut comes in the layout of out, diffIn goes in the layout of in
+        for(long i = 0; i < sizeO; i++)
+            l_out[ACSATensorOffset(&tensorOut, i/((long)K*outHeight*outWidth), (i/((long)outHeight*outWidth))%K,
+                    (i/outWidth)%outHeight, i%outWidth)] = diffOut[i];
+        ref = (float *)mkl_malloc(sizeI*sizeof(float), 64);
+        res = (float *)mkl_malloc(sizeI*sizeof(float), 64);
+        myDirectBwdData(diffOut, filter, ref, N, C, H, W, K, outHeight, outWidth, ph, pw, s, s, d, d, G);
+        ret = ACSAWinoConvolutionBwdData<float>(handle, l_out, filter, l_in,
+                &tensorIn, &tensorFilter, &tensorOut, &convMess, &winoMess);
+        for(long i = 0; i < sizeI; i++)
+            res[i] = l_in[ACSATensorOffset(&tensorIn, i/((long)C*H*W), (i/((long)H*W))%C, (i/W)%H, i%W)];
+        count = sizeI;
+    }
+    else if(mode == V_BWD_FILTER){
+        // The filter gradient is fp32 whatever the bridge
+        for(long i = 0; i < sizeO; i++)
+            l_out[ACSATensorOffset(&tensorOut, i/((long)K*outHeight*outWidth), (i/((long)outHeight*outWidth))%K,
+                    (i/outWidth)%outHeight, i%outWidth)] = diffOut[i];
+        ref = (float *)mkl_malloc(sizeF*sizeof(float), 64);
+        res = (float *)mkl_malloc(sizeF*sizeof(float), 64);
+        myDirectBwdFilter(in, diffOut, ref, N, C, H, W, K, outHeight, outWidth, ph, pw, s, s, G);
+        ret = ACSAWinoConvolutionBwdFilter<float>(handle, l_in, l_out, res,
+                &tensorIn, &tensorFilter, &tensorOut, &convMess, &winoMess);
+        count = sizeF;
+        tol = bridgeTol(ACSA_BRIDGE_FP32);
+    }
+    else{
+        ref = (float *)mkl_malloc(sizeO*sizeof(float), 64);
+        res = (float *)mkl_malloc(sizeO*sizeof(float), 64);
+        memset(ref, 0, sizeO*sizeof(float));
+        myDirectConv(v_in, filter, ref, N, C, H, W, K, ph, pw, s, s, d, d, G);
+        ret = ACSAWinoConvolutionFwd<float>(handle, l_in, filter, l_out,
+                &tensorIn, &tensorFilter, &tensorOut, &convMess, &winoMess);
+        for(long i = 0; i < sizeO; i++)
+            res[i] = l_out[ACSATensorOffset(&tensorOut, i/((long)K*outHeight*outWidth), (i/((long)outHeight*outWidth))%K,
+                    (i/outWidth)%outHeight, i%outWidth)];
+        count = sizeO;
+    }
+
+    printf("Verify[%2d]: %-15s Tensor(%-3d %-3d %-3d %-3d %-3d) Pad(%-2d %-2d) Groups(%-3d) ##  ",
+            counter, name[mode], N, C, H, W, K, ph, pw, G);
+
+    double emax = 0, vmax = 0;
+    long imax = 0;
+    for(long i = 0; i < count; i++){
+        vmax = std::max(vmax, (double)fabs(ref[i]));
+        if(fabs(res[i] - ref[i]) > emax){
+            emax = fabs(res[i] - ref[i]);
+            imax = i;
+        }
+    }
+    if(ret != ACSASUCCESS)
+        printf("Output Error!!! [The convolution failed]\n");
+    else if(emax > tol*vmax)
+        printf("Output Error!!! [Index=%ld, data[input]=%g | data[verity]=%g, max=%g]\n",
+                imax, res[imax], ref[imax], vmax);
+    else
+        printf("Output  True!!! [error %.3g of max]\n", (vmax > 0) ? emax/vmax : 0);
+
+    counter = (counter%16)+1;
+
+    mkl_free(in);
+    mkl_free(v_in);
+    mkl_free(filter);
+    mkl_free(diffOut);
+    mkl_free(l_in);
+    mkl_free(l_out);
+    mkl_free(ref);
+    mkl_free(res);
+}
+
 /* Winograd Covoluton. */
-void winograd_conv(const int N, const int C, const int H, const int W, const int K,
+void winograd_conv(ACSAHandle *handle,
+        const int N, const int C, const int H, const int W, const int K,
         const int ph, const int pw,
         const int algo, const int bb, const int mg,
         long *total_flops, double *total_time, const int verify)
@@ -150,22 +406,52 @@ void winograd_conv(const int N, const int C, const int H, const int W, const int
     {
         case F_2X3:
             ACSASetWinoMessage(winoMess, ACSA_WINOGRAD_2X3, bb, mg);
-            ACSAWinoConvolution_2x3<float>(in, filter, out,
+            ACSASetWinoGemm(winoMess, gemm_mode);
+            ACSASetWinoSchedule(winoMess, schedule_mode);
+            ACSASetWinoBridge(winoMess, bridge_mode);
+            ACSAWinoConvolution_2x3<float>(handle, in, filter, out,
                     &tensorIn, &tensorFilter, &tensorOut, &convMess, &winoMess);
             break;
         case F_3X3:
             ACSASetWinoMessage(winoMess, ACSA_WINOGRAD_3X3, bb, mg);
-            ACSAWinoConvolution_3x3<float>(in, filter, out,
+            ACSASetWinoGemm(winoMess, gemm_mode);
+            ACSASetWinoSchedule(winoMess, schedule_mode);
+            ACSASetWinoBridge(winoMess, bridge_mode);
+            ACSAWinoConvolution_3x3<float>(handle, in, filter, out,
                     &tensorIn, &tensorFilter, &tensorOut, &convMess, &winoMess);
             break;
         case F_4X3:
             ACSASetWinoMessage(winoMess, ACSA_WINOGRAD_4X3, bb, mg);
-            ACSAWinoConvolution_4x3<float>(in, filter, out,
+            ACSASetWinoGemm(winoMess, gemm_mode);
+            ACSASetWinoSchedule(winoMess, schedule_mode);
+            ACSASetWinoBridge(winoMess, bridge_mode);
+            ACSAWinoConvolution_4x3<float>(handle, in, filter, out,
                     &tensorIn, &tensorFilter, &tensorOut, &convMess, &winoMess);
             break;
         case F_6X3:
             ACSASetWinoMessage(winoMess, ACSA_WINOGRAD_6X3, bb, mg);
-            ACSAWinoConvolution_6x3<float>(in, filter, out,
+            ACSASetWinoGemm(winoMess, gemm_mode);
+            ACSASetWinoSchedule(winoMess, schedule_mode);
+            ACSASetWinoBridge(winoMess, bridge_mode);
+            ACSAWinoConvolution_6x3<float>(handle, in, filter, out,
+                    &tensorIn, &tensorFilter, &tensorOut, &convMess, &winoMess);
+            break;
+        case F_TUNE:
+            ACSASetWinoMessage(winoMess, ACSA_WINOGRAD_TUNE, bb, mg);
+            ACSASetWinoGemm(winoMess, gemm_mode);
+            ACSASetWinoSchedule(winoMess, schedule_mode);
+            ACSASetWinoBridge(winoMess, bridge_mode);
+            ACSAWinoTune<float>(handle, in, filter, out,
+                    &tensorIn, &tensorFilter, &tensorOut, &convMess, &winoMess);
+            printf("CONV[%2d]: Tuned algo=%d bb=%d mg=%d\n", counter,
+                    winoMess.algo_, winoMess.batch_block_, winoMess.merge_);
+            ACSAWinoConvolutionFwd<float>(handle, in, filter, out,
+                    &tensorIn, &tensorFilter, &tensorOut, &convMess, &winoMess);
+            break;
+        case F_GEMM:
+            ACSASetWinoMessage(winoMess, ACSA_CONV_GEMM, bb, mg);
+            ACSASetWinoGemm(winoMess, gemm_mode);
+            ACSAWinoConvolutionFwd<float>(handle, in, filter, out,
                     &tensorIn, &tensorFilter, &tensorOut, &convMess, &winoMess);
             break;
         default:
@@ -178,19 +464,24 @@ void winograd_conv(const int N, const int C, const int H, const int W, const int
         switch(algo)
         {
             case F_2X3:
-                ACSAWinoConvolution_2x3<float>(in, filter, out,
+                ACSAWinoConvolution_2x3<float>(handle, in, filter, out,
                         &tensorIn, &tensorFilter, &tensorOut, &convMess, &winoMess);
                 break;
             case F_3X3:
-                ACSAWinoConvolution_3x3<float>(in, filter, out,
+                ACSAWinoConvolution_3x3<float>(handle, in, filter, out,
                         &tensorIn, &tensorFilter, &tensorOut, &convMess, &winoMess);
                 break;
             case F_4X3:
-                ACSAWinoConvolution_4x3<float>(in, filter, out,
+                ACSAWinoConvolution_4x3<float>(handle, in, filter, out,
                         &tensorIn, &tensorFilter, &tensorOut, &convMess, &winoMess);
                 break;
             case F_6X3:
-                ACSAWinoConvolution_6x3<float>(in, filter, out,
+                ACSAWinoConvolution_6x3<float>(handle, in, filter, out,
+                        &tensorIn, &tensorFilter, &tensorOut, &convMess, &winoMess);
+                break;
+            case F_TUNE:
+            case F_GEMM:
+                ACSAWinoConvolutionFwd<float>(handle, in, filter, out,
                         &tensorIn, &tensorFilter, &tensorOut, &convMess, &winoMess);
                 break;
             default:
@@ -228,13 +519,29 @@ void winograd_conv(const int N, const int C, const int H, const int W, const int
 
 int main(int argc, char** argv){
     if(argc < 3){
-        printf("Enter batch_size verity/noverity!!!\n"); 
+        printf("Enter batch_size verity/noverity [gemm: 0 mkl, 1 kernel] [schedule: 0 phased, 1 fused] [tune: 0 table, 1 auto] [bridge: 0 fp32, 1 bf16, 2 fp16, 3 int8 of F(2x3)] [baseline: 0 winograd, 1 im2col gemm]!!!\n");
+        printf("verity: 0 time, 1 forward, 2 backward data, 3 backward filter, 4 stride 2, 5 dilation 2, "
+                "6 groups, 7 depthwise, 8 NHWC, 9 nChw16c, 10 INT8 on nChw16c, 2-10 run by AUTO or TUNE\n");
         exit(-1); 
     }
 
     int i, j; 
     int batch = atoi(argv[1]); 
     int verify = atoi(argv[2]); 
+    if(argc > 3 && atoi(argv[3]) == 1)
+        gemm_mode = ACSA_GEMM_KERNEL;
+    if(argc > 4 && atoi(argv[4]) == 1)
+        schedule_mode = ACSA_SCHEDULE_FUSED;
+    if(argc > 5 && atoi(argv[5]) == 1)
+        tune_mode = 1;
+    if(argc > 6 && atoi(argv[6]) == 1)
+        bridge_mode = ACSA_BRIDGE_BF16;
+    else if(argc > 6 && atoi(argv[6]) == 2)
+        bridge_mode = ACSA_BRIDGE_FP16;
+    else if(argc > 6 && atoi(argv[6]) == 3)
+        bridge_mode = ACSA_BRIDGE_INT8;
+    if(argc > 7 && atoi(argv[7]) == 1)
+        gemm_base = 1;
 
     /* VGG19 Conv Layer */
     const int layer_num = 16;
@@ -267,7 +574,8 @@ int main(int argc, char** argv){
     /* Prepare the environment for Winograd.
      * 1. init
      * */ 
-    ACSACnnInitLib<float>(); 
+    ACSAHandle handle;
+    ACSACreateHandle(handle, 0); 
 
     /* Compute Convoltuion Using F(2,3) Winograd */
     total_time = 0.0f; 
@@ -292,18 +600,23 @@ int main(int argc, char** argv){
         ph = pad_h_arr[t];
         pw = pad_w_arr[t];
 
-        algo = algo_arr[t];
+        algo = gemm_base ? F_GEMM : (tune_mode ? F_TUNE : algo_arr[t]);
         bb = bb_arr[t];
         mg = mg_arr[t];
 
+        if(verify > V_FWD){
+            verify_path(&handle, verify, N, C, H, W, K, ph, pw);
+            continue;
+        }
+
 #if 1
         /* Use the best merge value. */
-        winograd_conv(N, C, H, W, K, ph, pw, 
+        winograd_conv(&handle, N, C, H, W, K, ph, pw, 
                 algo, bb, mg,
                 &total_flops, &total_time, verify);
 #else
         /* Use the assigned merge value. */
-        winograd_conv(N, C, H, W, K, ph, pw, 
+        winograd_conv(&handle, N, C, H, W, K, ph, pw, 
                 atoi(argv[argc-2]), bb, atoi(argv[argc-1]),
                 &total_flops, &total_time, verify);
 #endif
@@ -314,7 +627,7 @@ int main(int argc, char** argv){
     }
     printf("\n *******************************************************************\n\n"); 
 
-    ACSACnnFreeLib<float>(); 
+    ACSADestroyHandle(handle); 
 
     return 0; 
 }